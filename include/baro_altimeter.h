@@ -6,19 +6,26 @@
 // ----------------------------------------------------------------------------
 /**
  * This class encompasses all functions to create a barometric altimeter for 
- * the drone, based on Adafruit's BMP388 sensor library. This class is 
- * responsible for:
+ * the drone, based on the BMP388 driver (sensor_drivers/bmp388_barometer.h). 
+ * This class is responsible for:
  * - Initializing and configuring the sensor
  * - Reading pressure and temperature
  * - Filtering raw measurements
  * - Computing change in altitude from T/O location
  * - Computing vertical speed
  * 
- * The library applies a median filter to the data to smooth out measurements 
- * during 'hover' states, and based on thresholds, returns more responsive 
- * readings during altitude changes.
+ * The sensor free-runs at its ODR and buffers readings in its FIFO. Each 
+ * ReadSensor() drains the readings that arrived since the last call and runs 
+ * every one of them through the filters, with its own timestamp.
  * 
- * Computes vertical speed based on a backwards difference formula
+ * Out-of-range readings and spikes are replaced with the local median by a 
+ * Hampel filter before anything else sees them, then the pressure and 
+ * temperature are low pass filtered.
+ * 
+ * Altitude and vertical speed come from a Kalman filter (AltKalmanFilter) 
+ * fed with the barometric altitude of every reading. If the INS provides a 
+ * vertical acceleration through SetVertAccel(), it is used as the filter's 
+ * process input.
  */
 
 
@@ -29,13 +36,17 @@
 
 
 // Includes
-#include <Wire.h>
 #include <math.h>
 #include "hummingbird_config.h"
 #include "debugging.h"
-#include "Adafruit_BMP3XX.h"
-#include "filters/median_filter.h"
+#include "hal/i2c_bus.h"
+#include "sensor_drivers/bmp388_barometer.h"
+#include "sensor_drivers/seqlock.h"
+#include "filters/filter_chain.h"
+#include "filters/hampel_filter.h"
 #include "filters/low_pass_filter.h"
+#include "filters/filter_design.h"
+#include "filters/alt_kalman_filter.h"
 
 
 // Constants/config
@@ -43,23 +54,56 @@ constexpr float BARO_ALTIMETER_PRES_MAX = 108300.0f;  // [Pa] Max. allowable atm
 constexpr float BARO_ALTIMETER_PRES_MIN = 94800.0f;  // [Pa] Min. allowable atmos. pressure (~28inHg)
 constexpr float BARO_ALTIMETER_TEMP_MAX = 50.0f;  // [C] Max. allowable atmos. temperature (122F)
 constexpr float BARO_ALTIMETER_TEMP_MIN = -23.0f;  // [C] Min. allowable atmos. temperature (-10F)
+constexpr size_t BARO_ALTIMETER_PRES_HAMPEL_WIDTH = 7;  // Pressure outlier filter window width
+constexpr size_t BARO_ALTIMETER_TEMP_HAMPEL_WIDTH = 5;  // Temperature outlier filter window width
+constexpr float BARO_ALTIMETER_HAMPEL_NSIGMA = 3.0f;  // Outlier gate width in robust std. deviations
+constexpr float BARO_ALTIMETER_PRES_HAMPEL_MIN_DEV = 12.0f;  // [Pa] Smallest pressure outlier gate (~1m)
+constexpr float BARO_ALTIMETER_TEMP_HAMPEL_MIN_DEV = 0.3f;  // [C] Smallest temperature outlier gate
+constexpr float BARO_ALTIMETER_NOMINAL_DT = 0.02f;  // [s] Nominal time between readings (50Hz ODR)
+constexpr size_t BARO_ALTIMETER_FIFO_BATCH = 16;  // Max. FIFO readings processed per ReadSensor()
+constexpr float BARO_ALTIMETER_PRES_LPF_FC = 0.12f;  // [Hz] Pressure LPF cutoff frequency
+constexpr float BARO_ALTIMETER_TEMP_LPF_FC = 0.84f;  // [Hz] Temperature LPF cutoff frequency
+constexpr float BARO_ALTIMETER_PRES_LPF_ALPHA = DesignEMAAlpha(1.0f / BARO_ALTIMETER_NOMINAL_DT, BARO_ALTIMETER_PRES_LPF_FC);  // Pressure LPF smoothing factor at the nominal dt
+constexpr float BARO_ALTIMETER_TEMP_LPF_ALPHA = DesignEMAAlpha(1.0f / BARO_ALTIMETER_NOMINAL_DT, BARO_ALTIMETER_TEMP_LPF_FC);  // Temperature LPF smoothing factor at the nominal dt
+static_assert(EMAAlphaIsValid(BARO_ALTIMETER_PRES_LPF_ALPHA), "Baro pressure LPF cutoff must be in (0, fs/2)");
+static_assert(EMAAlphaIsValid(BARO_ALTIMETER_TEMP_LPF_ALPHA), "Baro temperature LPF cutoff must be in (0, fs/2)");
+
+/* Filter pipelines. Reconfigure a pipeline by changing its stages here. */
+typedef HampelFilter<BARO_ALTIMETER_PRES_HAMPEL_WIDTH> BaroPresOutlierFilter_t;  // Spikes, ahead of the pipeline and Kalman filter
+typedef HampelFilter<BARO_ALTIMETER_TEMP_HAMPEL_WIDTH> BaroTempOutlierFilter_t;  // Spikes, ahead of the pipeline
+typedef FilterChain<LowPassFilter> BaroPresFilter_t;  // LPF
+typedef FilterChain<LowPassFilter> BaroTempFilter_t;  // LPF
+
+
+/**
+ * Altimeter outputs after one ReadSensor(), read as a whole through Outputs.
+ */
+typedef struct
+{
+    float pressure;  // [Pa] Filtered pressure (GetPressure())
+    float temperature;  // [C] Filtered temperature (GetTemp())
+    float altitude;  // [m] Altitude above takeoff (GetAltitude())
+    float altitudeMSL;  // [m] Altitude above MSL (GetAltitudeMSL())
+    float vertSpeed;  // [m/s] Vertical speed, up is positive (GetVertSpeed())
+    uint64_t measMicros;  // [us] Micros64() of the latest reading (GetMeasMicros())
+} BaroAltimeterOutput_t;
 
 
-class BaroAltimeter:
-public Adafruit_BMP3XX
+class BaroAltimeter
 {
     public:
-        BaroAltimeter();
-        bool ConnectToSensor(TwoWire *userWire = &Wire2);
+        BaroAltimeter(I2CBus *bus = SensorI2CBus());
+        bool ConnectToSensor();
         bool ConfigureSensorParams(
-            uint8_t presOS = BMP3_NO_OVERSAMPLING, uint8_t tempOS = BMP3_NO_OVERSAMPLING,
-            uint8_t iirCoef = BMP3_IIR_FILTER_COEFF_3, uint8_t sensODR = BMP3_ODR_50_HZ);
+            BMP388OSR_t presOS = BMP388_OS_1X, BMP388OSR_t tempOS = BMP388_OS_1X,
+            BMP388IIR_t iirCoef = BMP388_IIR_COEF_3, BMP388ODR_t sensODR = BMP388_ODR_50HZ);
         bool Initialize();
         bool SetMSLPres(float presMSL_Pa = 101325.0f);
         // bool SetPresMedFiltWidth(uint8_t windowLen = 5);
         // bool SetTempLPFFactor(float alpha = 0.60f);
         // bool SetPresLPFFactor(float alpha = 0.985f);
         bool ReadSensor();
+        void SetVertAccel(float vertAccel);
         float GetMSLPres();
         float GetAltitudeMSL();
         float GetAltitude();
@@ -69,35 +113,45 @@ public Adafruit_BMP3XX
         float GetPressure();
         float GetTemp();
         float GetVertSpeed();
+        uint32_t GetPresRejectCount();
+        uint64_t GetMeasMicros();
+        uint32_t GetTempRejectCount();
 
         bool isMSLPSet;  // True if MSL pressure is set, false if not
         bool isConnected;  // True if sensor connection began, false if not
         bool isConfigured;  // True if sensor params are set, false if not
         bool isReady;  // True if connected with ground-level pres and temp are set, false if not
+        SeqLock<BaroAltimeterOutput_t> Outputs;  // Consistent copy of the getters' values, published by each ReadSensor() with new readings
         // bool gotData;  // True if a measurement was taken, false if not
         
     private:
 
         bool _ReadGroundPresTemp(uint8_t n, unsigned long measDelay);
         bool _SetTakeoffAltitude();
+        void _ProcessReading(const BaroSample_t &sample);
         
         float _p;  // [Pa] Current pressure (filtered)
-        float _pRaw;  // [Pa] Unfiltered pressure
+        float _pRaw;  // [Pa] Unfiltered pressure, outliers removed
         float _t;  // [C] Current temperature (filtered)
-        float _tRaw;  // [C] Unfiltered temperature
+        float _tRaw;  // [C] Unfiltered temperature, outliers removed
         float _altMSL;  // [m] Altitude above MSL
-        float _lastAltMSL;  // [m] Previous altitude above MSL. Used to calculate vertical speed.
         float _alt;  // [m] Altitude above takeoff location
         float _groundPres;  // [Pa] Ground-level/takeoff altitude pressure
         float _groundTemp;  // [C] Ground-level/takeoff altitude temperature
         float _groundAltMSL;  // [m] Ground-level/takeoff altitude above sea level
         float _mslPres;  // [Pa] Pressure at MSL, typically obtained from airport METAR reports
         float _vertSpeed;  // [m/s] Vertical speed
-        unsigned long _lastMeasMillis;  // [ms] Last measurement time, used to compute dt
-        unsigned long _currMeasMillis;  // [ms] Current measurement time, used to compute dt
-        MedianFilter _PresFastFilter;
-        LowPassFilter _PresSlowFilter;
-        LowPassFilter _TempSlowFilter;
+        float _vertAccel;  // [m/s/s] Latest vertical acceleration from the INS, up is positive
+        bool _hasVertAccel;  // True if a new vertical acceleration was given since the last reading
+        uint64_t _lastMeasMicros;  // [us] Last measurement Micros64(), used to compute dt
+        uint64_t _currMeasMicros;  // [us] Current measurement Micros64() (group delay removed)
+        BMP388Baro _Sensor;  // Pressure/temperature sensor
+        BaroSample_t _fifoBuf[BARO_ALTIMETER_FIFO_BATCH];  // Readings drained from the sensor FIFO
+        BaroPresOutlierFilter_t _PresOutlierFilter;  // Pressure outlier rejection
+        BaroTempOutlierFilter_t _TempOutlierFilter;  // Temperature outlier rejection
+        BaroPresFilter_t _PresFilter;  // Pressure filter pipeline
+        BaroTempFilter_t _TempFilter;  // Temperature filter pipeline
+        AltKalmanFilter _AltFilter;  // Altitude & vertical speed estimator
 
 };
 
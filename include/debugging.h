@@ -13,7 +13,7 @@
 
 
 #pragma once
-#include <Arduino.h>
+#include "hal/hal_platform.h"
 #include "hummingbird_config.h"
 
 
@@ -0,0 +1,63 @@
+// ----------------------------------------------------------------------------
+// ALTITUDE & VERTICAL SPEED KALMAN FILTER
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Three-state Kalman filter that estimates altitude, vertical speed (climb),
+ * and accelerometer bias from barometric altitude measurements.
+ *
+ * State: x = [h, v, b]^T
+ *     h  [m] Altitude
+ *     v  [m/s] Vertical speed, up is positive
+ *     b  [m/s/s] Vertical accelerometer bias
+ *
+ * Without an accelerometer input, the filter is a constant-velocity model
+ * with white-noise acceleration (the bias state is not used). With a vertical
+ * acceleration input 'a' the model is:
+ *     h' = h + v*dt + 0.5*(a - b)*dt^2
+ *     v' = v + (a - b)*dt
+ *     b' = b
+ *
+ * Everything is fixed-size 3x3 math, so the per-sample cost is small and
+ * constant.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <math.h>
+
+
+/* Default noise parameters */
+constexpr float ALTKF_BARO_STD      = 0.5f;   // [m] Baro altitude measurement noise (1-sigma)
+constexpr float ALTKF_ACCEL_STD     = 0.3f;   // [m/s/s] Accelerometer noise when an accel. input is used
+constexpr float ALTKF_MANEUVER_STD  = 2.0f;   // [m/s/s] Unmodeled vertical accel. when no accel. input is used
+constexpr float ALTKF_BIAS_STD      = 0.01f;  // [m/s/s/sqrt(s)] Accelerometer bias random walk
+constexpr float ALTKF_MAX_DT        = 0.5f;   // [s] Largest time step to propagate in one go
+
+
+class AltKalmanFilter
+{
+public:
+    AltKalmanFilter();
+    ~AltKalmanFilter() {};
+    void SetNoise(float baroStd, float accelStd, float maneuverStd, float biasStd);
+    void Reset(float alt, float vertSpeed = 0.0f);
+    void Predict(float dt);
+    void Predict(float dt, float vertAccel);
+    void Correct(float baroAlt);
+    float GetAltitude();
+    float GetVertSpeed();
+    float GetAccelBias();
+    bool isInitialized;  // True once Reset() was called
+private:
+    void _Propagate(float dt, float accel, bool useAccel);
+    float _x[3];  // [h, v, b] State
+    float _P[3][3];  // State covariance
+    float _R;  // [m^2] Baro measurement variance
+    float _qAccel;  // [(m/s/s)^2] Accelerometer noise variance
+    float _qManeuver;  // [(m/s/s)^2] Unmodeled accel. variance (no accel. input)
+    float _qBias;  // [(m/s/s)^2/s] Bias random walk variance
+};
@@ -0,0 +1,54 @@
+// ----------------------------------------------------------------------------
+// DISCRETE BIQUAD FILTER IMPLEMENTATION
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * General second-order (biquad) IIR filter that runs precomputed
+ * coefficients, e.g. a Butterworth low pass from DesignButterworthLPF() in
+ * filter_design.h.
+ */
+
+#pragma once
+
+#include "filters/filter_design.h"
+
+
+class BiquadFilter
+{
+public:
+    BiquadFilter();
+    BiquadFilter(const BiquadCoefs_t &coefs);
+    ~BiquadFilter() {};
+    void SetCoefficients(const BiquadCoefs_t &coefs);
+    void Reset(float val = 0.0f);
+    float Filter(float rawPoint);
+private:
+    bool _setcoefs;  // Were the coefficients set?
+    BiquadCoefs_t _c;  // Normalized coefficients
+    float _z1, _z2;  // Filter state (transposed direct form II)
+};
+
+
+// ----------------------------------------------------------------------------
+// Filter(float rawPoint)
+// ----------------------------------------------------------------------------
+/**
+ * Apply the biquad to a new point and output the filtered value.
+ *
+ * @param rawPoint  Raw data point to filter
+ * @return          Filtered measurement
+ */
+inline float BiquadFilter::Filter(float rawPoint)
+{
+    float outPoint;
+
+    if (this->_setcoefs == false)  // Just return unfiltered measurement
+        return rawPoint;
+
+    outPoint = (this->_c.b0 * rawPoint) + this->_z1;
+    this->_z1 = (this->_c.b1 * rawPoint) - (this->_c.a1 * outPoint) + this->_z2;
+    this->_z2 = (this->_c.b2 * rawPoint) - (this->_c.a2 * outPoint);
+    return outPoint;
+}
@@ -0,0 +1,141 @@
+// ----------------------------------------------------------------------------
+// COMPILE-TIME FILTER CHAIN
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Compose several filter stages into a single filter at compile time. A stage
+ * is any class with a non-virtual 'float Filter(float)' method (LowPassFilter,
+ * FixedMedianFilter, NotchFilter, RateLimitFilter, ...). The chain stores each
+ * stage by value, so the whole pipeline's state is one contiguous struct. The
+ * stages' Filter() methods are defined in their headers (there's no LTO), so
+ * the compiler can inline every stage into the caller.
+ *
+ * Example:
+ *     typedef FilterChain<FixedMedianFilter<5>, LowPassFilter> PresFilter_t;
+ *     PresFilter_t PresFilter;
+ *     PresFilter.Stage<1>().SetSmoothingFactor(0.1f);
+ *     p = PresFilter.Filter(pRaw);  // median, then LPF
+ *
+ * Changing the pipeline only means changing the typedef.
+ *
+ * Filter(rawPoint, dt) passes the measured sample period to every stage that
+ * has a 'float Filter(float, float)' overload (e.g. a LowPassFilter set up
+ * with a cutoff frequency). Other stages get Filter(rawPoint).
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+
+template <typename... Stages>
+class FilterChain;
+
+
+/**
+ * Stage type/accessor lookup for a FilterChain. FilterChainElement<I, Chain>
+ * gives the type of the I'th stage and a reference to it.
+ */
+template <size_t I, typename Chain>
+struct FilterChainElement;
+
+template <typename Head, typename... Tail>
+struct FilterChainElement<0, FilterChain<Head, Tail...>>
+{
+    typedef Head type;
+    static Head &Get(FilterChain<Head, Tail...> &chain) { return chain.head; }
+};
+
+template <size_t I, typename Head, typename... Tail>
+struct FilterChainElement<I, FilterChain<Head, Tail...>>
+{
+    typedef typename FilterChainElement<I - 1, FilterChain<Tail...>>::type type;
+    static type &Get(FilterChain<Head, Tail...> &chain)
+    {
+        return FilterChainElement<I - 1, FilterChain<Tail...>>::Get(chain.tail);
+    }
+};
+
+
+/**
+ * Call a stage's Filter(rawPoint, dt) if it has one, otherwise
+ * Filter(rawPoint). The int/long argument picks the first overload when both
+ * are viable.
+ */
+template <typename Stage>
+inline auto FilterChainStageDt(Stage &stage, float rawPoint, float dt, int)
+    -> decltype(stage.Filter(rawPoint, dt))
+{
+    return stage.Filter(rawPoint, dt);
+}
+
+template <typename Stage>
+inline float FilterChainStageDt(Stage &stage, float rawPoint, float, long)
+{
+    return stage.Filter(rawPoint);
+}
+
+
+/**
+ * End of the chain. Passes the point through untouched.
+ */
+template <>
+class FilterChain<>
+{
+public:
+    static constexpr size_t NumStages = 0;
+    float Filter(float rawPoint) { return rawPoint; }
+    float Filter(float rawPoint, float) { return rawPoint; }
+};
+
+
+/**
+ * Filter chain. Runs a data point through 'Head' and then the rest of the
+ * stages, in the order they are listed.
+ */
+template <typename Head, typename... Tail>
+class FilterChain<Head, Tail...>
+{
+public:
+    static constexpr size_t NumStages = 1 + sizeof...(Tail);
+
+    /**
+     * Run a new point through every stage of the chain.
+     *
+     * @param rawPoint  Raw data point to filter
+     * @return          Output of the last stage
+     */
+    float Filter(float rawPoint)
+    {
+        return tail.Filter(head.Filter(rawPoint));
+    }
+
+    /**
+     * Run a new point through every stage of the chain, giving
+     * dt-aware stages the measured sample period.
+     *
+     * @param rawPoint  Raw data point to filter
+     * @param dt        [s] Time since the previous point
+     * @return          Output of the last stage
+     */
+    float Filter(float rawPoint, float dt)
+    {
+        return tail.Filter(FilterChainStageDt(head, rawPoint, dt, 0), dt);
+    }
+
+    /**
+     * Return a reference to the I'th stage (0 is the first stage the data
+     * goes through). Use this to configure the stages.
+     */
+    template <size_t I>
+    typename FilterChainElement<I, FilterChain>::type &Stage()
+    {
+        static_assert(I < NumStages, "FilterChain stage index out of range");
+        return FilterChainElement<I, FilterChain>::Get(*this);
+    }
+
+    Head head;  ///< First stage
+    FilterChain<Tail...> tail;  ///< Remaining stages
+};
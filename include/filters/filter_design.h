@@ -0,0 +1,150 @@
+// ----------------------------------------------------------------------------
+// COMPILE-TIME FILTER COEFFICIENT DESIGN
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * constexpr design functions for filter coefficients. Give them the sample
+ * rate and cutoff/center frequencies and the compiler computes the
+ * coefficients, so they end up as read-only constants and nothing is computed
+ * at startup. Pair them with a static_assert so a typo in a frequency is a
+ * build error instead of an unstable filter:
+ *
+ *     constexpr BiquadCoefs_t GYRO_NOTCH = DesignNotch(400.0f, 120.0f, 2.0f);
+ *     static_assert(BiquadIsStable(GYRO_NOTCH), "Gyro notch is unstable");
+ *
+ *     constexpr float ACCEL_ALPHA = DesignEMAAlpha(200.0f, 30.0f);
+ *     static_assert(EMAAlphaIsValid(ACCEL_ALPHA), "Bad accel. LPF alpha");
+ *
+ * Invalid parameters (e.g. a cutoff at or above Nyquist) give coefficients
+ * that fail the checks above.
+ *
+ * Biquads are from the RBJ audio EQ cookbook, the same as NotchFilter.
+ */
+
+#pragma once
+
+#include "constants.h"
+#include "maths/constexpr_math.h"
+
+
+/* Normalized (a0 = 1) biquad coefficients */
+typedef struct
+{
+    float b0, b1, b2;  // Numerator
+    float a1, a2;  // Denominator
+} BiquadCoefs_t;
+
+
+/* Q factor of a 2nd-order Butterworth filter, 1/sqrt(2) */
+constexpr float FILTER_DESIGN_BUTTERWORTH_Q = 0.70710678f;
+
+
+/* Check the design inputs, 0 < f < fs/2 */
+constexpr bool FilterDesignFreqIsValid(float fsHz, float fHz)
+{
+    return (fsHz > 0.0f) && (fHz > 0.0f) && (fHz < 0.5f * fsHz);
+}
+
+
+/* Returned for invalid design inputs. Pole on the unit circle, so
+   BiquadIsStable() is false. */
+constexpr BiquadCoefs_t FilterDesignInvalidBiquad()
+{
+    return BiquadCoefs_t{0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+}
+
+
+/* Normalize RBJ coefficients by a0 = 1 + alpha */
+constexpr BiquadCoefs_t FilterDesignNormalize(float b0, float b1, float b2, float a0, float a1, float a2)
+{
+    return BiquadCoefs_t{b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0};
+}
+
+constexpr BiquadCoefs_t FilterDesignLPFRBJ(float cosw0, float alpha)
+{
+    return FilterDesignNormalize(
+        0.5f * (1.0f - cosw0), 1.0f - cosw0, 0.5f * (1.0f - cosw0),
+        1.0f + alpha, -2.0f * cosw0, 1.0f - alpha);
+}
+
+constexpr BiquadCoefs_t FilterDesignNotchRBJ(float cosw0, float alpha)
+{
+    return FilterDesignNormalize(
+        1.0f, -2.0f * cosw0, 1.0f,
+        1.0f + alpha, -2.0f * cosw0, 1.0f - alpha);
+}
+
+
+// ----------------------------------------------------------------------------
+// DesignEMAAlpha(float fsHz, float fcHz)
+// ----------------------------------------------------------------------------
+/**
+ * Smoothing factor of a 1st-order low pass filter (LowPassFilter) with a
+ * -3dB cutoff frequency fc, alpha = 1 - exp(-2*pi*fc/fs).
+ *
+ * @param fsHz  [Hz] Sample rate
+ * @param fcHz  [Hz] Cutoff frequency, 0 < fc < fs/2
+ * @return      Smoothing factor, (0, 1). -1 if the inputs are invalid.
+ */
+constexpr float DesignEMAAlpha(float fsHz, float fcHz)
+{
+    return FilterDesignFreqIsValid(fsHz, fcHz) ? (1.0f - ConstexprExp(-CONSTS_2PI * fcHz / fsHz)) : -1.0f;
+}
+
+
+// ----------------------------------------------------------------------------
+// DesignButterworthLPF(float fsHz, float fcHz)
+// ----------------------------------------------------------------------------
+/**
+ * 2nd-order Butterworth low pass biquad.
+ *
+ * @param fsHz  [Hz] Sample rate
+ * @param fcHz  [Hz] -3dB cutoff frequency, 0 < fc < fs/2
+ * @return      Biquad coefficients
+ */
+constexpr BiquadCoefs_t DesignButterworthLPF(float fsHz, float fcHz)
+{
+    return FilterDesignFreqIsValid(fsHz, fcHz)
+        ? FilterDesignLPFRBJ(
+            ConstexprCos(CONSTS_2PI * fcHz / fsHz),
+            ConstexprSin(CONSTS_2PI * fcHz / fsHz) / (2.0f * FILTER_DESIGN_BUTTERWORTH_Q))
+        : FilterDesignInvalidBiquad();
+}
+
+
+// ----------------------------------------------------------------------------
+// DesignNotch(float fsHz, float centerHz, float q)
+// ----------------------------------------------------------------------------
+/**
+ * Notch (band-stop) biquad.
+ *
+ * @param fsHz      [Hz] Sample rate
+ * @param centerHz  [Hz] Frequency to reject, 0 < f < fs/2
+ * @param q         Quality factor, > 0. Higher is a narrower notch.
+ * @return          Biquad coefficients
+ */
+constexpr BiquadCoefs_t DesignNotch(float fsHz, float centerHz, float q)
+{
+    return (FilterDesignFreqIsValid(fsHz, centerHz) && q > 0.0f)
+        ? FilterDesignNotchRBJ(
+            ConstexprCos(CONSTS_2PI * centerHz / fsHz),
+            ConstexprSin(CONSTS_2PI * centerHz / fsHz) / (2.0f * q))
+        : FilterDesignInvalidBiquad();
+}
+
+
+/* True if a LowPassFilter smoothing factor is in (0, 1] */
+constexpr bool EMAAlphaIsValid(float alpha)
+{
+    return (alpha > 0.0f) && (alpha <= 1.0f);
+}
+
+
+/* True if both poles of the biquad are inside the unit circle (stability
+   triangle: |a2| < 1 and |a1| < 1 + a2) */
+constexpr bool BiquadIsStable(const BiquadCoefs_t &c)
+{
+    return (c.a2 < 1.0f) && (c.a2 > -1.0f) && (c.a1 < 1.0f + c.a2) && (-c.a1 < 1.0f + c.a2);
+}
@@ -0,0 +1,179 @@
+// ----------------------------------------------------------------------------
+// THREE-AXIS POLYPHASE FIR DECIMATOR
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Anti-alias and downsample an oversampled three-axis stream (gyro, accel.)
+ * by an integer factor M. Sample the sensor at its max. ODR, push batches of
+ * samples in, and get one filtered sample out for every M in.
+ *
+ * This is the polyphase form of 'FIR filter, then keep every M'th point': the
+ * filter is only evaluated at the instants that are kept, so the cost is one
+ * NTAPS-long dot product per OUTPUT sample instead of per input sample.
+ *
+ * The three axes are kept in separate arrays (SoA) and are convolved in the
+ * same loop, so the compiler can vectorize it. The delay line is stored twice
+ * back-to-back so the dot product never has to wrap around.
+ *
+ * Coefficients default to a Blackman-windowed sinc with the cutoff (-6dB
+ * point) at a fraction of the output Nyquist frequency, normalized to unity
+ * DC gain. E.g. 800Hz -> 200Hz with 32 taps and the default cutoff: -1dB at
+ * 50Hz, -6dB at 80Hz, and a 350Hz tone (which would alias to 50Hz) is down
+ * more than 80dB.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <math.h>
+#include "constants.h"
+
+
+template <size_t NTAPS, size_t M>
+class FIRDecimator3
+{
+public:
+    static_assert(NTAPS > 0, "FIRDecimator3 needs at least one tap");
+    static_assert(M > 0, "FIRDecimator3 decimation factor must be >= 1");
+
+    /**
+     * Construct the decimator and design its anti-alias filter.
+     *
+     * @param cutoffFrac    Cutoff as a fraction of the OUTPUT Nyquist
+     *                      frequency, (0, 1]. Default 0.8.
+     */
+    FIRDecimator3(float cutoffFrac = 0.8f)
+    {
+        DesignLowPass(cutoffFrac);
+        Reset();
+    }
+
+    /**
+     * Design a Blackman-windowed sinc low pass with unity DC gain.
+     *
+     * @param cutoffFrac    Cutoff as a fraction of the output Nyquist, (0, 1]
+     */
+    void DesignLowPass(float cutoffFrac)
+    {
+        size_t i;
+        float fc;  // Cutoff as a fraction of the input sample rate
+        float center = 0.5f * (float)(NTAPS - 1);
+        float sum = 0.0f;
+
+        if (cutoffFrac <= 0.0f || cutoffFrac > 1.0f)
+            cutoffFrac = 0.8f;
+
+        fc = (0.5f * cutoffFrac) / (float)M;
+
+        for (i = 0; i < NTAPS; i++)
+        {
+            float n = (float)i - center;
+            float sinc = (fabsf(n) < 1.0e-6f) ? (2.0f * fc) : (sinf(CONSTS_2PI * fc * n) / (CONSTS_PI * n));
+            float win = (NTAPS > 1)
+                ? 0.42f - (0.5f * cosf(CONSTS_2PI * (float)i / (float)(NTAPS - 1))) + (0.08f * cosf(2.0f * CONSTS_2PI * (float)i / (float)(NTAPS - 1)))
+                : 1.0f;
+            _h[i] = sinc * win;
+            sum += _h[i];
+        }
+
+        for (i = 0; i < NTAPS; i++)
+            _h[i] /= sum;
+    }
+
+    /**
+     * Use your own filter coefficients.
+     *
+     * @param coefs     Array of NTAPS FIR coefficients
+     */
+    void SetCoefficients(const float *coefs)
+    {
+        for (size_t i = 0; i < NTAPS; i++)
+            _h[i] = coefs[i];
+    }
+
+    /**
+     * Clear the delay line and the decimation phase.
+     *
+     * @param val   Value to fill the delay lines with (e.g. first sample)
+     */
+    void Reset(float val = 0.0f)
+    {
+        for (size_t i = 0; i < 2 * NTAPS; i++)
+        {
+            _x[i] = val;
+            _y[i] = val;
+            _z[i] = val;
+        }
+        _head = 0;
+        _phase = 0;
+    }
+
+    /**
+     * Push a batch of input samples and write out the decimated samples.
+     * The output arrays must have room for (n / M) + 1 samples.
+     *
+     * @param inX, inY, inZ     Input samples, n per axis
+     * @param n                 Number of input samples
+     * @param outX, outY, outZ  Decimated output samples
+     * @return                  Number of output samples written
+     */
+    size_t Process(const float *inX, const float *inY, const float *inZ, size_t n,
+                   float *outX, float *outY, float *outZ)
+    {
+        size_t i, k;
+        size_t nOut = 0;
+
+        for (i = 0; i < n; i++)
+        {
+            // Newest sample sits at _head, oldest at _head + NTAPS - 1
+            _head = (_head == 0) ? (NTAPS - 1) : (_head - 1);
+            _x[_head] = inX[i];
+            _y[_head] = inY[i];
+            _z[_head] = inZ[i];
+            _x[_head + NTAPS] = inX[i];
+            _y[_head + NTAPS] = inY[i];
+            _z[_head + NTAPS] = inZ[i];
+
+            _phase++;
+            if (_phase < M)
+                continue;
+            _phase = 0;
+
+            // Only evaluate the filter at the kept instants
+            const float *px = &_x[_head];
+            const float *py = &_y[_head];
+            const float *pz = &_z[_head];
+            float sx = 0.0f;
+            float sy = 0.0f;
+            float sz = 0.0f;
+            for (k = 0; k < NTAPS; k++)
+            {
+                sx += _h[k] * px[k];
+                sy += _h[k] * py[k];
+                sz += _h[k] * pz[k];
+            }
+            outX[nOut] = sx;
+            outY[nOut] = sy;
+            outZ[nOut] = sz;
+            nOut++;
+        }
+
+        return nOut;
+    }
+
+    /* Return the decimation factor */
+    size_t GetFactor() const { return M; }
+
+    /* Return the filter's group delay in INPUT samples (linear phase) */
+    float GetGroupDelay() const { return 0.5f * (float)(NTAPS - 1); }
+
+private:
+    float _h[NTAPS];  ///< FIR coefficients
+    float _x[2 * NTAPS];  ///< X delay line (stored twice)
+    float _y[2 * NTAPS];  ///< Y delay line (stored twice)
+    float _z[2 * NTAPS];  ///< Z delay line (stored twice)
+    size_t _head;  ///< Index of the newest sample in the delay lines
+    size_t _phase;  ///< Input samples since the last output
+};
@@ -0,0 +1,88 @@
+// ----------------------------------------------------------------------------
+// FIXED-SIZE MEDIAN FILTER
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Median filter with the window width set at compile time. The window lives
+ * inside the object (no heap), so it can be used as a FilterChain stage.
+ * Good for knocking out single-sample spikes before a low pass filter.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+
+template <size_t N>
+class FixedMedianFilter
+{
+public:
+    static_assert(N > 0, "FixedMedianFilter window must have at least one point");
+
+    /**
+     * Construct the filter and fill the window with an initial value.
+     *
+     * @param initVal  Value to fill the window with.
+     */
+    FixedMedianFilter(float initVal = 0.0f)
+    {
+        Fill(initVal);
+    }
+
+    /**
+     * Fill the window with a value. Use this to initialize the filter!
+     *
+     * @param val  Value to fill the window with.
+     */
+    void Fill(float val)
+    {
+        for (size_t i = 0; i < N; i++)
+            _window[i] = val;
+        _insertIndex = 0;
+    }
+
+    /**
+     * Add a point to the window and return the median of the window.
+     *
+     * @param newPoint  Noisy point to filter.
+     * @return          Median of the last N points.
+     */
+    float Filter(float newPoint)
+    {
+        float sorted[N];
+        size_t i, j;
+
+        _window[_insertIndex] = newPoint;
+        _insertIndex++;
+        if (_insertIndex >= N)
+            _insertIndex = 0;
+
+        // Insertion sort into a scratch copy. N is small, so this beats
+        // anything fancier.
+        for (i = 0; i < N; i++)
+        {
+            float val = _window[i];
+            j = i;
+            while (j > 0 && sorted[j - 1] > val)
+            {
+                sorted[j] = sorted[j - 1];
+                j--;
+            }
+            sorted[j] = val;
+        }
+
+        if (N % 2 == 1)
+            return sorted[N / 2];
+
+        return 0.5f * (sorted[(N / 2) - 1] + sorted[N / 2]);
+    }
+
+    /* Return the median filter window width */
+    size_t GetWindowWidth() const { return N; }
+
+private:
+    float _window[N];  ///< Past data points (ring buffer)
+    size_t _insertIndex;  ///< Where the next point goes in the window
+};
@@ -0,0 +1,175 @@
+// ----------------------------------------------------------------------------
+// HAMPEL (MEDIAN ABSOLUTE DEVIATION) OUTLIER FILTER
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Streaming Hampel filter with the window width set at compile time. Each new
+ * point is compared to the median of the last N points. If it is further
+ * than nSigma robust standard deviations away, it is an outlier and the
+ * median is output instead. Everything else passes through untouched, so,
+ * unlike a median filter, good data isn't smoothed or delayed.
+ *
+ * The robust standard deviation is 1.4826 * MAD, where MAD is the median
+ * absolute deviation from the median of the window. A floor on the gate keeps
+ * a quiet (or quantized, MAD = 0) signal from rejecting every change.
+ *
+ * The window lives inside the object (no heap), so it can be used as a
+ * FilterChain stage ahead of any other filter. The window is filled with the
+ * first point it sees.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+
+
+/* Scale factor from MAD to standard deviation for Gaussian noise */
+constexpr float HAMPEL_MAD_TO_STD = 1.4826f;
+
+
+template <size_t N>
+class HampelFilter
+{
+public:
+    static_assert(N >= 3, "HampelFilter window must have at least three points");
+
+    /**
+     * Construct the filter.
+     *
+     * @param nSigma    Gate width in robust standard deviations. Default 3.
+     * @param minDev    Smallest gate width, same units as the signal.
+     *                  Default 0.
+     */
+    HampelFilter(float nSigma = 3.0f, float minDev = 0.0f)
+    {
+        SetThreshold(nSigma, minDev);
+        _primed = false;
+        _insertIndex = 0;
+        _median = 0.0f;
+        _rejectCount = 0;
+    }
+
+    /**
+     * Set the outlier gate.
+     *
+     * @param nSigma    Gate width in robust standard deviations, > 0
+     * @param minDev    Smallest gate width, same units as the signal, >= 0
+     */
+    void SetThreshold(float nSigma, float minDev)
+    {
+        _nSigma = fabsf(nSigma);
+        _minDev = fabsf(minDev);
+    }
+
+    /**
+     * Fill the window with a value.
+     *
+     * @param val  Value to fill the window with.
+     */
+    void Fill(float val)
+    {
+        for (size_t i = 0; i < N; i++)
+            _window[i] = val;
+        _insertIndex = 0;
+        _median = val;
+        _primed = true;
+    }
+
+    /**
+     * Check a point against the window and return it, or the window median
+     * if it is an outlier. Outliers still go into the window, so a real step
+     * change passes once it fills half of the window.
+     *
+     * @param newPoint  Point to check.
+     * @return          newPoint, or the median if newPoint is an outlier.
+     */
+    float Filter(float newPoint)
+    {
+        float sorted[N];
+        float gate;
+
+        if (_primed == false)
+            Fill(newPoint);
+
+        _window[_insertIndex] = newPoint;
+        _insertIndex++;
+        if (_insertIndex >= N)
+            _insertIndex = 0;
+
+        for (size_t i = 0; i < N; i++)
+            sorted[i] = _window[i];
+        _median = _Median(sorted);
+
+        for (size_t i = 0; i < N; i++)
+            sorted[i] = fabsf(_window[i] - _median);
+        gate = _nSigma * HAMPEL_MAD_TO_STD * _Median(sorted);
+        if (gate < _minDev)
+            gate = _minDev;
+
+        if (fabsf(newPoint - _median) > gate)
+        {
+            _rejectCount++;
+            return _median;
+        }
+
+        return newPoint;
+    }
+
+    /**
+     * Reject a point that is already known to be bad (e.g. out of range)
+     * without putting it in the window. Counts as a rejection.
+     *
+     * @return  Median of the window.
+     */
+    float Reject()
+    {
+        _rejectCount++;
+        return _median;
+    }
+
+    /* Return the number of rejected points */
+    uint32_t GetRejectCount() const { return _rejectCount; }
+
+    /* Return the median of the window at the last point */
+    float GetMedian() const { return _median; }
+
+    /* Return the filter window width */
+    size_t GetWindowWidth() const { return N; }
+
+private:
+    /* Median of N points. Sorts the array in place (insertion sort, N is
+       small). */
+    static float _Median(float *arr)
+    {
+        size_t i, j;
+
+        for (i = 1; i < N; i++)
+        {
+            float val = arr[i];
+            j = i;
+            while (j > 0 && arr[j - 1] > val)
+            {
+                arr[j] = arr[j - 1];
+                j--;
+            }
+            arr[j] = val;
+        }
+
+        if (N % 2 == 1)
+            return arr[N / 2];
+
+        return 0.5f * (arr[(N / 2) - 1] + arr[N / 2]);
+    }
+
+    float _window[N];  ///< Past data points (ring buffer)
+    size_t _insertIndex;  ///< Where the next point goes in the window
+    bool _primed;  ///< Was the window filled?
+    float _median;  ///< Median of the window at the last point
+    float _nSigma;  ///< Gate width in robust standard deviations
+    float _minDev;  ///< Smallest gate width
+    uint32_t _rejectCount;  ///< Number of rejected points
+};
@@ -8,16 +8,28 @@
  * This is a simple implementation of a discrete low pass filter to filter
  * noisy signals. A low pass filter will let low-frequency signals through and
  * attenuate high-frequency signals (-3dB cutoff).
+ * 
+ * The filter can be configured with a raw smoothing factor (only correct at 
+ * one sample rate), or with a cutoff frequency. With a cutoff frequency, 
+ * Filter(rawPoint, dt) recomputes the smoothing factor from the measured 
+ * sample period so the bandwidth stays put when loop timing jitters.
  */
 
 #pragma once
 
-#include <Arduino.h>
+#include <math.h>
 #include "constants.h"
 #include "maths/math_functs.h"
 #include "hummingbird_config.h"
 
 
+/**
+ * If the measured sample period is within this fraction of the nominal 
+ * period, use the cached smoothing factor instead of recomputing it.
+ */
+constexpr float LPF_DT_NOMINAL_TOL = 0.02f;
+
+
 // ------------------------------------
 // Low Pass Filter Class
 // ------------------------------------
@@ -27,11 +39,75 @@ public:
     LowPassFilter();
     ~LowPassFilter();
     void SetSmoothingFactor(float newSF = 1.0f);
+    bool SetCutoffFrequency(float cutoffHz, float nominalDt);
+    bool SetCutoffFrequency(float cutoffHz, float nominalDt, float nominalAlpha);
     float Filter(float rawPoint);
-    float dt;
+    float Filter(float rawPoint, float sampleDt);
+    float dt;  // [s] Last sample period given to Filter(rawPoint, sampleDt)
 protected:
 private:
     bool _setsf;  // Set smoothing factor?
+    bool _setfc;  // Set cutoff frequency?
     float _outPoint;  // Previously filtered point
-    float _a;  // Filter smoothing factor, [0, 1]
+    float _a;  // Filter smoothing factor, [0, 1]. Cached value for the nominal dt if using a cutoff frequency.
+    float _wc;  // [rad/s] Cutoff frequency
+    float _nominalDt;  // [s] Nominal sample period that '_a' was computed for
 };
+
+
+// ----------------------------------------------------------------------------
+// Filter(float rawPoint)
+// ----------------------------------------------------------------------------
+/**
+ * Apply the LFP (defined by the smoothing factor) to a new point and output 
+ * the filtered value.
+ * 
+ * @param rawPoint  Raw data point to filter
+ * @return          Filtered measurement
+ */
+inline float LowPassFilter::Filter(float rawPoint)
+{
+    if (this->_setsf == false)  // Just return unfiltered measurement
+    {
+        this->_outPoint = rawPoint;
+        return this->_outPoint;
+    }
+
+    this->_outPoint = (this->_a * rawPoint) + ((1.0f - this->_a) * this->_outPoint);
+    return this->_outPoint;
+}
+
+
+// ----------------------------------------------------------------------------
+// Filter(float rawPoint, float sampleDt)
+// ----------------------------------------------------------------------------
+/**
+ * Apply the LPF to a new point that arrived 'sampleDt' seconds after the 
+ * previous one. If a cutoff frequency was set and the sample period is off 
+ * nominal, the smoothing factor is recomputed (with a cheap exp()) so the 
+ * cutoff frequency stays correct. A zero or negative dt leaves the output 
+ * unchanged. With a raw smoothing factor, this is the same as Filter(rawPoint).
+ * 
+ * @param rawPoint  Raw data point to filter
+ * @param sampleDt  [s] Time since the previous point
+ * @return          Filtered measurement
+ */
+inline float LowPassFilter::Filter(float rawPoint, float sampleDt)
+{
+    float a;
+
+    this->dt = sampleDt;
+
+    if (this->_setfc == false)
+        return this->Filter(rawPoint);
+
+    if (fabsf(sampleDt - this->_nominalDt) <= (LPF_DT_NOMINAL_TOL * this->_nominalDt))
+        a = this->_a;  // Close enough to nominal, use the cached value
+    else if (sampleDt <= 0.0f)
+        return this->_outPoint;
+    else
+        a = 1.0f - expf_fast(-this->_wc * sampleDt);
+
+    this->_outPoint = (a * rawPoint) + ((1.0f - a) * this->_outPoint);
+    return this->_outPoint;
+}
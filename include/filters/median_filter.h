@@ -10,7 +10,7 @@
 
 #pragma once
 
-#include <Arduino.h>
+#include <stddef.h>
 #include "hummingbird_config.h"
 
 constexpr size_t MEDAINFILT_MAX_POINTS = 20;  // Max. number of points to store for filter
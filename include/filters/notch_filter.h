@@ -0,0 +1,56 @@
+// ----------------------------------------------------------------------------
+// DISCRETE NOTCH FILTER IMPLEMENTATION
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Second-order (biquad) notch filter. Attenuates a narrow band of frequencies
+ * around the center frequency (motor/prop vibration, for example) and lets
+ * everything else through.
+ */
+
+#pragma once
+
+#include <math.h>
+#include "constants.h"
+#include "filters/filter_design.h"
+
+
+class NotchFilter
+{
+public:
+    NotchFilter();
+    ~NotchFilter() {};
+    bool SetNotch(float centerFreqHz, float sampleRateHz, float q = 0.707f);
+    bool SetNotch(const BiquadCoefs_t &coefs);
+    float Filter(float rawPoint);
+private:
+    bool _setnotch;  // Was the notch configured?
+    float _b0, _b1, _b2;  // Numerator coefficients (normalized by a0)
+    float _a1, _a2;  // Denominator coefficients (normalized by a0)
+    float _z1, _z2;  // Filter state (transposed direct form II)
+};
+
+
+// ----------------------------------------------------------------------------
+// Filter(float rawPoint)
+// ----------------------------------------------------------------------------
+/**
+ * Apply the notch to a new point and output the filtered value.
+ *
+ * @param rawPoint  Raw data point to filter
+ * @return          Filtered measurement
+ */
+inline float NotchFilter::Filter(float rawPoint)
+{
+    float outPoint;
+
+    if (this->_setnotch == false)  // Just return unfiltered measurement
+        return rawPoint;
+
+    outPoint = (this->_b0 * rawPoint) + this->_z1;
+    this->_z1 = (this->_b1 * rawPoint) - (this->_a1 * outPoint) + this->_z2;
+    this->_z2 = (this->_b2 * rawPoint) - (this->_a2 * outPoint);
+    return outPoint;
+}
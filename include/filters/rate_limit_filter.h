@@ -0,0 +1,60 @@
+// ----------------------------------------------------------------------------
+// RATE LIMITER
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Limit how much a signal can change between two samples. Useful to keep
+ * glitches from yanking downstream filters around.
+ */
+
+#pragma once
+
+#include <math.h>
+
+
+class RateLimitFilter
+{
+public:
+    RateLimitFilter();
+    ~RateLimitFilter() {};
+    void SetMaxStep(float maxStep);
+    float Filter(float rawPoint);
+private:
+    bool _setstep;  // Was the max. step set?
+    bool _primed;  // Has the filter seen a point yet?
+    float _maxStep;  // Max. allowed change between two outputs
+    float _outPoint;  // Previous output
+};
+
+
+// ----------------------------------------------------------------------------
+// Filter(float rawPoint)
+// ----------------------------------------------------------------------------
+/**
+ * Move the output towards the new point by at most the max. step.
+ *
+ * @param rawPoint  Raw data point to filter
+ * @return          Rate-limited measurement
+ */
+inline float RateLimitFilter::Filter(float rawPoint)
+{
+    float delta;
+
+    if (this->_setstep == false || this->_primed == false)
+    {
+        this->_outPoint = rawPoint;
+        this->_primed = true;
+        return this->_outPoint;
+    }
+
+    delta = rawPoint - this->_outPoint;
+    if (delta > this->_maxStep)
+        delta = this->_maxStep;
+    else if (delta < -this->_maxStep)
+        delta = -this->_maxStep;
+
+    this->_outPoint += delta;
+    return this->_outPoint;
+}
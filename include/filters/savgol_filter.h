@@ -0,0 +1,257 @@
+// ----------------------------------------------------------------------------
+// STREAMING SAVITZKY-GOLAY SMOOTHER/DIFFERENTIATOR
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Fit a polynomial to the last N points by least squares and return its value
+ * or one of its derivatives. The fit is linear in the data, so it boils down
+ * to one N-long dot product per sample with coefficients that are computed
+ * once in Configure().
+ *
+ * Compared to low pass filtering and then finite differencing, a polynomial
+ * fit tracks ramps (and curves, for order >= 2) without lag, so the derivative
+ * is smooth with much less delay. The fit is evaluated at the newest point by
+ * default. Evaluating it further back in the window (up to the center) gives
+ * more smoothing for more delay.
+ *
+ * Example, climb rate from altitude at 50Hz:
+ *     SavGolFilter<11> VSFilter;
+ *     VSFilter.Configure(2, 1);  // Quadratic fit, 1st derivative
+ *     VSFilter.Fill(alt);
+ *     vs = VSFilter.Filter(alt, 0.02f);  // [m/s]
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <math.h>
+
+
+/* Highest polynomial order that can be fit */
+constexpr size_t SAVGOL_MAX_ORDER = 4;
+
+
+template <size_t N>
+class SavGolFilter
+{
+public:
+    static_assert(N >= 2, "SavGolFilter window must have at least two points");
+
+    /**
+     * Construct the filter as a quadratic smoother (order 2, or linear for a
+     * two-point window, no derivative) and fill the window with an initial
+     * value.
+     *
+     * @param initVal  Value to fill the window with.
+     */
+    SavGolFilter(float initVal = 0.0f)
+    {
+        Configure((N > 2) ? 2 : 1, 0);
+        Fill(initVal);
+    }
+
+    /**
+     * Compute the filter coefficients.
+     *
+     * @param order     Polynomial order, must be < N and <= SAVGOL_MAX_ORDER
+     * @param deriv     Derivative to output, 0 = smoothed value, must be <= order
+     * @param lag       [samples] Where in the window to evaluate the fit.
+     *                  0 = newest point (least delay), (N-1)/2 = center
+     *                  (most smoothing).
+     * @return          True if the arguments are valid, false if not (the
+     *                  old coefficients are kept)
+     */
+    bool Configure(size_t order, size_t deriv, float lag = 0.0f)
+    {
+        const size_t nc = order + 1;
+        float ata[SAVGOL_MAX_ORDER + 1][SAVGOL_MAX_ORDER + 1];
+        float w[SAVGOL_MAX_ORDER + 1];  // Row 'deriv' of inv(A^T*A)
+        float scale = 1.0f / (float)(N - 1);  // Keeps the powers of t in [-1, 0]
+        float tEval = -lag * scale;
+        size_t i, j, k;
+
+        if (order > SAVGOL_MAX_ORDER || order >= N || deriv > order || lag < 0.0f || lag > (float)(N - 1))
+            return false;
+
+        // Normal equations, t = -(N-1)..0 (scaled), newest point at t = 0
+        for (i = 0; i < nc; i++)
+            for (j = 0; j < nc; j++)
+                ata[i][j] = 0.0f;
+
+        for (k = 0; k < N; k++)
+        {
+            float t = -(float)k * scale;
+            float ti = 1.0f;
+            for (i = 0; i < nc; i++)
+            {
+                float tij = ti;
+                for (j = 0; j < nc; j++)
+                {
+                    ata[i][j] += tij;
+                    tij *= t;
+                }
+                ti *= t;
+            }
+        }
+
+        // Solve A^T*A * w = d/dt^deriv of [1, t, t^2, ...] at tEval. Then the
+        // coefficient for point k is w . [1, t_k, t_k^2, ...].
+        for (i = 0; i < nc; i++)
+        {
+            float fact = 1.0f;
+            float tp = 1.0f;
+            if (i < deriv)
+            {
+                w[i] = 0.0f;
+                continue;
+            }
+            for (j = 0; j < deriv; j++)
+                fact *= (float)(i - j);
+            for (j = 0; j < i - deriv; j++)
+                tp *= tEval;
+            w[i] = fact * tp;
+        }
+
+        if (_Solve(ata, w, nc) == false)
+            return false;
+
+        for (k = 0; k < N; k++)
+        {
+            float t = -(float)k * scale;
+            float tk = 1.0f;
+            float c = 0.0f;
+            for (i = 0; i < nc; i++)
+            {
+                c += w[i] * tk;
+                tk *= t;
+            }
+            _coefs[k] = c;
+        }
+
+        // Undo the time scaling, coefficients are per sample^deriv
+        for (i = 0; i < deriv; i++)
+            for (k = 0; k < N; k++)
+                _coefs[k] *= scale;
+
+        _deriv = deriv;
+        return true;
+    }
+
+    /**
+     * Fill the window with a value. Use this to initialize the filter!
+     *
+     * @param val  Value to fill the window with.
+     */
+    void Fill(float val)
+    {
+        for (size_t i = 0; i < 2 * N; i++)
+            _window[i] = val;
+        _head = 0;
+    }
+
+    /**
+     * Add a point to the window and evaluate the fit.
+     *
+     * @param newPoint  Noisy point to filter.
+     * @return          Smoothed value, or derivative per sample^deriv
+     */
+    float Filter(float newPoint)
+    {
+        const float *px;
+        float sum = 0.0f;
+
+        // Newest point sits at _head, oldest at _head + N - 1
+        _head = (_head == 0) ? (N - 1) : (_head - 1);
+        _window[_head] = newPoint;
+        _window[_head + N] = newPoint;
+
+        px = &_window[_head];
+        for (size_t k = 0; k < N; k++)
+            sum += _coefs[k] * px[k];
+
+        return sum;
+    }
+
+    /**
+     * Add a point to the window and evaluate the fit, scaling derivatives
+     * to physical units. Assumes the points are evenly spaced by dt.
+     *
+     * @param newPoint  Noisy point to filter.
+     * @param dt        [s] Sample period
+     * @return          Smoothed value, or derivative per s^deriv
+     */
+    float Filter(float newPoint, float dt)
+    {
+        float out = Filter(newPoint);
+
+        if (dt <= 0.0f)
+            return out;
+
+        for (size_t i = 0; i < _deriv; i++)
+            out /= dt;
+
+        return out;
+    }
+
+    /* Return the filter window width */
+    size_t GetWindowWidth() const { return N; }
+
+    /* Return the coefficient applied to the point k samples old */
+    float GetCoefficient(size_t k) const { return (k < N) ? _coefs[k] : 0.0f; }
+
+private:
+    /**
+     * Solve A*x = b in place with Gauss-Jordan elimination and partial
+     * pivoting. A is destroyed, b becomes x.
+     */
+    static bool _Solve(float A[SAVGOL_MAX_ORDER + 1][SAVGOL_MAX_ORDER + 1], float *b, size_t n)
+    {
+        size_t i, j, r;
+
+        for (i = 0; i < n; i++)
+        {
+            size_t piv = i;
+            for (r = i + 1; r < n; r++)
+                if (fabsf(A[r][i]) > fabsf(A[piv][i]))
+                    piv = r;
+
+            if (fabsf(A[piv][i]) < 1.0e-12f)
+                return false;
+
+            if (piv != i)
+            {
+                for (j = 0; j < n; j++)
+                {
+                    float tmp = A[i][j];
+                    A[i][j] = A[piv][j];
+                    A[piv][j] = tmp;
+                }
+                float tmp = b[i];
+                b[i] = b[piv];
+                b[piv] = tmp;
+            }
+
+            for (r = 0; r < n; r++)
+            {
+                if (r == i)
+                    continue;
+                float f = A[r][i] / A[i][i];
+                for (j = i; j < n; j++)
+                    A[r][j] -= f * A[i][j];
+                b[r] -= f * b[i];
+            }
+        }
+
+        for (i = 0; i < n; i++)
+            b[i] /= A[i][i];
+
+        return true;
+    }
+
+    float _coefs[N];  ///< Coefficient for the point k samples old
+    float _window[2 * N];  ///< Past data points (stored twice)
+    size_t _head;  ///< Index of the newest point in the window
+    size_t _deriv;  ///< Derivative order the coefficients compute
+};
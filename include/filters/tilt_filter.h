@@ -0,0 +1,134 @@
+// ----------------------------------------------------------------------------
+// GYRO-PROPAGATED TILT FILTER
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Complementary filter for the direction of "up" in the body frame, for
+ * projecting the accelerometer onto the vertical. Tilt taken from the same
+ * accel. vector it's applied to can't separate gravity from acceleration
+ * (it always returns |a| - g), so here the tilt comes from the gyro and the
+ * accelerometer only corrects its drift:
+ *
+ *     Propagate(gyro, dt);     // Every gyro sample: du/dt = -w x u
+ *     Correct(accel, dt);      // Every accel. sample: u -> a/|a|, time constant tau
+ *     VerticalAccel(accel, g); // a . u - g, up is positive
+ *
+ * 'up' is the unit vector the accelerometer reads along at rest (opposite
+ * gravity), in body axes. Horizontal acceleration that lasts much less than
+ * the time constant doesn't tilt the estimate; sustained acceleration
+ * (longer than tau) slowly does.
+ */
+
+#pragma once
+
+#include <math.h>
+
+
+class TiltFilter
+{
+public:
+    /**
+     * Construct the filter, level ('up' along body +z) until Reset().
+     */
+    TiltFilter()
+    {
+        _tau = 1.0f;
+        up[0] = 0.0f;
+        up[1] = 0.0f;
+        up[2] = 1.0f;
+    }
+
+    /**
+     * Set the time constant of the accel. correction.
+     *
+     * @param tau   [s] Time constant. Longer rejects more horizontal
+     *              acceleration, shorter corrects gyro drift faster.
+     */
+    void SetTimeConstant(float tau)
+    {
+        _tau = (tau > 0.0f) ? tau : 0.0f;
+    }
+
+    /**
+     * Align 'up' with an accel. measurement, e.g. the first one or the
+     * turn-on mean.
+     *
+     * @param accel     [m/s/s] [ax, ay, az] Accel. measurement
+     */
+    void Reset(const float accel[3])
+    {
+        float n = sqrtf((accel[0] * accel[0]) + (accel[1] * accel[1]) + (accel[2] * accel[2]));
+
+        if (n <= 0.0f)
+            return;
+        for (int k = 0; k < 3; k++)
+            up[k] = accel[k] / n;
+    }
+
+    /**
+     * Rotate 'up' by a gyro sample. A world-fixed vector in body axes
+     * turns opposite to the body: du/dt = -w x u.
+     *
+     * @param gyro  [rad/s] [gx, gy, gz] Gyro measurement, bias removed
+     * @param dt    [s] Time since the previous gyro sample
+     */
+    void Propagate(const float gyro[3], float dt)
+    {
+        float u0 = up[0];
+        float u1 = up[1];
+        float u2 = up[2];
+
+        up[0] -= dt * ((gyro[1] * u2) - (gyro[2] * u1));
+        up[1] -= dt * ((gyro[2] * u0) - (gyro[0] * u2));
+        up[2] -= dt * ((gyro[0] * u1) - (gyro[1] * u0));
+        _Normalize();
+    }
+
+    /**
+     * Pull 'up' toward the direction of an accel. measurement, with time
+     * constant tau.
+     *
+     * @param accel [m/s/s] [ax, ay, az] Accel. measurement
+     * @param dt    [s] Time since the previous accel. sample
+     */
+    void Correct(const float accel[3], float dt)
+    {
+        float n = sqrtf((accel[0] * accel[0]) + (accel[1] * accel[1]) + (accel[2] * accel[2]));
+        float k = dt / (_tau + dt);
+
+        if (n <= 0.0f || dt <= 0.0f)
+            return;
+        for (int i = 0; i < 3; i++)
+            up[i] += k * ((accel[i] / n) - up[i]);
+        _Normalize();
+    }
+
+    /**
+     * Vertical acceleration, gravity removed, up is positive.
+     *
+     * @param accel [m/s/s] [ax, ay, az] Accel. measurement, bias removed
+     * @param g     [m/s/s] Local gravity
+     * @return  [m/s/s] Acceleration along 'up', less g
+     */
+    float VerticalAccel(const float accel[3], float g) const
+    {
+        return (accel[0] * up[0]) + (accel[1] * up[1]) + (accel[2] * up[2]) - g;
+    }
+
+    float up[3];  ///< Unit "up" (opposite gravity) in body axes
+
+private:
+    void _Normalize()
+    {
+        float n = sqrtf((up[0] * up[0]) + (up[1] * up[1]) + (up[2] * up[2]));
+
+        if (n <= 0.0f)
+            return;
+        for (int k = 0; k < 3; k++)
+            up[k] /= n;
+    }
+
+    float _tau;  ///< [s] Accel. correction time constant
+};
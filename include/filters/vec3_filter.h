@@ -0,0 +1,175 @@
+// ----------------------------------------------------------------------------
+// THREE-AXIS VECTOR FILTERS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Filters that update all three axes of a vector (accel., gyro, mag.) in one
+ * call. State is kept per-axis in arrays (SoA), so one loop over the axes
+ * does the work and the compiler can unroll/vectorize it, instead of three
+ * separate filter objects each with their own call and branches.
+ *
+ * - Vec3LowPassFilter: 1st-order low pass, branch-free. Passes data through
+ *   (alpha = 1) until a smoothing factor is set.
+ * - Vec3MedianFilter<N>: median of the last N points of each axis.
+ * - Vec3Filter<F>: three of any scalar filter with 'float Filter(float)',
+ *   for filters without a dedicated vector version.
+ *
+ * All of them take/return 3-element arrays, e.g. Vectorf::vec:
+ *     AccelLPF.Filter(Accel.vec, Accel.vec);  // In place
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+
+class Vec3LowPassFilter
+{
+public:
+    /**
+     * Construct the filter. Passes data through until a smoothing factor
+     * is set.
+     */
+    Vec3LowPassFilter()
+    {
+        _a = 1.0f;
+        Reset(0.0f, 0.0f, 0.0f);
+    }
+
+    /**
+     * Set the smoothing factor (alpha), e.g. from DesignEMAAlpha().
+     *
+     * @param alpha     Smoothing factor, [0, 1]. 1 is no filtering.
+     */
+    void SetSmoothingFactor(float alpha)
+    {
+        if (alpha < 0.0f)
+            alpha = 0.0f;
+        else if (alpha > 1.0f)
+            alpha = 1.0f;
+        _a = alpha;
+    }
+
+    /**
+     * Set the filter output, e.g. to the first measurement.
+     */
+    void Reset(float x, float y, float z)
+    {
+        _y[0] = x;
+        _y[1] = y;
+        _y[2] = z;
+    }
+
+    /**
+     * Filter a new 3-axis point, y += alpha * (x - y).
+     *
+     * @param in    [x, y, z] Raw point
+     * @param out   [x, y, z] Filtered point. Can be the same array as 'in'.
+     */
+    void Filter(const float *in, float *out)
+    {
+        for (size_t i = 0; i < 3; i++)
+        {
+            _y[i] += _a * (in[i] - _y[i]);
+            out[i] = _y[i];
+        }
+    }
+
+private:
+    float _a;  ///< Smoothing factor
+    float _y[3];  ///< Filter output per axis
+};
+
+
+template <size_t N>
+class Vec3MedianFilter
+{
+public:
+    static_assert(N > 0, "Vec3MedianFilter window must have at least one point");
+
+    /**
+     * Construct the filter and fill the windows with an initial value.
+     */
+    Vec3MedianFilter(float initVal = 0.0f)
+    {
+        Fill(initVal, initVal, initVal);
+    }
+
+    /**
+     * Fill each axis' window with a value.
+     */
+    void Fill(float x, float y, float z)
+    {
+        for (size_t k = 0; k < N; k++)
+        {
+            _w[0][k] = x;
+            _w[1][k] = y;
+            _w[2][k] = z;
+        }
+        _insertIndex = 0;
+    }
+
+    /**
+     * Add a 3-axis point and return the median of each axis' window.
+     *
+     * @param in    [x, y, z] Raw point
+     * @param out   [x, y, z] Median. Can be the same array as 'in'.
+     */
+    void Filter(const float *in, float *out)
+    {
+        float sorted[N];
+        size_t i, j, k;
+
+        for (i = 0; i < 3; i++)
+            _w[i][_insertIndex] = in[i];
+        _insertIndex++;
+        if (_insertIndex >= N)
+            _insertIndex = 0;
+
+        for (i = 0; i < 3; i++)
+        {
+            for (k = 0; k < N; k++)
+            {
+                float val = _w[i][k];
+                j = k;
+                while (j > 0 && sorted[j - 1] > val)
+                {
+                    sorted[j] = sorted[j - 1];
+                    j--;
+                }
+                sorted[j] = val;
+            }
+
+            out[i] = (N % 2 == 1) ? sorted[N / 2] : 0.5f * (sorted[(N / 2) - 1] + sorted[N / 2]);
+        }
+    }
+
+    /* Return the median filter window width */
+    size_t GetWindowWidth() const { return N; }
+
+private:
+    float _w[3][N];  ///< Past data points per axis (ring buffers)
+    size_t _insertIndex;  ///< Where the next point goes in the windows
+};
+
+
+template <typename F>
+class Vec3Filter
+{
+public:
+    /**
+     * Filter a new 3-axis point with one scalar filter per axis.
+     *
+     * @param in    [x, y, z] Raw point
+     * @param out   [x, y, z] Filtered point. Can be the same array as 'in'.
+     */
+    void Filter(const float *in, float *out)
+    {
+        for (size_t i = 0; i < 3; i++)
+            out[i] = axis[i].Filter(in[i]);
+    }
+
+    F axis[3];  ///< Per-axis filters, configure them directly
+};
@@ -0,0 +1,78 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: PLATFORM SERVICES
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * The few Arduino services the drivers use besides the I2C bus: micros(),
+ * millis(), delay(), and the debug serial port. On the Teensy this is just
+ * Arduino.h. On a host (non-Arduino) build they are stand-ins driven by a
+ * simulated clock, so the sensor stack runs at full speed on a workstation:
+ *
+ * - The clock only moves when something moves it: delay(),
+ *   delayMicroseconds(), HalSimAdvanceMicros(), or a HostI2CBus with a bus
+ *   clock set (each transfer takes its bus time).
+ * - Serial prints go nowhere unless Serial.echo is set, then to stdout.
+ *
+ * Micros64() is the one clock for sensor timestamps on both: monotonic,
+ * microseconds, and 64 bits so differences never need wrap handling.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+
+uint64_t Micros64();
+
+
+#ifndef ARDUINO
+
+
+uint32_t micros();
+uint32_t millis();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+uint64_t HalSimMicros64();
+void HalSimAdvanceMicros(uint32_t us);
+void HalSimSetMicros(uint64_t us);
+
+
+/* No flash/RAM split on the host */
+#ifndef F
+#define F(msg) (msg)
+#endif
+
+
+/**
+ * Debug serial port stand-in. Only the print()/println() overloads the
+ * firmware uses.
+ */
+class HalSerialPort
+{
+public:
+    HalSerialPort() : echo(false) {}
+    void begin(uint32_t baud) { (void)baud; }
+    void print(const char *msg);
+    void print(char c);
+    void print(int val);
+    void print(unsigned int val);
+    void print(long val);
+    void print(unsigned long val);
+    void print(double val, int digits = 2);
+    void println();
+    template <typename T> void println(T val) { this->print(val); this->println(); }
+    void println(double val, int digits) { this->print(val, digits); this->println(); }
+
+    bool echo;  ///< True to print to stdout, false to drop everything
+};
+
+extern HalSerialPort Serial;
+#endif
@@ -0,0 +1,77 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: I2C BUS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Thin blocking I2C bus interface the sensor drivers use instead of TwoWire.
+ * Everything the drivers do on the bus is one of four transfers: a register
+ * read (write the register, repeated start, read), a register write, or a
+ * raw read/write with no register (the u-blox stream and UBX messages).
+ *
+ * Implementations:
+ * - TeensyI2CBus (i2c_bus_teensy.h): a Wire bus on the Teensy 4.1.
+ * - HostI2CBus (i2c_bus_host.h): simulated devices for host builds and tests,
+ *   e.g. the register-level sensor models in sim_sensor_models.h.
+ *
+ * SensorI2CBus() and GPSI2CBus() return the platform's default buses
+ * (SENSOR_I2C and GPS_I2C from hummingbird_config.h on the Teensy).
+ *
+ * Transfers still just return true or false, but LastError() says why the
+ * last one failed, and Recover() tries to free a bus a device is holding
+ * (see I2CBusMonitor in i2c_bus_monitor.h).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ * Max. bytes per register read on the Teensy: WireIMXRT's BUFFER_LENGTH 
+ * (136) on the Teensy 4.x, checked in i2c_bus_teensy.cpp. Drivers keep their 
+ * bursts within this so they run unchanged on every bus.
+ */
+constexpr uint8_t I2C_BUS_MAX_TRANSFER = 136;
+
+
+/**
+ * Why the last transfer failed
+ */
+typedef enum
+{
+    I2C_ERR_NONE = 0,  // Last transfer succeeded
+    I2C_ERR_NACK,  // Address or data NACK: device missing, busy, or reset
+    I2C_ERR_TIMEOUT,  // Bus stuck (SDA or SCL held low), arbitration lost, or controller timeout
+    I2C_ERR_SHORT_READ,  // Device returned fewer bytes than asked for
+    I2C_ERR_BAD_LENGTH,  // Transfer too long for the bus, not sent
+    I2C_ERR_BUDGET,  // Refused by I2CBusScheduler: over the running job's byte budget
+    I2C_ERR_BUSY  // Refused by AsyncI2CSharedBus: the async engine kept the bus too long, not sent
+} I2CBusError_t;
+
+
+class I2CBus
+{
+public:
+    virtual ~I2CBus() {}
+    virtual bool Begin() = 0;
+    virtual bool Probe(uint8_t address) = 0;
+    virtual bool ReadRegs(uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len) = 0;
+    virtual bool WriteRegs(uint8_t address, uint8_t reg, const uint8_t *buf, uint8_t len) = 0;
+    virtual bool Read(uint8_t address, uint8_t *buf, uint8_t len) = 0;
+    virtual bool Write(uint8_t address, const uint8_t *buf, uint8_t len) = 0;
+
+    /* Why the last transfer failed. Buses that can't tell report success. */
+    virtual I2CBusError_t LastError() const { return I2C_ERR_NONE; }
+    /* Free a stuck bus and restart the controller. False if not supported or still stuck. */
+    virtual bool Recover() { return false; }
+
+    bool ReadReg8(uint8_t address, uint8_t reg, uint8_t *val);
+    bool WriteReg8(uint8_t address, uint8_t reg, uint8_t val);
+};
+
+
+I2CBus *SensorI2CBus();
+I2CBus *GPSI2CBus();
@@ -0,0 +1,68 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: HOST (SIMULATED) I2C BUS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Blocking I2CBus on simulated devices, for host builds and tests. Devices
+ * are attached by address; an address with no device NACKs.
+ *
+ * Timing: with SetClockHz() set, every transfer advances the simulated clock
+ * (hal_platform.h) by its time on the wire, 9 bits per byte including the
+ * address bytes, so code that polls sensors sees realistic micros() and the
+ * sensor models produce samples at their ODR. With no clock set, transfers
+ * take no time and the stack runs as fast as the host can go.
+ *
+ * InjectNACKs() makes the next transfers fail, to test driver error paths.
+ * InjectBusLock() makes every transfer time out, like a device holding SDA
+ * low, until Recover() is called. Host builds only.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hal/i2c_bus.h"
+#include "hal/sim_i2c_device.h"
+
+
+class HostI2CBus : public I2CBus
+{
+public:
+    HostI2CBus();
+    bool AttachDevice(uint8_t address, SimI2CDevice *device);
+    SimI2CDevice *FindDevice(uint8_t address);
+    void SetClockHz(uint32_t hz);
+    void InjectNACKs(uint32_t count);
+    void InjectBusLock();
+
+    bool Begin() override;
+    bool Probe(uint8_t address) override;
+    bool ReadRegs(uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len) override;
+    bool WriteRegs(uint8_t address, uint8_t reg, const uint8_t *buf, uint8_t len) override;
+    bool Read(uint8_t address, uint8_t *buf, uint8_t len) override;
+    bool Write(uint8_t address, const uint8_t *buf, uint8_t len) override;
+    I2CBusError_t LastError() const override;
+    bool Recover() override;
+
+    uint32_t transfers;  ///< Transfers started, including NACKed ones
+    uint32_t bytes;  ///< Bytes on the wire, including address and register bytes
+    uint32_t nacks;  ///< Transfers that NACKed
+    uint32_t timeouts;  ///< Transfers that timed out on a locked bus
+    uint32_t recoveries;  ///< Recover() calls
+private:
+    SimI2CDevice *_Start(uint8_t address, uint32_t nBytes);
+    bool _Finish(bool ok);
+
+    uint8_t _addresses[HOST_I2C_MAX_DEVICES];  ///< Device addresses
+    SimI2CDevice *_devices[HOST_I2C_MAX_DEVICES];  ///< Devices
+    uint8_t _nDevices;  ///< Number of attached devices
+    uint32_t _clockHz;  ///< [Hz] Simulated SCL rate, 0 for zero-time transfers
+    uint32_t _nacksToInject;  ///< Remaining transfers to fail
+    bool _busLocked;  ///< True while transfers time out (until Recover())
+    I2CBusError_t _lastError;  ///< Why the last transfer failed
+};
+
+
+HostI2CBus &HostSensorI2CBus();
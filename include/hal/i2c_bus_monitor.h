@@ -0,0 +1,82 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: I2C BUS HEALTH MONITOR
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Bus health layer between the drivers and a bus. Every transfer is passed
+ * through and counted per device address: NACKs, timeouts and short reads
+ * (from the bus's LastError()), the current run of failures, and when the
+ * device last answered, so a dropped-out sensor shows up in the stats with
+ * how long it has been gone.
+ *
+ * When the bus itself is stuck it is recovered right away (Recover(), an
+ * SCL clock-out on the Teensy) instead of waiting for a power cycle. Only a
+ * timeout (SDA/SCL held low, arbitration lost) triggers it. A NACK means a
+ * device is missing or busy, not that the bus is stuck, and a recovery would
+ * stall the bus for the healthy devices; bringing a NACKing device back is
+ * up to its sensor system (see sensor_health.h).
+ *
+ * The monitor is an I2CBus itself. SensorI2CBus() and GPSI2CBus() return one
+ * on the Teensy.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hal/i2c_bus.h"
+
+
+constexpr uint8_t I2C_MONITOR_MAX_DEVICES = 8;  // Max. device addresses tracked on one bus
+
+
+/**
+ * Per-device transfer statistics
+ */
+typedef struct
+{
+    uint8_t address;  // 7-bit device address
+    uint32_t transfers;  // Transfers to the device
+    uint32_t errors;  // Failed transfers (device or bus faults)
+    uint32_t nacks;  // Address/data NACKs
+    uint32_t timeouts;  // Bus timeouts/stuck bus
+    uint32_t shortReads;  // Reads that returned too few bytes
+    uint32_t consecutiveErrors;  // Failed transfers since the last good one
+    uint64_t lastOkMicros;  // [us] Micros64() at the end of the last good transfer, 0 if none yet
+} I2CDeviceStats_t;
+
+
+class I2CBusMonitor : public I2CBus
+{
+public:
+    I2CBusMonitor(I2CBus *bus);
+    I2CBusMonitor(const I2CBusMonitor &) = delete;
+    I2CBusMonitor &operator=(const I2CBusMonitor &) = delete;
+
+    const I2CDeviceStats_t *GetStats(uint8_t address) const;
+    uint8_t DeviceCount() const;
+    const I2CDeviceStats_t *GetDevice(uint8_t index) const;
+    uint64_t SinceLastOkMicros(uint8_t address) const;
+    void ResetStats();
+
+    bool Begin() override;
+    bool Probe(uint8_t address) override;
+    bool ReadRegs(uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len) override;
+    bool WriteRegs(uint8_t address, uint8_t reg, const uint8_t *buf, uint8_t len) override;
+    bool Read(uint8_t address, uint8_t *buf, uint8_t len) override;
+    bool Write(uint8_t address, const uint8_t *buf, uint8_t len) override;
+    I2CBusError_t LastError() const override;
+    bool Recover() override;
+
+    uint32_t busRecoveries;  ///< Bus recoveries run
+    uint32_t failedRecoveries;  ///< Recoveries that didn't free the bus
+private:
+    bool _Record(uint8_t address, bool ok);
+    I2CDeviceStats_t *_Find(uint8_t address);
+
+    I2CBus *_bus;  ///< Bus being monitored
+    I2CDeviceStats_t _devices[I2C_MONITOR_MAX_DEVICES];  ///< Per-device stats
+    uint8_t _nDevices;  ///< Number of devices seen
+};
@@ -0,0 +1,109 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: I2C BUS SCHEDULER
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Shares one I2C bus between devices with different needs: the IMU wants
+ * short reads at a steady rate, the GPS wants long stream drains whenever
+ * there is time. Each device gets a job with a rate, a priority (0 is
+ * highest), and a max. number of payload bytes per run. Service() runs the
+ * jobs that are due, highest priority first, and holds a job back if its
+ * worst-case bus time (maxBytes at the bus clock) would make a higher-priority
+ * job start late. Long drains are cut into maxBytes-sized pieces that fit
+ * between IMU reads, so IMU jitter doesn't depend on how much the GPS has
+ * queued.
+ *
+ * The scheduler is itself an I2CBus: give it to the drivers the jobs run and
+ * every transfer is counted against the running job (bytes and time on the
+ * bus, for Utilization()), and refused if it would go over the job's maxBytes.
+ * Transfers outside a job (e.g. sensor setup) pass straight through.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hal/i2c_bus.h"
+
+
+constexpr uint8_t I2C_SCHED_MAX_JOBS = 8;  // Max. jobs on one bus
+constexpr uint8_t I2C_SCHED_NO_JOB = 0xFF;  // No job running
+constexpr uint8_t I2C_SCHED_OVERHEAD_BYTES = 3;  // Address, register, and repeated-start address bytes per transfer
+
+
+/**
+ * Job body. Do the device's transfers through the scheduler, moving at most
+ * 'maxBytes' payload bytes.
+ */
+typedef void (*I2CBusJobFn_t)(void *context, uint16_t maxBytes);
+
+
+/**
+ * Scheduled job: settings, then state and statistics kept by the scheduler.
+ */
+typedef struct
+{
+    const char *name;  // For reports
+    I2CBusJobFn_t run;  // Job body
+    void *context;  // Passed through to 'run', e.g. the driver
+    uint32_t periodMicros;  // [us] Run period. 0 for a background job (whenever the bus is free).
+    uint8_t priority;  // 0 is highest
+    uint16_t maxBytes;  // Max. payload bytes per run
+
+    uint64_t nextMicros;  // [us] Micros64() when the job is next due
+    uint32_t runs;  // Times run
+    uint32_t deferrals;  // Times held back so a higher-priority job could start on time
+    uint32_t rejected;  // Transfers refused for going over maxBytes
+    uint32_t bytes;  // Payload bytes moved
+    uint64_t busyMicros;  // [us] Time on the bus
+    uint32_t maxLateMicros;  // [us] Worst start time after being due (periodic jobs)
+} I2CBusJob_t;
+
+
+class I2CBusScheduler : public I2CBus
+{
+public:
+    I2CBusScheduler(I2CBus *bus);
+    I2CBusScheduler(const I2CBusScheduler &) = delete;
+    I2CBusScheduler &operator=(const I2CBusScheduler &) = delete;
+
+    uint8_t AddJob(const char *name, I2CBusJobFn_t run, void *context, uint32_t periodMicros, uint8_t priority,
+        uint16_t maxBytes);
+    void SetClockHz(uint32_t hz);
+    uint8_t Service();
+    uint8_t JobCount() const;
+    const I2CBusJob_t *GetJob(uint8_t id) const;
+    float Utilization(uint8_t id) const;
+    float TotalUtilization() const;
+    void ResetStats();
+    uint32_t WireMicros(uint16_t payloadBytes) const;
+
+    bool Begin() override;
+    bool Probe(uint8_t address) override;
+    bool ReadRegs(uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len) override;
+    bool WriteRegs(uint8_t address, uint8_t reg, const uint8_t *buf, uint8_t len) override;
+    bool Read(uint8_t address, uint8_t *buf, uint8_t len) override;
+    bool Write(uint8_t address, const uint8_t *buf, uint8_t len) override;
+    I2CBusError_t LastError() const override;
+    bool Recover() override;
+
+    uint32_t otherBytes;  ///< Payload bytes moved outside jobs
+    uint64_t otherBusyMicros;  ///< [us] Bus time outside jobs
+private:
+    bool _Reserve(uint8_t len);
+    void _Account(uint64_t startMicros, uint8_t len);
+    bool _IsDue(const I2CBusJob_t *job, uint64_t now) const;
+    bool _WouldDelay(const I2CBusJob_t *job, uint64_t now) const;
+    void _Run(I2CBusJob_t *job, uint64_t now);
+
+    I2CBus *_bus;  ///< Bus being shared
+    I2CBusJob_t _jobs[I2C_SCHED_MAX_JOBS];  ///< Jobs
+    uint8_t _nJobs;  ///< Number of jobs
+    uint8_t _current;  ///< Running job, I2C_SCHED_NO_JOB outside jobs
+    uint16_t _budget;  ///< Payload bytes the running job has left
+    bool _lastRejected;  ///< True if the last transfer was refused for its budget
+    uint32_t _clockHz;  ///< [Hz] Bus clock, for worst-case job times
+    uint64_t _statsStartMicros;  ///< [us] Micros64() when the stats were reset
+};
@@ -0,0 +1,47 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: TEENSY I2C BUS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * I2CBus on an Arduino Wire bus (Wire, Wire1, Wire2 on the Teensy 4.1).
+ * Register reads use a repeated start. Reads longer than
+ * I2C_BUS_MAX_TRANSFER are rejected rather than silently truncated.
+ *
+ * Wire's status codes are kept for LastError(). With the bus pins given,
+ * Recover() frees a bus a device is holding: a device that lost a clock
+ * edge mid-read keeps SDA low waiting for the rest of its byte, and only
+ * more clocks (up to 9) and a STOP get it off the bus.
+ */
+
+#pragma once
+
+#ifdef ARDUINO
+#include <Wire.h>
+#include "hal/i2c_bus.h"
+
+
+class TeensyI2CBus : public I2CBus
+{
+public:
+    TeensyI2CBus(TwoWire *wire, int8_t sdaPin = -1, int8_t sclPin = -1, uint32_t clockHz = 400000);
+    bool Begin() override;
+    bool Probe(uint8_t address) override;
+    bool ReadRegs(uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len) override;
+    bool WriteRegs(uint8_t address, uint8_t reg, const uint8_t *buf, uint8_t len) override;
+    bool Read(uint8_t address, uint8_t *buf, uint8_t len) override;
+    bool Write(uint8_t address, const uint8_t *buf, uint8_t len) override;
+    I2CBusError_t LastError() const override;
+    bool Recover() override;
+private:
+    bool _EndTransmission(bool sendStop);
+    bool _RequestFrom(uint8_t address, uint8_t len);
+
+    TwoWire *_wire;  ///< Wire bus
+    int8_t _sdaPin;  ///< SDA pin for bus recovery, -1 if not set
+    int8_t _sclPin;  ///< SCL pin for bus recovery, -1 if not set
+    uint32_t _clockHz;  ///< [Hz] SCL rate restored after recovery
+    I2CBusError_t _lastError;  ///< Why the last transfer failed
+};
+#endif
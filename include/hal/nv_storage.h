@@ -0,0 +1,38 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: NON-VOLATILE STORAGE
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Byte-addressed non-volatile storage for data that should survive a power
+ * cycle, such as learned sensor calibration. Callers own their layout (see
+ * NV_ADDR_* in hummingbird_config.h) and their own validity checks (a magic
+ * number and checksum); unwritten storage reads as 0xFF.
+ *
+ * Implementations:
+ * - TeensyNVStorage (nv_storage_teensy.h): the Teensy 4.1's emulated EEPROM
+ *   (4284 bytes in flash). Writes skip bytes that didn't change, to save
+ *   flash wear, but still avoid writing often.
+ * - HostNVStorage (nv_storage_host.h): RAM, for host builds and tests.
+ *
+ * PlatformNVStorage() returns the platform's storage.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+class NVStorage
+{
+public:
+    virtual ~NVStorage() {}
+    virtual uint16_t Size() const = 0;
+    virtual bool Read(uint16_t address, void *buf, uint16_t len) = 0;
+    virtual bool Write(uint16_t address, const void *buf, uint16_t len) = 0;
+};
+
+
+NVStorage *PlatformNVStorage();
@@ -0,0 +1,39 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: HOST NON-VOLATILE STORAGE
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * NVStorage in RAM, for host builds and tests. Starts erased (0xFF), the
+ * same size as the Teensy 4.1's EEPROM. 'writes' and 'bytesWritten' count
+ * what would have worn the flash. Host builds only.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hal/nv_storage.h"
+
+
+constexpr uint16_t HOST_NV_SIZE = 4284;  // [bytes] Teensy 4.1 EEPROM size
+
+
+class HostNVStorage : public NVStorage
+{
+public:
+    HostNVStorage();
+    void Erase();
+
+    uint16_t Size() const override;
+    bool Read(uint16_t address, void *buf, uint16_t len) override;
+    bool Write(uint16_t address, const void *buf, uint16_t len) override;
+
+    uint8_t mem[HOST_NV_SIZE];  ///< Contents
+    uint32_t writes;  ///< Write() calls that succeeded
+    uint32_t bytesWritten;  ///< Bytes that changed value
+};
+
+
+HostNVStorage &HostPlatformNVStorage();
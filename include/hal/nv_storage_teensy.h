@@ -0,0 +1,26 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: TEENSY NON-VOLATILE STORAGE
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * NVStorage on the Teensy's EEPROM library (flash-emulated EEPROM on the
+ * Teensy 4.1). Writes go through EEPROM.update(), so unchanged bytes aren't
+ * rewritten.
+ */
+
+#pragma once
+
+#ifdef ARDUINO
+#include "hal/nv_storage.h"
+
+
+class TeensyNVStorage : public NVStorage
+{
+public:
+    uint16_t Size() const override;
+    bool Read(uint16_t address, void *buf, uint16_t len) override;
+    bool Write(uint16_t address, const void *buf, uint16_t len) override;
+};
+#endif
@@ -0,0 +1,44 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: SIMULATED I2C DEVICE
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Device interface for the simulated buses (HostI2CBus, HostI2CBackend).
+ * Register reads/writes start at 'reg' and the device decides how its
+ * register pointer moves, like the real part. Return false to NACK.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+constexpr uint8_t HOST_I2C_MAX_DEVICES = 8;  // Max. simulated devices on one bus
+
+
+class SimI2CDevice
+{
+public:
+    virtual ~SimI2CDevice() {}
+    virtual bool ReadRegs(uint8_t reg, uint8_t *buf, uint8_t len) = 0;
+    virtual bool WriteRegs(uint8_t reg, const uint8_t *buf, uint8_t len) = 0;
+
+    /* Read without a register address. NACKs unless the device overrides it. */
+    virtual bool Read(uint8_t *buf, uint8_t len)
+    {
+        (void)buf;
+        (void)len;
+        return false;
+    }
+
+    /* Write without a register address. By default the first byte is the register. */
+    virtual bool Write(const uint8_t *buf, uint8_t len)
+    {
+        if (len == 0)
+            return true;
+        return this->WriteRegs(buf[0], buf + 1, (uint8_t)(len - 1));
+    }
+};
@@ -0,0 +1,258 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: SIMULATED SENSOR MODELS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Register-level models of the Hummingbird's I2C devices, for host builds.
+ * Attach them to a HostI2CBus (or HostI2CBackend) and the unmodified drivers
+ * talk to them like the real parts: WHO_AM_I, range/ODR control registers,
+ * status bits, output encoding, burst auto-increment, and FIFOs behave as in
+ * the datasheets. Tests set the physical quantities (SetRate(), SetAccel(),
+ * SetPressure(), ...) and the models encode them for the configured range.
+ *
+ * Timing comes from the simulated clock (hal_platform.h). An active sensor
+ * produces one sample per ODR period: data-ready status bits set, FIFOs fill
+ * (and overflow), and a connected DataReadyPin gets one Trigger() per sample
+ * with the sample time.
+ *
+ * Models:
+ * - SimFXAS21002: gyro, 0x21. FIFO with WRAPTOONE.
+ * - SimFXOS8700: accel/mag, 0x1F. 14-bit accel, hybrid auto-increment, FIFO.
+ * - SimLIS3MDL: magnetometer, 0x1E. Auto-increment only with the 0x80 bit.
+ * - SimBMP388: barometer, 0x77. NVM calibration and raw ADC values that
+ *   compensate (Bosch floating-point formulas) back to the set pressure and
+ *   temperature. Forced and normal modes, FIFO with header-mode frames.
+ *   Multi-byte writes are register address/data pairs.
+ * - SimUbloxI2C: u-blox DDC (I2C) port, 0x42. Byte count at 0xFD/0xFE,
+ *   output stream at 0xFF, periodic NMEA output, and UBX input with ACK-ACK
+ *   (or ACK-NAK on a bad checksum) replies to CFG messages.
+ *
+ * Host builds only.
+ */
+
+#pragma once
+
+#ifndef ARDUINO
+#include <stddef.h>
+#include <stdint.h>
+#include "hal/sim_i2c_device.h"
+#include "sensor_drivers/data_ready_pin.h"
+
+
+constexpr uint8_t SIM_FXAS21002_ADDR = 0x21;
+constexpr uint8_t SIM_FXOS8700_ADDR = 0x1F;
+constexpr uint8_t SIM_LIS3MDL_ADDR = 0x1E;
+constexpr uint8_t SIM_BMP388_ADDR = 0x77;
+constexpr uint8_t SIM_UBLOX_ADDR = 0x42;
+
+constexpr uint8_t SIM_FIFO_SIZE = 32;  // FXAS21002/FXOS8700 FIFO depth [samples]
+constexpr uint16_t SIM_BMP388_FIFO_SIZE = 512;  // BMP388 FIFO size [bytes]
+constexpr uint16_t SIM_UBLOX_TX_SIZE = 2048;  // u-blox output buffer [bytes]. Power of 2.
+constexpr uint16_t SIM_UBLOX_RX_SIZE = 512;  // Bytes of received messages kept for tests
+static_assert((SIM_UBLOX_TX_SIZE & (SIM_UBLOX_TX_SIZE - 1)) == 0, "SIM_UBLOX_TX_SIZE must be a power of 2");
+
+
+/**
+ * 256-register device with a register pointer. Reads and writes go through
+ * the _ReadReg()/_WriteReg() hooks and the pointer moves with _NextReg(), so
+ * models only handle their special registers.
+ */
+class SimRegisterDevice : public SimI2CDevice
+{
+public:
+    SimRegisterDevice();
+    bool ReadRegs(uint8_t reg, uint8_t *buf, uint8_t len) override;
+    bool WriteRegs(uint8_t reg, const uint8_t *buf, uint8_t len) override;
+    bool Read(uint8_t *buf, uint8_t len) override;
+    void ConnectDataReady(DataReadyPin *pin);
+
+    uint8_t regs[256];  ///< Register map
+    uint32_t samples;  ///< Samples produced since power-on
+protected:
+    virtual void _Update() {}
+    virtual uint8_t _ReadReg(uint8_t reg) { return this->regs[reg]; }
+    virtual void _WriteReg(uint8_t reg, uint8_t val) { this->regs[reg] = val; }
+    virtual uint8_t _NextReg(uint8_t reg) { return (uint8_t)(reg + 1); }
+    void _StartSampling(uint32_t periodMicros);
+    uint32_t _NewSamples(uint32_t periodMicros);
+    static int16_t _ToCounts(float val, float lsbPerUnit);
+
+    uint8_t _ptr;  ///< Register pointer
+    DataReadyPin *_drdy;  ///< Data-ready output, nullptr if not connected
+    uint64_t _nextSampleMicros;  ///< [us] Simulated time of the next sample
+};
+
+
+/**
+ * FXAS21002 gyro.
+ */
+class SimFXAS21002 : public SimRegisterDevice
+{
+public:
+    SimFXAS21002();
+    void Reset();
+    void SetRate(float gx, float gy, float gz);
+    void SetTemperature(int8_t tempC);
+    uint8_t FIFOCount();
+protected:
+    void _Update() override;
+    uint8_t _ReadReg(uint8_t reg) override;
+    void _WriteReg(uint8_t reg, uint8_t val) override;
+    uint8_t _NextReg(uint8_t reg) override;
+private:
+    float _LSBPerDPS();
+    uint32_t _PeriodMicros();
+
+    float _rate[3];  ///< [deg/s] Angular rate
+    uint8_t _fifoCount;  ///< Samples in the FIFO
+    bool _fifoOverflow;  ///< FIFO overflowed since F_STATUS was last read
+};
+
+
+/**
+ * FXOS8700 accelerometer/magnetometer.
+ */
+class SimFXOS8700 : public SimRegisterDevice
+{
+public:
+    SimFXOS8700();
+    void Reset();
+    void SetAccel(float ax, float ay, float az);
+    void SetMag(float mx, float my, float mz);
+    uint8_t FIFOCount();
+protected:
+    void _Update() override;
+    uint8_t _ReadReg(uint8_t reg) override;
+    void _WriteReg(uint8_t reg, uint8_t val) override;
+    uint8_t _NextReg(uint8_t reg) override;
+private:
+    bool _IsHybrid();
+    uint32_t _PeriodMicros();
+
+    float _accel[3];  ///< [G's] Acceleration
+    float _mag[3];  ///< [uT] Magnetic field
+    uint8_t _fifoCount;  ///< Samples in the FIFO
+    bool _fifoOverflow;  ///< FIFO overflowed since F_STATUS was last read
+};
+
+
+/**
+ * LIS3MDL magnetometer.
+ */
+class SimLIS3MDL : public SimRegisterDevice
+{
+public:
+    SimLIS3MDL();
+    void Reset();
+    bool ReadRegs(uint8_t reg, uint8_t *buf, uint8_t len) override;
+    bool WriteRegs(uint8_t reg, const uint8_t *buf, uint8_t len) override;
+    void SetField(float mx, float my, float mz);
+    void SetTemperature(float tempC);
+protected:
+    void _Update() override;
+    uint8_t _ReadReg(uint8_t reg) override;
+    void _WriteReg(uint8_t reg, uint8_t val) override;
+    uint8_t _NextReg(uint8_t reg) override;
+private:
+    uint32_t _PeriodMicros();
+
+    float _field[3];  ///< [uT] Magnetic field
+    float _tempC;  ///< [C] Temperature
+    bool _autoInc;  ///< Current burst auto-increments (sub-address bit 7 set)
+};
+
+
+/**
+ * BMP388 barometer. Calibration coefficients from the NVM, converted as in
+ * the datasheet (section 9.1).
+ */
+typedef struct
+{
+    double t1, t2, t3;
+    double p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11;
+} SimBMP388Calib_t;
+
+
+class SimBMP388 : public SimRegisterDevice
+{
+public:
+    SimBMP388();
+    bool WriteRegs(uint8_t reg, const uint8_t *buf, uint8_t len) override;
+    void Reset();
+    void SetPressure(float pressPa);
+    void SetTemperature(float tempC);
+    double CompensateTemperature(uint32_t rawT) const;
+    double CompensatePressure(uint32_t rawP, double tempC) const;
+    uint32_t RawPressure() const { return this->_rawP; }
+    uint32_t RawTemperature() const { return this->_rawT; }
+    uint16_t FIFOLength();
+protected:
+    void _Update() override;
+    uint8_t _ReadReg(uint8_t reg) override;
+    void _WriteReg(uint8_t reg, uint8_t val) override;
+    uint8_t _NextReg(uint8_t reg) override;
+private:
+    void _Convert();
+    void _Invert();
+    void _PushFrame();
+    uint32_t _PeriodMicros();
+
+    SimBMP388Calib_t _calib;  ///< Calibration coefficients
+    float _pressPa;  ///< [Pa] Pressure
+    float _tempC;  ///< [C] Temperature
+    uint32_t _rawP;  ///< 24-bit pressure ADC value for _pressPa
+    uint32_t _rawT;  ///< 24-bit temperature ADC value for _tempC
+    uint8_t _fifo[SIM_BMP388_FIFO_SIZE];  ///< FIFO frames, oldest first from _fifoRead
+    uint16_t _fifoLen;  ///< Bytes stored in _fifo
+    uint16_t _fifoRead;  ///< Next byte to read out of _fifo
+};
+
+
+/**
+ * u-blox receiver DDC (I2C) port.
+ */
+class SimUbloxI2C : public SimI2CDevice
+{
+public:
+    SimUbloxI2C();
+    bool ReadRegs(uint8_t reg, uint8_t *buf, uint8_t len) override;
+    bool WriteRegs(uint8_t reg, const uint8_t *buf, uint8_t len) override;
+    bool Read(uint8_t *buf, uint8_t len) override;
+    bool Write(const uint8_t *buf, uint8_t len) override;
+    uint16_t QueueOutput(const uint8_t *data, uint16_t len);
+    uint16_t QueueOutput(const char *text);
+    void SetNavOutput(const char *text, uint32_t periodMicros);
+    uint16_t Available();
+
+    uint8_t received[SIM_UBLOX_RX_SIZE];  ///< Message bytes written to the receiver (first SIM_UBLOX_RX_SIZE)
+    uint16_t nReceived;  ///< Bytes in 'received'
+    uint32_t ubxMessages;  ///< Valid UBX messages received
+    uint32_t ubxBadChecksums;  ///< UBX messages with bad checksums
+    uint32_t dropped;  ///< Output bytes dropped because the buffer was full
+    uint8_t lastClass;  ///< Class of the last valid UBX message
+    uint8_t lastId;  ///< ID of the last valid UBX message
+private:
+    void _Update();
+    uint8_t _ReadByte();
+    void _Receive(uint8_t b);
+    void _QueueAck(bool ack, uint8_t cls, uint8_t id);
+
+    uint8_t _tx[SIM_UBLOX_TX_SIZE];  ///< Output stream (ring buffer)
+    uint16_t _txHead;  ///< Next byte to write
+    uint16_t _txTail;  ///< Next byte to read
+    uint16_t _countLatch;  ///< Byte count latched when 0xFD is read
+    uint8_t _ptr;  ///< Register pointer
+    const char *_navText;  ///< Sentences output every nav. period, nullptr for none
+    uint32_t _navPeriodMicros;  ///< [us] Nav. output period
+    uint64_t _nextNavMicros;  ///< [us] Simulated time of the next nav. output
+    uint8_t _rxState;  ///< UBX parser state
+    uint8_t _rxHdr[4];  ///< UBX class, id, length
+    uint16_t _rxLen;  ///< UBX payload length
+    uint16_t _rxCount;  ///< UBX payload bytes received
+    uint8_t _rxCkA;  ///< Running checksum A
+    uint8_t _rxCkB;  ///< Running checksum B
+    bool _rxBad;  ///< Checksum A didn't match
+};
+#endif
@@ -24,6 +24,22 @@
  * connected to. Found in hummingbird_config.h
  */
 #define SENSOR_I2C Wire2
+#define SENSOR_I2C_SDA_PIN 25   // Wire2 SDA, bit-banged for bus recovery
+#define SENSOR_I2C_SCL_PIN 24   // Wire2 SCL, bit-banged for bus recovery
+#define SENSOR_I2C_CLOCK_HZ 400000  // [Hz] SCL rate, restored after bus recovery
+
+/**
+ * ====================================
+ * SENSOR DATA-READY INTERRUPT PINS
+ * ====================================
+ * Teensy pins wired to each sensor's data-ready (DRDY/INT1) output. With a 
+ * pin set, the sensor is read once per data-ready interrupt and its samples 
+ * are timestamped in the ISR. -1 means not wired: the sensor is polled. 
+ * Found in hummingbird_config.h
+ */
+#define GYRO_DRDY_PIN -1        // FXAS21002 INT1
+#define ACCELMAG_DRDY_PIN -1    // FXOS8700 INT1
+#define MAG_DRDY_PIN -1         // LIS3MDL DRDY
 
 /**
  * ====================================
@@ -40,6 +56,8 @@
  * I2C bus that the GPS is connected to. Found in hummingbird_config.h
  */
 #define GPS_I2C Wire2
+#define GPS_I2C_SDA_PIN 25   // Wire2 SDA
+#define GPS_I2C_SCL_PIN 24   // Wire2 SCL
 
 /**
  * ====================================
@@ -87,6 +105,15 @@
 #define GRN_LED 14          // Green status LED PWM
 // #define BLU_LED 13          // Blue status LED PWM
 
+/**
+ * ====================================
+ * NON-VOLATILE STORAGE LAYOUT
+ * ====================================
+ * Byte addresses in the EEPROM (hal/nv_storage.h) of data kept between 
+ * boots. Found in hummingbird_config.h
+ */
+#define NV_ADDR_GYRO_TEMP_BIAS 0    // Gyro temperature bias table (GyroTempBias), ~300 bytes
+
 /**
  * Define floating point precision for floats close to zero. These parameters 
  * aretypically used to check if a number is close to zero to prevent divide 
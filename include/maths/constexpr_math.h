@@ -0,0 +1,84 @@
+// ----------------------------------------------------------------------------
+// COMPILE-TIME MATH FUNCTIONS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * constexpr (C++11) versions of sin(), cos(), tan(), exp(), and sqrt() so
+ * constants such as filter coefficients can be computed by the compiler.
+ * They use range reduction and series/iterations in double precision and are
+ * accurate to float precision.
+ *
+ * These are meant for constant expressions. Use the <math.h> functions at
+ * runtime, they are much faster.
+ */
+
+#pragma once
+
+
+/* Internal helpers, don't call these directly */
+constexpr double ConstexprMathSq(double x) { return x * x; }
+
+constexpr double ConstexprMathSinSeries(double x2, double term, int n, double sum)
+{
+    return (n > 25) ? sum : ConstexprMathSinSeries(x2, -term * x2 / (double)((2 * n) * (2 * n + 1)), n + 1, sum + term);
+}
+
+constexpr double ConstexprMathWrapPi(double x)
+{
+    // Wrap to [-pi, pi]
+    return x - (6.283185307179586 * (double)(long long)((x + ((x >= 0.0) ? 3.141592653589793 : -3.141592653589793)) / 6.283185307179586));
+}
+
+constexpr double ConstexprMathSin(double x)
+{
+    return ConstexprMathSinSeries(ConstexprMathSq(ConstexprMathWrapPi(x)), ConstexprMathWrapPi(x), 1, 0.0);
+}
+
+constexpr double ConstexprMathExpSeries(double x, double term, int n, double sum)
+{
+    return (n > 20) ? sum : ConstexprMathExpSeries(x, term * x / (double)n, n + 1, sum + term);
+}
+
+constexpr double ConstexprMathExp(double x)
+{
+    // exp(x) = exp(x/2)^2 until |x| is small enough for the series
+    return ((x > 0.5) || (x < -0.5)) ? ConstexprMathSq(ConstexprMathExp(0.5 * x)) : ConstexprMathExpSeries(x, 1.0, 1, 0.0);
+}
+
+constexpr double ConstexprMathSqrtIter(double x, double guess, int n)
+{
+    return (n > 60) ? guess : ConstexprMathSqrtIter(x, 0.5 * (guess + (x / guess)), n + 1);
+}
+
+
+/* [rad] Compile-time sine */
+constexpr float ConstexprSin(float x)
+{
+    return (float)ConstexprMathSin((double)x);
+}
+
+/* [rad] Compile-time cosine */
+constexpr float ConstexprCos(float x)
+{
+    return (float)ConstexprMathSin((double)x + 1.5707963267948966);
+}
+
+/* [rad] Compile-time tangent */
+constexpr float ConstexprTan(float x)
+{
+    return (float)(ConstexprMathSin((double)x) / ConstexprMathSin((double)x + 1.5707963267948966));
+}
+
+/* Compile-time exp(x) */
+constexpr float ConstexprExp(float x)
+{
+    return (float)ConstexprMathExp((double)x);
+}
+
+/* Compile-time square root. Returns 0 for x <= 0 */
+constexpr float ConstexprSqrt(float x)
+{
+    return (x <= 0.0f) ? 0.0f : (float)ConstexprMathSqrtIter((double)x, ((double)x > 1.0) ? (double)x : 1.0, 0);
+}
@@ -10,7 +10,7 @@
 
 #pragma once
 
-#include <Arduino.h>
+#include <stdint.h>
 #include <math.h>
 #include <float.h>
 #include "constants.h"
@@ -18,6 +18,7 @@
 
 
 float InvSqrtf(float num);  // Used for normalizing
+float expf_fast(float x);  // Cheap exp() approximation for filter coefficients
 
 template <typename T>
 T RangeConstrain(const T val, const T lower, const T upper);  // Constrain value to a range
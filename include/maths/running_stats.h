@@ -0,0 +1,77 @@
+// ----------------------------------------------------------------------------
+// RUNNING MEAN AND VARIANCE
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Welford's running mean and variance of 3-axis samples, one sample at a
+ * time, without storing them. Numerically stable in single precision: each
+ * sample updates the mean by its deviation, and the sum of squared
+ * deviations from the current mean, so there's no large sum of squares to
+ * cancel.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+
+class RunningStats3
+{
+public:
+    RunningStats3() { this->Reset(); }
+
+    /* Forget every sample */
+    void Reset()
+    {
+        this->n = 0;
+        for (uint8_t k = 0; k < 3; k++)
+        {
+            this->mean[k] = 0.0f;
+            this->_m2[k] = 0.0f;
+        }
+    }
+
+    /**
+     * Add a sample.
+     *
+     * @param x  Sample [x, y, z].
+     */
+    void Add(const float x[3])
+    {
+        float delta;
+
+        this->n++;
+        for (uint8_t k = 0; k < 3; k++)
+        {
+            delta = x[k] - this->mean[k];
+            this->mean[k] += delta / (float)this->n;
+            this->_m2[k] += delta * (x[k] - this->mean[k]);
+        }
+    }
+
+    /* Sample variance of an axis. 0 until there are two samples. */
+    float Variance(uint8_t axis) const
+    {
+        return (this->n > 1) ? this->_m2[axis] / (float)(this->n - 1) : 0.0f;
+    }
+
+    /* Largest variance of the mean (variance / n) of the three axes. 0 until there are two samples. */
+    float MaxMeanVariance() const
+    {
+        float v = 0.0f;
+
+        for (uint8_t k = 0; k < 3; k++)
+        {
+            if (this->Variance(k) > v)
+                v = this->Variance(k);
+        }
+        return (this->n > 0) ? v / (float)this->n : 0.0f;
+    }
+
+    uint32_t n;  ///< Number of samples
+    float mean[3];  ///< Mean of each axis
+private:
+    float _m2[3];  ///< Sum of squared deviations from the mean, each axis
+};
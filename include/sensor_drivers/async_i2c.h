@@ -0,0 +1,168 @@
+// ----------------------------------------------------------------------------
+// ASYNCHRONOUS I2C TRANSACTION ENGINE
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Queued, non-blocking I2C register reads/writes shared by the sensor
+ * drivers. A driver fills in a transaction descriptor (address, register,
+ * length, buffer, completion callback) and submits it; the transfer runs in
+ * the background from the bus backend's interrupt, and the next queued
+ * transaction starts as soon as one finishes. The CPU only spends time
+ * queueing and decoding, not waiting on the bus (a 6-byte read at 400kHz is
+ * ~250us of bus time).
+ *
+ * Completion callbacks run from Poll() in the main loop, not from the ISR, so
+ * they can do floating point and touch driver state without locks. Call
+ * Poll() every loop.
+ *
+ * The engine shares its bus controller with the blocking I2CBus on the same
+ * pins. AsyncI2CSharedBus wraps that bus so every blocking transfer first
+ * waits for the engine to go idle and holds it (LockBus()) until the
+ * transfer is over; transactions submitted meanwhile wait in the queue.
+ * SensorI2CBus() and SensorAsyncI2C() are set up that way.
+ *
+ * Backends:
+ * - TeensyLPI2CBackend (async_i2c_teensy.h): interrupt-driven LPI2C on the
+ *   Teensy 4.1.
+ * - HostI2CBackend (async_i2c_host.h): completes transactions from simulated
+ *   devices for host tests.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hal/i2c_bus.h"
+
+
+constexpr uint8_t ASYNC_I2C_QUEUE_SIZE = 16;  // Max. queued transactions. Power of 2.
+static_assert((ASYNC_I2C_QUEUE_SIZE & (ASYNC_I2C_QUEUE_SIZE - 1)) == 0, "ASYNC_I2C_QUEUE_SIZE must be a power of 2");
+constexpr uint32_t ASYNC_I2C_LOCK_TIMEOUT_US = 5000;  // [us] Max. wait in LockBus(), a full queue of 6-byte reads at 400kHz
+
+
+/**
+ * Transaction status.
+ */
+typedef enum
+{
+    I2C_TXN_IDLE = 0,  // Never submitted
+    I2C_TXN_QUEUED,  // Waiting for the bus
+    I2C_TXN_BUSY,  // On the bus
+    I2C_TXN_DONE,  // Finished OK
+    I2C_TXN_NACK,  // Device didn't acknowledge
+    I2C_TXN_ERROR  // Arbitration lost, bus error, or short read
+} I2CTxnStatus_t;
+
+
+struct I2CTransaction_t;
+typedef void (*I2CCallback_t)(I2CTransaction_t *txn);
+
+
+/**
+ * I2C register transaction descriptor. Owned by the driver, and must stay
+ * alive (and untouched) until its callback runs.
+ */
+typedef struct I2CTransaction_t
+{
+    uint8_t address;  // 7-bit device address
+    uint8_t reg;  // First register
+    uint8_t *buf;  // Read: destination. Write: data to write after reg.
+    uint8_t len;  // Number of bytes to read/write, > 0
+    bool isWrite;  // True to write, false to read
+    I2CCallback_t callback;  // Called from AsyncI2C::Poll() when done. Can be nullptr.
+    void *context;  // Passed through for the callback, e.g. the driver
+    volatile I2CTxnStatus_t status;  // Set by the engine
+    uint64_t startMicros;  // [us] Micros64() when the transfer started on the bus
+} I2CTransaction_t;
+
+
+class AsyncI2C;
+
+
+/**
+ * Bus backend. Start() begins a transfer and returns right away; the backend
+ * calls AsyncI2C::OnComplete() (usually from its ISR) when it finishes.
+ */
+class AsyncI2CBackend
+{
+public:
+    virtual ~AsyncI2CBackend() {}
+    virtual bool Begin(AsyncI2C *engine) = 0;
+    virtual void Start(I2CTransaction_t *txn) = 0;
+};
+
+
+class AsyncI2C
+{
+public:
+    AsyncI2C(AsyncI2CBackend *backend);
+    AsyncI2C(const AsyncI2C &) = delete;
+    AsyncI2C &operator=(const AsyncI2C &) = delete;
+
+    bool Begin();
+    bool Submit(I2CTransaction_t *txn);
+    bool SubmitRead(I2CTransaction_t *txn, uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len,
+        I2CCallback_t callback = nullptr, void *context = nullptr);
+    bool SubmitWrite(I2CTransaction_t *txn, uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len,
+        I2CCallback_t callback = nullptr, void *context = nullptr);
+    void Poll();
+    bool IsIdle() const;
+    uint8_t Pending() const;
+    bool LockBus(uint32_t timeoutMicros = ASYNC_I2C_LOCK_TIMEOUT_US);
+    void UnlockBus();
+    bool IsLocked() const;
+    void OnComplete(I2CTxnStatus_t status);
+
+    uint32_t completed;  ///< Transactions finished OK
+    uint32_t failed;  ///< Transactions that NACKed or errored
+private:
+    void _StartNext();
+
+    AsyncI2CBackend *_backend;  ///< Bus backend
+    I2CTransaction_t *volatile _queue[ASYNC_I2C_QUEUE_SIZE];  ///< Submitted transactions, in order
+    volatile uint8_t _tail;  ///< Next free slot. Main loop only.
+    volatile uint8_t _active;  ///< Transaction on the bus (or next to start). ISR only, once running.
+    volatile uint8_t _callbackIdx;  ///< Next finished transaction to call back. Main loop only.
+    volatile bool _busy;  ///< True while a transfer is on the bus
+    volatile bool _locked;  ///< True while a blocking transfer has the bus (LockBus())
+};
+
+
+/**
+ * Blocking I2CBus on the controller an AsyncI2C engine also drives. Each
+ * transfer (and Recover()) waits for the engine to finish what's on the bus
+ * and holds it off until the transfer is done. If the engine doesn't go idle
+ * within ASYNC_I2C_LOCK_TIMEOUT_US, the transfer isn't sent and LastError()
+ * is I2C_ERR_BUSY. Submit async transactions from the main loop only, like
+ * the blocking transfers, so one can't start in between.
+ */
+class AsyncI2CSharedBus : public I2CBus
+{
+public:
+    AsyncI2CSharedBus(I2CBus *bus, AsyncI2C *engine);
+    AsyncI2CSharedBus(const AsyncI2CSharedBus &) = delete;
+    AsyncI2CSharedBus &operator=(const AsyncI2CSharedBus &) = delete;
+
+    bool Begin() override;
+    bool Probe(uint8_t address) override;
+    bool ReadRegs(uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len) override;
+    bool WriteRegs(uint8_t address, uint8_t reg, const uint8_t *buf, uint8_t len) override;
+    bool Read(uint8_t address, uint8_t *buf, uint8_t len) override;
+    bool Write(uint8_t address, const uint8_t *buf, uint8_t len) override;
+    I2CBusError_t LastError() const override;
+    bool Recover() override;
+
+    uint32_t busyRejects;  ///< Transfers not sent because the engine kept the bus
+private:
+    bool _Lock();
+    void _Unlock();
+
+    I2CBus *_bus;  ///< Blocking bus
+    AsyncI2C *_engine;  ///< Engine on the same controller
+    bool _lastBusy;  ///< True if the last transfer was refused (engine busy)
+};
+
+
+AsyncI2C *SensorAsyncI2C();
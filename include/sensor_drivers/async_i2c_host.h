@@ -0,0 +1,42 @@
+// ----------------------------------------------------------------------------
+// ASYNCHRONOUS I2C HOST (SIMULATED) BACKEND
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * AsyncI2C backend for host builds and tests. Transactions are completed
+ * from simulated devices attached by address. There is no bus interrupt;
+ * Step() stands in for the transfer-complete ISR and finishes the transfer
+ * on the "bus", so tests control exactly when transactions complete. Devices
+ * are the same SimI2CDevice models the blocking HostI2CBus uses.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "sensor_drivers/async_i2c.h"
+#include "hal/sim_i2c_device.h"
+
+
+class HostI2CBackend : public AsyncI2CBackend
+{
+public:
+    HostI2CBackend();
+    bool AttachDevice(uint8_t address, SimI2CDevice *device);
+    SimI2CDevice *FindDevice(uint8_t address);
+    bool Begin(AsyncI2C *engine) override;
+    void Start(I2CTransaction_t *txn) override;
+    bool Step();
+    uint32_t RunAll();
+private:
+    AsyncI2C *_engine;  ///< Engine to notify
+    I2CTransaction_t *_txn;  ///< Transfer on the simulated bus
+    uint8_t _addresses[HOST_I2C_MAX_DEVICES];  ///< Device addresses
+    SimI2CDevice *_devices[HOST_I2C_MAX_DEVICES];  ///< Devices
+    uint8_t _nDevices;  ///< Number of attached devices
+};
+
+
+HostI2CBackend &HostSensorI2CBackend();
@@ -0,0 +1,59 @@
+// ----------------------------------------------------------------------------
+// ASYNCHRONOUS I2C TEENSY 4.1 (LPI2C) BACKEND
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Interrupt-driven AsyncI2C backend for the i.MX RT1062's LPI2C master. The
+ * whole transaction (START, register, repeated START, RECEIVE n, STOP) is
+ * queued as LPI2C commands; the ISR keeps the 4-word TX FIFO fed, drains
+ * received bytes, and reports completion on STOP. The CPU is free for the
+ * rest of the transfer.
+ *
+ * Pin muxing and the bus clock are left to Wire: call SENSOR_I2C.begin() and
+ * setClock() first, then Begin(). Wire drives the same LPI2C for the blocking
+ * transfers, so those go through SensorI2CBus(), whose AsyncI2CSharedBus
+ * holds the engine off for each one; don't call SENSOR_I2C directly once the
+ * engine is running. Start() sets up the FIFO watermarks again each time, in
+ * case Wire changed them.
+ *
+ * SENSOR_I2C (Wire2) is LPI2C4. Only one instance is supported; 
+ * SensorAsyncI2C() returns its engine.
+ */
+
+#pragma once
+
+#if defined(__IMXRT1062__)
+
+#include <Arduino.h>
+#include "sensor_drivers/async_i2c.h"
+
+
+constexpr uint8_t LPI2C_FIFO_DEPTH = 4;  // LPI2C TX/RX FIFO depth [words]
+
+
+class TeensyLPI2CBackend : public AsyncI2CBackend
+{
+public:
+    TeensyLPI2CBackend(IMXRT_LPI2C_t *port = &IMXRT_LPI2C4, IRQ_NUMBER_t irq = IRQ_LPI2C4);
+    bool Begin(AsyncI2C *engine) override;
+    void Start(I2CTransaction_t *txn) override;
+private:
+    static void _Isr();
+    void _OnInterrupt();
+    bool _NextCommand(uint32_t *cmd);
+    void _FillTxFIFO();
+    void _Finish(I2CTxnStatus_t status);
+
+    static TeensyLPI2CBackend *_instance;  ///< Backend the ISR serves
+
+    IMXRT_LPI2C_t *_port;  ///< LPI2C peripheral
+    IRQ_NUMBER_t _irq;  ///< LPI2C interrupt
+    AsyncI2C *_engine;  ///< Engine to notify
+    I2CTransaction_t *volatile _txn;  ///< Transfer on the bus
+    volatile uint16_t _cmdIdx;  ///< Next command of the transfer to queue
+    volatile uint8_t _rxIdx;  ///< Bytes received so far
+};
+
+#endif
@@ -1,45 +1,215 @@
 // ----------------------------------------------------------------------------
 // BMP388 BAROMETRIC ALTIMETER AND TEMPERATURE SENSOR
-// 
+//
 // Code By: Michael Wrona
 // Created: 25 Feb 2021
 // ----------------------------------------------------------------------------
 /**
- * This is driver code for the BMP388 temp/pres sensor. It also incorporates 
- * Adafruit's BMP388 driver code.
+ * This is driver code for the BMP388 temp/pres sensor, on the I2C bus HAL.
+ *
+ * The sensor runs in normal mode (free-running at the ODR) with its FIFO
+ * storing pressure+temperature frames, which ReadFIFO() drains in bursts, so
+ * the baro can run at up to 200Hz without one transaction per sample.
+ * Compensation is Bosch's floating-point variant done in single precision:
+ * the NVM trimming coefficients are scaled to float once in Initialize(),
+ * then each sample is a handful of float multiply-adds on the FPU.
+ *
+ * BMP388 Datasheet: https://www.bosch-sensortec.com/media/boschsensortec/downloads/datasheets/bst-bmp388-ds001.pdf
  */
 
 #pragma once
 
 
-#include <Arduino.h>
-#include <Wire.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "hal/hal_platform.h"
+#include "hal/i2c_bus.h"
+#include "sensor_drivers/reg_config.h"
 #include "hummingbird_config.h"
 #include "debugging.h"
-// #include "constants.h"
-#include "Adafruit_Sensor.h"
-#include "Adafruit_BMP3XX.h"
 
 #if defined(DEBUG)
     #define BMP388_DEBUG  // Enable/disable debug print messages
 #endif
 
 
-class BMP388Baro:
-public Adafruit_BMP3XX
+#define BMP388_ADDR 0x77  // I2C address, SDO high
+#define BMP388_CHIP_ID 0x50  // CHIP_ID register value
+
+
+/**
+ * BMP388 registers
+ */
+typedef enum
+{
+    BMP388_REG_CHIP_ID = 0x00,
+    BMP388_REG_ERR = 0x02,  // Error flags: fatal_err, cmd_err, conf_err
+    BMP388_REG_STATUS = 0x03,  // cmd_rdy, drdy_press, drdy_temp
+    BMP388_REG_DATA = 0x04,  // Pressure XLSB, LSB, MSB, then temperature XLSB, LSB, MSB
+    BMP388_REG_INT_STATUS = 0x11,
+    BMP388_REG_FIFO_LENGTH = 0x12,  // FIFO fill level [bytes], 9 bits, LSB first
+    BMP388_REG_FIFO_DATA = 0x14,  // FIFO output. Burst reads stay on this register.
+    BMP388_REG_FIFO_CONFIG_1 = 0x17,  // fifo_mode, stop_on_full, time/press/temp enables
+    BMP388_REG_FIFO_CONFIG_2 = 0x18,  // Subsampling, data select
+    BMP388_REG_PWR_CTRL = 0x1B,  // press_en, temp_en, mode
+    BMP388_REG_OSR = 0x1C,  // osr_p, osr_t
+    BMP388_REG_ODR = 0x1D,  // odr_sel
+    BMP388_REG_CONFIG = 0x1F,  // iir_filter
+    BMP388_REG_NVM_PAR_T1 = 0x31,  // First of 21 NVM trimming coefficient bytes
+    BMP388_REG_CMD = 0x7E
+} BMP388Reg_t;
+
+
+/**
+ * Register bits and commands
+ */
+constexpr uint8_t BMP388_ERR_CONF = 0x04;  // ERR_REG: sensor configuration error (e.g. OSR too high for the ODR)
+constexpr uint8_t BMP388_PWR_PRESS_TEMP = 0x03;  // PWR_CTRL: press_en | temp_en
+constexpr uint8_t BMP388_PWR_MODE_NORMAL = 0x30;  // PWR_CTRL: normal mode
+constexpr uint8_t BMP388_FIFO_CONFIG_1_PT = 0x19;  // FIFO_CONFIG_1: fifo_mode, fifo_press_en, fifo_temp_en (overwrite oldest when full)
+constexpr uint8_t BMP388_FIFO_CONFIG_2_FILT = 0x08;  // FIFO_CONFIG_2: IIR-filtered data, no subsampling
+constexpr uint8_t BMP388_CMD_FIFO_FLUSH = 0xB0;  // CMD: clear the FIFO
+constexpr uint8_t BMP388_CMD_SOFT_RESET = 0xB6;  // CMD: soft reset
+constexpr uint8_t BMP388_NVM_LEN = 21;  // NVM trimming coefficient bytes
+
+
+/**
+ * FIFO frames (header mode). A pressure+temperature frame is the header then
+ * temperature and pressure, each 24-bit LSB first.
+ */
+constexpr uint8_t BMP388_FIFO_HDR_PRESS_TEMP = 0x94;  // Pressure + temperature frame
+constexpr uint8_t BMP388_FIFO_HDR_PRESS = 0x84;  // Pressure-only frame
+constexpr uint8_t BMP388_FIFO_HDR_TEMP = 0x90;  // Temperature-only frame
+constexpr uint8_t BMP388_FIFO_HDR_TIME = 0xA0;  // Sensor time frame
+constexpr uint8_t BMP388_FIFO_HDR_CONFIG = 0x48;  // Config. change frame
+constexpr uint8_t BMP388_FIFO_HDR_ERROR = 0x44;  // Config. error frame
+constexpr uint8_t BMP388_FIFO_FRAME_BYTES = 7;  // Pressure + temperature frame length
+constexpr uint16_t BMP388_FIFO_SIZE = 512;  // FIFO size [bytes]
+
+/**
+ * Max. FIFO bytes per I2C read: whole frames within I2C_BUS_MAX_TRANSFER, so
+ * a burst doesn't usually split a frame.
+ */
+constexpr uint8_t BMP388_FIFO_BYTES_PER_READ = (I2C_BUS_MAX_TRANSFER / BMP388_FIFO_FRAME_BYTES) * BMP388_FIFO_FRAME_BYTES;
+
+
+/**
+ * Oversampling settings. OSR register values.
+ */
+typedef enum
+{
+    BMP388_OS_1X = 0,  // No oversampling
+    BMP388_OS_2X = 1,
+    BMP388_OS_4X = 2,
+    BMP388_OS_8X = 3,
+    BMP388_OS_16X = 4,
+    BMP388_OS_32X = 5
+} BMP388OSR_t;
+
+
+/**
+ * IIR filter coefficients. CONFIG register iir_filter values, n for a
+ * coefficient of 2^n - 1.
+ */
+typedef enum
+{
+    BMP388_IIR_OFF = 0,
+    BMP388_IIR_COEF_1 = 1,
+    BMP388_IIR_COEF_3 = 2,
+    BMP388_IIR_COEF_7 = 3,
+    BMP388_IIR_COEF_15 = 4,
+    BMP388_IIR_COEF_31 = 5,
+    BMP388_IIR_COEF_63 = 6,
+    BMP388_IIR_COEF_127 = 7
+} BMP388IIR_t;
+
+
+/**
+ * Output data rates. ODR register odr_sel values: a period of 5ms * 2^odr_sel.
+ * At 200Hz only 1x pressure and temperature oversampling fit in a period.
+ */
+typedef enum
+{
+    BMP388_ODR_200HZ = 0x00,
+    BMP388_ODR_100HZ = 0x01,
+    BMP388_ODR_50HZ = 0x02,
+    BMP388_ODR_25HZ = 0x03,
+    BMP388_ODR_12_5HZ = 0x04
+} BMP388ODR_t;
+
+
+/* Sample period at an ODR [us] */
+constexpr uint32_t BMP388PeriodMicros(BMP388ODR_t odr)
+{
+    return 5000UL << (uint8_t)odr;
+}
+
+
+/**
+ * [us] Group delay of the BMP388's IIR filter, subtracted from sample
+ * timestamps. The filter updates once per sample and, with coefficient c
+ * (register value n: c = 2^n - 1), its output lags the input by c samples.
+ */
+constexpr uint32_t BMP388IIRGroupDelayMicros(BMP388IIR_t iirCoef, BMP388ODR_t odr)
+{
+    return ((1UL << (uint8_t)iirCoef) - 1UL) * BMP388PeriodMicros(odr);
+}
+
+
+/**
+ * NVM trimming coefficients, scaled to float as in the datasheet (section 9.1)
+ */
+typedef struct
+{
+    float t1, t2, t3;
+    float p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11;
+} BMP388Calib_t;
+
+
+/**
+ * One compensated sample read out of the FIFO.
+ */
+typedef struct
+{
+    float pressure;  // [Pa] Pressure
+    float temperature;  // [C] Temperature
+    uint64_t micros;  // [us] Micros64() when the sample was taken (reconstructed from the ODR, IIR delay removed)
+} BaroSample_t;
+
+
+/**
+ * Bosch BMP388 barometer driver.
+ */
+class BMP388Baro
 {
 public:
-    BMP388Baro(TwoWire *wireInput = &SENSOR_I2C);
-    bool Initialize(uint8_t presOS=BMP3_NO_OVERSAMPLING, uint8_t tempOS=BMP3_NO_OVERSAMPLING, 
-                    uint8_t iirCoef=BMP3_IIR_FILTER_COEFF_3, uint8_t odr=BMP3_ODR_50_HZ);
+    BMP388Baro(I2CBus *bus = SensorI2CBus());
+    bool Connect();
+    bool Initialize(BMP388OSR_t presOS = BMP388_OS_1X, BMP388OSR_t tempOS = BMP388_OS_1X,
+                    BMP388IIR_t iirCoef = BMP388_IIR_COEF_3, BMP388ODR_t odr = BMP388_ODR_50HZ);
+    bool ConfigureFIFO();
+    bool FlushFIFO();
+    size_t ReadFIFO(BaroSample_t *samples, size_t maxSamples);
     bool ReadSensor();
     float GetPressure();
     float GetTemperature();
-    uint32_t prevMeasMicros;  // [us] Previous measurement micros()
+    float CompensateTemperature(uint32_t rawT) const;
+    float CompensatePressure(uint32_t rawP, float tempC) const;
+    uint64_t prevMeasMicros;  ///< [us] Micros64() when the latest sample was taken (IIR delay removed)
+    uint32_t groupDelayMicros;  ///< [us] IIR filter group delay at the current settings
+    uint32_t fifoPeriodMicros;  ///< [us] Time between samples (1/ODR)
+    uint32_t fifoOverflows;  ///< Number of FIFO reads that found the FIFO full (oldest frames lost)
+    bool isConnected;  ///< True if the chip ID matched and the calibration was read
+    bool isFIFOEnabled;  ///< True if ConfigureFIFO() succeeded
 protected:
 private:
-    bool connected;  // Whether or not a good connection was made
-    float _t;  // [C] Raw temperature
-    float _p;  // [Pa] Raw pressure
-    TwoWire *_SensorWire;  // I2C interface that the sensor is connected to.
+    bool _ReadCalib();
+    static uint8_t _FrameBytes(uint8_t header);
+    static uint32_t _Raw24(const uint8_t *buf);
+    void I2Cwrite8(uint8_t regOfInterest, uint8_t valToWrite);
+    uint8_t I2Cread8(uint8_t regOfInterest);
+    BMP388Calib_t _calib;  ///< Calibration coefficients
+    float _t;  ///< [C] Latest temperature
+    float _p;  ///< [Pa] Latest pressure
+    I2CBus *_bus;  ///< I2C bus the sensor is on.
 };
@@ -0,0 +1,143 @@
+// ----------------------------------------------------------------------------
+// FUSED RAW-COUNT TO SI CONVERSION
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Turns a sensor's raw int16 counts into calibrated SI values with one 3x3
+ * matrix and an offset (nine multiply-adds per sample), instead of separate
+ * passes for sensitivity, unit conversion, axis rotation and calibration.
+ *
+ * For counts c, sensitivity k [unit/LSB], unit factor u [SI/unit], axis
+ * rotation R (sensor to body), and the symmetric calibration S and bias B of
+ * sensor_calib_params.h (in body axes and sensor units):
+ *
+ *     out = u * S * (R * k * c - B) = (u * k * S * R) * c - (u * S * B)
+ *
+ * MakeCountsToSI() does this product at compile time, so with constexpr
+ * ranges (e.g. INS_GYRO_RANGE) the whole conversion is a constant.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+
+/**
+ * Symmetric calibration matrix and bias, as in sensor_calib_params.h.
+ * | X_CAL |   | s11 s12 s13 | | X - bx |
+ * | Y_CAL | = | s12 s22 s23 | | Y - by |
+ * | Z_CAL |   | s13 s23 s33 | | Z - bz |
+ */
+typedef struct
+{
+    float s11, s12, s13, s22, s23, s33;
+    float bx, by, bz;
+} SensorCalib_t;
+
+constexpr SensorCalib_t SENSOR_CALIB_NONE = {1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f};
+
+
+/**
+ * Sensor to body axis rotation. Rows are body axes, columns sensor axes.
+ */
+typedef struct
+{
+    float r[3][3];
+} SensorAxes_t;
+
+constexpr SensorAxes_t SENSOR_AXES_IDENTITY = {{{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}}};
+
+
+/**
+ * Counts to SI conversion: out = m * counts + b
+ */
+typedef struct
+{
+    float m[3][3];  // [SI/LSB] Sensitivity, unit conversion, axis rotation and calibration
+    float b[3];  // [SI] Offset (calibration bias)
+} CountsToSI_t;
+
+
+/* Internal helpers, don't call these directly */
+constexpr float CountsToSICalS(const SensorCalib_t &cal, int i, int j)
+{
+    return (i == j) ? ((i == 0) ? cal.s11 : (i == 1) ? cal.s22 : cal.s33)
+        : ((i + j == 1) ? cal.s12 : (i + j == 2) ? cal.s13 : cal.s23);
+}
+
+constexpr float CountsToSIM(float scale, const SensorCalib_t &cal, const SensorAxes_t &axes, int i, int j)
+{
+    return scale * ((CountsToSICalS(cal, i, 0) * axes.r[0][j]) + (CountsToSICalS(cal, i, 1) * axes.r[1][j])
+        + (CountsToSICalS(cal, i, 2) * axes.r[2][j]));
+}
+
+constexpr float CountsToSIB(float unitToSI, const SensorCalib_t &cal, int i)
+{
+    return -unitToSI * ((CountsToSICalS(cal, i, 0) * cal.bx) + (CountsToSICalS(cal, i, 1) * cal.by)
+        + (CountsToSICalS(cal, i, 2) * cal.bz));
+}
+
+
+// ----------------------------------------------------------------------------
+// MakeCountsToSI(float sens, float unitToSI, const SensorCalib_t &cal, const SensorAxes_t &axes)
+// ----------------------------------------------------------------------------
+/**
+ * Fuse sensitivity, unit conversion, axis rotation, and calibration into one
+ * conversion. Compile-time when the arguments are constants.
+ *
+ * @param sens      [unit/LSB] Sensor sensitivity, e.g. GyroSensitivity(rng).
+ * @param unitToSI  [SI/unit] Unit conversion, e.g. DEG2RAD. 1 to keep units.
+ * @param cal       Calibration in 'unit', applied after the axis rotation.
+ * @param axes      Sensor to body axis rotation.
+ * @return  Conversion from counts to calibrated SI values.
+ */
+constexpr CountsToSI_t MakeCountsToSI(float sens, float unitToSI, const SensorCalib_t &cal = SENSOR_CALIB_NONE,
+    const SensorAxes_t &axes = SENSOR_AXES_IDENTITY)
+{
+    return {
+        {
+            {CountsToSIM(sens * unitToSI, cal, axes, 0, 0), CountsToSIM(sens * unitToSI, cal, axes, 0, 1), CountsToSIM(sens * unitToSI, cal, axes, 0, 2)},
+            {CountsToSIM(sens * unitToSI, cal, axes, 1, 0), CountsToSIM(sens * unitToSI, cal, axes, 1, 1), CountsToSIM(sens * unitToSI, cal, axes, 1, 2)},
+            {CountsToSIM(sens * unitToSI, cal, axes, 2, 0), CountsToSIM(sens * unitToSI, cal, axes, 2, 1), CountsToSIM(sens * unitToSI, cal, axes, 2, 2)}
+        },
+        {CountsToSIB(unitToSI, cal, 0), CountsToSIB(unitToSI, cal, 1), CountsToSIB(unitToSI, cal, 2)}
+    };
+}
+
+
+/**
+ * Scale a conversion's output, e.g. by local gravity for [g's] to [m/s/s]
+ * when g is only known at runtime.
+ */
+constexpr CountsToSI_t ScaleCountsToSI(const CountsToSI_t &cvt, float k)
+{
+    return {
+        {
+            {k * cvt.m[0][0], k * cvt.m[0][1], k * cvt.m[0][2]},
+            {k * cvt.m[1][0], k * cvt.m[1][1], k * cvt.m[1][2]},
+            {k * cvt.m[2][0], k * cvt.m[2][1], k * cvt.m[2][2]}
+        },
+        {k * cvt.b[0], k * cvt.b[1], k * cvt.b[2]}
+    };
+}
+
+
+/**
+ * Convert raw counts to calibrated SI values.
+ *
+ * @param cvt  Conversion from MakeCountsToSI().
+ * @param raw  [LSB] Raw sensor counts (sensor axes).
+ * @param out  [SI] Calibrated values (body axes).
+ */
+inline void ApplyCountsToSI(const CountsToSI_t &cvt, const int16_t raw[3], float out[3])
+{
+    float x = (float)raw[0];
+    float y = (float)raw[1];
+    float z = (float)raw[2];
+
+    out[0] = (cvt.m[0][0] * x) + (cvt.m[0][1] * y) + (cvt.m[0][2] * z) + cvt.b[0];
+    out[1] = (cvt.m[1][0] * x) + (cvt.m[1][1] * y) + (cvt.m[1][2] * z) + cvt.b[1];
+    out[2] = (cvt.m[2][0] * x) + (cvt.m[2][1] * y) + (cvt.m[2][2] * z) + cvt.b[2];
+}
@@ -0,0 +1,64 @@
+// ----------------------------------------------------------------------------
+// SENSOR DATA-READY INTERRUPT PIN
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Timestamps a sensor's data-ready (DRDY/INT) pin from its interrupt, so
+ * drivers read each sample exactly once, right after it's ready, and know
+ * when it was taken. The ISR only records Micros64() in a small ring buffer;
+ * the I2C read itself happens in the main loop (Wire isn't ISR-safe) when
+ * Available() says a sample is waiting. If the loop falls behind, Pop()
+ * returns the newest event and counts the skipped ones in 'missed'.
+ *
+ * Single producer (ISR) / single consumer (main loop): the ISR only writes
+ * the head index and the main loop only writes the tail, so no critical
+ * sections are needed. If the queue fills before the loop gets to it, new
+ * events are dropped and counted in 'overruns'.
+ *
+ * On a host (non-Arduino) build there are no interrupts; call Trigger() to
+ * simulate one.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+constexpr int8_t DRDY_PIN_NONE = -1;  // No data-ready pin connected, poll the sensor
+constexpr uint8_t DRDY_MAX_PINS = 4;  // Max. number of attached data-ready pins
+constexpr uint8_t DRDY_QUEUE_SIZE = 8;  // Pending events per pin. Power of 2.
+static_assert((DRDY_QUEUE_SIZE & (DRDY_QUEUE_SIZE - 1)) == 0, "DRDY_QUEUE_SIZE must be a power of 2");
+
+
+class DataReadyPin
+{
+public:
+    DataReadyPin();
+    ~DataReadyPin();
+    DataReadyPin(const DataReadyPin &) = delete;
+    DataReadyPin &operator=(const DataReadyPin &) = delete;
+
+    bool Attach(int8_t pin, bool activeHigh = true);
+    void Detach();
+    bool IsAttached() const;
+    bool Available() const;
+    bool Pop(uint64_t *tMicros);
+    void Clear();
+    void Trigger();
+    void Trigger(uint64_t tMicros);
+
+    volatile uint32_t overruns;  ///< Events dropped because the queue was full
+    uint32_t missed;  ///< Samples overwritten before they were read
+private:
+    template <uint8_t SLOT> static void _Isr();
+    static DataReadyPin *_slots[DRDY_MAX_PINS];  ///< Attached pins, indexed by ISR slot
+
+    volatile uint64_t _times[DRDY_QUEUE_SIZE];  ///< [us] Event Micros64() timestamps (ring buffer)
+    volatile uint8_t _head;  ///< Next slot the ISR writes. Only the ISR changes it.
+    volatile uint8_t _tail;  ///< Next slot to pop. Only the main loop changes it.
+    int8_t _pin;  ///< Attached pin, DRDY_PIN_NONE if not attached
+    int8_t _slot;  ///< ISR slot, -1 if not attached
+};
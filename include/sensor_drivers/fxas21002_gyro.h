@@ -19,13 +19,17 @@
 
 #pragma once
 
-#include <Arduino.h>
-#include <Wire.h>
+#include "hal/hal_platform.h"
+#include "hal/i2c_bus.h"
 // #include <limits.h>
 #include "constants.h"
 #include "debugging.h"
 #include "conversions.h"
 #include "hummingbird_config.h"
+#include "sensor_drivers/data_ready_pin.h"
+#include "sensor_drivers/async_i2c.h"
+#include "sensor_drivers/reg_config.h"
+#include "sensor_drivers/spsc_ring.h"
 
 
 #ifdef DEBUG
@@ -63,14 +67,91 @@ typedef enum
     GYRO_REG_YOUT_LSB = 0x04,
     GYRO_REG_ZOUT_MSB = 0x05,
     GYRO_REG_ZOUT_LSB = 0x06,
+    GYRO_REG_F_STATUS = 0x08,  // FIFO status: overflow, watermark, sample count
+    GYRO_REG_F_SETUP  = 0x09,  // FIFO mode and watermark
     GYRO_REG_ID       = 0x0C,
     GYRO_REG_TEMP     = 0x12,  //  (p.45)
     GYRO_REG_CTRL0    = 0x0D,  // (p.38)
     GYRO_REG_CTRL1    = 0x13,
-    GYRO_REG_CTRL2    = 0x14
+    GYRO_REG_CTRL2    = 0x14,
+    GYRO_REG_CTRL3    = 0x15
 } GyroRegisters_t;
 
 
+/**
+ * FIFO register bits
+ */
+constexpr uint8_t GYRO_F_STATUS_OVF     = 0x80;  // F_STATUS: FIFO overflowed, oldest samples lost
+constexpr uint8_t GYRO_F_STATUS_WMKF    = 0x40;  // F_STATUS: Watermark reached
+constexpr uint8_t GYRO_F_STATUS_CNT     = 0x3F;  // F_STATUS: Number of samples in the FIFO
+constexpr uint8_t GYRO_F_SETUP_CIRCULAR = 0x40;  // F_SETUP: Circular buffer mode (newest samples kept)
+constexpr uint8_t GYRO_CTRL3_WRAPTOONE  = 0x08;  // CTRL_REG3: Burst reads wrap from Z LSB back to X MSB (next FIFO sample)
+constexpr uint8_t GYRO_CTRL1_ACTIVE     = 0x02;  // CTRL_REG1: Active mode
+constexpr uint8_t GYRO_CTRL1_RST        = 0x40;  // CTRL_REG1: Software reset (self-clearing)
+constexpr uint8_t GYRO_CTRL2_DRDY_INT1  = 0x0E;  // CTRL_REG2: Data-ready interrupt on INT1, active high, push-pull
+
+/* FIFO depth [samples] */
+constexpr uint8_t GYRO_FIFO_SIZE = 32;
+
+/**
+ * Max. FIFO samples per I2C read. Reads are limited to I2C_BUS_MAX_TRANSFER 
+ * (136) bytes, and each sample is 6 bytes, so a full FIFO takes two bursts.
+ */
+constexpr uint8_t GYRO_FIFO_SAMPLES_PER_READ = I2C_BUS_MAX_TRANSFER / 6;
+
+
+/**
+ * Gyro output data rates. CTRL_REG1 DR[2:0] bits are set from these.
+ */
+typedef enum
+{
+    GYRO_ODR_800HZ = 800,  // 800Hz ODR
+    GYRO_ODR_400HZ = 400,  // 400Hz ODR
+    GYRO_ODR_200HZ = 200,  // 200Hz ODR
+    GYRO_ODR_100HZ = 100,  // 100Hz ODR
+    GYRO_ODR_50HZ = 50,  // 50Hz ODR
+    GYRO_ODR_25HZ = 25  // 25Hz ODR
+} GyroODR_t;
+
+
+/**
+ * Group delay of the gyro's signal chain at an ODR [us]: about half a period
+ * for the decimation filter plus ~0.7 periods for the LPF (CTRL_REG0[BW] = 00, 
+ * cutoff ~0.32 ODR). Subtracted from sample timestamps so they mark when the 
+ * motion happened, not when the output registers updated.
+ */
+constexpr uint32_t GyroGroupDelayMicros(uint32_t odrHz)
+{
+    return 1200000UL / odrHz;
+}
+
+
+/* [us] Boot time after a software reset, before the part takes writes again */
+constexpr uint32_t GYRO_BOOT_US = 1000;
+
+
+/**
+ * Standby to active transition time at an ODR [us], 1/ODR + 60ms. Samples 
+ * before then aren't valid.
+ */
+constexpr uint32_t GyroTurnOnMicros(uint32_t odrHz)
+{
+    return 1000000UL / odrHz + 60000UL;
+}
+
+
+/**
+ * One gyro sample read out of the FIFO.
+ */
+typedef struct
+{
+    float gx;  // [deg/s] Gyro x
+    float gy;  // [deg/s] Gyro y
+    float gz;  // [deg/s] Gyro z
+    uint64_t micros;  // [us] Micros64() when the sample was taken (reconstructed from the ODR, group delay removed)
+} GyroSample_t;
+
+
 /**
  * Gyro measurement ranges.
  */
@@ -83,28 +164,64 @@ typedef enum
 } GyroRanges_t;
 
 
+/**
+ * Sensitivity of a gyro range [dps/LSB]. constexpr, so a constant range gives 
+ * a compile-time conversion (see counts_to_si.h).
+ */
+constexpr float GyroSensitivity(GyroRanges_t rng)
+{
+    return (rng == GYRO_RNG_250DPS) ? GYRO_SENS_250 : (rng == GYRO_RNG_500DPS) ? GYRO_SENS_500 
+        : (rng == GYRO_RNG_1000DPS) ? GYRO_SENS_1000 : (rng == GYRO_RNG_2000DPS) ? GYRO_SENS_2000 : 0.0f;
+}
+
+
 /**
  * NXP FXAS21002 gyro sensor driver.
  */
 class FXAS21002Gyro
 {
 public:
-    FXAS21002Gyro(TwoWire *wireInput = &SENSOR_I2C);
+    FXAS21002Gyro(I2CBus *bus = SensorI2CBus());
     ~FXAS21002Gyro() {};
     bool Initialize(GyroRanges_t rng = GYRO_RNG_1000DPS);
+    bool BeginInitialize(GyroRanges_t rng = GYRO_RNG_1000DPS);
+    RegConfigStatus_t StepInitialize(uint32_t *waitMicros);
     bool ReadSensor();
+    bool ConfigureFIFO(GyroODR_t odr = GYRO_ODR_800HZ, uint8_t watermark = 8);
+    size_t ReadFIFO(GyroSample_t *samples, size_t maxSamples);
+    bool AttachDataReady(int8_t pin);
+    bool DataReady();
+    bool SubmitRead(AsyncI2C *i2c);
+    bool IsReadPending();
+    I2CTxnStatus_t ReadStatus();
     float GetTemperature();
+    bool ReadTemperature(float *tempC);
     float GetGx();
     float GetGy();
     float GetGz();  
-    uint32_t prevMeasMicros;  ///< Previous measurement micros()
+    void GetRaw(int16_t raw[3]);
+    uint64_t prevMeasMicros;  ///< [us] Micros64() when the latest sample was taken (group delay removed)
+    uint32_t groupDelayMicros;  ///< [us] Group delay at the current ODR
+    uint32_t fifoOverflows;  ///< Number of FIFO reads that found the FIFO overflowed
+    bool isFIFOEnabled;  ///< True if ConfigureFIFO() succeeded
+    uint32_t fifoPeriodMicros;  ///< [us] Time between FIFO samples (1/ODR)
+    DataReadyPin drdy;  ///< INT1 data-ready interrupt, if wired
+    uint32_t readFailures;  ///< Number of failed async reads
+    SensorStream stream;  ///< Every sample read, raw counts, for the sensor system to drain
 protected:
 private:
     void I2Cwrite8(uint8_t regOfInterest, uint8_t valToWrite);
     uint8_t I2Cread8(uint8_t regOfInterest);
-    float _gx;  ///< Gyro x reading, [deg/s]
-    float _gy;  ///< Gyro y reading, [deg/s]
-    float _gz;  ///< Gyro z reading, [deg/s]
+    uint64_t _SampleMicros(uint64_t startMicros);
+    void _Publish(uint64_t micros);
+    static void _OnReadComplete(I2CTransaction_t *txn);
+    I2CTransaction_t _txn;  ///< Async read of the output registers
+    uint8_t _txnBuf[6];  ///< Async read destination
+    int16_t _raw[3];  ///< Latest gyro reading [LSB]
+    float _sens;  ///< Sensitivity of the selected range [dps/LSB]. 0 until initialized.
     GyroRanges_t gyroRange;  ///< Selected gyro measurement range.
-    TwoWire *_SensorWire;  ///< I2C bus the sensor is connected to.
+    uint32_t _odrHz;  ///< [Hz] Current output data rate
+    uint64_t _settledMicros;  ///< [us] Micros64() when the output is valid again after AttachDataReady()
+    RegConfigJob _initJob;  ///< Configuration written by StepInitialize()
+    I2CBus *_bus;  ///< I2C bus the sensor is connected to.
 };
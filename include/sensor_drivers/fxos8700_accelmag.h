@@ -10,16 +10,23 @@
 // SAME ADC! See p.22 for more.
 // - Because we are using the LIS3MDL compass in the GPS, I chose to disable 
 // hybrid mode and only use the FXOS8700's accelerometer (8/26/2021).
+// - Hybrid mode is back on by default: with M_CTRL_REG2[hyb_autoinc_mode] set, 
+// one 13-byte burst from STATUS returns accel. and mag. together, giving a 
+// second magnetometer for no extra transactions. The ODR is halved.
 
 
 
 
 #pragma once
 
-#include <Wire.h>
-#include <Arduino.h>
+#include "hal/hal_platform.h"
+#include "hal/i2c_bus.h"
 #include "hummingbird_config.h"
 #include "debugging.h"
+#include "sensor_drivers/data_ready_pin.h"
+#include "sensor_drivers/async_i2c.h"
+#include "sensor_drivers/reg_config.h"
+#include "sensor_drivers/spsc_ring.h"
 
 #ifdef DEBUG
 #define FXOS8700_DEBUG  // Toggle printing FXOS8700 debug messages to the debug port
@@ -47,12 +54,25 @@ typedef enum
     ACCEL_RNG_8G = 0x02
 } AccelRanges_t;
 
+
+/**
+ * Accel. sensitivity of a range [G's/LSB], for the 14-bit (right-shifted) 
+ * counts. constexpr, so a constant range gives a compile-time conversion 
+ * (see counts_to_si.h).
+ */
+constexpr float AccelSensitivity(AccelRanges_t rng)
+{
+    return (rng == ACCEL_RNG_2G) ? ACCELMAG_CVT_GS_2G : (rng == ACCEL_RNG_4G) ? ACCELMAG_CVT_GS_4G 
+        : (rng == ACCEL_RNG_8G) ? ACCELMAG_CVT_GS_8G : 0.0f;
+}
+
 /**
  * Accelerometer & magnetometer registers.
  */
 typedef enum
 {
-    ACCELMAG_REG_STATUS     = 0x00,          
+    ACCELMAG_REG_STATUS     = 0x00,  // F_STATUS when the FIFO is enabled
+    ACCELMAG_REG_F_SETUP    = 0x09,
     ACCELMAG_REG_ID         = 0x0D,       
     ACCELMAG_REG_XYZ_CFG    = 0x0E,
     ACCELMAG_REG_AOUT_X_MSB = 0x01,
@@ -79,27 +99,106 @@ typedef enum
 } MagAccelRegisters_t;
 
 
+/**
+ * Register bits
+ */
+constexpr uint8_t ACCELMAG_F_STATUS_OVF     = 0x80;  // F_STATUS: FIFO overflowed, oldest samples lost
+constexpr uint8_t ACCELMAG_F_STATUS_CNT     = 0x3F;  // F_STATUS: Number of samples in the FIFO
+constexpr uint8_t ACCELMAG_F_SETUP_CIRCULAR = 0x40;  // F_SETUP: Circular buffer mode (newest samples kept)
+constexpr uint8_t ACCELMAG_MCTRL1_HYBRID    = 0x1F;  // M_CTRL_REG1: Max. mag. oversampling, hybrid (accel. + mag.) mode
+constexpr uint8_t ACCELMAG_MCTRL1_ACCEL     = 0x10;  // M_CTRL_REG1: Mag. oversampling = 0b100, accel. only
+constexpr uint8_t ACCELMAG_MCTRL2_AUTOINC   = 0x20;  // M_CTRL_REG2: hyb_autoinc_mode, burst reads jump from 0x06 to 0x33
+constexpr uint8_t ACCELMAG_CTRL3_ACTIVE_HI  = 0x02;  // CTRL_REG3: Interrupts active high, push-pull
+constexpr uint8_t ACCELMAG_CTRL4_DRDY       = 0x01;  // CTRL_REG4: Data-ready interrupt enabled
+constexpr uint8_t ACCELMAG_CTRL5_DRDY_INT1  = 0x01;  // CTRL_REG5: Data-ready interrupt on INT1
+
+/* FIFO depth [samples] */
+constexpr uint8_t ACCELMAG_FIFO_SIZE = 32;
+
+/**
+ * Max. FIFO samples per I2C read. Reads are limited to I2C_BUS_MAX_TRANSFER 
+ * (136) bytes, and each sample is 6 bytes, so a full FIFO takes two bursts.
+ */
+constexpr uint8_t ACCELMAG_FIFO_SAMPLES_PER_READ = I2C_BUS_MAX_TRANSFER / 6;
+
+/* [us] Accel. sample period (CTRL_REG1[DR] = 001, 400Hz single sensor / 200Hz hybrid) */
+constexpr uint32_t ACCELMAG_PERIOD_US_ACCEL  = 2500;
+constexpr uint32_t ACCELMAG_PERIOD_US_HYBRID = 5000;
+
+/* [us] Standby to active transition time, 2/ODR + 1ms */
+constexpr uint32_t ACCELMAG_TURN_ON_US_ACCEL  = 2 * ACCELMAG_PERIOD_US_ACCEL + 1000;
+constexpr uint32_t ACCELMAG_TURN_ON_US_HYBRID = 2 * ACCELMAG_PERIOD_US_HYBRID + 1000;
+
+/**
+ * [us] Group delay, subtracted from sample timestamps. In high-resolution 
+ * mode the ADC oversamples across the whole ODR period, so the sample 
+ * represents the middle of the period.
+ */
+constexpr uint32_t ACCELMAG_GROUP_DELAY_US_ACCEL  = ACCELMAG_PERIOD_US_ACCEL / 2;
+constexpr uint32_t ACCELMAG_GROUP_DELAY_US_HYBRID = ACCELMAG_PERIOD_US_HYBRID / 2;
+
+
+/**
+ * One accelerometer sample read out of the FIFO.
+ */
+typedef struct
+{
+    float ax;  // [G's] Accel. x
+    float ay;  // [G's] Accel. y
+    float az;  // [G's] Accel. z
+    uint64_t micros;  // [us] Micros64() when the sample was taken (reconstructed from the ODR, group delay removed)
+} AccelSample_t;
+
+
 /**
  * NXP Semiconductor FXOS8700 accelerometer/magnetometer sensor class.
  */
 class FXOS8700AccelMag
 {
 public:
-    FXOS8700AccelMag(TwoWire *wireInput = &SENSOR_I2C);
+    FXOS8700AccelMag(I2CBus *bus = SensorI2CBus());
     ~FXOS8700AccelMag() {};
-    bool Initialize(AccelRanges_t accRange = ACCEL_RNG_4G);
+    bool Initialize(AccelRanges_t accRange = ACCEL_RNG_4G, bool useHybrid = true);
+    bool BeginInitialize(AccelRanges_t accRange = ACCEL_RNG_4G, bool useHybrid = true);
+    RegConfigStatus_t StepInitialize(uint32_t *waitMicros);
     bool ReadSensor();
+    bool ConfigureFIFO(uint8_t watermark = 8);
+    size_t ReadFIFO(AccelSample_t *samples, size_t maxSamples);
+    bool AttachDataReady(int8_t pin);
+    bool DataReady();
+    bool SubmitRead(AsyncI2C *i2c);
+    bool IsReadPending();
     float GetAx();
     float GetAy();
     float GetAz();
-    uint32_t prevMeasMicros;  ///< Previous measurement micros()
+    float GetMx();
+    float GetMy();
+    float GetMz();
+    void GetRawAccel(int16_t raw[3]);
+    void GetRawMag(int16_t raw[3]);
+    uint64_t prevMeasMicros;  ///< [us] Micros64() when the latest sample was taken (group delay removed)
+    uint32_t fifoOverflows;  ///< Number of FIFO reads that found the FIFO overflowed
     AccelRanges_t accelRange;  ///< Measurement range
+    bool isHybrid;  ///< True if the magnetometer is enabled (hybrid mode)
+    bool isFIFOEnabled;  ///< True if ConfigureFIFO() succeeded
+    DataReadyPin drdy;  ///< INT1 data-ready interrupt, if wired
+    uint32_t readFailures;  ///< Number of failed async reads
+    SensorStream stream;  ///< Every accel. sample read, raw counts, for the sensor system to drain
 protected:
 private:
-    float _ax;  ///< X-acceleration [G's]
-    float _ay;  ///< Y-acceleration [G's]
-    float _az;  ///< Z-acceleration [G's]
-    TwoWire *_SensorWire;  ///< I2C bus that the sensor is on
+    int16_t _accel[3];  ///< Latest acceleration, 14-bit [LSB]
+    int16_t _mag[3];  ///< Latest magnetic field [LSB]
+    float _accelSens;  ///< Accel. sensitivity of the selected range [G's/LSB]. 0 until initialized.
+    uint8_t _ctrlReg1;  ///< CTRL_REG1 value in active mode
+    RegConfigJob _initJob;  ///< Configuration written by StepInitialize()
+    I2CBus *_bus;  ///< I2C bus that the sensor is on
     uint8_t I2Cread8(uint8_t regOfInterest);
     void I2Cwrite8(uint8_t regOfInterest, uint8_t valToWrite);
+    bool I2CreadBurst(uint8_t startReg, uint8_t *buf, uint8_t len);
+    void _Decode(const uint8_t *raw);
+    uint64_t _SampleMicros(uint64_t startMicros);
+    void _Publish(uint64_t micros);
+    static void _OnReadComplete(I2CTransaction_t *txn);
+    I2CTransaction_t _txn;  ///< Async read of STATUS + output registers
+    uint8_t _txnBuf[13];  ///< Async read destination
 };
@@ -0,0 +1,65 @@
+// ----------------------------------------------------------------------------
+// GYRO TEMPERATURE BIAS TABLE
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Gyro zero-rate bias as a function of die temperature: a small table of
+ * bins GYRO_TBIAS_T_STEP degrees apart, linearly interpolated per sample.
+ *
+ * The table is learned, not calibrated: each measurement taken while the
+ * vehicle sits still (the turn-on bias measurement, and stationary periods
+ * the INS detects afterwards) is split between the two bins around its
+ * temperature and averaged in. A bin's weight is how many samples it has
+ * seen, capped at GYRO_TBIAS_MAX_WEIGHT so it keeps tracking slow aging.
+ * Bins with too little weight to trust are skipped and the nearest learned
+ * bins used instead (flat past the learned range).
+ *
+ * Save()/Load() keep the table in non-volatile storage with a checksum, so
+ * a warm table makes the pre-flight bias measurement unnecessary.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hal/nv_storage.h"
+
+
+constexpr uint8_t GYRO_TBIAS_BINS = 16;  // Number of temperature bins
+constexpr float GYRO_TBIAS_T_MIN = -20.0f;  // [C] Temperature of the first bin
+constexpr float GYRO_TBIAS_T_STEP = 5.0f;  // [C] Bin spacing. Bins cover -20C to 55C.
+constexpr float GYRO_TBIAS_MIN_WEIGHT = 20.0f;  // [samples] Weight before a bin is used
+constexpr float GYRO_TBIAS_MAX_WEIGHT = 4096.0f;  // [samples] Weight cap. Sets how fast old data is forgotten.
+constexpr uint32_t GYRO_TBIAS_NV_MAGIC = 0x31425447;  // "GTB1"
+
+
+/**
+ * One temperature bin
+ */
+typedef struct
+{
+    float bias[3];  // [rad/s] Learned bias, [x, y, z]
+    float weight;  // [samples] Amount of data averaged in, 0 if unlearned
+} GyroTempBiasBin_t;
+
+
+class GyroTempBias
+{
+public:
+    GyroTempBias();
+    void Clear();
+    void Learn(float tempC, const float meas[3], float weight = 1.0f);
+    bool GetBias(float tempC, float bias[3]) const;
+    float Confidence(float tempC) const;
+    bool Save(NVStorage *nv, uint16_t address);
+    bool Load(NVStorage *nv, uint16_t address);
+    static float BinTemperature(uint8_t bin);
+
+    GyroTempBiasBin_t bins[GYRO_TBIAS_BINS];  ///< Temperature bins, coldest first
+    uint32_t learnedSinceSave;  ///< Learn() calls since the last Save()/Load()
+private:
+    static float _Position(float tempC);
+    void _LearnBin(uint8_t bin, const float meas[3], float weight);
+};
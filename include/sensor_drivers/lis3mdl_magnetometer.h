@@ -12,10 +12,13 @@
 
 #pragma once
 
-#include <Arduino.h>
-#include <Wire.h>
+#include "hal/hal_platform.h"
+#include "hal/i2c_bus.h"
 #include "debugging.h"
 #include "hummingbird_config.h"
+#include "sensor_drivers/data_ready_pin.h"
+#include "sensor_drivers/async_i2c.h"
+#include "sensor_drivers/reg_config.h"
 
 
 #ifdef DEBUG
@@ -39,6 +42,48 @@
 #define LIS3MDL_CTRL_REG5 0x24  // Control register 5
 
 
+/**
+ * Fast output data rates (CTRL_REG1[FAST_ODR]). The rate comes from the 
+ * operating mode (CTRL_REG1[OM], CTRL_REG4[OMZ]): faster modes average less 
+ * and are noisier.
+ */
+typedef enum {
+    LIS3MDL_ODR_155HZ = 155,  // Ultra-high performance
+    LIS3MDL_ODR_300HZ = 300,  // High performance
+    LIS3MDL_ODR_560HZ = 560,  // Medium performance
+    LIS3MDL_ODR_1000HZ = 1000  // Low power
+} LIS3MDL_ODR_t;
+
+
+/**
+ * [us] Group delay at a fast ODR, subtracted from sample timestamps. Each 
+ * output is the average over one conversion, which takes most of the 
+ * period, so it represents the middle of it.
+ */
+constexpr uint32_t LIS3MDLGroupDelayMicros(uint32_t odrHz)
+{
+    return 500000UL / odrHz;
+}
+
+
+constexpr float LIS3MDL_TEMP_LSB_PER_C = 8.0f;  // Temperature sensitivity [LSB/C]
+constexpr float LIS3MDL_TEMP_OFFSET_C = 25.0f;  // [C] Temperature at 0 LSB (typical, not trimmed)
+
+
+/**
+ * One entry of a temperature compensation table. Between entries the offset 
+ * and scale are interpolated linearly; outside the table the end entries 
+ * hold. The driver applies (field - offset) * scale per sensor axis, before 
+ * any axis rotation or calibration.
+ */
+typedef struct
+{
+    float tempC;  // [C] Die temperature of this entry (GetTemperature())
+    float offset[3];  // [uT] Offset at this temperature, sensor axes
+    float scale[3];  // Scale factor at this temperature, sensor axes
+} LIS3MDLTempComp_t;
+
+
 /**
  * LIS3MDL data registers
  */
@@ -65,28 +110,60 @@ typedef enum {
 } LIS3MDL_MeasRange_t;
 
 
+/**
+ * Sensitivity of a measurement range [uT/LSB]. LSB/gauss values are from the 
+ * LIS3MDL datasheet, 1G = 100uT. constexpr, so a constant range gives a 
+ * compile-time conversion (see counts_to_si.h).
+ */
+constexpr float LIS3MDLSensitivity(LIS3MDL_MeasRange_t rng)
+{
+    return (rng == LIS3MDL_RANGE_4G) ? 100.0f / 6842.0f : (rng == LIS3MDL_RANGE_8G) ? 100.0f / 3421.0f 
+        : (rng == LIS3MDL_RANGE_12G) ? 100.0f / 2281.0f : (rng == LIS3MDL_RANGE_16G) ? 100.0f / 1711.0f : 0.0f;
+}
+
+
 /**
  * STMicroelectronics LIS3MDL magnetometer sensor class
  */
 class LIS3MDL_Mag
 {
 public:
-    LIS3MDL_Mag(TwoWire *userWire = &SENSOR_I2C);
+    LIS3MDL_Mag(I2CBus *bus = SensorI2CBus());
     ~LIS3MDL_Mag() {};
-    bool Initialize(LIS3MDL_MeasRange_t measRange = LIS3MDL_RANGE_4G);
+    bool Initialize(LIS3MDL_MeasRange_t measRange = LIS3MDL_RANGE_4G, LIS3MDL_ODR_t odr = LIS3MDL_ODR_155HZ);
+    bool SetTempCompensation(const LIS3MDLTempComp_t *table, uint8_t n);
     bool ReadSensor();
+    bool AttachDataReady(int8_t pin);
+    bool DataReady();
+    bool SubmitRead(AsyncI2C *i2c);
+    bool IsReadPending();
     float GetMx();
     float GetMy();
     float GetMz();
+    void GetRaw(int16_t raw[3]);
     float GetTemperature();
-    uint32_t prevMeasMicros;  ///< Previous measurement micros()
+    uint64_t prevMeasMicros;  ///< [us] Micros64() when the latest sample was taken (group delay removed)
+    uint32_t groupDelayMicros;  ///< [us] Group delay at the current ODR
+    DataReadyPin drdy;  ///< DRDY data-ready interrupt, if wired
+    uint32_t readFailures;  ///< Number of failed async reads
 protected:
 private:
-    float _mx;  ///< x-magnetometer reading [uT]
-    float _my;  ///< y-magnetometer reading [uT]
-    float _mz;  ///< z-magnetometer reading [uT]
-    TwoWire *_SensorWire;  ///< I2C/wire interface the sensor is on.
+    int16_t _raw[3];  ///< Latest magnetometer reading, temperature compensated [LSB]
+    int16_t _tempRaw;  ///< Latest temperature reading [LSB]
+    float _sens;  ///< Sensitivity of the selected range [uT/LSB]. 0 until initialized.
+    const LIS3MDLTempComp_t *_tcTable;  ///< Temperature compensation table, nullptr for none
+    uint8_t _tcLen;  ///< Entries in _tcTable
+    bool _tcStale;  ///< _tcOffset/_tcScale need recomputing
+    float _tcOffset[3];  ///< Offset at the current temperature [LSB]
+    float _tcScale[3];  ///< Scale at the current temperature
+    I2CBus *_bus;  ///< I2C bus the sensor is on.
     LIS3MDL_MeasRange_t _range;  ///< Sensor measurement range.
     void I2Cwrite8(uint8_t regOfInterest, uint8_t valToWrite);
     uint8_t I2Cread8(uint8_t regOfInterest);
+    uint64_t _SampleMicros(uint64_t startMicros);
+    void _Decode(const uint8_t *buf);
+    void _UpdateTempComp();
+    static void _OnReadComplete(I2CTransaction_t *txn);
+    I2CTransaction_t _txn;  ///< Async read of the output registers
+    uint8_t _txnBuf[8];  ///< Async read destination: mag. and temperature
 };
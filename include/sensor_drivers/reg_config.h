@@ -0,0 +1,107 @@
+// ----------------------------------------------------------------------------
+// REGISTER CONFIGURATION TABLES
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * A driver's configuration as a table of register writes, applied in as few
+ * bus transfers as the part allows and checked with one burst read per block
+ * of registers:
+ *
+ *     const RegConfig_t config[] = {
+ *         {REG_CTRL1, 0x00,   REG_NO_VERIFY,  0},     // Standby
+ *         {REG_CTRL2, ctrl2,  REG_VERIFY_ALL, 0},
+ *         {REG_CTRL1, active, REG_VERIFY_ALL, 6000},  // Turn-on time
+ *     };
+ *     ApplyRegConfig(bus, ADDR, config, 3, REG_BURST_AUTOINC);
+ *
+ * Entries are written in order. Consecutive entries go out in one transfer
+ * when the part can take them that way (next register for auto-increment
+ * parts, any register for address/data pair parts) and the earlier entry has
+ * no wait. 'waitMicros' is the datasheet time the part needs after that
+ * write (reset boot, standby-to-active), and the only delay there is.
+ *
+ * Only the last write to a register is verified, under its 'verifyMask'.
+ * Self-clearing bits (reset) and command registers aren't read back.
+ *
+ * ApplyRegConfig() blocks through the waits. From a running loop (e.g.
+ * re-initializing a sensor that dropped out), RegConfigJob does the same
+ * writes up to one wait per Step() and returns the wait instead of spending
+ * it:
+ *
+ *     job.Start(bus, ADDR, config, 3, REG_BURST_AUTOINC);
+ *     while ((status = job.Step(&waitMicros)) == REG_CONFIG_BUSY)
+ *         ...  // Come back after waitMicros
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hal/i2c_bus.h"
+
+
+constexpr uint8_t REG_VERIFY_ALL = 0xFF;  // Read back and check every bit
+constexpr uint8_t REG_NO_VERIFY = 0x00;  // Write only: self-clearing bits, commands, or overwritten later
+constexpr uint8_t REG_CONFIG_MAX_ENTRIES = 16;  // Max. verified registers per table
+constexpr uint8_t REG_CONFIG_MAX_GAP = 1;  // Unlisted (reserved) registers a read-back burst may read through
+
+
+/**
+ * How the part handles multi-byte transfers
+ */
+typedef enum
+{
+    REG_BURST_AUTOINC,  // Register address steps through reads and writes (FXAS21002, FXOS8700)
+    REG_BURST_AUTOINC_MSB,  // Steps only if bit 7 of the register address is set (LIS3MDL)
+    REG_BURST_ADDR_PAIRS  // Writes are register address/data pairs, reads step (BMP388)
+} RegBurstMode_t;
+
+
+/**
+ * Progress of a RegConfigJob
+ */
+typedef enum
+{
+    REG_CONFIG_DONE,  // Written and verified
+    REG_CONFIG_BUSY,  // Part of the table written. Step() again after the wait.
+    REG_CONFIG_FAILED  // A write was NACKed or the read-back didn't match
+} RegConfigStatus_t;
+
+
+/**
+ * One register write
+ */
+typedef struct
+{
+    uint8_t reg;  // Register address
+    uint8_t value;  // Value to write
+    uint8_t verifyMask;  // Bits to check on read-back. REG_NO_VERIFY to skip.
+    uint32_t waitMicros;  // [us] Datasheet wait after this write. 0 for none.
+} RegConfig_t;
+
+
+bool WriteRegConfig(I2CBus *bus, uint8_t address, const RegConfig_t *config, uint8_t n, RegBurstMode_t mode);
+bool VerifyRegConfig(I2CBus *bus, uint8_t address, const RegConfig_t *config, uint8_t n, RegBurstMode_t mode);
+bool ApplyRegConfig(I2CBus *bus, uint8_t address, const RegConfig_t *config, uint8_t n, RegBurstMode_t mode);
+
+
+/**
+ * A configuration table applied a burst at a time, without blocking
+ */
+class RegConfigJob
+{
+public:
+    RegConfigJob();
+    bool Start(I2CBus *bus, uint8_t address, const RegConfig_t *config, uint8_t n, RegBurstMode_t mode);
+    RegConfigStatus_t Step(uint32_t *waitMicros);
+    bool IsBusy() const;
+private:
+    RegConfig_t _config[REG_CONFIG_MAX_ENTRIES];  ///< Copy of the table
+    I2CBus *_bus;  ///< I2C bus the part is on. nullptr when idle.
+    uint8_t _address;  ///< 7-bit device address
+    uint8_t _n;  ///< Entries in the table
+    uint8_t _next;  ///< Next entry to write. _n once all are written.
+    RegBurstMode_t _mode;  ///< How the part handles multi-byte transfers
+};
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "sensor_drivers/counts_to_si.h"
+
 
 // ----------------------------------------------------------------------------
 // Magnetometer calibration coefficients (data in [uT])
@@ -27,6 +29,9 @@ constexpr float SENSCALIB_MAG_BX    = 15.606863f;  // X magn. bias
 constexpr float SENSCALIB_MAG_BY    = 38.011123f;  // Y magn. bias
 constexpr float SENSCALIB_MAG_BZ    = 41.207505f;  // Z magn. bias
 
+constexpr SensorCalib_t SENSCALIB_MAG = {SENSCALIB_MAG_S11, SENSCALIB_MAG_S12, SENSCALIB_MAG_S13, 
+    SENSCALIB_MAG_S22, SENSCALIB_MAG_S23, SENSCALIB_MAG_S33, SENSCALIB_MAG_BX, SENSCALIB_MAG_BY, SENSCALIB_MAG_BZ};
+
 
 // ----------------------------------------------------------------------------
 // Accelerometer calibration coefficients (data in [G's])
@@ -44,6 +49,9 @@ constexpr float SENSCALIB_ACCEL_BX  = 0.027031f;  // X accel. bias
 constexpr float SENSCALIB_ACCEL_BY  = -0.040204f;  // Y accel. bias
 constexpr float SENSCALIB_ACCEL_BZ  = 0.046558f;  // Z accel. bias
 
+constexpr SensorCalib_t SENSCALIB_ACCEL = {SENSCALIB_ACCEL_S11, SENSCALIB_ACCEL_S12, SENSCALIB_ACCEL_S13, 
+    SENSCALIB_ACCEL_S22, SENSCALIB_ACCEL_S23, SENSCALIB_ACCEL_S33, SENSCALIB_ACCEL_BX, SENSCALIB_ACCEL_BY, SENSCALIB_ACCEL_BZ};
+
 
 
 
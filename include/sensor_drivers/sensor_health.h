@@ -0,0 +1,65 @@
+// ----------------------------------------------------------------------------
+// SENSOR HEALTH AND BACKGROUND RE-INITIALIZATION
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tracks one sensor's reads for its sensor system: the age of its newest
+ * good sample, failures, and when to try bringing it back. A sensor that
+ * browned out or was reset by a bus glitch comes back up in its power-on
+ * defaults and won't produce data until it is configured again, so after
+ * 'failsToReinit' failed reads in a row the system re-runs the driver's
+ * Initialize() from its update loop, then every 'retryMicros' until reads
+ * work again.
+ *
+ * Retries are cheap while the device is gone (the driver's ID read NACKs
+ * right away); the driver's own settling delays only run once it answers.
+ *
+ * Usage, in the sensor system's Update():
+ *
+ *     if (Sensor.ReadSensor())
+ *         SensorHealth.ReadOk(Sensor.prevMeasMicros);
+ *     else if (SensorHealth.ReadFailed())
+ *         SensorHealth.ReinitDone(Sensor.Initialize(...));
+ *
+ * A driver with a non-blocking BeginInitialize()/StepInitialize() doesn't
+ * stall the loop for those delays. While StepInitialize() returns
+ * REG_CONFIG_BUSY, ReinitWait() records when the part is due to be ready;
+ * the sensor isn't read meanwhile (IsReinitPending()), and once ReinitDue()
+ * a later Update() runs the next step, and finally the verification, then
+ * ReinitDone(). See InertialNavSystem::ReinitGyro().
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+class SensorHealth
+{
+public:
+    SensorHealth(uint8_t failsToReinit, uint32_t retryMicros);
+
+    void ReadOk(uint64_t sampleMicros);
+    bool ReadFailed();
+    void ReinitWait(uint32_t waitMicros);
+    bool IsReinitPending() const;
+    bool ReinitDue() const;
+    void ReinitDone(bool ok);
+    bool IsOnline() const;
+    uint64_t DataAgeMicros() const;
+
+    uint64_t lastSampleMicros;  ///< [us] Micros64() timestamp of the newest good sample, 0 if none yet
+    uint32_t readFailures;  ///< Failed reads
+    uint32_t consecutiveFailures;  ///< Failed reads since the last good one
+    uint32_t reinits;  ///< Re-initializations that succeeded
+    uint32_t reinitFailures;  ///< Re-initializations that failed
+private:
+    uint8_t _failsToReinit;  ///< Failed reads in a row before re-initializing
+    uint32_t _retryMicros;  ///< [us] Time between re-initialization attempts
+    uint64_t _nextReinitMicros;  ///< [us] Micros64() of the earliest next attempt
+    uint64_t _readyMicros;  ///< [us] Micros64() when a pending re-initialization can continue
+    bool _reinitPending;  ///< True between ReinitWait() and ReinitDone()
+};
@@ -0,0 +1,122 @@
+// ----------------------------------------------------------------------------
+// SEQLOCK SNAPSHOTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Consistent copies of a sensor system's outputs, published by one writer
+ * and read by any number of readers without locks or disabling interrupts:
+ *
+ *     SeqLock<INSOutput_t> Outputs;      // Sensor system
+ *     Outputs.Write(out);                // End of Update()
+ *
+ *     INSOutput_t ins;                   // Telemetry, logging, controller
+ *     if (INS.Outputs.Read(&ins)) ...
+ *
+ * The sequence counter is odd while a write is in progress. A reader copies
+ * the value between two reads of the counter and keeps the copy only if the
+ * counter was even and didn't change, so it never sees half of one update
+ * and half of the next. The value is stored as 32-bit relaxed atomics
+ * (plain loads/stores on the Cortex-M7), ordered by fences around the copy.
+ *
+ * The writer must never be interrupted by a reader of the same snapshot:
+ * update from the ISR or higher-priority task, read from the loop or lower
+ * priority. A reader only retries if a write lands during its copy, so
+ * Read() gives up after 'maxTries' rather than spin.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+
+constexpr uint8_t SEQLOCK_READ_TRIES = 4;  // Default attempts per Read() before giving up
+
+
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock values must be trivially copyable");
+
+public:
+    SeqLock() : _seq(0)
+    {
+        for (size_t i = 0; i < WORDS; i++)
+            this->_words[i].store(0, std::memory_order_relaxed);
+    }
+    SeqLock(const SeqLock &) = delete;
+    SeqLock &operator=(const SeqLock &) = delete;
+
+    /**
+     * Publish a new value. One writer only.
+     *
+     * @param value  Value to copy in.
+     */
+    void Write(const T &value)
+    {
+        uint32_t buf[WORDS];
+        uint32_t seq = this->_seq.load(std::memory_order_relaxed);
+
+        buf[WORDS - 1] = 0;  // Padding past the end of T
+        memcpy(buf, &value, sizeof(T));
+
+        this->_seq.store(seq + 1, std::memory_order_relaxed);  // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; i++)
+            this->_words[i].store(buf[i], std::memory_order_relaxed);
+        this->_seq.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * Copy the latest value.
+     *
+     * @param value     Output, the value. Unchanged if no consistent copy was
+     *                  made.
+     * @param maxTries  Attempts before giving up.
+     * @return  True if 'value' is a consistent copy of one Write().
+     */
+    bool Read(T *value, uint8_t maxTries = SEQLOCK_READ_TRIES) const
+    {
+        uint32_t buf[WORDS];
+        uint32_t seq;
+
+        if (value == nullptr)
+            return false;
+
+        for (uint8_t tries = 0; tries < maxTries; tries++)
+        {
+            seq = this->_seq.load(std::memory_order_acquire);
+            if (seq & 1)
+                continue;  // Write in progress
+
+            for (size_t i = 0; i < WORDS; i++)
+                buf[i] = this->_words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (this->_seq.load(std::memory_order_relaxed) == seq)
+            {
+                memcpy(value, buf, sizeof(T));
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /* Number of completed writes. A reader can tell a new value from the last one it read. */
+    uint32_t Version() const
+    {
+        return this->_seq.load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> _seq;  ///< Twice the completed writes, +1 while writing
+    std::atomic<uint32_t> _words[WORDS];  ///< Value, as 32-bit words
+};
@@ -0,0 +1,139 @@
+// ----------------------------------------------------------------------------
+// SINGLE-PRODUCER/SINGLE-CONSUMER RING BUFFER
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Wait-free ring buffer between one producer (a sensor driver's read, which
+ * may run from an interrupt or another task) and one consumer (the estimator
+ * loop). Neither side ever blocks or disables interrupts.
+ *
+ * The head and tail are free-running counters, each written by one side
+ * only. The producer copies an item into its slot, then publishes it with a
+ * release store of the head; the consumer's acquire load of the head
+ * guarantees it sees the whole item. The consumer copies the item out before
+ * its release store of the tail hands the slot back. So a slot is never
+ * written while it's being read, and items can't tear. On the Cortex-M7 the
+ * atomics are plain loads/stores with a DMB; on x86 the ordering is free.
+ *
+ * When the ring is full Push() refuses the new item rather than overwrite
+ * an unread one, and counts it in Overruns(). Size the ring for the longest
+ * loop overrun (see SENSOR_STREAM_DEPTH).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+
+template <typename T, uint32_t N>
+class SPSCRing
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "SPSCRing size must be a power of 2");
+
+public:
+    SPSCRing() : _head(0), _tail(0), _overruns(0) {}
+    SPSCRing(const SPSCRing &) = delete;
+    SPSCRing &operator=(const SPSCRing &) = delete;
+
+    /**
+     * Add an item. Producer only.
+     *
+     * @param item  Item to copy in.
+     * @return  True if added, false if the ring is full (counted in Overruns()).
+     */
+    bool Push(const T &item)
+    {
+        uint32_t head = this->_head.load(std::memory_order_relaxed);
+
+        if (head - this->_tail.load(std::memory_order_acquire) >= N)
+        {
+            this->_overruns.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        this->_items[head & (N - 1)] = item;
+        this->_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Remove the oldest item. Consumer only.
+     *
+     * @param item  Output, the item. Unchanged if the ring is empty.
+     * @return  True if an item was removed.
+     */
+    bool Pop(T *item)
+    {
+        return this->PopBatch(item, 1) == 1;
+    }
+
+    /**
+     * Remove up to 'maxItems' of the oldest items, oldest first, with one
+     * acquire of the head and one release of the tail. Consumer only.
+     *
+     * @param items     Output buffer.
+     * @param maxItems  Size of the buffer. The rest stay for the next call.
+     * @return  Number of items removed.
+     */
+    size_t PopBatch(T *items, size_t maxItems)
+    {
+        uint32_t tail = this->_tail.load(std::memory_order_relaxed);
+        uint32_t n = this->_head.load(std::memory_order_acquire) - tail;
+
+        if (items == nullptr)
+            return 0;
+        if (n > maxItems)
+            n = (uint32_t)maxItems;
+
+        for (uint32_t i = 0; i < n; i++)
+            items[i] = this->_items[(tail + i) & (N - 1)];
+
+        this->_tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    /* Items waiting. Exact from the consumer, a lower bound from the producer. */
+    uint32_t Available() const
+    {
+        return this->_head.load(std::memory_order_acquire) - this->_tail.load(std::memory_order_acquire);
+    }
+
+    /* Drop every waiting item. Consumer only. */
+    void Clear()
+    {
+        this->_tail.store(this->_head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    /* Items refused because the ring was full */
+    uint32_t Overruns() const
+    {
+        return this->_overruns.load(std::memory_order_relaxed);
+    }
+
+    static constexpr uint32_t Capacity() { return N; }
+
+private:
+    T _items[N];  ///< Slots, indexed by counter mod N
+    std::atomic<uint32_t> _head;  ///< Items ever pushed. Only the producer changes it.
+    std::atomic<uint32_t> _tail;  ///< Items ever popped. Only the consumer changes it.
+    std::atomic<uint32_t> _overruns;  ///< Items refused because the ring was full
+};
+
+
+/**
+ * Sensor sample streams. Drivers publish every sample they read as raw
+ * counts and a timestamp (the sensor systems convert with counts_to_si.h).
+ */
+constexpr uint32_t SENSOR_STREAM_DEPTH = 64;  // Samples per stream. Power of 2. 80ms of 800Hz gyro, two full FIFOs.
+
+typedef struct
+{
+    uint64_t micros;  // [us] Micros64() when the sample was taken (group delay removed)
+    int16_t raw[3];  // [LSB] Raw counts [x, y, z]
+} SensorSample_t;
+
+typedef SPSCRing<SensorSample_t, SENSOR_STREAM_DEPTH> SensorStream;
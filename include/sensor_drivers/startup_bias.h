@@ -0,0 +1,71 @@
+// ----------------------------------------------------------------------------
+// STARTUP BIAS ESTIMATOR
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Non-blocking turn-on bias measurement. Instead of averaging in a busy
+ * loop, the estimator is fed each gyro and accelerometer sample as the
+ * sensor system processes it, and keeps a Welford running mean and variance
+ * of each (maths/running_stats.h):
+ *
+ *     MEASURING --(still, mean converged)--> DONE
+ *         ^  |
+ *         +--+ (moved: start over)
+ *
+ * A sample that strays from its running mean by more than
+ * BIAS_EST_GYRO_DEV/BIAS_EST_ACCEL_DEV means the vehicle moved, and the
+ * measurement starts over. It's done once it has been still for
+ * BIAS_EST_MIN_US and the standard error of every mean is within
+ * BIAS_EST_GYRO_SEM/BIAS_EST_ACCEL_SEM, or after BIAS_EST_MAX_US still
+ * (the old fixed averaging time) if the sensor is noisier than that.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "maths/running_stats.h"
+
+
+constexpr uint32_t BIAS_EST_MIN_SAMPLES = 50;  // Min. samples of each sensor
+constexpr uint32_t BIAS_EST_MIN_US = 200000;  // [us] Min. still time, so slow motion shows up
+constexpr uint32_t BIAS_EST_MAX_US = 1000000;  // [us] Still time after which the means are taken regardless of convergence
+constexpr float BIAS_EST_GYRO_SEM = 0.0005f;  // [rad/s] Gyro mean standard error when converged, per axis (~0.03dps)
+constexpr float BIAS_EST_ACCEL_SEM = 0.005f;  // [m/s/s] Accel. mean standard error when converged, per axis
+constexpr float BIAS_EST_GYRO_DEV = 0.05f;  // [rad/s] Gyro deviation from the running mean that counts as motion
+constexpr float BIAS_EST_ACCEL_DEV = 0.5f;  // [m/s/s] Accel. deviation from the running mean that counts as motion
+
+
+/**
+ * Estimator state
+ */
+typedef enum
+{
+    BIAS_EST_IDLE,  // Not started
+    BIAS_EST_MEASURING,  // Averaging, starts over on motion
+    BIAS_EST_DONE  // Means are ready
+} BiasEstState_t;
+
+
+class StartupBiasEstimator
+{
+public:
+    StartupBiasEstimator();
+    void Start(bool measureGyro = true);
+    void AddGyro(const float gyro[3], uint64_t micros);
+    void AddAccel(const float accel[3], uint64_t micros);
+    bool IsDone() const;
+
+    BiasEstState_t state;  ///< Current state
+    RunningStats3 gyro;  ///< [rad/s] Gyro statistics over the current still window
+    RunningStats3 accel;  ///< [m/s/s] Accel. statistics over the current still window
+    uint32_t restarts;  ///< Times motion restarted the measurement
+    bool measureGyro;  ///< False if the gyro bias is already known (only the accel. is measured)
+private:
+    void _Restart(uint64_t micros);
+    void _CheckDone(uint64_t micros);
+
+    uint64_t _startMicros;  ///< [us] First sample of the current still window
+    bool _windowStarted;  ///< True once the current window has a sample
+};
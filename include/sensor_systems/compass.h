@@ -12,8 +12,8 @@
 #pragma once
 
 
-#include <Arduino.h>
-#include <Wire.h>
+#include "hal/hal_platform.h"
+#include "hal/i2c_bus.h"
 #include <math.h>
 #include "hummingbird_config.h"
 #include "sensor_drivers/lis3mdl_magnetometer.h"
@@ -21,6 +21,9 @@
 #include "constants.h"
 #include "maths/math_functs.h"
 #include "sensor_drivers/sensor_calib_params.h"
+#include "sensor_drivers/counts_to_si.h"
+#include "sensor_drivers/sensor_health.h"
+#include "sensor_drivers/seqlock.h"
 
 
 #if defined(DEBUG) && defined(DEBUG_PORT)
@@ -31,6 +34,19 @@
 
 /* CONFIGURATION PARAMETERS */
 constexpr LIS3MDL_MeasRange_t MAGCOMPASS_RANGE  = LIS3MDL_RANGE_4G;  // Magnetometer measurement range
+constexpr LIS3MDL_ODR_t MAGCOMPASS_ODR = LIS3MDL_ODR_155HZ;  // Magnetometer ODR, up to LIS3MDL_ODR_1000HZ (noisier)
+constexpr uint8_t MAGCOMPASS_REINIT_AFTER_FAILS = 3;  // Failed reads in a row before the magnetometer is re-initialized
+constexpr uint32_t MAGCOMPASS_REINIT_RETRY_US = 50000;  // [us] Time between re-initialization attempts while it's down
+
+/**
+ * Magnetometer temperature compensation (sensor axes, [uT]), applied in the 
+ * driver before the calibration below. Fill in from a thermal calibration 
+ * run, sorted by temperature; a single identity entry leaves readings as-is.
+ */
+constexpr LIS3MDLTempComp_t MAGCOMPASS_TEMPCOMP[] = {
+    {25.0f, {0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}}
+};
+constexpr uint8_t MAGCOMPASS_TEMPCOMP_LEN = sizeof(MAGCOMPASS_TEMPCOMP) / sizeof(MAGCOMPASS_TEMPCOMP[0]);
 
 /**
  * Decide whether or not to rotate magnetometer measurements.
@@ -39,11 +55,34 @@ constexpr LIS3MDL_MeasRange_t MAGCOMPASS_RANGE  = LIS3MDL_RANGE_4G;  // Magnetom
  */
 // #define MAGCOMPASS_DO_NOT_ROTATE
 
+#ifdef MAGCOMPASS_DO_NOT_ROTATE
+constexpr SensorAxes_t MAGCOMPASS_AXES = SENSOR_AXES_IDENTITY;
+#else
+/* Body [x, y, z] = sensor [-y, -x, -z] */
+constexpr SensorAxes_t MAGCOMPASS_AXES = {{{0.0f, -1.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}}};
+#endif
+
+/* Counts to [uT] conversions (counts_to_si.h): rotated, and rotated + calibrated */
+static_assert(LIS3MDLSensitivity(MAGCOMPASS_RANGE) > 0.0f, "Unknown compass range");
+constexpr CountsToSI_t MAGCOMPASS_CVT_RAW = MakeCountsToSI(LIS3MDLSensitivity(MAGCOMPASS_RANGE), 1.0f, SENSOR_CALIB_NONE, MAGCOMPASS_AXES);
+constexpr CountsToSI_t MAGCOMPASS_CVT = MakeCountsToSI(LIS3MDLSensitivity(MAGCOMPASS_RANGE), 1.0f, SENSCALIB_MAG, MAGCOMPASS_AXES);
+
+
+/**
+ * Compass outputs from one Update(), read as a whole through Compass.Outputs.
+ */
+typedef struct
+{
+    float mag[3];  // [uT] Magnetometer, body frame, calibrated (Mag)
+    float magRaw[3];  // [uT] Magnetometer, body frame, uncalibrated (MagRaw)
+    uint64_t magMicros;  // [us] Micros64() when the sample was taken
+} MagCompassOutput_t;
+
 
 class MagCompass
 {
 public:
-    MagCompass(TwoWire *userWire = &SENSOR_I2C);
+    MagCompass(I2CBus *bus = SensorI2CBus());
     ~MagCompass();
     
     // Do not allow copies
@@ -55,16 +94,18 @@ public:
     bool Update();
     float GetHeading(Vectorf AccelMeas);
 
-    uint32_t prevUpdateMicros;  // [us] Previous update micros()
+    uint64_t prevUpdateMicros;  // [us] Previous update Micros64()
+    uint64_t magMicros;  // [us] Micros64() when the sample in Mag was taken
     Vectorf Mag;     // [mx, my, mz], [uT] Magnetometer readings (calibrated)
     Vectorf MagRaw;  // [mx, my, mz], [uT] Raw, uncalibrated readings
+    SensorHealth MagHealth;  // Magnetometer read failures, data age and re-initializations
+    SeqLock<MagCompassOutput_t> Outputs;  // Consistent copy of Mag, MagRaw and magMicros, published on each new sample
 
 protected:
 private:
     float heading;  // [rad], [0, 2pi) Tilt-compensated magnetic heading
     LIS3MDL_Mag MagSensor;
     LIS3MDL_MeasRange_t magMeasRange;
-    TwoWire *SensorWire;
 };
 
 // Only one instance of MagCompass
@@ -12,8 +12,8 @@
 
 
 
-#include <Arduino.h>
-#include <Wire.h>
+#include "hal/hal_platform.h"
+#include "hal/i2c_bus.h"
 #include "hummingbird_config.h"
 #include "maths/vectors.h"
 #include "TinyGPS++.h"
@@ -44,8 +44,31 @@ constexpr uint32_t GNSS_MIN_SATS = 5;
 /* I2C address of the UBLOX GPS module */
 constexpr uint8_t GNSS_I2C_ADDR = 0x42;
 
-/* I2C buffer size of the device. 32 bytes for Arduino Nano and Teensy 4.1 */
-constexpr uint16_t GNSS_I2C_BUFFSIZE = 32;
+/* Max. bytes per I2C read of the GPS stream (bus transfer limit) */
+constexpr uint16_t GNSS_I2C_BUFFSIZE = I2C_BUS_MAX_TRANSFER;
+
+/* [ms] Max. wait for the receiver to answer on the bus after power-up */
+constexpr uint32_t GNSS_BOOT_TIMEOUT_MS = 1000;
+
+/**
+ * [ms] Max. wait for the UBX-ACK of a CFG message. The receiver answers 
+ * within a second, usually within a few ms.
+ */
+constexpr uint32_t GNSS_ACK_TIMEOUT_MS = 1000;
+
+/* [ms] Polling period while waiting for the receiver to boot or acknowledge */
+constexpr uint32_t GNSS_ACK_POLL_MS = 2;
+
+/* Times a CFG message is sent before giving up */
+constexpr uint8_t GNSS_CFG_TRIES = 2;
+
+/**
+ * Bytes per ListenForData() call when the GPS shares its bus with the IMU 
+ * (I2CBusScheduler job budget). 64 bytes is ~1.5ms at 400kHz, short enough 
+ * to fit between 400Hz IMU reads; at 10Hz NMEA output it still drains 
+ * several kB/s.
+ */
+constexpr uint16_t GNSS_I2C_DRAIN_BYTES = 64;
 
 
 /* Possible baud rates for the GNSS sensor */
@@ -90,6 +113,15 @@ typedef enum
 } GNSSNavRate_t;
 
 
+/* Reply to a UBX CFG message */
+typedef enum
+{
+    GNSS_ACK_NONE,  // No reply (yet)
+    GNSS_ACK_ACK,   // UBX-ACK-ACK: message accepted
+    GNSS_ACK_NAK    // UBX-ACK-NAK: message rejected
+} GNSSAck_t;
+
+
 /* GPS status types */
 typedef enum
 {
@@ -105,7 +137,7 @@ typedef enum
 class GNSSComputer
 {
 public:
-    GNSSComputer(TwoWire *userWire = &GPS_I2C);
+    GNSSComputer(I2CBus *bus = GPSI2CBus());
     ~GNSSComputer() {};
 
     // Do not allow copies (singleton)
@@ -119,7 +151,7 @@ public:
         GNSSNavRate_t userODR       = GNSS_NAVRATE_10HZ
         );
     bool WaitForSatellites(uint32_t nSats = GNSS_MIN_SATS);
-    bool ListenForData();
+    bool ListenForData(uint16_t maxBytes = 0xFFFF);
 
     TinyGPSPlus NMEAParser;          // TinyGPS++ GPS object
     // TinyGPSCustom PDOPParser;  // Parse GxGSA for PDOP
@@ -152,13 +184,23 @@ private:
     Vectord PosLLA;     // [rad, rad, m] Lat, lon, altitude
     Vectorf PosECEF;    // [m, m, m] ECEF position
     Vectorf VelECEF;    // [m/s, m/s, m/s] ECEF velocity
-    void SendUBXConfigMessage(const uint8_t *msg, size_t len);
+    bool SendUBXConfigMessage(const uint8_t *msg, size_t len);
+    bool WaitForAck(uint8_t msgClass, uint8_t msgId, uint32_t timeoutMs);
+    void ParseUBXAck(uint8_t b);
     // LPF for smoothing gps pos (to smooth out impulses/sharp changes)
     // LPF for smoothing altitude
 private:
     bool isConfigured;  // True if ConfigureDevice() was called, false if not
     uint32_t lastDataCheck;  // [ms] millis() of when last checked for new data.
     uint32_t dataPollWait;  // [ms] Period between polling for new data. 
+    uint16_t streamBytesLeft;  // Bytes the GPS still had queued after the last (budget-limited) read
+    uint8_t ubxState;  // UBX-ACK parser: position in the frame
+    uint8_t ubxFrame[6];  // UBX-ACK parser: class, ID, length, payload (class, ID of the acknowledged message)
+    uint8_t ubxCkA;  // UBX-ACK parser: running checksum A
+    uint8_t ubxCkB;  // UBX-ACK parser: running checksum B
+    uint8_t ackClass;  // Class of the message in the last UBX-ACK
+    uint8_t ackId;  // ID of the message in the last UBX-ACK
+    GNSSAck_t ackStatus;  // Last UBX-ACK, GNSS_ACK_NONE since the last CFG message was sent
     int32_t gpsBaud;  // Baud rate for serial connection
     float navTs;  // [sec] GPS navigation sample period
     float navRate;  // [Hz] GPS navigation rate
@@ -168,7 +210,7 @@ private:
     GNSSNetworks_t network;         // Satellite network(s) that the GPS is connected to
     GNSSDynamics_t dynamicModel;    // Dynamic model for the GPS fusion algorithms
     GNSSNavRate_t updateRate;       // [Hz] navigation rate from gps
-    TwoWire *gpsWire;      // HW I2C bus that the GPS is connected to
+    I2CBus *gpsBus;      // I2C bus that the GPS is connected to
 };
 
 // Only one instance
@@ -24,7 +24,17 @@
 #include "sensor_drivers/fxas21002_gyro.h"
 #include "sensor_drivers/fxos8700_accelmag.h"
 #include "sensor_drivers/sensor_calib_params.h"
-#include "filters/low_pass_filter.h"
+#include "sensor_drivers/counts_to_si.h"
+#include "sensor_drivers/sensor_health.h"
+#include "sensor_drivers/gyro_temp_bias.h"
+#include "sensor_drivers/startup_bias.h"
+#include "sensor_drivers/seqlock.h"
+#include "sensor_drivers/async_i2c.h"
+#include "hal/nv_storage.h"
+#include "maths/math_functs.h"
+#include "filters/vec3_filter.h"
+#include "filters/tilt_filter.h"
+#include "filters/filter_design.h"
 
 
 #ifdef DEBUG
@@ -32,15 +42,65 @@
 #endif
 
 /* Filters */
-constexpr float INS_ACCEL_LPF_SF = 0.95f;  // Smoothing factor (alpha) of accelerometer low-pass filter, [0, 1]
+constexpr float INS_ACCEL_FS = 200.0f;  // [Hz] Accelerometer sample rate (hybrid mode ODR)
+constexpr float INS_ACCEL_LPF_FC = 25.0f;  // [Hz] Accelerometer low-pass filter cutoff frequency. Above flight dynamics, below motor vibration (~4ms delay).
+constexpr float INS_ACCEL_LPF_SF = DesignEMAAlpha(INS_ACCEL_FS, INS_ACCEL_LPF_FC);  // Smoothing factor (alpha) of accelerometer low-pass filter, [0, 1]
+static_assert(EMAAlphaIsValid(INS_ACCEL_LPF_SF), "INS accel. LPF cutoff must be in (0, fs/2)");
 // constexpr float INS_GYRO_LPF_SF = 0.98f;  // Gyro low pass filter smoothing factor [0, 1]
 
-/* Turn-on biases */
-constexpr uint32_t INS_BIAS_INIT_TIME = 1000;  // [millisec] Amount of time taken to determine accel. and gyro turn-on bias
+/* Vertical acceleration (tilt_filter.h) */
+constexpr float INS_TILT_TAU = 2.0f;  // [s] Time constant of the accel. correction of the gyro-propagated tilt
+constexpr float INS_TILT_MAX_DT = 0.1f;  // [s] Longest sample gap the tilt is propagated/corrected across
+
+/* Gyro temperature bias table (gyro_temp_bias.h) */
+constexpr uint32_t INS_GYRO_TEMP_PERIOD_US = 1000000;  // [us] Gyro die temperature read period
+constexpr float INS_TBIAS_SKIP_INIT_WEIGHT = 500.0f;  // [samples] Stored bias weight at the turn-on temperature that skips the turn-on gyro bias measurement
+constexpr uint32_t INS_TBIAS_SAVE_PERIOD_US = 600000000;  // [us] Min. time between saves of the bias table (flash wear)
+constexpr uint32_t INS_TBIAS_SAVE_MIN_LEARNED = 1000;  // Learned samples before the bias table is saved again
+
+/* Stationary detection, for learning gyro bias */
+constexpr float INS_STILL_GYRO_DEV = 0.03f;  // [rad/s] Max. gyro deviation from its recent mean, per axis
+constexpr float INS_STILL_GYRO_RATE = 0.03f;  // [rad/s] Max. bias-compensated rate, per axis (once the turn-on bias is set)
+constexpr float INS_STILL_ACCEL_DEV = 0.3f;  // [m/s/s] Max. accel. deviation from its recent mean, per axis
+constexpr float INS_STILL_MEAN_SF = 0.02f;  // Smoothing factor (alpha) of the recent means
+constexpr uint32_t INS_STILL_TIME_US = 1000000;  // [us] Time still before gyro samples are learned
+
+/* Sample streams (spsc_ring.h) */
+constexpr uint8_t INS_STREAM_BATCH = 16;  // Samples drained from a sensor stream per batch
+
+/* Sensor dropouts */
+constexpr uint8_t INS_REINIT_AFTER_FAILS = 3;  // Failed reads in a row before a sensor is re-initialized
+constexpr uint32_t INS_REINIT_RETRY_US = 50000;  // [us] Time between re-initialization attempts while a sensor is down
 
 /* Measurement ranges */
 constexpr GyroRanges_t INS_GYRO_RANGE = GYRO_RNG_1000DPS;  // Gyro measurement range
 constexpr AccelRanges_t INS_ACCEL_RANGE = ACCEL_RNG_4G;  // Accelerometer measurement range
+static_assert(GyroSensitivity(INS_GYRO_RANGE) > 0.0f, "Unknown INS gyro range");
+static_assert(AccelSensitivity(INS_ACCEL_RANGE) > 0.0f, "Unknown INS accel. range");
+
+/* Counts to SI conversions (counts_to_si.h). Accel. is in g's, scaled by local gravity at runtime. */
+constexpr CountsToSI_t INS_GYRO_CVT = MakeCountsToSI(GyroSensitivity(INS_GYRO_RANGE), DEG2RAD);  // [LSB] -> [rad/s]
+constexpr CountsToSI_t INS_ACCEL_CVT_G = MakeCountsToSI(AccelSensitivity(INS_ACCEL_RANGE), 1.0f, SENSCALIB_ACCEL);  // [LSB] -> calibrated [g's]
+constexpr CountsToSI_t INS_GYRO_CVT_RAW = MakeCountsToSI(GyroSensitivity(INS_GYRO_RANGE), 1.0f);  // [LSB] -> [deg/s], GetGyroRaw()
+constexpr CountsToSI_t INS_ACCEL_CVT_RAW = MakeCountsToSI(AccelSensitivity(INS_ACCEL_RANGE), 1.0f);  // [LSB] -> [g's], GetAccelRaw()
+
+
+/**
+ * INS outputs from one Update(), read as a whole through INS.Outputs.
+ */
+typedef struct
+{
+    float gyro[3];  // [rad/s] Gyro, bias removed (Gyro)
+    float gyroBias[3];  // [rad/s] Gyro bias removed (GyroBias)
+    float accel[3];  // [m/s/s] Accelerometer, filtered (Accel)
+    float roll;  // [rad] Accelerometer roll angle (NED)
+    float pitch;  // [rad] Accelerometer pitch angle (NED)
+    float gyroTempC;  // [C] Gyro die temperature
+    uint64_t gyroMicros;  // [us] Micros64() when the gyro sample was taken
+    uint64_t accelMicros;  // [us] Micros64() when the accel. sample was taken
+    bool isStill;  // True if the vehicle has been still for INS_STILL_TIME_US
+    bool biasReady;  // True once the turn-on biases are measured (IsBiasReady())
+} INSOutput_t;
 
 
 // ----------------------------------------------------------------------------
@@ -67,28 +127,65 @@ public:
     bool Update();
     float GetAccelPitch();
     float GetAccelRoll();
+    float GetVertAccel();
+    void GetGyroRaw(float gyroRaw[3]);
+    void GetAccelRaw(float accelRaw[3]);
+    uint32_t GetStreamOverruns();
+    bool IsBiasReady();
+    bool SaveBiasTable();
     
-    Vectorf Gyro;        // [rad/s], [gx, gy, gz] Gyro measurements (filtered) 
-    Vectorf GyroRaw;     // [deg/s], [gx, gy, gz] Raw gyro measurements
-    Vectorf GyroTOBias;  // [rad/s], [bgx, bgy, bgz] Measured gyro turn-on biases
+    Vectorf Gyro;        // [rad/s], [gx, gy, gz] Gyro measurements (temperature-compensated bias removed)
+    Vectorf GyroTOBias;  // [rad/s], [bgx, bgy, bgz] Gyro turn-on biases (measured, or from the stored bias table)
+    Vectorf GyroBias;    // [rad/s], [bgx, bgy, bgz] Gyro bias removed from Gyro, at gyroTempC
     Vectorf Accel;       // [m/s/s], [ax, ay, az] Accelerometer measurements (filtered)
-    Vectorf AccelRaw;    // [g's], [ax, ay, az] Raw accelerometer measurements
     Vectorf AccelTOBias; // [m/s/s], [bax, bay, baz] Measured accelerometer turn-on biases
-    uint32_t prevUpdateMicros;  // [us] Previous INS update micros()
+    StartupBiasEstimator BiasEstimator;  // Turn-on bias measurement, fed by Update()
+    uint64_t prevUpdateMicros;  // [us] Previous INS update Micros64()
+    uint64_t gyroMicros;  // [us] Micros64() when the gyro sample in Gyro was taken
+    uint64_t accelMicros;  // [us] Micros64() when the accel. sample in Accel was taken
+    SensorHealth GyroHealth;  // Gyro read failures, data age and re-initializations
+    SensorHealth AccelHealth;  // Accelerometer read failures, data age and re-initializations
+    GyroTempBias GyroBiasTable;  // Gyro bias vs. temperature, learned while still, kept in NV storage
+    float gyroTempC;  // [C] Gyro die temperature
+    bool isStill;  // True if the vehicle has been still for INS_STILL_TIME_US
+    SeqLock<INSOutput_t> Outputs;  // Consistent copy of the outputs above, published at the end of each Update()
 protected:
 private:
     void UpdateAccelAngles();
-    bool MeasureInitGyroBiases(uint32_t samplePeriod);
-    bool MeasureInitAccelBiases(uint32_t samplePeriod);
+    void PublishOutputs();
+    void ProcessGyroSample(const SensorSample_t &sample);
+    void ProcessAccelSample(const SensorSample_t &sample);
+    void UpdateGyroTemp();
+    void UpdateGyroBias(const float gyroMeas[3], uint64_t micros);
+    bool UpdateStillness(const float gyroMeas[3], uint64_t micros);
+    bool GyroReadDone(bool readOk);
+    void ReinitGyro(bool start);
+    void ReinitAccel(bool start);
+    void SetTurnOnBiases();
 
     float roll;     // [rad] Accelerometer roll angle (NED)
     float pitch;    // [rad] Accelerometer pitch angle (NED)
+    int16_t gyroCounts[3];  // [LSB] Raw counts of the sample in Gyro, for GetGyroRaw()
+    int16_t accelCounts[3];  // [LSB] Raw counts of the sample in Accel, for GetAccelRaw()
     
     FXOS8700AccelMag AccelMagSensor;  // Accelerometer/magnetometer sensor class
     FXAS21002Gyro GyroSensor;  // Gyroscope sensor class
-    LowPassFilter AxLPF;  // Ax data filter
-    LowPassFilter AyLPF;  // Ay data filter
-    LowPassFilter AzLPF;  // Az data filter
+    AsyncI2C *asyncI2C;  // Async engine the gyro is read through, nullptr to read it blocking
+    bool gyroReadSubmitted;  // True while a gyro read queued on asyncI2C hasn't been collected
+    Vec3LowPassFilter AccelLPF;  // [ax, ay, az] Accelerometer data filter
+    bool accelLPFInit;  // True once AccelLPF is reset to the first accel. sample
+    TiltFilter Tilt;  // Gyro-propagated "up" in body axes, for GetVertAccel()
+    bool tiltInit;  // True once Tilt is aligned with an accel. sample
+    CountsToSI_t accelCvt;  // [LSB] -> calibrated [m/s/s], INS_ACCEL_CVT_G scaled by accelCvtGrav
+    float accelCvtGrav;  // [m/s/s] Gravity accelCvt was scaled with
+    bool gyroTOBiasValid;  // True once GyroTOBias is measured or loaded
+    bool biasReady;  // True once BiasEstimator finished and the turn-on biases are set
+    uint64_t gyroTempMicros;  // [us] Micros64() of the next gyro temperature read
+    uint64_t tbiasSaveMicros;  // [us] Micros64() of the last bias table save
+    uint64_t stillSinceMicros;  // [us] Timestamp of the last gyro sample the vehicle was moving in
+    float gyroMean[3];  // [rad/s] Recent mean gyro measurement (uncompensated), for stationary detection
+    float accelMean[3];  // [m/s/s] Recent mean accel. measurement, for stationary detection
+    bool stillMeansInit;  // True once gyroMean/accelMean are seeded
 };
 
 
@@ -14,10 +14,11 @@
 constexpr size_t UBX_CFG_PRTLEN = 28;  // Length of baud rate messages
 
 
-// UBX CFG message to set I2C poort to UBX+NMEA+RTCM2 in, NMEA out
+// UBX CFG message to set I2C poort to UBX+NMEA+RTCM2 in, UBX+NMEA out. UBX
+// out carries the UBX-ACK replies to the CFG messages that follow.
 constexpr uint8_t UBX_CFG_PRT_I2C[UBX_CFG_PRTLEN] = {
     0xB5,0x62,0x06,0x00,0x14,0x00,0x00,0x00,0x00,0x00,0x84,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x07,0x00,0x02,0x00,0x00,0x00,0x00,0x00,0xA7,0xCC
+    0x00,0x00,0x00,0x07,0x00,0x03,0x00,0x00,0x00,0x00,0x00,0xA8,0xD2
 };
 
 
@@ -6,13 +6,12 @@
 // ----------------------------------------------------------------------------
 /**
  * This class encompasses all functions to create a barometric altimeter for 
- * the drone, based on Adafruit's BMP388 sensor library. This class is 
- * responsible for:
+ * the drone, based on the BMP388 driver. This class is responsible for:
  * - Initializing the sensor
  * - Reading pressure and temperature
  * - Filtering raw measurements
  * - Computing change in altitude from T/O location
- * - Computing vertical speed
+ * - Computing vertical speed (Kalman filter)
  */
 
 
@@ -23,8 +22,13 @@
 
 
 
-BaroAltimeter::BaroAltimeter()
-: _PresFastFilter(7, 101325.0f)
+/**
+ * Create the altimeter.
+ * 
+ * @param bus  I2C bus the BMP388 is on.
+ */
+BaroAltimeter::BaroAltimeter(I2CBus *bus)
+    : _Sensor(bus)
 {
     // Set default values for variables or zero them
     this->isConnected = false;
@@ -41,29 +45,33 @@ BaroAltimeter::BaroAltimeter()
     this->_groundAltMSL = 280.0f;
     this->_mslPres = 101325.0f;
     this->_vertSpeed = 0.0f;
-    this->_lastMeasMillis = 0;
-    this->_currMeasMillis = 0;
-
-    // this->_PresFastFilter.SetWindowWidth(7);
-    this->_TempSlowFilter.SetSmoothingFactor(0.1f);
-    this->_PresSlowFilter.SetSmoothingFactor(.015f);
+    this->_vertAccel = 0.0f;
+    this->_hasVertAccel = false;
+    this->_lastMeasMicros = 0;
+    this->_currMeasMicros = 0;
+
+    this->_PresOutlierFilter.SetThreshold(BARO_ALTIMETER_HAMPEL_NSIGMA, BARO_ALTIMETER_PRES_HAMPEL_MIN_DEV);
+    this->_TempOutlierFilter.SetThreshold(BARO_ALTIMETER_HAMPEL_NSIGMA, BARO_ALTIMETER_TEMP_HAMPEL_MIN_DEV);
+    this->_PresOutlierFilter.Fill(101325.0f);
+    this->_TempOutlierFilter.Fill(15.0f);
+    this->_PresFilter.Stage<0>().SetCutoffFrequency(BARO_ALTIMETER_PRES_LPF_FC, BARO_ALTIMETER_NOMINAL_DT, BARO_ALTIMETER_PRES_LPF_ALPHA);
+    this->_TempFilter.Stage<0>().SetCutoffFrequency(BARO_ALTIMETER_TEMP_LPF_FC, BARO_ALTIMETER_NOMINAL_DT, BARO_ALTIMETER_TEMP_LPF_ALPHA);
 }
 
 
 // ----------------------------------------------------------------------------
-// ConnectToSensor(TwoWire *userWire)
+// ConnectToSensor()
 // ----------------------------------------------------------------------------
 /**
- * Attempt to connect to the BMP388 pressure/temperature sensor by running 
- * Adafruit's BMP_3XX.begin() method. Returns false if it could't connect to 
- * the sensor.
+ * Attempt to connect to the BMP388 pressure/temperature sensor on the bus 
+ * given to the constructor and read its calibration. Returns false if it 
+ * could't connect to the sensor.
  *
- * @param userWire  I2C bus that the sensor is connected to. Default Wire2.
  * @return          True if success, false if not.
  */
-bool BaroAltimeter::ConnectToSensor(TwoWire *userWire)
+bool BaroAltimeter::ConnectToSensor()
 {
-    if (!this->begin((uint8_t)0x77, userWire))
+    if (!this->_Sensor.Connect())
     {
         // Sensor could not be initialized correctly
         #ifdef DEBUG
@@ -79,55 +87,40 @@ bool BaroAltimeter::ConnectToSensor(TwoWire *userWire)
 
 // ----------------------------------------------------------------------------
 // ConfigureSensorParams(
-//     uint8_t presOS, uint8_t tempOS,
-//     uint8_t iirCoef, uint8_t sensODR)
+//     BMP388OSR_t presOS, BMP388OSR_t tempOS,
+//     BMP388IIR_t iirCoef, BMP388ODR_t sensODR)
 // ----------------------------------------------------------------------------
 /**
- * Configure BMP388 oversampling, IIR filtering, and ODR. Refer to 
- * Adafruit_BMP_3XX.h for config. options
+ * Configure BMP388 oversampling, IIR filtering, and ODR, and start it 
+ * sampling into its FIFO. Refer to bmp388_barometer.h for config. options. 
+ * Up to 200Hz with 1x oversampling.
  * 
  * @param presOS    Pressure oversampling
  * @param tempSO    Temperature oversampling
  * @param iirCoef   Infinite impulse response (IIR) filter coef.
- * @param sensODR   Output data rate [Hz]
+ * @param sensODR   Output data rate
  * @return          True if successfully configured, false if not.
  */
 bool BaroAltimeter::ConfigureSensorParams(
-    uint8_t presOS, uint8_t tempOS,
-    uint8_t iirCoef, uint8_t sensODR)
+    BMP388OSR_t presOS, BMP388OSR_t tempOS,
+    BMP388IIR_t iirCoef, BMP388ODR_t sensODR)
 {
     // Check if we are connected to the sensor. Otherwise, connect to it
-    if (!this->isConnected)
-        this->ConnectToSensor(&Wire2);
-
-    if (!this->setTemperatureOversampling(tempOS))
-    {
-        #ifdef DEBUG
-            DEBUG_PORT.println("BARO_ALTIMETER ERROR: Could not set temp OS. Check settings.");
-        #endif
+    if (!this->isConnected && !this->ConnectToSensor())
         return false;
-    }
 
-    if (!this->setPressureOversampling(presOS))
+    if (!this->_Sensor.Initialize(presOS, tempOS, iirCoef, sensODR))
     {
         #ifdef DEBUG
-            DEBUG_PORT.println("BARO_ALTIMETER ERROR: Could not set pres OS. Check settings.");
+            DEBUG_PORT.println("BARO_ALTIMETER ERROR: Could not set OS, IIR filter coef. or ODR. Check settings.");
         #endif
         return false;
     }
 
-    if (!this->setIIRFilterCoeff(iirCoef))
+    if (!this->_Sensor.ConfigureFIFO())
     {
         #ifdef DEBUG
-            DEBUG_PORT.println("BARO_ALTIMETER ERROR: Could not set IIR filter coef. Check settings.");
-        #endif
-        return false;
-    }
-
-    if (!this->setOutputDataRate(sensODR))
-    {
-        #ifdef DEBUG
-            DEBUG_PORT.println("BARO_ALTIMETER ERROR: Could not set ODR. Check settings.");
+            DEBUG_PORT.println("BARO_ALTIMETER ERROR: Could not enable the sensor FIFO.");
         #endif
         return false;
     }
@@ -170,7 +163,7 @@ bool BaroAltimeter::Initialize()
     if (this->isConnected == false)
     {
         #ifdef DEBUG
-            DEBUG_PORT.println("BARO_ALTIMETER ERROR: Call ConnectToSensor() method before intializing. Using default Wire2...");
+            DEBUG_PORT.println("BARO_ALTIMETER ERROR: Call ConnectToSensor() method before intializing. Using the default bus...");
         #endif
         if (!this->ConnectToSensor())  // Use defaults in baro_altimeter.h
             return false;
@@ -205,6 +198,13 @@ bool BaroAltimeter::Initialize()
         return false;
     }
 
+    // Skip the readings buffered while measuring the ground values
+    this->_Sensor.FlushFIFO();
+
+    // Start the outlier filters at the ground values
+    this->_PresOutlierFilter.Fill(this->_groundPres);
+    this->_TempOutlierFilter.Fill(this->_groundTemp);
+
     // Set T/O Altitude MSL
     this->_SetTakeoffAltitude();
 
@@ -224,73 +224,35 @@ bool BaroAltimeter::Initialize()
 // ReadSensor()
 // ----------------------------------------------------------------------------
 /**
- * Read raw pressure and temperature data from BMP388.
+ * Drain the readings the BMP388 buffered since the last call (up to 
+ * BARO_ALTIMETER_FIFO_BATCH, oldest first) and run each through the filters. 
+ * The results are then published to Outputs, for readers that may be 
+ * interrupted by ReadSensor().
  * 
- * @return  True if a valid reading was done, false if not.
+ * @return  True if at least one new reading was processed, false if none 
+ *          were ready or the read failed.
  */
 bool BaroAltimeter::ReadSensor()
 {
-    float pfast;  // [Pa] "fast reacting" pressure reading from median filter
-    float pdiff;  // [Pa] Pressure difference
-    float presRatio;  // [Pa] ratio between current and MSL pressure. Used to compute altitude
+    BaroAltimeterOutput_t out;
+    size_t n;  // Readings drained from the FIFO
 
 
-    if (!this->performReading())
-    {
-        #ifdef DEBUG
-            DEBUG_PORT.println("BARO_ALTIMETER ERROR: Error reading sensor data.");
-        #endif
+    n = this->_Sensor.ReadFIFO(this->_fifoBuf, BARO_ALTIMETER_FIFO_BATCH);
+    if (n == 0)
         return false;
-    }
 
-    // Cvt. rom double to float
-    this->_pRaw = (float)this->pressure;
-    this->_tRaw = (float)this->temperature;
+    for (size_t i = 0; i < n; i++)
+        this->_ProcessReading(this->_fifoBuf[i]);
+    this->_hasVertAccel = false;
 
-    // Range checks on variables
-    if (this->_pRaw >= BARO_ALTIMETER_PRES_MAX || this->_pRaw <= BARO_ALTIMETER_PRES_MIN)
-    {
-        this->_pRaw = 101325.0f;
-        #ifdef DEBUG
-            DEBUG_PORT.println("BARO_ALTIMETER ERROR: Pressure reading out of allowable bounds.");
-        #endif
-    }
-
-    if (this->_tRaw >= BARO_ALTIMETER_TEMP_MAX || this->_tRaw <= BARO_ALTIMETER_TEMP_MIN)
-    {
-        this->_tRaw = 15.0f;
-        #ifdef DEBUG
-            DEBUG_PORT.println("BARO_ALTIMETER ERROR: Temperature reading out of allowable bounds.");
-        #endif
-    }
-
-    /* UPDATE PRESSURE AND TEMPERATURE */
-    this->_currMeasMillis = millis();
-
-    // Filter pressure and temperature measurements
-    // pfast = this->_PresFastFilter.Update(this->_pRaw);
-    this->_t = this->_TempSlowFilter.Filter(this->_tRaw);
-    this->_p = this->_PresSlowFilter.Filter(this->_pRaw);; //->_PresSlowFilter.FilterWithSF(pfast);
-
-    // Depending on pressure change, select the "slow reacting" pressure for when the drone is "stationary"
-    // or the "fast reacting" pressure when the drone changes altitude
-    // Method can be seen at: https://youtu.be/2BLb6qUKikI?t=667
-
-    /* UPDATE ALTITUDE */
-    // TODO: Check if altitude is negative?
-    presRatio = this->_p / this->_mslPres;
-    // this->_altMSL = 153.8462f * (this->_groundTemp + 273.15f) * (1.0f - expf(0.190259f * logf(presRatio)));
-    this->_altMSL = 44300.0f * (1.0f - powf(presRatio, 0.19f));
-    this->_alt = this->_altMSL - this->_groundAltMSL;  // Above ground
-
-    /* UPDATE VERTICAL SPEED */
-    // Backwards difference formula, for now
-    // TODO: Check for NaN or div. by zero error!
-    this->_vertSpeed = ((this->_altMSL - this->_lastAltMSL) * 1000.0f) / (this->_currMeasMillis - this->_lastMeasMillis);
-    
-    /* UPDATE "CHANGE" VARIABLES */
-    this->_lastAltMSL = this->_altMSL;
-    this->_lastMeasMillis = this->_currMeasMillis;
+    out.pressure = this->_p;
+    out.temperature = this->_t;
+    out.altitude = this->_alt;
+    out.altitudeMSL = this->_altMSL;
+    out.vertSpeed = this->_vertSpeed;
+    out.measMicros = this->_currMeasMicros;
+    this->Outputs.Write(out);
 
 
     #ifdef BARO_ALTIMETER_DEBUG
@@ -305,6 +267,24 @@ bool BaroAltimeter::ReadSensor()
 
 
 
+// ----------------------------------------------------------------------------
+// SetVertAccel(float vertAccel)
+// ----------------------------------------------------------------------------
+/**
+ * Give the altimeter the latest vertical acceleration (gravity removed, up is 
+ * positive), e.g. from InertialNavSystem::GetVertAccel(). It is used as the 
+ * Kalman filter's process input on the next ReadSensor(). If it isn't called 
+ * between readings, the filter falls back to a constant-velocity model.
+ * 
+ * @param vertAccel [m/s/s] Vertical acceleration, up is positive
+ */
+void BaroAltimeter::SetVertAccel(float vertAccel)
+{
+    this->_vertAccel = vertAccel;
+    this->_hasVertAccel = true;
+}
+
+
 /* Return "smoothed" atmospheric pressure in [Pa] */
 float BaroAltimeter::GetPressure()
 {
@@ -326,6 +306,27 @@ float BaroAltimeter::GetVertSpeed()
 }
 
 
+/* Return the number of pressure readings rejected as outliers */
+uint32_t BaroAltimeter::GetPresRejectCount()
+{
+    return this->_PresOutlierFilter.GetRejectCount();
+}
+
+
+/* Return the number of temperature readings rejected as outliers */
+uint32_t BaroAltimeter::GetTempRejectCount()
+{
+    return this->_TempOutlierFilter.GetRejectCount();
+}
+
+
+/* Return Micros64() when the latest reading was taken, IIR delay removed [us] */
+uint64_t BaroAltimeter::GetMeasMicros()
+{
+    return this->_currMeasMicros;
+}
+
+
 /* Return ground/takeoff pressure in [Pa] */
 float BaroAltimeter::GetGroundPres()
 {
@@ -391,6 +392,91 @@ bool BaroAltimeter::_SetTakeoffAltitude()
 }
 
 
+// ----------------------------------------------------------------------------
+// _ProcessReading(const BaroSample_t &sample)
+// ----------------------------------------------------------------------------
+/**
+ * Run one reading through the outlier filters, the LPF's, and the altitude 
+ * Kalman filter.
+ * 
+ * @param sample  Compensated reading, timestamped with the IIR delay removed.
+ */
+void BaroAltimeter::_ProcessReading(const BaroSample_t &sample)
+{
+    float presRatio;  // [Pa] ratio between current and MSL pressure. Used to compute altitude
+    float measAltMSL;  // [m] Altitude above MSL from this reading's (unfiltered) pressure
+    float dt;  // [s] Time since the last reading
+
+
+    this->_pRaw = sample.pressure;
+    this->_tRaw = sample.temperature;
+
+    // Range checks on variables. Out-of-range readings and spikes are 
+    // replaced with the median of the recent readings, so they don't step 
+    // the filters.
+    if (this->_pRaw >= BARO_ALTIMETER_PRES_MAX || this->_pRaw <= BARO_ALTIMETER_PRES_MIN)
+    {
+        this->_pRaw = this->_PresOutlierFilter.Reject();
+        #ifdef DEBUG
+            DEBUG_PORT.println("BARO_ALTIMETER ERROR: Pressure reading out of allowable bounds.");
+        #endif
+    }
+    else
+    {
+        this->_pRaw = this->_PresOutlierFilter.Filter(this->_pRaw);
+    }
+
+    if (this->_tRaw >= BARO_ALTIMETER_TEMP_MAX || this->_tRaw <= BARO_ALTIMETER_TEMP_MIN)
+    {
+        this->_tRaw = this->_TempOutlierFilter.Reject();
+        #ifdef DEBUG
+            DEBUG_PORT.println("BARO_ALTIMETER ERROR: Temperature reading out of allowable bounds.");
+        #endif
+    }
+    else
+    {
+        this->_tRaw = this->_TempOutlierFilter.Filter(this->_tRaw);
+    }
+
+    /* UPDATE PRESSURE AND TEMPERATURE */
+    // FIFO readings are timestamped from the ODR, less the IIR delay
+    this->_currMeasMicros = sample.micros;
+    dt = (float)(this->_currMeasMicros - this->_lastMeasMicros) * 1.0e-6f;
+
+    // Filter pressure and temperature measurements. The LPF's use the measured 
+    // dt so their cutoff frequencies hold when the loop timing jitters.
+    this->_t = this->_TempFilter.Filter(this->_tRaw, dt);
+    this->_p = this->_PresFilter.Filter(this->_pRaw, dt);
+
+    /* UPDATE ALTITUDE AND VERTICAL SPEED */
+    // The Kalman filter does the smoothing, so feed it the outlier-rejected 
+    // pressure altitude. The LPF'd pressure would only add lag.
+    // TODO: Check if altitude is negative?
+    presRatio = this->_pRaw / this->_mslPres;
+    // measAltMSL = 153.8462f * (this->_groundTemp + 273.15f) * (1.0f - expf(0.190259f * logf(presRatio)));
+    measAltMSL = 44300.0f * (1.0f - powf(presRatio, 0.19f));
+
+    if (!this->_AltFilter.isInitialized)
+    {
+        this->_AltFilter.Reset(measAltMSL);
+    }
+    else
+    {
+        // The latest vertical accel. applies to every reading in the batch
+        if (this->_hasVertAccel)
+            this->_AltFilter.Predict(dt, this->_vertAccel);
+        else
+            this->_AltFilter.Predict(dt);
+        this->_AltFilter.Correct(measAltMSL);
+    }
+
+    this->_altMSL = this->_AltFilter.GetAltitude();
+    this->_alt = this->_altMSL - this->_groundAltMSL;  // Above ground
+    this->_vertSpeed = this->_AltFilter.GetVertSpeed();
+    this->_lastMeasMicros = this->_currMeasMicros;
+}
+
+
 // ----------------------------------------------------------------------------
 // _ReadGroundPresTemp(uint8_t n, unsigned long measDelay)
 // ----------------------------------------------------------------------------
@@ -411,18 +497,18 @@ bool BaroAltimeter::_ReadGroundPresTemp(uint8_t n, unsigned long measDelay)
     // Take a few readings to "flush out bad data"
     for (i = 0; i < 5; i++)
     {
-        if (!this->performReading())
+        if (!this->_Sensor.ReadSensor())
             return false;
         delay(measDelay);
     }
     // Take 'n' measurements and compute the average
     for (i = 0; i < n; i++)
     {
-        if (!this->performReading())
+        if (!this->_Sensor.ReadSensor())
             return false;
 
-        this->_groundPres += (float)this->pressure;  // Adafruit returns double, cvt. to float
-        this->_groundTemp += (float)this->temperature;
+        this->_groundPres += this->_Sensor.GetPressure();
+        this->_groundTemp += this->_Sensor.GetTemperature();
         delay(measDelay);
     }
 
@@ -0,0 +1,221 @@
+// ----------------------------------------------------------------------------
+// ALTITUDE & VERTICAL SPEED KALMAN FILTER
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Three-state Kalman filter that estimates altitude, vertical speed (climb),
+ * and accelerometer bias from barometric altitude measurements.
+ */
+
+#include "filters/alt_kalman_filter.h"
+
+
+// ----------------------------------------------------------------------------
+// AltKalmanFilter()
+// ----------------------------------------------------------------------------
+/**
+ * Constructor for the altitude Kalman filter. Uses the default noise
+ * parameters. Call Reset() with the first altitude before using it.
+ */
+AltKalmanFilter::AltKalmanFilter()
+{
+    this->isInitialized = false;
+    this->SetNoise(ALTKF_BARO_STD, ALTKF_ACCEL_STD, ALTKF_MANEUVER_STD, ALTKF_BIAS_STD);
+    this->Reset(0.0f);
+    this->isInitialized = false;
+}
+
+
+// ----------------------------------------------------------------------------
+// SetNoise(float baroStd, float accelStd, float maneuverStd, float biasStd)
+// ----------------------------------------------------------------------------
+/**
+ * Set the filter's noise parameters (1-sigma values).
+ *
+ * @param baroStd       [m] Baro altitude measurement noise
+ * @param accelStd      [m/s/s] Accelerometer noise, used with an accel. input
+ * @param maneuverStd   [m/s/s] Unmodeled vertical accel., used without an accel. input
+ * @param biasStd       [m/s/s/sqrt(s)] Accelerometer bias random walk
+ */
+void AltKalmanFilter::SetNoise(float baroStd, float accelStd, float maneuverStd, float biasStd)
+{
+    this->_R = baroStd * baroStd;
+    this->_qAccel = accelStd * accelStd;
+    this->_qManeuver = maneuverStd * maneuverStd;
+    this->_qBias = biasStd * biasStd;
+}
+
+
+// ----------------------------------------------------------------------------
+// Reset(float alt, float vertSpeed)
+// ----------------------------------------------------------------------------
+/**
+ * Reset the filter to a known altitude and vertical speed.
+ *
+ * @param alt       [m] Altitude
+ * @param vertSpeed [m/s] Vertical speed, up is positive
+ */
+void AltKalmanFilter::Reset(float alt, float vertSpeed)
+{
+    size_t i, j;
+
+    this->_x[0] = alt;
+    this->_x[1] = vertSpeed;
+    this->_x[2] = 0.0f;
+
+    for (i = 0; i < 3; i++)
+        for (j = 0; j < 3; j++)
+            this->_P[i][j] = 0.0f;
+
+    this->_P[0][0] = this->_R;
+    this->_P[1][1] = 1.0f;
+    this->_P[2][2] = 0.25f;
+    this->isInitialized = true;
+}
+
+
+// ----------------------------------------------------------------------------
+// Predict(float dt)
+// ----------------------------------------------------------------------------
+/**
+ * Propagate the state without an accelerometer input (constant-velocity
+ * model).
+ *
+ * @param dt    [s] Time since the last prediction
+ */
+void AltKalmanFilter::Predict(float dt)
+{
+    this->_Propagate(dt, 0.0f, false);
+}
+
+
+// ----------------------------------------------------------------------------
+// Predict(float dt, float vertAccel)
+// ----------------------------------------------------------------------------
+/**
+ * Propagate the state with a vertical acceleration input.
+ *
+ * @param dt        [s] Time since the last prediction
+ * @param vertAccel [m/s/s] Vertical acceleration (gravity removed), up is positive
+ */
+void AltKalmanFilter::Predict(float dt, float vertAccel)
+{
+    this->_Propagate(dt, vertAccel, true);
+}
+
+
+// ----------------------------------------------------------------------------
+// Correct(float baroAlt)
+// ----------------------------------------------------------------------------
+/**
+ * Correct the state with a barometric altitude measurement. H = [1, 0, 0].
+ *
+ * @param baroAlt   [m] Measured altitude
+ */
+void AltKalmanFilter::Correct(float baroAlt)
+{
+    size_t i, j;
+    float K[3];  // Kalman gain
+    float P0[3];  // First row of P
+    float innov;  // Innovation
+    float invS;  // Inverse of the innovation variance
+
+    innov = baroAlt - this->_x[0];
+    invS = 1.0f / (this->_P[0][0] + this->_R);
+
+    for (i = 0; i < 3; i++)
+    {
+        P0[i] = this->_P[0][i];
+        K[i] = this->_P[i][0] * invS;
+        this->_x[i] += K[i] * innov;
+    }
+
+    // P = (I - K*H) * P
+    for (i = 0; i < 3; i++)
+        for (j = 0; j < 3; j++)
+            this->_P[i][j] -= K[i] * P0[j];
+}
+
+
+/* Return altitude estimate in [m] */
+float AltKalmanFilter::GetAltitude()
+{
+    return this->_x[0];
+}
+
+
+/* Return vertical speed estimate in [m/s]. Up is positive */
+float AltKalmanFilter::GetVertSpeed()
+{
+    return this->_x[1];
+}
+
+
+/* Return vertical accelerometer bias estimate in [m/s/s] */
+float AltKalmanFilter::GetAccelBias()
+{
+    return this->_x[2];
+}
+
+
+// ------------------------------------
+// Private methods
+// ------------------------------------
+
+
+// ----------------------------------------------------------------------------
+// _Propagate(float dt, float accel, bool useAccel)
+// ----------------------------------------------------------------------------
+/**
+ * State and covariance propagation, P = F*P*F^T + Q.
+ *
+ * @param dt        [s] Time step. Ignored if <= 0, clamped to ALTKF_MAX_DT.
+ * @param accel     [m/s/s] Vertical acceleration input
+ * @param useAccel  True to use the accel. input and bias state
+ */
+void AltKalmanFilter::_Propagate(float dt, float accel, bool useAccel)
+{
+    size_t i, j;
+    float F[3][3];
+    float FP[3][3];
+    float G[3];  // Noise input vector
+    float halfdt2;
+    float q;
+    float a;
+
+    if (dt <= 0.0f)
+        return;
+
+    if (dt > ALTKF_MAX_DT)
+        dt = ALTKF_MAX_DT;
+
+    halfdt2 = 0.5f * dt * dt;
+
+    /* State */
+    a = useAccel ? (accel - this->_x[2]) : 0.0f;
+    this->_x[0] += (this->_x[1] * dt) + (a * halfdt2);
+    this->_x[1] += a * dt;
+
+    /* Covariance */
+    F[0][0] = 1.0f; F[0][1] = dt;   F[0][2] = useAccel ? -halfdt2 : 0.0f;
+    F[1][0] = 0.0f; F[1][1] = 1.0f; F[1][2] = useAccel ? -dt : 0.0f;
+    F[2][0] = 0.0f; F[2][1] = 0.0f; F[2][2] = 1.0f;
+
+    for (i = 0; i < 3; i++)
+        for (j = 0; j < 3; j++)
+            FP[i][j] = (F[i][0] * this->_P[0][j]) + (F[i][1] * this->_P[1][j]) + (F[i][2] * this->_P[2][j]);
+
+    G[0] = halfdt2;
+    G[1] = dt;
+    G[2] = 0.0f;
+    q = useAccel ? this->_qAccel : this->_qManeuver;
+
+    for (i = 0; i < 3; i++)
+        for (j = 0; j < 3; j++)
+            this->_P[i][j] = (FP[i][0] * F[j][0]) + (FP[i][1] * F[j][1]) + (FP[i][2] * F[j][2]) + (q * G[i] * G[j]);
+
+    if (useAccel)
+        this->_P[2][2] += this->_qBias * dt;
+}
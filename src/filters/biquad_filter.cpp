@@ -0,0 +1,78 @@
+// ----------------------------------------------------------------------------
+// DISCRETE BIQUAD FILTER IMPLEMENTATION
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * General second-order (biquad) IIR filter that runs precomputed
+ * coefficients.
+ */
+
+#include "filters/biquad_filter.h"
+
+
+// ----------------------------------------------------------------------------
+// BiquadFilter()
+// ----------------------------------------------------------------------------
+/**
+ * Constructor for the biquad filter. Passes data through unfiltered until
+ * SetCoefficients() is called.
+ */
+BiquadFilter::BiquadFilter()
+{
+    this->_setcoefs = false;
+    this->_c = BiquadCoefs_t{1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    this->Reset();
+}
+
+
+// ----------------------------------------------------------------------------
+// BiquadFilter(const BiquadCoefs_t &coefs)
+// ----------------------------------------------------------------------------
+/**
+ * Constructor for the biquad filter with coefficients, usually a constexpr
+ * design from filter_design.h.
+ *
+ * @param coefs     Normalized biquad coefficients
+ */
+BiquadFilter::BiquadFilter(const BiquadCoefs_t &coefs)
+{
+    this->SetCoefficients(coefs);
+    this->Reset();
+}
+
+
+// ----------------------------------------------------------------------------
+// SetCoefficients(const BiquadCoefs_t &coefs)
+// ----------------------------------------------------------------------------
+/**
+ * Set the filter coefficients. The filter state is kept.
+ *
+ * @param coefs     Normalized biquad coefficients
+ */
+void BiquadFilter::SetCoefficients(const BiquadCoefs_t &coefs)
+{
+    this->_c = coefs;
+    this->_setcoefs = true;
+}
+
+
+// ----------------------------------------------------------------------------
+// Reset(float val)
+// ----------------------------------------------------------------------------
+/**
+ * Reset the filter state to a steady-state input value so there is no
+ * startup transient.
+ *
+ * @param val   Steady-state input value
+ */
+void BiquadFilter::Reset(float val)
+{
+    float b = this->_c.b0 + this->_c.b1 + this->_c.b2;
+    float a = 1.0f + this->_c.a1 + this->_c.a2;
+    float y = (a != 0.0f) ? (val * b / a) : val;  // DC output
+
+    this->_z1 = y - (this->_c.b0 * val);
+    this->_z2 = (this->_c.b2 * val) - (this->_c.a2 * y);
+}
@@ -10,7 +10,6 @@
  * attenuate high-frequency signals (-3dB cutoff).
  */
 
-#include <Arduino.h>
 #include "filters/low_pass_filter.h"
 
 
@@ -29,8 +28,12 @@
 LowPassFilter::LowPassFilter()
 {
     this->_setsf = false;
+    this->_setfc = false;
     this->_outPoint = 0.0f;
     this->_a = 1.0f;
+    this->_wc = 0.0f;
+    this->_nominalDt = 0.0f;
+    this->dt = 0.0f;
 }
 
 
@@ -46,29 +49,60 @@ void LowPassFilter::SetSmoothingFactor(float newSF)
 {
     this->_a = RangeConstrain(newSF, 0.0f, 1.0f);
     this->_setsf = true;
+    this->_setfc = false;
 }
 
 
 // ----------------------------------------------------------------------------
-// Filter(float rawPoint)
+// SetCutoffFrequency(float cutoffHz, float nominalDt)
 // ----------------------------------------------------------------------------
 /**
- * Apply the LFP (defined by the smoothing factor) to a new point and output 
- * the filtered value.
+ * Configure the filter by its -3dB cutoff frequency. The smoothing factor for 
+ * the nominal sample period is computed once and cached:
+ *     alpha = 1 - exp(-2*pi*fc*dt)
  * 
- * @param rawPoint  Raw data point to filter
- * @return          Filtered measurement
+ * @param cutoffHz  [Hz] Cutoff frequency, > 0
+ * @param nominalDt [s] Nominal sample period, > 0
+ * @return          True if set, false if the inputs are invalid.
  */
-float LowPassFilter::Filter(float rawPoint)
+bool LowPassFilter::SetCutoffFrequency(float cutoffHz, float nominalDt)
 {
-    if (this->_setsf == false)  // Just return unfiltered measurement
-    {
-        this->_outPoint = rawPoint;
-        return this->_outPoint;
-    }
+    if (cutoffHz <= 0.0f || nominalDt <= 0.0f)
+        return false;
 
-    this->_outPoint = (this->_a * rawPoint) + ((1.0f - this->_a) * this->_outPoint);
-    return this->_outPoint;
+    this->_wc = CONSTS_2PI * cutoffHz;
+    this->_nominalDt = nominalDt;
+    this->_a = 1.0f - expf(-this->_wc * nominalDt);
+    this->_setsf = true;
+    this->_setfc = true;
+    return true;
+}
+
+
+// ----------------------------------------------------------------------------
+// SetCutoffFrequency(float cutoffHz, float nominalDt, float nominalAlpha)
+// ----------------------------------------------------------------------------
+/**
+ * Same as SetCutoffFrequency(cutoffHz, nominalDt), but with the nominal 
+ * smoothing factor computed at compile time:
+ *     DesignEMAAlpha(1.0f / nominalDt, cutoffHz)
+ * 
+ * @param cutoffHz      [Hz] Cutoff frequency, > 0
+ * @param nominalDt     [s] Nominal sample period, > 0
+ * @param nominalAlpha  Smoothing factor at the nominal sample period, (0, 1]
+ * @return              True if set, false if the inputs are invalid.
+ */
+bool LowPassFilter::SetCutoffFrequency(float cutoffHz, float nominalDt, float nominalAlpha)
+{
+    if (cutoffHz <= 0.0f || nominalDt <= 0.0f || nominalAlpha <= 0.0f || nominalAlpha > 1.0f)
+        return false;
+
+    this->_wc = CONSTS_2PI * cutoffHz;
+    this->_nominalDt = nominalDt;
+    this->_a = nominalAlpha;
+    this->_setsf = true;
+    this->_setfc = true;
+    return true;
 }
 
 
@@ -8,7 +8,6 @@
  * A simple median filter implementation. Used to smooth noisy signals.
  */
 
-#include <Arduino.h>
 #include "filters/median_filter.h"
 
 // ------------------------------------
@@ -93,7 +92,8 @@ void MedianFilter::Fill(float val)
  */
 float MedianFilter::Filter(float newPoint)
 {
-    float filtValue;  // Filtered/smoothed value to output
+    float sorted[MEDAINFILT_MAX_POINTS];  // Sorted copy of the window
+    size_t i, j;
     
     // Insert new value into window, update window index
     this->dataPoints[this->insertIndex] = newPoint;
@@ -104,12 +104,23 @@ float MedianFilter::Filter(float newPoint)
         this->insertIndex = 0;
     
 
-    // Compute mean/average of values in window
-    filtValue = 0.0f;
-    for (size_t i = 0; i < this->N; i++)
-        filtValue += this->dataPoints[i];
-    
-    return (filtValue / (float)this->N);
+    // Insertion sort into a scratch copy, the window is small
+    for (i = 0; i < this->N; i++)
+    {
+        float val = this->dataPoints[i];
+        j = i;
+        while (j > 0 && sorted[j - 1] > val)
+        {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = val;
+    }
+
+    if (this->N % 2 == 1)
+        return sorted[this->N / 2];
+
+    return 0.5f * (sorted[(this->N / 2) - 1] + sorted[this->N / 2]);
 }
 
 
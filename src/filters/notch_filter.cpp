@@ -0,0 +1,90 @@
+// ----------------------------------------------------------------------------
+// DISCRETE NOTCH FILTER IMPLEMENTATION
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Second-order (biquad) notch filter. Attenuates a narrow band of frequencies
+ * around the center frequency (motor/prop vibration, for example) and lets
+ * everything else through.
+ */
+
+#include "filters/notch_filter.h"
+
+
+// ----------------------------------------------------------------------------
+// NotchFilter()
+// ----------------------------------------------------------------------------
+/**
+ * Constructor for the notch filter. Passes data through unfiltered until
+ * SetNotch() is called.
+ */
+NotchFilter::NotchFilter()
+{
+    this->_setnotch = false;
+    this->_b0 = 1.0f;
+    this->_b1 = 0.0f;
+    this->_b2 = 0.0f;
+    this->_a1 = 0.0f;
+    this->_a2 = 0.0f;
+    this->_z1 = 0.0f;
+    this->_z2 = 0.0f;
+}
+
+
+// ----------------------------------------------------------------------------
+// SetNotch(float centerFreqHz, float sampleRateHz, float q)
+// ----------------------------------------------------------------------------
+/**
+ * Compute the notch coefficients (RBJ audio EQ cookbook).
+ *
+ * @param centerFreqHz  [Hz] Frequency to reject
+ * @param sampleRateHz  [Hz] Rate that Filter() is called at
+ * @param q             Quality factor. Higher is a narrower notch.
+ * @return              True if set, false if the parameters are invalid.
+ */
+bool NotchFilter::SetNotch(float centerFreqHz, float sampleRateHz, float q)
+{
+    float w0, cosw0, alpha, a0inv;
+
+    if (sampleRateHz <= 0.0f || q <= 0.0f || centerFreqHz <= 0.0f || centerFreqHz >= 0.5f * sampleRateHz)
+        return false;
+
+    w0 = CONSTS_2PI * centerFreqHz / sampleRateHz;
+    cosw0 = cosf(w0);
+    alpha = sinf(w0) / (2.0f * q);
+    a0inv = 1.0f / (1.0f + alpha);
+
+    this->_b0 = a0inv;
+    this->_b1 = -2.0f * cosw0 * a0inv;
+    this->_b2 = a0inv;
+    this->_a1 = -2.0f * cosw0 * a0inv;
+    this->_a2 = (1.0f - alpha) * a0inv;
+    this->_setnotch = true;
+    return true;
+}
+
+
+// ----------------------------------------------------------------------------
+// SetNotch(const BiquadCoefs_t &coefs)
+// ----------------------------------------------------------------------------
+/**
+ * Use notch coefficients designed at compile time with DesignNotch().
+ *
+ * @param coefs     Normalized biquad coefficients
+ * @return          True if set, false if the coefficients are unstable.
+ */
+bool NotchFilter::SetNotch(const BiquadCoefs_t &coefs)
+{
+    if (BiquadIsStable(coefs) == false)
+        return false;
+
+    this->_b0 = coefs.b0;
+    this->_b1 = coefs.b1;
+    this->_b2 = coefs.b2;
+    this->_a1 = coefs.a1;
+    this->_a2 = coefs.a2;
+    this->_setnotch = true;
+    return true;
+}
@@ -0,0 +1,43 @@
+// ----------------------------------------------------------------------------
+// RATE LIMITER
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Limit how much a signal can change between two samples. Useful to keep
+ * glitches from yanking downstream filters around.
+ */
+
+#include "filters/rate_limit_filter.h"
+
+
+// ----------------------------------------------------------------------------
+// RateLimitFilter()
+// ----------------------------------------------------------------------------
+/**
+ * Constructor for the rate limiter. Passes data through unlimited until
+ * SetMaxStep() is called. The first point is always passed through.
+ */
+RateLimitFilter::RateLimitFilter()
+{
+    this->_setstep = false;
+    this->_primed = false;
+    this->_maxStep = 0.0f;
+    this->_outPoint = 0.0f;
+}
+
+
+// ----------------------------------------------------------------------------
+// SetMaxStep(float maxStep)
+// ----------------------------------------------------------------------------
+/**
+ * Set the max. allowed change between two consecutive outputs.
+ *
+ * @param maxStep   Max. change per sample, same units as the signal
+ */
+void RateLimitFilter::SetMaxStep(float maxStep)
+{
+    this->_maxStep = fabsf(maxStep);
+    this->_setstep = true;
+}
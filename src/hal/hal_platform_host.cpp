@@ -0,0 +1,132 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: HOST PLATFORM SERVICES
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Simulated clock and debug port for host builds. See hal_platform.h.
+ */
+
+
+#ifndef ARDUINO
+#include <stdio.h>
+#include "hal/hal_platform.h"
+
+
+static uint64_t halSimMicros = 0;  // [us] Simulated time since "power-on"
+
+HalSerialPort Serial;
+
+
+/* Return simulated micros(). Wraps at 2^32 like the Teensy's. */
+uint32_t micros()
+{
+    return (uint32_t)halSimMicros;
+}
+
+
+/* Return simulated millis() */
+uint32_t millis()
+{
+    return (uint32_t)(halSimMicros / 1000ULL);
+}
+
+
+/* Advance the simulated clock instead of waiting */
+void delay(uint32_t ms)
+{
+    halSimMicros += (uint64_t)ms * 1000ULL;
+}
+
+
+/* Advance the simulated clock instead of waiting */
+void delayMicroseconds(uint32_t us)
+{
+    halSimMicros += us;
+}
+
+
+/* Return the simulated clock without wrapping [us] */
+uint64_t HalSimMicros64()
+{
+    return halSimMicros;
+}
+
+
+/* Sensor timestamp clock: the simulated clock [us] */
+uint64_t Micros64()
+{
+    return halSimMicros;
+}
+
+
+/* Move the simulated clock forward [us] */
+void HalSimAdvanceMicros(uint32_t us)
+{
+    halSimMicros += us;
+}
+
+
+/* Set the simulated clock, e.g. to test micros() rollover [us] */
+void HalSimSetMicros(uint64_t us)
+{
+    halSimMicros = us;
+}
+
+
+void HalSerialPort::print(const char *msg)
+{
+    if (this->echo)
+        fputs(msg, stdout);
+}
+
+
+void HalSerialPort::print(char c)
+{
+    if (this->echo)
+        fputc(c, stdout);
+}
+
+
+void HalSerialPort::print(int val)
+{
+    if (this->echo)
+        printf("%d", val);
+}
+
+
+void HalSerialPort::print(unsigned int val)
+{
+    if (this->echo)
+        printf("%u", val);
+}
+
+
+void HalSerialPort::print(long val)
+{
+    if (this->echo)
+        printf("%ld", val);
+}
+
+
+void HalSerialPort::print(unsigned long val)
+{
+    if (this->echo)
+        printf("%lu", val);
+}
+
+
+void HalSerialPort::print(double val, int digits)
+{
+    if (this->echo)
+        printf("%.*f", digits, val);
+}
+
+
+void HalSerialPort::println()
+{
+    if (this->echo)
+        fputc('\n', stdout);
+}
+#endif
@@ -0,0 +1,50 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: TEENSY PLATFORM SERVICES
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Teensy side of hal_platform.h. The Arduino core provides everything except
+ * the 64-bit timestamp clock.
+ */
+
+
+#ifdef ARDUINO
+#include "hal/hal_platform.h"
+
+
+// ----------------------------------------------------------------------------
+// Micros64()
+// ----------------------------------------------------------------------------
+/**
+ * micros() extended to 64 bits, so it never wraps (micros() wraps every 71.6
+ * minutes). Counts wraps of micros() between calls, so it has to be called at
+ * least once per wrap period; the sensor reads in the main loop see to that.
+ * Safe to call from ISRs: the update runs with interrupts off and restores
+ * the caller's interrupt state.
+ *
+ * @return  [us] Time since power-on.
+ */
+uint64_t Micros64()
+{
+    static uint32_t lastMicros = 0;
+    static uint32_t wraps = 0;
+    uint32_t primask;
+    uint32_t now;
+    uint64_t t;
+
+    __asm__ volatile("mrs %0, primask" : "=r" (primask));
+    __disable_irq();
+
+    now = micros();
+    if (now < lastMicros)
+        wraps++;
+    lastMicros = now;
+    t = ((uint64_t)wraps << 32) | now;
+
+    if ((primask & 0x01) == 0)
+        __enable_irq();
+    return t;
+}
+#endif
@@ -0,0 +1,40 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: I2C BUS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Single-register helpers shared by every bus. See i2c_bus.h.
+ */
+
+
+#include "hal/i2c_bus.h"
+
+
+/**
+ * Read one register.
+ *
+ * @param address  7-bit device address.
+ * @param reg      Register to read.
+ * @param val      Output, register value. Unchanged if the read failed.
+ * @return  True if successful, false if the device didn't respond.
+ */
+bool I2CBus::ReadReg8(uint8_t address, uint8_t reg, uint8_t *val)
+{
+    return this->ReadRegs(address, reg, val, 1);
+}
+
+
+/**
+ * Write one register.
+ *
+ * @param address  7-bit device address.
+ * @param reg      Register to write.
+ * @param val      Value to write.
+ * @return  True if successful, false if the device didn't respond.
+ */
+bool I2CBus::WriteReg8(uint8_t address, uint8_t reg, uint8_t val)
+{
+    return this->WriteRegs(address, reg, &val, 1);
+}
@@ -0,0 +1,253 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: HOST (SIMULATED) I2C BUS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Blocking I2CBus on simulated devices. See i2c_bus_host.h. Host builds
+ * only: the Teensy has real buses.
+ */
+
+
+#ifndef ARDUINO
+#include "hal/i2c_bus_host.h"
+#include "hal/hal_platform.h"
+
+
+HostI2CBus::HostI2CBus()
+{
+    this->transfers = 0;
+    this->bytes = 0;
+    this->nacks = 0;
+    this->timeouts = 0;
+    this->recoveries = 0;
+    this->_nDevices = 0;
+    this->_clockHz = 0;
+    this->_nacksToInject = 0;
+    this->_busLocked = false;
+    this->_lastError = I2C_ERR_NONE;
+}
+
+
+// ----------------------------------------------------------------------------
+// AttachDevice(uint8_t address, SimI2CDevice *device)
+// ----------------------------------------------------------------------------
+/**
+ * Put a simulated device on the bus.
+ *
+ * @param address  7-bit device address.
+ * @param device   Simulated device.
+ * @return  True if attached, false if the address is taken or the bus is full.
+ */
+bool HostI2CBus::AttachDevice(uint8_t address, SimI2CDevice *device)
+{
+    if (device == nullptr || this->FindDevice(address) != nullptr)
+        return false;
+    if (this->_nDevices >= HOST_I2C_MAX_DEVICES)
+        return false;
+
+    this->_addresses[this->_nDevices] = address;
+    this->_devices[this->_nDevices] = device;
+    this->_nDevices++;
+    return true;
+}
+
+
+/* Return the device at an address, nullptr if none (NACK) */
+SimI2CDevice *HostI2CBus::FindDevice(uint8_t address)
+{
+    for (uint8_t i = 0; i < this->_nDevices; i++)
+    {
+        if (this->_addresses[i] == address)
+            return this->_devices[i];
+    }
+
+    return nullptr;
+}
+
+
+/**
+ * Set the simulated SCL rate. Transfers then advance the simulated clock by
+ * their time on the wire.
+ *
+ * @param hz  [Hz] Bus clock, e.g. 400000. 0 for zero-time transfers.
+ */
+void HostI2CBus::SetClockHz(uint32_t hz)
+{
+    this->_clockHz = hz;
+}
+
+
+/**
+ * Fail the next transfers with a NACK, whatever the device would do.
+ *
+ * @param count  Number of transfers to fail.
+ */
+void HostI2CBus::InjectNACKs(uint32_t count)
+{
+    this->_nacksToInject = count;
+}
+
+
+/* Time out every transfer, as if a device were holding SDA low, until Recover() */
+void HostI2CBus::InjectBusLock()
+{
+    this->_busLocked = true;
+}
+
+
+bool HostI2CBus::Begin()
+{
+    return true;
+}
+
+
+/* Return true if a device is attached at the address */
+bool HostI2CBus::Probe(uint8_t address)
+{
+    return this->_Start(address, 1) != nullptr;
+}
+
+
+/* Write 'reg', repeated start, read 'len' bytes */
+bool HostI2CBus::ReadRegs(uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    SimI2CDevice *dev = this->_Start(address, 3 + (uint32_t)len);
+
+    if (dev == nullptr)
+        return false;
+    return this->_Finish(dev->ReadRegs(reg, buf, len));
+}
+
+
+/* Write 'reg', then 'len' bytes */
+bool HostI2CBus::WriteRegs(uint8_t address, uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+    SimI2CDevice *dev = this->_Start(address, 2 + (uint32_t)len);
+
+    if (dev == nullptr)
+        return false;
+    return this->_Finish(dev->WriteRegs(reg, buf, len));
+}
+
+
+/* Read 'len' bytes without a register address */
+bool HostI2CBus::Read(uint8_t address, uint8_t *buf, uint8_t len)
+{
+    SimI2CDevice *dev = this->_Start(address, 1 + (uint32_t)len);
+
+    if (dev == nullptr)
+        return false;
+    return this->_Finish(dev->Read(buf, len));
+}
+
+
+/* Write 'len' raw bytes */
+bool HostI2CBus::Write(uint8_t address, const uint8_t *buf, uint8_t len)
+{
+    SimI2CDevice *dev = this->_Start(address, 1 + (uint32_t)len);
+
+    if (dev == nullptr)
+        return false;
+    return this->_Finish(dev->Write(buf, len));
+}
+
+
+/* Why the last transfer failed */
+I2CBusError_t HostI2CBus::LastError() const
+{
+    return this->_lastError;
+}
+
+
+/**
+ * Clock out a stuck bus: clears InjectBusLock(). Takes 100us of simulated
+ * time with a bus clock set.
+ *
+ * @return  True (the bus is free).
+ */
+bool HostI2CBus::Recover()
+{
+    this->recoveries++;
+    this->_busLocked = false;
+    this->_lastError = I2C_ERR_NONE;
+    if (this->_clockHz > 0)
+        HalSimAdvanceMicros(100);
+    return true;
+}
+
+
+// ----------------------------------------------------------------------------
+// _Start(uint8_t address, uint32_t nBytes)
+// ----------------------------------------------------------------------------
+/**
+ * Account for a transfer and find the device that answers it.
+ *
+ * @param address  7-bit device address.
+ * @param nBytes   Bytes on the wire, including address bytes.
+ * @return  Device, or nullptr if the transfer NACKs.
+ */
+SimI2CDevice *HostI2CBus::_Start(uint8_t address, uint32_t nBytes)
+{
+    SimI2CDevice *dev;
+
+    this->transfers++;
+    this->bytes += nBytes;
+    if (this->_clockHz > 0)
+        HalSimAdvanceMicros((uint32_t)((9ULL * nBytes * 1000000ULL) / this->_clockHz));
+
+    if (this->_busLocked)
+    {
+        this->timeouts++;
+        this->_lastError = I2C_ERR_TIMEOUT;
+        return nullptr;
+    }
+
+    dev = this->FindDevice(address);
+    if (this->_nacksToInject > 0)
+    {
+        this->_nacksToInject--;
+        dev = nullptr;
+    }
+
+    if (dev == nullptr)
+    {
+        this->nacks++;
+        this->_lastError = I2C_ERR_NACK;
+        return nullptr;
+    }
+
+    this->_lastError = I2C_ERR_NONE;
+    return dev;
+}
+
+
+/* Set the error for a device that refused a transfer (a data NACK) */
+bool HostI2CBus::_Finish(bool ok)
+{
+    this->_lastError = ok ? I2C_ERR_NONE : I2C_ERR_NACK;
+    return ok;
+}
+
+
+/* Host default bus. Attach the sensor models to it. */
+HostI2CBus &HostSensorI2CBus()
+{
+    static HostI2CBus bus;
+    return bus;
+}
+
+
+/* Host builds have one simulated bus for everything */
+I2CBus *SensorI2CBus()
+{
+    return &HostSensorI2CBus();
+}
+
+
+I2CBus *GPSI2CBus()
+{
+    return &HostSensorI2CBus();
+}
+#endif
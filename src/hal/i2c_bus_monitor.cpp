@@ -0,0 +1,231 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: I2C BUS HEALTH MONITOR
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Per-device error statistics and stuck-bus recovery. See i2c_bus_monitor.h.
+ */
+
+
+#include "hal/i2c_bus_monitor.h"
+#include "hal/hal_platform.h"
+
+
+/**
+ * Monitor a bus.
+ *
+ * @param bus  Bus to monitor. Drivers should only use it through the monitor.
+ */
+I2CBusMonitor::I2CBusMonitor(I2CBus *bus)
+{
+    this->_bus = bus;
+    this->_nDevices = 0;
+    this->busRecoveries = 0;
+    this->failedRecoveries = 0;
+}
+
+
+/* Return a device's stats, nullptr if it hasn't been addressed yet */
+const I2CDeviceStats_t *I2CBusMonitor::GetStats(uint8_t address) const
+{
+    for (uint8_t i = 0; i < this->_nDevices; i++)
+    {
+        if (this->_devices[i].address == address)
+            return &this->_devices[i];
+    }
+
+    return nullptr;
+}
+
+
+/* Return the number of devices with stats */
+uint8_t I2CBusMonitor::DeviceCount() const
+{
+    return this->_nDevices;
+}
+
+
+/* Return the stats of the index'th device seen, nullptr for a bad index */
+const I2CDeviceStats_t *I2CBusMonitor::GetDevice(uint8_t index) const
+{
+    if (index >= this->_nDevices)
+        return nullptr;
+    return &this->_devices[index];
+}
+
+
+/**
+ * Time since a device last answered.
+ *
+ * @param address  7-bit device address.
+ * @return  [us] Time since its last good transfer. UINT64_MAX if it never
+ *          answered.
+ */
+uint64_t I2CBusMonitor::SinceLastOkMicros(uint8_t address) const
+{
+    const I2CDeviceStats_t *stats = this->GetStats(address);
+
+    if (stats == nullptr || stats->lastOkMicros == 0)
+        return UINT64_MAX;
+    return Micros64() - stats->lastOkMicros;
+}
+
+
+/* Clear the counters. Last-good times are kept. */
+void I2CBusMonitor::ResetStats()
+{
+    for (uint8_t i = 0; i < this->_nDevices; i++)
+    {
+        this->_devices[i].transfers = 0;
+        this->_devices[i].errors = 0;
+        this->_devices[i].nacks = 0;
+        this->_devices[i].timeouts = 0;
+        this->_devices[i].shortReads = 0;
+    }
+    this->busRecoveries = 0;
+    this->failedRecoveries = 0;
+}
+
+
+bool I2CBusMonitor::Begin()
+{
+    return this->_bus->Begin();
+}
+
+
+bool I2CBusMonitor::Probe(uint8_t address)
+{
+    return this->_Record(address, this->_bus->Probe(address));
+}
+
+
+bool I2CBusMonitor::ReadRegs(uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    return this->_Record(address, this->_bus->ReadRegs(address, reg, buf, len));
+}
+
+
+bool I2CBusMonitor::WriteRegs(uint8_t address, uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+    return this->_Record(address, this->_bus->WriteRegs(address, reg, buf, len));
+}
+
+
+bool I2CBusMonitor::Read(uint8_t address, uint8_t *buf, uint8_t len)
+{
+    return this->_Record(address, this->_bus->Read(address, buf, len));
+}
+
+
+bool I2CBusMonitor::Write(uint8_t address, const uint8_t *buf, uint8_t len)
+{
+    return this->_Record(address, this->_bus->Write(address, buf, len));
+}
+
+
+I2CBusError_t I2CBusMonitor::LastError() const
+{
+    return this->_bus->LastError();
+}
+
+
+/**
+ * Recover the bus now and count it.
+ *
+ * @return  True if the bus is free.
+ */
+bool I2CBusMonitor::Recover()
+{
+    this->busRecoveries++;
+    if (!this->_bus->Recover())
+    {
+        this->failedRecoveries++;
+        return false;
+    }
+
+    return true;
+}
+
+
+// ----------------------------------------------------------------------------
+// _Record(uint8_t address, bool ok)
+// ----------------------------------------------------------------------------
+/**
+ * Count a finished transfer against its device, and recover the bus if it
+ * timed out. NACKs and short reads are device faults and only counted.
+ * Transfers the bus refused without sending (too long, over a scheduler
+ * budget, async engine busy) aren't device faults and only count as
+ * transfers.
+ *
+ * @param address  7-bit device address.
+ * @param ok       Transfer result.
+ * @return  'ok'
+ */
+bool I2CBusMonitor::_Record(uint8_t address, bool ok)
+{
+    I2CDeviceStats_t *stats = this->_Find(address);
+    I2CBusError_t err;
+
+    if (stats != nullptr)
+        stats->transfers++;
+
+    if (ok)
+    {
+        if (stats != nullptr)
+        {
+            stats->consecutiveErrors = 0;
+            stats->lastOkMicros = Micros64();
+        }
+        return true;
+    }
+
+    err = this->_bus->LastError();
+    if (err == I2C_ERR_BAD_LENGTH || err == I2C_ERR_BUDGET || err == I2C_ERR_BUSY)
+        return false;
+
+    if (stats != nullptr)
+    {
+        stats->errors++;
+        stats->consecutiveErrors++;
+        if (err == I2C_ERR_TIMEOUT)
+            stats->timeouts++;
+        else if (err == I2C_ERR_SHORT_READ)
+            stats->shortReads++;
+        else
+            stats->nacks++;
+    }
+
+    if (err == I2C_ERR_TIMEOUT)
+        this->Recover();
+
+    return false;
+}
+
+
+/* Return a device's stats, adding it if there's room. nullptr if full. */
+I2CDeviceStats_t *I2CBusMonitor::_Find(uint8_t address)
+{
+    I2CDeviceStats_t *stats;
+
+    for (uint8_t i = 0; i < this->_nDevices; i++)
+    {
+        if (this->_devices[i].address == address)
+            return &this->_devices[i];
+    }
+
+    if (this->_nDevices >= I2C_MONITOR_MAX_DEVICES)
+        return nullptr;
+
+    stats = &this->_devices[this->_nDevices++];
+    stats->address = address;
+    stats->transfers = 0;
+    stats->errors = 0;
+    stats->nacks = 0;
+    stats->timeouts = 0;
+    stats->shortReads = 0;
+    stats->consecutiveErrors = 0;
+    stats->lastOkMicros = 0;
+    return stats;
+}
@@ -0,0 +1,406 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: I2C BUS SCHEDULER
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Rate/priority scheduler with per-job byte budgets for a shared I2C bus.
+ * See i2c_bus_scheduler.h.
+ */
+
+
+#include "hal/i2c_bus_scheduler.h"
+#include "hal/hal_platform.h"
+
+
+// ----------------------------------------------------------------------------
+// I2CBusScheduler(I2CBus *bus)
+// ----------------------------------------------------------------------------
+/**
+ * Construct a scheduler for a bus.
+ *
+ * @param bus  Bus to share. Jobs should only use it through the scheduler.
+ */
+I2CBusScheduler::I2CBusScheduler(I2CBus *bus)
+{
+    this->_bus = bus;
+    this->_nJobs = 0;
+    this->_current = I2C_SCHED_NO_JOB;
+    this->_budget = 0;
+    this->_lastRejected = false;
+    this->_clockHz = 400000;
+    this->otherBytes = 0;
+    this->otherBusyMicros = 0;
+    this->_statsStartMicros = Micros64();
+}
+
+
+// ----------------------------------------------------------------------------
+// AddJob(const char *name, I2CBusJobFn_t run, void *context,
+//     uint32_t periodMicros, uint8_t priority, uint16_t maxBytes)
+// ----------------------------------------------------------------------------
+/**
+ * Add a job. Periodic jobs are first due right away.
+ *
+ * @param name          Name for reports.
+ * @param run           Job body.
+ * @param context       Passed through to 'run'.
+ * @param periodMicros  [us] Run period, e.g. 2500 for 400Hz. 0 for a
+ *                      background job that runs whenever the bus is free.
+ * @param priority      0 is highest.
+ * @param maxBytes      Max. payload bytes per run.
+ * @return  Job ID, or I2C_SCHED_NO_JOB if full or 'run' is nullptr.
+ */
+uint8_t I2CBusScheduler::AddJob(const char *name, I2CBusJobFn_t run, void *context, uint32_t periodMicros,
+    uint8_t priority, uint16_t maxBytes)
+{
+    I2CBusJob_t *job;
+
+    if (run == nullptr || this->_nJobs >= I2C_SCHED_MAX_JOBS)
+        return I2C_SCHED_NO_JOB;
+
+    job = &this->_jobs[this->_nJobs];
+    job->name = name;
+    job->run = run;
+    job->context = context;
+    job->periodMicros = periodMicros;
+    job->priority = priority;
+    job->maxBytes = maxBytes;
+    job->nextMicros = Micros64();
+    job->runs = 0;
+    job->deferrals = 0;
+    job->rejected = 0;
+    job->bytes = 0;
+    job->busyMicros = 0;
+    job->maxLateMicros = 0;
+
+    return this->_nJobs++;
+}
+
+
+/**
+ * Set the bus clock used for worst-case job times. Doesn't change the bus.
+ *
+ * @param hz  [Hz] SCL rate, e.g. 400000.
+ */
+void I2CBusScheduler::SetClockHz(uint32_t hz)
+{
+    if (hz > 0)
+        this->_clockHz = hz;
+}
+
+
+// ----------------------------------------------------------------------------
+// Service()
+// ----------------------------------------------------------------------------
+/**
+ * Run the jobs that are due, highest priority first, each at most once. A job
+ * is held back (deferred to the next call) if its worst-case bus time would
+ * run into the next due time of a higher-priority periodic job. Call every
+ * loop.
+ *
+ * @return  Number of jobs run.
+ */
+uint8_t I2CBusScheduler::Service()
+{
+    bool considered[I2C_SCHED_MAX_JOBS] = {false};
+    uint8_t nRun = 0;
+
+    for (uint8_t pass = 0; pass < this->_nJobs; pass++)
+    {
+        uint64_t now = Micros64();
+        I2CBusJob_t *best = nullptr;
+        uint8_t bestIdx = 0;
+
+        // Highest-priority due job not yet considered. Ties go to the most overdue.
+        for (uint8_t i = 0; i < this->_nJobs; i++)
+        {
+            I2CBusJob_t *job = &this->_jobs[i];
+
+            if (considered[i] || !this->_IsDue(job, now))
+                continue;
+            if (best == nullptr || job->priority < best->priority ||
+                (job->priority == best->priority && job->nextMicros < best->nextMicros))
+            {
+                best = job;
+                bestIdx = i;
+            }
+        }
+
+        if (best == nullptr)
+            break;
+        considered[bestIdx] = true;
+
+        if (this->_WouldDelay(best, now))
+        {
+            best->deferrals++;
+            continue;
+        }
+
+        this->_current = bestIdx;
+        this->_Run(best, now);
+        this->_current = I2C_SCHED_NO_JOB;
+        nRun++;
+    }
+
+    return nRun;
+}
+
+
+/* Return the number of jobs */
+uint8_t I2CBusScheduler::JobCount() const
+{
+    return this->_nJobs;
+}
+
+
+/* Return a job's settings and stats, nullptr for a bad ID */
+const I2CBusJob_t *I2CBusScheduler::GetJob(uint8_t id) const
+{
+    if (id >= this->_nJobs)
+        return nullptr;
+    return &this->_jobs[id];
+}
+
+
+/**
+ * Fraction of the time since ResetStats() that a job kept the bus busy.
+ *
+ * @param id  Job ID.
+ * @return  Utilization, [0, 1]. 0 for a bad ID.
+ */
+float I2CBusScheduler::Utilization(uint8_t id) const
+{
+    uint64_t elapsed = Micros64() - this->_statsStartMicros;
+
+    if (id >= this->_nJobs || elapsed == 0)
+        return 0.0f;
+    return (float)this->_jobs[id].busyMicros / (float)elapsed;
+}
+
+
+/* Fraction of the time since ResetStats() the bus was busy, jobs or not */
+float I2CBusScheduler::TotalUtilization() const
+{
+    uint64_t elapsed = Micros64() - this->_statsStartMicros;
+    uint64_t busy = this->otherBusyMicros;
+
+    if (elapsed == 0)
+        return 0.0f;
+    for (uint8_t i = 0; i < this->_nJobs; i++)
+        busy += this->_jobs[i].busyMicros;
+    return (float)busy / (float)elapsed;
+}
+
+
+/* Clear the job statistics and restart the utilization window */
+void I2CBusScheduler::ResetStats()
+{
+    for (uint8_t i = 0; i < this->_nJobs; i++)
+    {
+        this->_jobs[i].runs = 0;
+        this->_jobs[i].deferrals = 0;
+        this->_jobs[i].rejected = 0;
+        this->_jobs[i].bytes = 0;
+        this->_jobs[i].busyMicros = 0;
+        this->_jobs[i].maxLateMicros = 0;
+    }
+    this->otherBytes = 0;
+    this->otherBusyMicros = 0;
+    this->_statsStartMicros = Micros64();
+}
+
+
+/**
+ * Worst-case bus time to move some payload bytes in one transfer, 9 bits per
+ * byte including the address and register bytes.
+ *
+ * @param payloadBytes  Bytes read or written.
+ * @return  [us] Time on the bus.
+ */
+uint32_t I2CBusScheduler::WireMicros(uint16_t payloadBytes) const
+{
+    return (uint32_t)((9ULL * ((uint32_t)payloadBytes + I2C_SCHED_OVERHEAD_BYTES) * 1000000ULL) / this->_clockHz);
+}
+
+
+bool I2CBusScheduler::Begin()
+{
+    return this->_bus->Begin();
+}
+
+
+bool I2CBusScheduler::Probe(uint8_t address)
+{
+    uint64_t t0 = Micros64();
+    bool ok;
+
+    this->_lastRejected = false;
+    ok = this->_bus->Probe(address);
+
+    this->_Account(t0, 0);
+    return ok;
+}
+
+
+bool I2CBusScheduler::ReadRegs(uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    uint64_t t0;
+    bool ok;
+
+    if (!this->_Reserve(len))
+        return false;
+    t0 = Micros64();
+    ok = this->_bus->ReadRegs(address, reg, buf, len);
+    this->_Account(t0, len);
+    return ok;
+}
+
+
+bool I2CBusScheduler::WriteRegs(uint8_t address, uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+    uint64_t t0;
+    bool ok;
+
+    if (!this->_Reserve(len))
+        return false;
+    t0 = Micros64();
+    ok = this->_bus->WriteRegs(address, reg, buf, len);
+    this->_Account(t0, len);
+    return ok;
+}
+
+
+bool I2CBusScheduler::Read(uint8_t address, uint8_t *buf, uint8_t len)
+{
+    uint64_t t0;
+    bool ok;
+
+    if (!this->_Reserve(len))
+        return false;
+    t0 = Micros64();
+    ok = this->_bus->Read(address, buf, len);
+    this->_Account(t0, len);
+    return ok;
+}
+
+
+bool I2CBusScheduler::Write(uint8_t address, const uint8_t *buf, uint8_t len)
+{
+    uint64_t t0;
+    bool ok;
+
+    if (!this->_Reserve(len))
+        return false;
+    t0 = Micros64();
+    ok = this->_bus->Write(address, buf, len);
+    this->_Account(t0, len);
+    return ok;
+}
+
+
+/* Why the last transfer failed: over budget, or the bus's own error */
+I2CBusError_t I2CBusScheduler::LastError() const
+{
+    if (this->_lastRejected)
+        return I2C_ERR_BUDGET;
+    return this->_bus->LastError();
+}
+
+
+bool I2CBusScheduler::Recover()
+{
+    this->_lastRejected = false;
+    return this->_bus->Recover();
+}
+
+
+/**
+ * Take 'len' bytes from the running job's budget.
+ *
+ * @return  True if the transfer may go ahead, false if it's over budget.
+ */
+bool I2CBusScheduler::_Reserve(uint8_t len)
+{
+    this->_lastRejected = false;
+    if (this->_current == I2C_SCHED_NO_JOB)
+        return true;
+
+    if (len > this->_budget)
+    {
+        this->_jobs[this->_current].rejected++;
+        this->_lastRejected = true;
+        return false;
+    }
+    this->_budget = (uint16_t)(this->_budget - len);
+    return true;
+}
+
+
+/* Charge a finished transfer to the running job (or to 'other') */
+void I2CBusScheduler::_Account(uint64_t startMicros, uint8_t len)
+{
+    uint64_t busy = Micros64() - startMicros;
+
+    if (this->_current == I2C_SCHED_NO_JOB)
+    {
+        this->otherBytes += len;
+        this->otherBusyMicros += busy;
+        return;
+    }
+
+    this->_jobs[this->_current].bytes += len;
+    this->_jobs[this->_current].busyMicros += busy;
+}
+
+
+/* Return true if a job should run now. Background jobs always should. */
+bool I2CBusScheduler::_IsDue(const I2CBusJob_t *job, uint64_t now) const
+{
+    return job->periodMicros == 0 || now >= job->nextMicros;
+}
+
+
+/**
+ * Return true if running a job now could make a higher-priority periodic job
+ * start late: its worst-case bus time reaches past that job's due time.
+ */
+bool I2CBusScheduler::_WouldDelay(const I2CBusJob_t *job, uint64_t now) const
+{
+    uint64_t end = now + this->WireMicros(job->maxBytes);
+
+    for (uint8_t i = 0; i < this->_nJobs; i++)
+    {
+        const I2CBusJob_t *other = &this->_jobs[i];
+
+        if (other == job || other->periodMicros == 0 || other->priority >= job->priority)
+            continue;
+        if (other->nextMicros < end)
+            return true;
+    }
+
+    return false;
+}
+
+
+/* Run a job with its byte budget and schedule its next run */
+void I2CBusScheduler::_Run(I2CBusJob_t *job, uint64_t now)
+{
+    if (job->periodMicros > 0)
+    {
+        uint64_t late = now - job->nextMicros;
+
+        if (late > job->maxLateMicros)
+            job->maxLateMicros = (late > 0xFFFFFFFFULL) ? 0xFFFFFFFFUL : (uint32_t)late;
+
+        // Keep the phase, but don't try to catch up on missed periods
+        job->nextMicros += job->periodMicros;
+        if (job->nextMicros <= now)
+            job->nextMicros = now + job->periodMicros;
+    }
+
+    this->_budget = job->maxBytes;
+    job->runs++;
+    job->run(job->context, job->maxBytes);
+}
@@ -0,0 +1,290 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: TEENSY I2C BUS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * I2CBus on an Arduino Wire bus. See i2c_bus_teensy.h.
+ */
+
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include "hal/i2c_bus_teensy.h"
+#include "hal/i2c_bus_monitor.h"
+#include "sensor_drivers/async_i2c.h"
+#include "hummingbird_config.h"
+
+#ifdef BUFFER_LENGTH
+static_assert(I2C_BUS_MAX_TRANSFER <= BUFFER_LENGTH, "I2C_BUS_MAX_TRANSFER is longer than Wire's buffer");
+#endif
+
+
+/**
+ * Wrap a Wire bus.
+ *
+ * @param wire     Wire bus the devices are on, e.g. &Wire2.
+ * @param sdaPin   The bus's SDA pin, for Recover(). -1 to not recover.
+ * @param sclPin   The bus's SCL pin, for Recover(). -1 to not recover.
+ * @param clockHz  [Hz] SCL rate to set again after a recovery.
+ */
+TeensyI2CBus::TeensyI2CBus(TwoWire *wire, int8_t sdaPin, int8_t sclPin, uint32_t clockHz)
+{
+    this->_wire = wire;
+    this->_sdaPin = sdaPin;
+    this->_sclPin = sclPin;
+    this->_clockHz = clockHz;
+    this->_lastError = I2C_ERR_NONE;
+}
+
+
+bool TeensyI2CBus::Begin()
+{
+    this->_wire->begin();
+    return true;
+}
+
+
+/* Return true if a device ACKs its address */
+bool TeensyI2CBus::Probe(uint8_t address)
+{
+    this->_wire->beginTransmission(address);
+    return this->_EndTransmission(true);
+}
+
+
+// ----------------------------------------------------------------------------
+// ReadRegs(uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len)
+// ----------------------------------------------------------------------------
+/**
+ * Write the register address, repeated start, then read 'len' bytes.
+ *
+ * @param address  7-bit device address.
+ * @param reg      First register.
+ * @param buf      Destination, at least 'len' bytes.
+ * @param len      Number of bytes, up to I2C_BUS_MAX_TRANSFER.
+ * @return  True if all bytes were read, false on a NACK or short read.
+ */
+bool TeensyI2CBus::ReadRegs(uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    if (len > I2C_BUS_MAX_TRANSFER)
+    {
+        this->_lastError = I2C_ERR_BAD_LENGTH;
+        return false;
+    }
+
+    this->_wire->beginTransmission(address);
+    this->_wire->write(reg);
+    if (!this->_EndTransmission(false))
+        return false;
+    if (!this->_RequestFrom(address, len))
+        return false;
+
+    for (uint8_t i = 0; i < len; i++)
+        buf[i] = this->_wire->read();
+
+    return true;
+}
+
+
+/**
+ * Write the register address, then 'len' bytes, in one transfer.
+ *
+ * @return  True if successful, false on a NACK.
+ */
+bool TeensyI2CBus::WriteRegs(uint8_t address, uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+    this->_wire->beginTransmission(address);
+    this->_wire->write(reg);
+    if (len > 0 && this->_wire->write(buf, len) != len)
+    {
+        this->_wire->endTransmission();
+        this->_lastError = I2C_ERR_BAD_LENGTH;
+        return false;
+    }
+
+    return this->_EndTransmission(true);
+}
+
+
+/**
+ * Read 'len' bytes without writing a register address first.
+ *
+ * @return  True if all bytes were read.
+ */
+bool TeensyI2CBus::Read(uint8_t address, uint8_t *buf, uint8_t len)
+{
+    if (len > I2C_BUS_MAX_TRANSFER)
+    {
+        this->_lastError = I2C_ERR_BAD_LENGTH;
+        return false;
+    }
+    if (!this->_RequestFrom(address, len))
+        return false;
+
+    for (uint8_t i = 0; i < len; i++)
+        buf[i] = this->_wire->read();
+
+    return true;
+}
+
+
+/**
+ * Write 'len' raw bytes in one transfer.
+ *
+ * @return  True if successful, false on a NACK or if Wire's buffer is too
+ *          small for the message.
+ */
+bool TeensyI2CBus::Write(uint8_t address, const uint8_t *buf, uint8_t len)
+{
+    this->_wire->beginTransmission(address);
+    if (this->_wire->write(buf, len) != len)
+    {
+        this->_wire->endTransmission();
+        this->_lastError = I2C_ERR_BAD_LENGTH;
+        return false;
+    }
+
+    return this->_EndTransmission(true);
+}
+
+
+/* Why the last transfer failed */
+I2CBusError_t TeensyI2CBus::LastError() const
+{
+    return this->_lastError;
+}
+
+
+// ----------------------------------------------------------------------------
+// Recover()
+// ----------------------------------------------------------------------------
+/**
+ * Free a stuck bus (I2C-bus spec. section 3.1.16): with SDA held low, clock 
+ * SCL by hand until the device lets go of SDA (at most 9 clocks, one byte 
+ * and the ACK), send a STOP, then hand the pins back to Wire. Takes about 
+ * 100us.
+ *
+ * @return  True if SDA is free, false if it's still held low or the pins
+ *          aren't set.
+ */
+bool TeensyI2CBus::Recover()
+{
+    bool sdaFree;
+
+    if (this->_sdaPin < 0 || this->_sclPin < 0)
+        return false;
+
+    this->_wire->end();
+    pinMode(this->_sdaPin, INPUT_PULLUP);
+    pinMode(this->_sclPin, OUTPUT_OPENDRAIN);
+    digitalWrite(this->_sclPin, HIGH);
+    delayMicroseconds(5);
+
+    for (uint8_t i = 0; i < 9 && digitalRead(this->_sdaPin) == LOW; i++)
+    {
+        digitalWrite(this->_sclPin, LOW);
+        delayMicroseconds(5);
+        digitalWrite(this->_sclPin, HIGH);
+        delayMicroseconds(5);
+    }
+
+    // STOP: SDA low to high while SCL is high
+    pinMode(this->_sdaPin, OUTPUT_OPENDRAIN);
+    digitalWrite(this->_sdaPin, LOW);
+    delayMicroseconds(5);
+    digitalWrite(this->_sdaPin, HIGH);
+    delayMicroseconds(5);
+    pinMode(this->_sdaPin, INPUT_PULLUP);
+    sdaFree = digitalRead(this->_sdaPin) == HIGH;
+
+    // Wire takes the pins back
+    this->_wire->begin();
+    this->_wire->setClock(this->_clockHz);
+    this->_lastError = I2C_ERR_NONE;
+
+    return sdaFree;
+}
+
+
+/**
+ * endTransmission() and keep why it failed. Teensy Wire codes: 1 too long, 
+ * 2 address NACK, 3 data NACK, 4 other (bus error, arbitration lost or 
+ * bus stuck), 5 timeout.
+ *
+ * @return  True if successful.
+ */
+bool TeensyI2CBus::_EndTransmission(bool sendStop)
+{
+    uint8_t status = this->_wire->endTransmission(sendStop);
+
+    switch (status)
+    {
+        case 0:
+            this->_lastError = I2C_ERR_NONE;
+            return true;
+        case 1:
+            this->_lastError = I2C_ERR_BAD_LENGTH;
+            break;
+        case 2:
+        case 3:
+            this->_lastError = I2C_ERR_NACK;
+            break;
+        default:
+            this->_lastError = I2C_ERR_TIMEOUT;
+            break;
+    }
+
+    return false;
+}
+
+
+/**
+ * requestFrom() and keep why it failed. No bytes at all is an address NACK 
+ * (or a stuck bus), some bytes is a short read.
+ *
+ * @return  True if all 'len' bytes arrived.
+ */
+bool TeensyI2CBus::_RequestFrom(uint8_t address, uint8_t len)
+{
+    uint8_t n = this->_wire->requestFrom(address, len);
+
+    if (n == len)
+    {
+        this->_lastError = I2C_ERR_NONE;
+        return true;
+    }
+
+    this->_lastError = (n == 0) ? I2C_ERR_NACK : I2C_ERR_SHORT_READ;
+    return false;
+}
+
+
+/**
+ * Bus the FXAS21002, FXOS8700, LIS3MDL and BMP388 are on, behind a monitor
+ * that keeps per-device error counts and recovers the bus when it sticks. 
+ * SensorAsyncI2C() drives the same LPI2C, so each transfer holds it off 
+ * (AsyncI2CSharedBus).
+ */
+I2CBus *SensorI2CBus()
+{
+    static TeensyI2CBus wire(&SENSOR_I2C, SENSOR_I2C_SDA_PIN, SENSOR_I2C_SCL_PIN, SENSOR_I2C_CLOCK_HZ);
+    static AsyncI2CSharedBus shared(&wire, SensorAsyncI2C());
+    static I2CBusMonitor bus(&shared);
+    return &bus;
+}
+
+
+/* Bus the GPS is on. Shares the sensor bus object if it's the same Wire. */
+I2CBus *GPSI2CBus()
+{
+    static TeensyI2CBus wire(&GPS_I2C, GPS_I2C_SDA_PIN, GPS_I2C_SCL_PIN);
+    static I2CBusMonitor bus(&wire);
+    TwoWire *gpsWire = &GPS_I2C;
+
+    if (gpsWire == &SENSOR_I2C)
+        return SensorI2CBus();
+    return &bus;
+}
+#endif
@@ -0,0 +1,83 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: HOST NON-VOLATILE STORAGE
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * NVStorage in RAM. See nv_storage_host.h. Host builds only.
+ */
+
+
+#ifndef ARDUINO
+#include <string.h>
+#include "hal/nv_storage_host.h"
+
+
+HostNVStorage::HostNVStorage()
+{
+    this->Erase();
+}
+
+
+/* Erase everything (0xFF) and clear the counters */
+void HostNVStorage::Erase()
+{
+    memset(this->mem, 0xFF, sizeof(this->mem));
+    this->writes = 0;
+    this->bytesWritten = 0;
+}
+
+
+uint16_t HostNVStorage::Size() const
+{
+    return HOST_NV_SIZE;
+}
+
+
+/* Read 'len' bytes. False if the range is past the end. */
+bool HostNVStorage::Read(uint16_t address, void *buf, uint16_t len)
+{
+    if ((uint32_t)address + len > HOST_NV_SIZE)
+        return false;
+
+    memcpy(buf, &this->mem[address], len);
+    return true;
+}
+
+
+/* Write 'len' bytes, counting the ones that change. False if past the end. */
+bool HostNVStorage::Write(uint16_t address, const void *buf, uint16_t len)
+{
+    const uint8_t *bytes = (const uint8_t *)buf;
+
+    if ((uint32_t)address + len > HOST_NV_SIZE)
+        return false;
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        if (this->mem[address + i] != bytes[i])
+        {
+            this->mem[address + i] = bytes[i];
+            this->bytesWritten++;
+        }
+    }
+
+    this->writes++;
+    return true;
+}
+
+
+/* Host default storage */
+HostNVStorage &HostPlatformNVStorage()
+{
+    static HostNVStorage storage;
+    return storage;
+}
+
+
+NVStorage *PlatformNVStorage()
+{
+    return &HostPlatformNVStorage();
+}
+#endif
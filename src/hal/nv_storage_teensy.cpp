@@ -0,0 +1,68 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: TEENSY NON-VOLATILE STORAGE
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * NVStorage on the Teensy's EEPROM. See nv_storage_teensy.h.
+ */
+
+
+#ifdef ARDUINO
+#include <EEPROM.h>
+#include "hal/nv_storage_teensy.h"
+
+
+/* Return the EEPROM size [bytes] */
+uint16_t TeensyNVStorage::Size() const
+{
+    return (uint16_t)EEPROM.length();
+}
+
+
+/**
+ * Read 'len' bytes.
+ *
+ * @return  True if successful, false if the range is past the end.
+ */
+bool TeensyNVStorage::Read(uint16_t address, void *buf, uint16_t len)
+{
+    uint8_t *bytes = (uint8_t *)buf;
+
+    if ((uint32_t)address + len > this->Size())
+        return false;
+
+    for (uint16_t i = 0; i < len; i++)
+        bytes[i] = EEPROM.read(address + i);
+
+    return true;
+}
+
+
+/**
+ * Write 'len' bytes. Bytes that already hold the value aren't rewritten.
+ *
+ * @return  True if successful, false if the range is past the end.
+ */
+bool TeensyNVStorage::Write(uint16_t address, const void *buf, uint16_t len)
+{
+    const uint8_t *bytes = (const uint8_t *)buf;
+
+    if ((uint32_t)address + len > this->Size())
+        return false;
+
+    for (uint16_t i = 0; i < len; i++)
+        EEPROM.update(address + i, bytes[i]);
+
+    return true;
+}
+
+
+/* The Teensy's EEPROM */
+NVStorage *PlatformNVStorage()
+{
+    static TeensyNVStorage storage;
+    return &storage;
+}
+#endif
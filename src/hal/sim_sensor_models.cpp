@@ -0,0 +1,1389 @@
+// ----------------------------------------------------------------------------
+// HARDWARE ABSTRACTION LAYER: SIMULATED SENSOR MODELS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Register-level models of the Hummingbird's I2C devices. See
+ * sim_sensor_models.h. Register addresses and bit fields are from the
+ * datasheets; only what the drivers use is modeled.
+ */
+
+
+#ifndef ARDUINO
+#include <math.h>
+#include <string.h>
+#include "hal/sim_sensor_models.h"
+#include "hal/hal_platform.h"
+
+
+// ----------------------------------------------------------------------------
+// SimRegisterDevice
+// ----------------------------------------------------------------------------
+SimRegisterDevice::SimRegisterDevice()
+{
+    memset(this->regs, 0, sizeof(this->regs));
+    this->samples = 0;
+    this->_ptr = 0;
+    this->_drdy = nullptr;
+    this->_nextSampleMicros = 0;
+}
+
+
+/* Burst read from 'reg'. The pointer moves with _NextReg(). */
+bool SimRegisterDevice::ReadRegs(uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    this->_ptr = reg;
+    return this->Read(buf, len);
+}
+
+
+/* Burst write from 'reg'. The pointer moves with _NextReg(). */
+bool SimRegisterDevice::WriteRegs(uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+    this->_Update();
+    this->_ptr = reg;
+    for (uint8_t i = 0; i < len; i++)
+    {
+        this->_WriteReg(this->_ptr, buf[i]);
+        this->_ptr = this->_NextReg(this->_ptr);
+    }
+
+    return true;
+}
+
+
+/* Burst read from the current register pointer */
+bool SimRegisterDevice::Read(uint8_t *buf, uint8_t len)
+{
+    this->_Update();
+    for (uint8_t i = 0; i < len; i++)
+    {
+        buf[i] = this->_ReadReg(this->_ptr);
+        this->_ptr = this->_NextReg(this->_ptr);
+    }
+
+    return true;
+}
+
+
+/**
+ * Connect the sensor's data-ready output to a DataReadyPin. Each new sample
+ * then calls Trigger() with the sample time, like the pin interrupt would.
+ *
+ * @param pin  Data-ready pin, e.g. the driver's 'drdy'. nullptr to disconnect.
+ */
+void SimRegisterDevice::ConnectDataReady(DataReadyPin *pin)
+{
+    this->_drdy = pin;
+}
+
+
+/* Start producing samples one period from now (standby -> active) */
+void SimRegisterDevice::_StartSampling(uint32_t periodMicros)
+{
+    this->_nextSampleMicros = HalSimMicros64() + periodMicros;
+}
+
+
+// ----------------------------------------------------------------------------
+// _NewSamples(uint32_t periodMicros)
+// ----------------------------------------------------------------------------
+/**
+ * Count the samples that became ready since the last call and raise the
+ * data-ready output for each.
+ *
+ * @param periodMicros  [us] Sample period (1/ODR).
+ * @return  Number of new samples.
+ */
+uint32_t SimRegisterDevice::_NewSamples(uint32_t periodMicros)
+{
+    uint64_t now = HalSimMicros64();
+    uint32_t n;
+
+    if (periodMicros == 0 || now < this->_nextSampleMicros)
+        return 0;
+
+    n = (uint32_t)((now - this->_nextSampleMicros) / periodMicros) + 1;
+    for (uint32_t k = 0; this->_drdy != nullptr && k < n; k++)
+        this->_drdy->Trigger(this->_nextSampleMicros + (uint64_t)k * periodMicros);
+
+    this->_nextSampleMicros += (uint64_t)n * periodMicros;
+    this->samples += n;
+    return n;
+}
+
+
+/* Convert a physical value to saturated int16 counts */
+int16_t SimRegisterDevice::_ToCounts(float val, float lsbPerUnit)
+{
+    float counts = roundf(val * lsbPerUnit);
+
+    if (counts > 32767.0f)
+        return 32767;
+    if (counts < -32768.0f)
+        return -32768;
+    return (int16_t)counts;
+}
+
+
+// ----------------------------------------------------------------------------
+// SimFXAS21002
+// ----------------------------------------------------------------------------
+constexpr uint8_t FXAS_STATUS = 0x00;  // DR_STATUS, or F_STATUS with the FIFO on
+constexpr uint8_t FXAS_OUT_X_MSB = 0x01;
+constexpr uint8_t FXAS_OUT_Z_LSB = 0x06;
+constexpr uint8_t FXAS_DR_STATUS = 0x07;
+constexpr uint8_t FXAS_F_STATUS = 0x08;
+constexpr uint8_t FXAS_F_SETUP = 0x09;
+constexpr uint8_t FXAS_WHO_AM_I = 0x0C;
+constexpr uint8_t FXAS_CTRL0 = 0x0D;
+constexpr uint8_t FXAS_TEMP = 0x12;
+constexpr uint8_t FXAS_CTRL1 = 0x13;
+constexpr uint8_t FXAS_CTRL3 = 0x15;
+
+
+SimFXAS21002::SimFXAS21002()
+{
+    this->_rate[0] = 0.0f;
+    this->_rate[1] = 0.0f;
+    this->_rate[2] = 0.0f;
+    this->Reset();
+}
+
+
+/* Power-on/software reset: standby, +/-2000dps, FIFO off */
+void SimFXAS21002::Reset()
+{
+    memset(this->regs, 0, sizeof(this->regs));
+    this->regs[FXAS_WHO_AM_I] = 0xD7;
+    this->regs[FXAS_TEMP] = 25;
+    this->_fifoCount = 0;
+    this->_fifoOverflow = false;
+}
+
+
+/* Set the angular rate [deg/s] */
+void SimFXAS21002::SetRate(float gx, float gy, float gz)
+{
+    this->_rate[0] = gx;
+    this->_rate[1] = gy;
+    this->_rate[2] = gz;
+}
+
+
+/* Set the die temperature [C] */
+void SimFXAS21002::SetTemperature(int8_t tempC)
+{
+    this->regs[FXAS_TEMP] = (uint8_t)tempC;
+}
+
+
+/* Samples in the FIFO at the current simulated time */
+uint8_t SimFXAS21002::FIFOCount()
+{
+    this->_Update();
+    return this->_fifoCount;
+}
+
+
+void SimFXAS21002::_Update()
+{
+    uint32_t n;
+
+    if (!(this->regs[FXAS_CTRL1] & 0x02))
+        return;  // Standby/ready
+
+    n = this->_NewSamples(this->_PeriodMicros());
+    if (n == 0)
+        return;
+
+    if (this->regs[FXAS_F_SETUP] >> 6)
+    {
+        if (this->_fifoCount + n > SIM_FIFO_SIZE)
+        {
+            this->_fifoOverflow = true;
+            this->_fifoCount = SIM_FIFO_SIZE;
+        }
+        else
+        {
+            this->_fifoCount = (uint8_t)(this->_fifoCount + n);
+        }
+    }
+    else
+    {
+        // ZYXOW if the previous sample wasn't read, then ZYXDR + XDR/YDR/ZDR
+        if (this->regs[FXAS_DR_STATUS] & 0x08)
+            this->regs[FXAS_DR_STATUS] |= 0xF0;
+        this->regs[FXAS_DR_STATUS] |= 0x0F;
+    }
+}
+
+
+uint8_t SimFXAS21002::_ReadReg(uint8_t reg)
+{
+    bool fifoOn = (this->regs[FXAS_F_SETUP] >> 6) != 0;
+    uint8_t wmk = this->regs[FXAS_F_SETUP] & 0x3F;
+
+    if (reg == FXAS_F_STATUS || (reg == FXAS_STATUS && fifoOn))
+    {
+        uint8_t fStatus = this->_fifoCount;
+        if (this->_fifoOverflow)
+            fStatus |= 0x80;
+        if (wmk > 0 && this->_fifoCount >= wmk)
+            fStatus |= 0x40;
+        this->_fifoOverflow = false;
+        return fStatus;
+    }
+
+    if (reg == FXAS_STATUS)
+        return this->regs[FXAS_DR_STATUS];
+
+    if (reg >= FXAS_OUT_X_MSB && reg <= FXAS_OUT_Z_LSB)
+    {
+        uint8_t idx = (uint8_t)(reg - FXAS_OUT_X_MSB);
+        uint16_t counts = (uint16_t)_ToCounts(this->_rate[idx / 2], this->_LSBPerDPS());
+
+        // Reading Z LSB finishes the sample: pop the FIFO or clear DR_STATUS
+        if (reg == FXAS_OUT_Z_LSB)
+        {
+            if (fifoOn && this->_fifoCount > 0)
+                this->_fifoCount--;
+            else if (!fifoOn)
+                this->regs[FXAS_DR_STATUS] = 0x00;
+        }
+
+        return (idx % 2 == 0) ? (uint8_t)(counts >> 8) : (uint8_t)(counts & 0xFF);
+    }
+
+    return this->regs[reg];
+}
+
+
+void SimFXAS21002::_WriteReg(uint8_t reg, uint8_t val)
+{
+    bool wasActive;
+
+    switch (reg)
+    {
+        case FXAS_CTRL1:
+            if (val & 0x40)
+            {
+                this->Reset();  // RST
+                return;
+            }
+            wasActive = (this->regs[FXAS_CTRL1] & 0x02) != 0;
+            this->regs[FXAS_CTRL1] = val;
+            if (!wasActive && (val & 0x02))
+                this->_StartSampling(this->_PeriodMicros());
+            break;
+        case FXAS_F_SETUP:
+            this->regs[FXAS_F_SETUP] = val;
+            if ((val >> 6) == 0)
+            {
+                this->_fifoCount = 0;
+                this->_fifoOverflow = false;
+            }
+            break;
+        case FXAS_STATUS:
+        case FXAS_DR_STATUS:
+        case FXAS_F_STATUS:
+        case FXAS_WHO_AM_I:
+        case FXAS_TEMP:
+            break;  // Read-only
+        default:
+            if (reg >= FXAS_OUT_X_MSB && reg <= FXAS_OUT_Z_LSB)
+                break;  // Read-only
+            this->regs[reg] = val;
+            break;
+    }
+}
+
+
+/* Z LSB rolls over to STATUS, or to X MSB with CTRL_REG3[WRAPTOONE] */
+uint8_t SimFXAS21002::_NextReg(uint8_t reg)
+{
+    if (reg == FXAS_OUT_Z_LSB)
+        return (this->regs[FXAS_CTRL3] & 0x08) ? FXAS_OUT_X_MSB : FXAS_STATUS;
+    return (uint8_t)(reg + 1);
+}
+
+
+/* LSB per deg/s for CTRL_REG0[FS] */
+float SimFXAS21002::_LSBPerDPS()
+{
+    static const float lsbPerDPS[4] = {16.0f, 32.0f, 64.0f, 128.0f};  // 2000, 1000, 500, 250dps
+    return lsbPerDPS[this->regs[FXAS_CTRL0] & 0x03];
+}
+
+
+/* Sample period for CTRL_REG1[DR] [us] */
+uint32_t SimFXAS21002::_PeriodMicros()
+{
+    uint8_t dr = (this->regs[FXAS_CTRL1] >> 2) & 0x07;
+    return (dr >= 6) ? 80000UL : (1250UL << dr);  // 800Hz ... 25Hz, 12.5Hz
+}
+
+
+// ----------------------------------------------------------------------------
+// SimFXOS8700
+// ----------------------------------------------------------------------------
+constexpr uint8_t FXOS_STATUS = 0x00;  // DR_STATUS, or F_STATUS with the FIFO on
+constexpr uint8_t FXOS_OUT_X_MSB = 0x01;
+constexpr uint8_t FXOS_OUT_Z_LSB = 0x06;
+constexpr uint8_t FXOS_F_SETUP = 0x09;
+constexpr uint8_t FXOS_WHO_AM_I = 0x0D;
+constexpr uint8_t FXOS_XYZ_DATA_CFG = 0x0E;
+constexpr uint8_t FXOS_CTRL1 = 0x2A;
+constexpr uint8_t FXOS_CTRL2 = 0x2B;
+constexpr uint8_t FXOS_M_DR_STATUS = 0x32;
+constexpr uint8_t FXOS_M_OUT_X_MSB = 0x33;
+constexpr uint8_t FXOS_M_OUT_Z_LSB = 0x38;
+constexpr uint8_t FXOS_M_CTRL1 = 0x5B;
+constexpr uint8_t FXOS_M_CTRL2 = 0x5C;
+
+
+SimFXOS8700::SimFXOS8700()
+{
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        this->_accel[i] = 0.0f;
+        this->_mag[i] = 0.0f;
+    }
+    this->Reset();
+}
+
+
+/* Power-on/software reset: standby, +/-2g, accel. only, FIFO off */
+void SimFXOS8700::Reset()
+{
+    memset(this->regs, 0, sizeof(this->regs));
+    this->regs[FXOS_WHO_AM_I] = 0xC7;
+    this->_fifoCount = 0;
+    this->_fifoOverflow = false;
+}
+
+
+/* Set the acceleration [G's] */
+void SimFXOS8700::SetAccel(float ax, float ay, float az)
+{
+    this->_accel[0] = ax;
+    this->_accel[1] = ay;
+    this->_accel[2] = az;
+}
+
+
+/* Set the magnetic field [uT] */
+void SimFXOS8700::SetMag(float mx, float my, float mz)
+{
+    this->_mag[0] = mx;
+    this->_mag[1] = my;
+    this->_mag[2] = mz;
+}
+
+
+/* Samples in the FIFO at the current simulated time */
+uint8_t SimFXOS8700::FIFOCount()
+{
+    this->_Update();
+    return this->_fifoCount;
+}
+
+
+void SimFXOS8700::_Update()
+{
+    uint32_t n;
+
+    if (!(this->regs[FXOS_CTRL1] & 0x01))
+        return;  // Standby
+
+    n = this->_NewSamples(this->_PeriodMicros());
+    if (n == 0)
+        return;
+
+    if (this->regs[FXOS_F_SETUP] >> 6)
+    {
+        if (this->_fifoCount + n > SIM_FIFO_SIZE)
+        {
+            this->_fifoOverflow = true;
+            this->_fifoCount = SIM_FIFO_SIZE;
+        }
+        else
+        {
+            this->_fifoCount = (uint8_t)(this->_fifoCount + n);
+        }
+    }
+    else
+    {
+        if (this->regs[FXOS_STATUS] & 0x08)
+            this->regs[FXOS_STATUS] |= 0xF0;  // ZYXOW
+        this->regs[FXOS_STATUS] |= 0x0F;  // ZYXDR
+    }
+
+    if (this->regs[FXOS_M_CTRL1] & 0x01)
+        this->regs[FXOS_M_DR_STATUS] |= 0x0F;  // Mag. (or hybrid) enabled
+}
+
+
+uint8_t SimFXOS8700::_ReadReg(uint8_t reg)
+{
+    static const float lsbPerG[4] = {4096.0f, 2048.0f, 1024.0f, 1024.0f};  // 2g, 4g, 8g (14-bit)
+    bool fifoOn = (this->regs[FXOS_F_SETUP] >> 6) != 0;
+
+    if (reg == FXOS_STATUS)
+    {
+        if (!fifoOn)
+            return this->regs[FXOS_STATUS];
+
+        uint8_t fStatus = this->_fifoCount;
+        uint8_t wmk = this->regs[FXOS_F_SETUP] & 0x3F;
+        if (this->_fifoOverflow)
+            fStatus |= 0x80;
+        if (wmk > 0 && this->_fifoCount >= wmk)
+            fStatus |= 0x40;
+        this->_fifoOverflow = false;
+        return fStatus;
+    }
+
+    if (reg >= FXOS_OUT_X_MSB && reg <= FXOS_OUT_Z_LSB)
+    {
+        uint8_t idx = (uint8_t)(reg - FXOS_OUT_X_MSB);
+        float counts = roundf(this->_accel[idx / 2] * lsbPerG[this->regs[FXOS_XYZ_DATA_CFG] & 0x03]);
+        uint16_t val;
+
+        // 14-bit, left-aligned
+        if (counts > 8191.0f)
+            counts = 8191.0f;
+        if (counts < -8192.0f)
+            counts = -8192.0f;
+        val = (uint16_t)((int16_t)counts * 4);
+
+        if (reg == FXOS_OUT_Z_LSB)
+        {
+            if (fifoOn && this->_fifoCount > 0)
+                this->_fifoCount--;
+            else if (!fifoOn)
+                this->regs[FXOS_STATUS] = 0x00;
+        }
+
+        return (idx % 2 == 0) ? (uint8_t)(val >> 8) : (uint8_t)(val & 0xFF);
+    }
+
+    if (reg >= FXOS_M_OUT_X_MSB && reg <= FXOS_M_OUT_Z_LSB)
+    {
+        uint8_t idx = (uint8_t)(reg - FXOS_M_OUT_X_MSB);
+        uint16_t val = (uint16_t)_ToCounts(this->_mag[idx / 2], 10.0f);  // 0.1uT/LSB
+
+        if (reg == FXOS_M_OUT_Z_LSB)
+            this->regs[FXOS_M_DR_STATUS] = 0x00;
+
+        return (idx % 2 == 0) ? (uint8_t)(val >> 8) : (uint8_t)(val & 0xFF);
+    }
+
+    return this->regs[reg];
+}
+
+
+void SimFXOS8700::_WriteReg(uint8_t reg, uint8_t val)
+{
+    bool wasActive;
+
+    if (reg <= FXOS_OUT_Z_LSB || reg == FXOS_WHO_AM_I)
+        return;  // Read-only
+    if (reg >= FXOS_M_DR_STATUS && reg <= FXOS_M_OUT_Z_LSB)
+        return;  // Read-only
+
+    switch (reg)
+    {
+        case FXOS_CTRL1:
+            wasActive = (this->regs[FXOS_CTRL1] & 0x01) != 0;
+            this->regs[FXOS_CTRL1] = val;
+            if (!wasActive && (val & 0x01))
+                this->_StartSampling(this->_PeriodMicros());
+            break;
+        case FXOS_CTRL2:
+            if (val & 0x40)
+                this->Reset();  // RST
+            else
+                this->regs[FXOS_CTRL2] = val;
+            break;
+        case FXOS_F_SETUP:
+            this->regs[FXOS_F_SETUP] = val;
+            if ((val >> 6) == 0)
+            {
+                this->_fifoCount = 0;
+                this->_fifoOverflow = false;
+            }
+            break;
+        default:
+            this->regs[reg] = val;
+            break;
+    }
+}
+
+
+/**
+ * With the FIFO on, Z LSB rolls over to X MSB (next FIFO sample). Otherwise,
+ * with M_CTRL_REG2[hyb_autoinc_mode], it jumps to the mag. registers, and the
+ * mag. Z LSB rolls over to STATUS.
+ */
+uint8_t SimFXOS8700::_NextReg(uint8_t reg)
+{
+    bool hybAutoInc = (this->regs[FXOS_M_CTRL2] & 0x20) != 0;
+
+    if (reg == FXOS_OUT_Z_LSB)
+    {
+        if (this->regs[FXOS_F_SETUP] >> 6)
+            return FXOS_OUT_X_MSB;
+        return hybAutoInc ? FXOS_M_OUT_X_MSB : (uint8_t)(reg + 1);
+    }
+    if (reg == FXOS_M_OUT_Z_LSB && hybAutoInc)
+        return FXOS_STATUS;
+    return (uint8_t)(reg + 1);
+}
+
+
+/* True if M_CTRL_REG1[m_hms] selects hybrid mode */
+bool SimFXOS8700::_IsHybrid()
+{
+    return (this->regs[FXOS_M_CTRL1] & 0x03) == 0x03;
+}
+
+
+/* Sample period for CTRL_REG1[DR] [us]. Hybrid mode halves the ODR. */
+uint32_t SimFXOS8700::_PeriodMicros()
+{
+    static const uint32_t periods[8] = {1250, 2500, 5000, 10000, 20000, 80000, 160000, 640000};
+    uint32_t period = periods[(this->regs[FXOS_CTRL1] >> 3) & 0x07];
+    return this->_IsHybrid() ? 2 * period : period;
+}
+
+
+// ----------------------------------------------------------------------------
+// SimLIS3MDL
+// ----------------------------------------------------------------------------
+constexpr uint8_t LIS_WHO_AM_I = 0x0F;
+constexpr uint8_t LIS_CTRL_REG1 = 0x20;
+constexpr uint8_t LIS_CTRL_REG2 = 0x21;
+constexpr uint8_t LIS_CTRL_REG3 = 0x22;
+constexpr uint8_t LIS_STATUS = 0x27;
+constexpr uint8_t LIS_OUT_X_L = 0x28;
+constexpr uint8_t LIS_OUT_Z_H = 0x2D;
+constexpr uint8_t LIS_TEMP_OUT_L = 0x2E;
+constexpr uint8_t LIS_TEMP_OUT_H = 0x2F;
+
+
+SimLIS3MDL::SimLIS3MDL()
+{
+    this->_field[0] = 0.0f;
+    this->_field[1] = 0.0f;
+    this->_field[2] = 0.0f;
+    this->_tempC = 25.0f;
+    this->_autoInc = false;
+    this->Reset();
+}
+
+
+/* Power-on/software reset: power-down, 10Hz, +/-4 gauss */
+void SimLIS3MDL::Reset()
+{
+    memset(this->regs, 0, sizeof(this->regs));
+    this->regs[LIS_WHO_AM_I] = 0x3D;
+    this->regs[LIS_CTRL_REG1] = 0x10;
+    this->regs[LIS_CTRL_REG3] = 0x03;
+}
+
+
+/* Sub-address bit 7 enables auto-increment for this burst */
+bool SimLIS3MDL::ReadRegs(uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    this->_autoInc = (reg & 0x80) != 0;
+    return SimRegisterDevice::ReadRegs(reg & 0x7F, buf, len);
+}
+
+
+bool SimLIS3MDL::WriteRegs(uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+    this->_autoInc = (reg & 0x80) != 0;
+    return SimRegisterDevice::WriteRegs(reg & 0x7F, buf, len);
+}
+
+
+/* Set the magnetic field [uT] */
+void SimLIS3MDL::SetField(float mx, float my, float mz)
+{
+    this->_field[0] = mx;
+    this->_field[1] = my;
+    this->_field[2] = mz;
+}
+
+
+/* Set the die temperature [C] */
+void SimLIS3MDL::SetTemperature(float tempC)
+{
+    this->_tempC = tempC;
+}
+
+
+void SimLIS3MDL::_Update()
+{
+    if ((this->regs[LIS_CTRL_REG3] & 0x03) != 0)
+        return;  // Not in continuous-conversion mode
+
+    if (this->_NewSamples(this->_PeriodMicros()) == 0)
+        return;
+
+    if (this->regs[LIS_STATUS] & 0x08)
+        this->regs[LIS_STATUS] |= 0xF0;  // ZYXOR
+    this->regs[LIS_STATUS] |= 0x0F;  // ZYXDA
+}
+
+
+uint8_t SimLIS3MDL::_ReadReg(uint8_t reg)
+{
+    static const float lsbPerUT[4] = {68.42f, 34.21f, 22.81f, 17.11f};  // 4, 8, 12, 16 gauss
+    uint16_t val;
+
+    if (reg >= LIS_OUT_X_L && reg <= LIS_OUT_Z_H)
+    {
+        uint8_t idx = (uint8_t)(reg - LIS_OUT_X_L);
+        val = (uint16_t)_ToCounts(this->_field[idx / 2], lsbPerUT[(this->regs[LIS_CTRL_REG2] >> 5) & 0x03]);
+
+        if (reg == LIS_OUT_Z_H)
+            this->regs[LIS_STATUS] = 0x00;
+
+        return (idx % 2 == 0) ? (uint8_t)(val & 0xFF) : (uint8_t)(val >> 8);  // LSB first
+    }
+
+    if (reg == LIS_TEMP_OUT_L || reg == LIS_TEMP_OUT_H)
+    {
+        val = (uint16_t)_ToCounts(this->_tempC - 25.0f, 8.0f);  // 8 LSB/C, 0 at 25C
+        return (reg == LIS_TEMP_OUT_L) ? (uint8_t)(val & 0xFF) : (uint8_t)(val >> 8);
+    }
+
+    return this->regs[reg];
+}
+
+
+void SimLIS3MDL::_WriteReg(uint8_t reg, uint8_t val)
+{
+    bool wasActive;
+
+    switch (reg)
+    {
+        case LIS_CTRL_REG1:
+            this->regs[LIS_CTRL_REG1] = val;
+            if ((this->regs[LIS_CTRL_REG3] & 0x03) == 0)
+                this->_StartSampling(this->_PeriodMicros());  // New ODR
+            break;
+        case LIS_CTRL_REG2:
+            if (val & 0x04)
+                this->Reset();  // SOFT_RST
+            else
+                this->regs[LIS_CTRL_REG2] = val;
+            break;
+        case LIS_CTRL_REG3:
+            wasActive = (this->regs[LIS_CTRL_REG3] & 0x03) == 0;
+            this->regs[LIS_CTRL_REG3] = val;
+            if ((val & 0x03) == 0x01)
+            {
+                // Single conversion, then idle
+                this->regs[LIS_STATUS] |= 0x0F;
+                this->regs[LIS_CTRL_REG3] = (uint8_t)(val | 0x03);
+                this->samples++;
+                if (this->_drdy != nullptr)
+                    this->_drdy->Trigger(HalSimMicros64());
+            }
+            else if (!wasActive && (val & 0x03) == 0)
+            {
+                this->_StartSampling(this->_PeriodMicros());
+            }
+            break;
+        case LIS_WHO_AM_I:
+            break;  // Read-only
+        default:
+            if (reg >= LIS_STATUS && reg <= LIS_TEMP_OUT_H)
+                break;  // Read-only
+            this->regs[reg] = val;
+            break;
+    }
+}
+
+
+/* Only auto-increments if the burst's sub-address had bit 7 set */
+uint8_t SimLIS3MDL::_NextReg(uint8_t reg)
+{
+    return this->_autoInc ? (uint8_t)((reg + 1) & 0x7F) : reg;
+}
+
+
+/* Sample period for CTRL_REG1[DO], or [OM] with FAST_ODR [us] */
+uint32_t SimLIS3MDL::_PeriodMicros()
+{
+    static const uint32_t fastHz[4] = {1000, 560, 300, 155};  // Low-power ... ultra-high performance
+    static const uint32_t doMilliHz[8] = {625, 1250, 2500, 5000, 10000, 20000, 40000, 80000};
+    uint8_t ctrl1 = this->regs[LIS_CTRL_REG1];
+
+    if (ctrl1 & 0x02)
+        return 1000000UL / fastHz[(ctrl1 >> 5) & 0x03];
+    return (uint32_t)(1000000000ULL / doMilliHz[(ctrl1 >> 2) & 0x07]);
+}
+
+
+// ----------------------------------------------------------------------------
+// SimBMP388
+// ----------------------------------------------------------------------------
+constexpr uint8_t BMP_CHIP_ID = 0x00;
+constexpr uint8_t BMP_STATUS = 0x03;
+constexpr uint8_t BMP_DATA_0 = 0x04;  // Pressure XLSB, LSB, MSB, then temperature XLSB, LSB, MSB
+constexpr uint8_t BMP_DATA_2 = 0x06;
+constexpr uint8_t BMP_DATA_5 = 0x09;
+constexpr uint8_t BMP_INT_STATUS = 0x11;
+constexpr uint8_t BMP_FIFO_LENGTH_0 = 0x12;
+constexpr uint8_t BMP_FIFO_LENGTH_1 = 0x13;
+constexpr uint8_t BMP_FIFO_DATA = 0x14;
+constexpr uint8_t BMP_FIFO_CONFIG_1 = 0x17;
+constexpr uint8_t BMP_PWR_CTRL = 0x1B;
+constexpr uint8_t BMP_OSR = 0x1C;
+constexpr uint8_t BMP_ODR = 0x1D;
+constexpr uint8_t BMP_NVM_START = 0x31;
+constexpr uint8_t BMP_CMD = 0x7E;
+
+/**
+ * NVM trimming coefficients, 0x31 to 0x45. Typical values from a BMP388
+ * breakout.
+ */
+constexpr uint8_t BMP_NVM_LEN = 21;
+static const uint8_t BMP_NVM[BMP_NVM_LEN] = {
+    0xE1, 0x6C,  // par_t1 = 27873
+    0xE3, 0x4A,  // par_t2 = 19171
+    0xF9,        // par_t3 = -7
+    0xB5, 0xFD,  // par_p1 = -587
+    0x3E, 0xF5,  // par_p2 = -2754
+    0x23,        // par_p3 = 35
+    0x01,        // par_p4 = 1
+    0x9F, 0x65,  // par_p5 = 26015
+    0xB4, 0x74,  // par_p6 = 29876
+    0x03,        // par_p7 = 3
+    0xFA,        // par_p8 = -6
+    0x68, 0x42,  // par_p9 = 17000
+    0x14,        // par_p10 = 20
+    0xC4         // par_p11 = -60
+};
+
+
+SimBMP388::SimBMP388()
+{
+    const uint8_t *n = BMP_NVM;
+
+    // Datasheet section 9.1: fixed-point NVM values to floating point
+    this->_calib.t1 = (double)(uint16_t)(n[1] << 8 | n[0]) / pow(2.0, -8);
+    this->_calib.t2 = (double)(uint16_t)(n[3] << 8 | n[2]) / pow(2.0, 30);
+    this->_calib.t3 = (double)(int8_t)n[4] / pow(2.0, 48);
+    this->_calib.p1 = ((double)(int16_t)(n[6] << 8 | n[5]) - pow(2.0, 14)) / pow(2.0, 20);
+    this->_calib.p2 = ((double)(int16_t)(n[8] << 8 | n[7]) - pow(2.0, 14)) / pow(2.0, 29);
+    this->_calib.p3 = (double)(int8_t)n[9] / pow(2.0, 32);
+    this->_calib.p4 = (double)(int8_t)n[10] / pow(2.0, 37);
+    this->_calib.p5 = (double)(uint16_t)(n[12] << 8 | n[11]) / pow(2.0, -3);
+    this->_calib.p6 = (double)(uint16_t)(n[14] << 8 | n[13]) / pow(2.0, 6);
+    this->_calib.p7 = (double)(int8_t)n[15] / pow(2.0, 8);
+    this->_calib.p8 = (double)(int8_t)n[16] / pow(2.0, 15);
+    this->_calib.p9 = (double)(int16_t)(n[18] << 8 | n[17]) / pow(2.0, 48);
+    this->_calib.p10 = (double)(int8_t)n[19] / pow(2.0, 48);
+    this->_calib.p11 = (double)(int8_t)n[20] / pow(2.0, 65);
+
+    this->_pressPa = 101325.0f;
+    this->_tempC = 25.0f;
+    this->_Invert();
+    this->Reset();
+}
+
+
+/* Power-on/soft reset: sleep mode, NVM loaded, data registers cleared */
+void SimBMP388::Reset()
+{
+    memset(this->regs, 0, sizeof(this->regs));
+    this->regs[BMP_CHIP_ID] = 0x50;
+    this->regs[BMP_STATUS] = 0x10;  // cmd_rdy
+    this->regs[BMP_OSR] = 0x02;
+    memcpy(&this->regs[BMP_NVM_START], BMP_NVM, BMP_NVM_LEN);
+    this->_fifoLen = 0;
+    this->_fifoRead = 0;
+}
+
+
+/* Set the pressure [Pa] */
+void SimBMP388::SetPressure(float pressPa)
+{
+    this->_pressPa = pressPa;
+    this->_Invert();
+}
+
+
+/* Set the temperature [C] */
+void SimBMP388::SetTemperature(float tempC)
+{
+    this->_tempC = tempC;
+    this->_Invert();
+}
+
+
+/* Return the FIFO fill level [bytes] */
+uint16_t SimBMP388::FIFOLength()
+{
+    this->_Update();
+    return (uint16_t)(this->_fifoLen - this->_fifoRead);
+}
+
+
+/* Bosch floating-point temperature compensation. Returns [C]. */
+double SimBMP388::CompensateTemperature(uint32_t rawT) const
+{
+    double pd1 = (double)rawT - this->_calib.t1;
+    double pd2 = pd1 * this->_calib.t2;
+    return pd2 + pd1 * pd1 * this->_calib.t3;
+}
+
+
+/* Bosch floating-point pressure compensation. Returns [Pa]. */
+double SimBMP388::CompensatePressure(uint32_t rawP, double tempC) const
+{
+    const SimBMP388Calib_t &c = this->_calib;
+    double t = tempC;
+    double up = (double)rawP;
+    double out1 = c.p5 + c.p6 * t + c.p7 * t * t + c.p8 * t * t * t;
+    double out2 = up * (c.p1 + c.p2 * t + c.p3 * t * t + c.p4 * t * t * t);
+    double out3 = up * up * (c.p9 + c.p10 * t) + up * up * up * c.p11;
+    return out1 + out2 + out3;
+}
+
+
+void SimBMP388::_Update()
+{
+    if (((this->regs[BMP_PWR_CTRL] >> 4) & 0x03) != 0x03)
+        return;  // Not in normal mode
+
+    uint32_t n = this->_NewSamples(this->_PeriodMicros());
+
+    if (n == 0)
+        return;
+
+    this->_Convert();
+    if (this->regs[BMP_FIFO_CONFIG_1] & 0x01)
+    {
+        // More than a FIFO's worth only overwrites frames that were never read
+        if (n > SIM_BMP388_FIFO_SIZE / 4)
+            n = SIM_BMP388_FIFO_SIZE / 4;
+        for (uint32_t k = 0; k < n; k++)
+            this->_PushFrame();
+    }
+}
+
+
+uint8_t SimBMP388::_ReadReg(uint8_t reg)
+{
+    uint8_t val = this->regs[reg];
+    uint16_t fifoLen = (uint16_t)(this->_fifoLen - this->_fifoRead);
+
+    if (reg == BMP_FIFO_LENGTH_0)
+        return (uint8_t)(fifoLen & 0xFF);
+    if (reg == BMP_FIFO_LENGTH_1)
+        return (uint8_t)(fifoLen >> 8);
+    if (reg == BMP_FIFO_DATA)
+    {
+        if (fifoLen == 0)
+            return 0x80;  // Empty frame
+        val = this->_fifo[this->_fifoRead++];
+        if (this->_fifoRead == this->_fifoLen)
+        {
+            this->_fifoLen = 0;
+            this->_fifoRead = 0;
+        }
+        return val;
+    }
+
+    // Reading a data MSB clears its data-ready bit; INT_STATUS clears on read
+    if (reg == BMP_DATA_2)
+        this->regs[BMP_STATUS] &= (uint8_t)~0x20;
+    else if (reg == BMP_DATA_5)
+        this->regs[BMP_STATUS] &= (uint8_t)~0x40;
+    else if (reg == BMP_INT_STATUS)
+        this->regs[BMP_INT_STATUS] = 0x00;
+
+    return val;
+}
+
+
+void SimBMP388::_WriteReg(uint8_t reg, uint8_t val)
+{
+    uint8_t mode;
+    bool wasNormal;
+
+    if (reg <= BMP_FIFO_DATA || (reg >= BMP_NVM_START && reg < BMP_NVM_START + BMP_NVM_LEN))
+        return;  // Read-only
+
+    switch (reg)
+    {
+        case BMP_PWR_CTRL:
+            wasNormal = ((this->regs[BMP_PWR_CTRL] >> 4) & 0x03) == 0x03;
+            this->regs[BMP_PWR_CTRL] = val;
+            mode = (val >> 4) & 0x03;
+            if (mode == 0x01 || mode == 0x02)
+            {
+                // Forced: one conversion, then back to sleep
+                this->_Convert();
+                this->samples++;
+                if (this->_drdy != nullptr)
+                    this->_drdy->Trigger(HalSimMicros64());
+                this->regs[BMP_PWR_CTRL] = val & 0x0F;
+            }
+            else if (mode == 0x03 && !wasNormal)
+            {
+                this->_StartSampling(this->_PeriodMicros());
+            }
+            break;
+        case BMP_FIFO_CONFIG_1:
+            this->regs[BMP_FIFO_CONFIG_1] = val;
+            if ((val & 0x01) == 0)
+            {
+                this->_fifoLen = 0;  // FIFO off
+                this->_fifoRead = 0;
+            }
+            break;
+        case BMP_CMD:
+            if (val == 0xB6)
+            {
+                this->Reset();  // softreset
+            }
+            else if (val == 0xB0)
+            {
+                this->_fifoLen = 0;  // fifo_flush
+                this->_fifoRead = 0;
+            }
+            break;
+        default:
+            this->regs[reg] = val;
+            break;
+    }
+}
+
+
+/* Latch a conversion into the data registers and set the data-ready bits */
+void SimBMP388::_Convert()
+{
+    uint8_t pwr = this->regs[BMP_PWR_CTRL];
+
+    if (pwr & 0x01)
+    {
+        this->regs[BMP_DATA_0] = (uint8_t)(this->_rawP);
+        this->regs[BMP_DATA_0 + 1] = (uint8_t)(this->_rawP >> 8);
+        this->regs[BMP_DATA_0 + 2] = (uint8_t)(this->_rawP >> 16);
+        this->regs[BMP_STATUS] |= 0x20;
+    }
+    if (pwr & 0x02)
+    {
+        this->regs[BMP_DATA_0 + 3] = (uint8_t)(this->_rawT);
+        this->regs[BMP_DATA_0 + 4] = (uint8_t)(this->_rawT >> 8);
+        this->regs[BMP_DATA_0 + 5] = (uint8_t)(this->_rawT >> 16);
+        this->regs[BMP_STATUS] |= 0x40;
+    }
+    this->regs[BMP_INT_STATUS] |= 0x08;  // drdy
+}
+
+
+/**
+ * Add a header-mode frame for the enabled FIFO data (fifo_press_en,
+ * fifo_temp_en): header, then temperature and pressure, 24-bit XLSB first.
+ * When full, the oldest frames go unless fifo_stop_on_full is set.
+ */
+void SimBMP388::_PushFrame()
+{
+    uint8_t cfg = this->regs[BMP_FIFO_CONFIG_1];
+    uint8_t frame[7];
+    uint8_t len = 1;
+
+    if ((cfg & 0x18) == 0)
+        return;  // Nothing enabled
+
+    frame[0] = (uint8_t)(0x80 | ((cfg & 0x10) ? 0x10 : 0x00) | ((cfg & 0x08) ? 0x04 : 0x00));
+    if (cfg & 0x10)
+    {
+        frame[len++] = (uint8_t)(this->_rawT);
+        frame[len++] = (uint8_t)(this->_rawT >> 8);
+        frame[len++] = (uint8_t)(this->_rawT >> 16);
+    }
+    if (cfg & 0x08)
+    {
+        frame[len++] = (uint8_t)(this->_rawP);
+        frame[len++] = (uint8_t)(this->_rawP >> 8);
+        frame[len++] = (uint8_t)(this->_rawP >> 16);
+    }
+
+    // Move unread bytes to the front
+    if (this->_fifoRead > 0)
+    {
+        memmove(this->_fifo, &this->_fifo[this->_fifoRead], this->_fifoLen - this->_fifoRead);
+        this->_fifoLen = (uint16_t)(this->_fifoLen - this->_fifoRead);
+        this->_fifoRead = 0;
+    }
+
+    if (this->_fifoLen + len > SIM_BMP388_FIFO_SIZE)
+    {
+        if (cfg & 0x02)
+            return;  // fifo_stop_on_full
+
+        // Frames are all the same length, so drop one from the front
+        memmove(this->_fifo, &this->_fifo[len], this->_fifoLen - len);
+        this->_fifoLen = (uint16_t)(this->_fifoLen - len);
+    }
+
+    memcpy(&this->_fifo[this->_fifoLen], frame, len);
+    this->_fifoLen = (uint16_t)(this->_fifoLen + len);
+}
+
+
+/**
+ * Find the 24-bit ADC values that compensate to the set temperature and
+ * pressure. Both compensations are monotonic over the ADC range, so a
+ * bisection on the raw value converges in 24 steps.
+ */
+void SimBMP388::_Invert()
+{
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t mid;
+    bool rising;
+    double tempC;
+    double targetT = (double)this->_tempC;
+    double targetP = (double)this->_pressPa;
+
+    lo = 0;
+    hi = 0xFFFFFF;
+    rising = this->CompensateTemperature(hi) > this->CompensateTemperature(lo);
+    while (hi - lo > 1)
+    {
+        mid = lo + (hi - lo) / 2;
+        if ((this->CompensateTemperature(mid) < targetT) == rising)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    this->_rawT = (fabs(this->CompensateTemperature(lo) - targetT) <
+        fabs(this->CompensateTemperature(hi) - targetT)) ? lo : hi;
+
+    // Pressure compensation uses the compensated temperature, like the driver
+    tempC = this->CompensateTemperature(this->_rawT);
+    lo = 0;
+    hi = 0xFFFFFF;
+    rising = this->CompensatePressure(hi, tempC) > this->CompensatePressure(lo, tempC);
+    while (hi - lo > 1)
+    {
+        mid = lo + (hi - lo) / 2;
+        if ((this->CompensatePressure(mid, tempC) < targetP) == rising)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    this->_rawP = (fabs(this->CompensatePressure(lo, tempC) - targetP) <
+        fabs(this->CompensatePressure(hi, tempC) - targetP)) ? lo : hi;
+}
+
+
+/**
+ * Writes don't auto-increment: after the first data byte, the rest of the
+ * transfer is register address/data pairs.
+ */
+bool SimBMP388::WriteRegs(uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+    if (len == 0)
+        return true;
+
+    this->_Update();
+    this->_WriteReg(reg, buf[0]);
+    for (uint8_t i = 1; i + 1 < len; i += 2)
+        this->_WriteReg(buf[i], buf[i + 1]);
+    this->_ptr = reg;
+
+    return true;
+}
+
+
+/* Burst reads of FIFO_DATA stay on it, so they walk through the FIFO */
+uint8_t SimBMP388::_NextReg(uint8_t reg)
+{
+    return (reg == BMP_FIFO_DATA) ? reg : (uint8_t)(reg + 1);
+}
+
+
+/* Sample period for ODR[odr_sel], 5ms * 2^odr_sel [us] */
+uint32_t SimBMP388::_PeriodMicros()
+{
+    uint8_t sel = this->regs[BMP_ODR] & 0x1F;
+    if (sel > 17)
+        sel = 17;
+    return 5000UL << sel;
+}
+
+
+// ----------------------------------------------------------------------------
+// SimUbloxI2C
+// ----------------------------------------------------------------------------
+constexpr uint8_t UBLOX_REG_COUNT_HI = 0xFD;
+constexpr uint8_t UBLOX_REG_COUNT_LO = 0xFE;
+constexpr uint8_t UBLOX_REG_STREAM = 0xFF;
+
+
+SimUbloxI2C::SimUbloxI2C()
+{
+    this->nReceived = 0;
+    this->ubxMessages = 0;
+    this->ubxBadChecksums = 0;
+    this->dropped = 0;
+    this->lastClass = 0;
+    this->lastId = 0;
+    this->_txHead = 0;
+    this->_txTail = 0;
+    this->_countLatch = 0;
+    this->_ptr = UBLOX_REG_STREAM;
+    this->_navText = nullptr;
+    this->_navPeriodMicros = 0;
+    this->_nextNavMicros = 0;
+    this->_rxState = 0;
+    this->_rxLen = 0;
+    this->_rxCount = 0;
+    this->_rxCkA = 0;
+    this->_rxCkB = 0;
+    this->_rxBad = false;
+}
+
+
+/* Register read: 0xFD/0xFE byte count (latched at 0xFD), 0xFF stream */
+bool SimUbloxI2C::ReadRegs(uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    this->_ptr = reg;
+    if (reg == UBLOX_REG_COUNT_LO)
+        this->_countLatch = this->Available();
+    return this->Read(buf, len);
+}
+
+
+/* A register address alone sets the pointer; anything longer is a message */
+bool SimUbloxI2C::WriteRegs(uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+    if (len == 0)
+    {
+        this->_ptr = reg;
+        return true;
+    }
+
+    this->_Receive(reg);
+    for (uint8_t i = 0; i < len; i++)
+        this->_Receive(buf[i]);
+    return true;
+}
+
+
+/* Read from the current pointer, usually the stream */
+bool SimUbloxI2C::Read(uint8_t *buf, uint8_t len)
+{
+    this->_Update();
+    for (uint8_t i = 0; i < len; i++)
+        buf[i] = this->_ReadByte();
+    return true;
+}
+
+
+/* One byte sets the pointer; two or more are message data (UBX or NMEA) */
+bool SimUbloxI2C::Write(const uint8_t *buf, uint8_t len)
+{
+    if (len == 0)
+        return true;
+    if (len == 1)
+    {
+        this->_ptr = buf[0];
+        return true;
+    }
+
+    for (uint8_t i = 0; i < len; i++)
+        this->_Receive(buf[i]);
+    return true;
+}
+
+
+/**
+ * Queue bytes in the receiver's output stream.
+ *
+ * @return  Number of bytes queued. The rest are dropped (buffer full).
+ */
+uint16_t SimUbloxI2C::QueueOutput(const uint8_t *data, uint16_t len)
+{
+    uint16_t n = 0;
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        uint16_t next = (uint16_t)((this->_txHead + 1) & (SIM_UBLOX_TX_SIZE - 1));
+        if (next == this->_txTail)
+        {
+            this->dropped += (uint32_t)(len - i);
+            break;
+        }
+        this->_tx[this->_txHead] = data[i];
+        this->_txHead = next;
+        n++;
+    }
+
+    return n;
+}
+
+
+/* Queue a string, e.g. NMEA sentences with their CR/LFs */
+uint16_t SimUbloxI2C::QueueOutput(const char *text)
+{
+    return this->QueueOutput((const uint8_t *)text, (uint16_t)strlen(text));
+}
+
+
+/**
+ * Output the same sentences once per navigation period, like a receiver
+ * with a fix.
+ *
+ * @param text          Sentences. Must stay alive. nullptr to stop.
+ * @param periodMicros  [us] Navigation period, e.g. 100000 for 10Hz.
+ */
+void SimUbloxI2C::SetNavOutput(const char *text, uint32_t periodMicros)
+{
+    this->_navText = text;
+    this->_navPeriodMicros = periodMicros;
+    this->_nextNavMicros = HalSimMicros64() + periodMicros;
+}
+
+
+/* Return the number of bytes waiting in the output stream */
+uint16_t SimUbloxI2C::Available()
+{
+    this->_Update();
+    return (uint16_t)((this->_txHead - this->_txTail) & (SIM_UBLOX_TX_SIZE - 1));
+}
+
+
+/* Queue the nav. output for every period that has passed */
+void SimUbloxI2C::_Update()
+{
+    uint64_t now;
+
+    if (this->_navText == nullptr || this->_navPeriodMicros == 0)
+        return;
+
+    now = HalSimMicros64();
+    while (now >= this->_nextNavMicros)
+    {
+        this->QueueOutput(this->_navText);
+        this->_nextNavMicros += this->_navPeriodMicros;
+    }
+}
+
+
+uint8_t SimUbloxI2C::_ReadByte()
+{
+    uint8_t b;
+
+    switch (this->_ptr)
+    {
+        case UBLOX_REG_COUNT_HI:
+            this->_countLatch = (uint16_t)((this->_txHead - this->_txTail) & (SIM_UBLOX_TX_SIZE - 1));
+            this->_ptr = UBLOX_REG_COUNT_LO;
+            return (uint8_t)(this->_countLatch >> 8);
+        case UBLOX_REG_COUNT_LO:
+            this->_ptr = UBLOX_REG_STREAM;
+            return (uint8_t)(this->_countLatch & 0xFF);
+        case UBLOX_REG_STREAM:
+            if (this->_txHead == this->_txTail)
+                return 0xFF;  // Nothing to send
+            b = this->_tx[this->_txTail];
+            this->_txTail = (uint16_t)((this->_txTail + 1) & (SIM_UBLOX_TX_SIZE - 1));
+            return b;
+        default:
+            this->_ptr++;
+            return 0x00;  // Reserved registers
+    }
+}
+
+
+/* Log a message byte and run the UBX frame parser */
+void SimUbloxI2C::_Receive(uint8_t b)
+{
+    if (this->nReceived < SIM_UBLOX_RX_SIZE)
+        this->received[this->nReceived++] = b;
+
+    switch (this->_rxState)
+    {
+        case 0:  // Sync char 1
+            if (b == 0xB5)
+                this->_rxState = 1;
+            return;
+        case 1:  // Sync char 2
+            this->_rxState = (b == 0x62) ? 2 : 0;
+            this->_rxCkA = 0;
+            this->_rxCkB = 0;
+            return;
+        case 2:  // Class, ID, length
+        case 3:
+        case 4:
+        case 5:
+            this->_rxHdr[this->_rxState - 2] = b;
+            this->_rxCkA = (uint8_t)(this->_rxCkA + b);
+            this->_rxCkB = (uint8_t)(this->_rxCkB + this->_rxCkA);
+            this->_rxState++;
+            if (this->_rxState == 6)
+            {
+                this->_rxLen = (uint16_t)(this->_rxHdr[2] | (this->_rxHdr[3] << 8));
+                this->_rxCount = 0;
+                if (this->_rxLen == 0)
+                    this->_rxState = 7;
+            }
+            return;
+        case 6:  // Payload
+            this->_rxCkA = (uint8_t)(this->_rxCkA + b);
+            this->_rxCkB = (uint8_t)(this->_rxCkB + this->_rxCkA);
+            if (++this->_rxCount >= this->_rxLen)
+                this->_rxState = 7;
+            return;
+        case 7:  // CK_A
+            this->_rxBad = (b != this->_rxCkA);
+            this->_rxState = 8;
+            return;
+        default:  // CK_B
+            this->_rxBad = this->_rxBad || (b != this->_rxCkB);
+            this->_rxState = 0;
+            if (this->_rxBad)
+            {
+                this->ubxBadChecksums++;
+                if (this->_rxHdr[0] == 0x06)
+                    this->_QueueAck(false, this->_rxHdr[0], this->_rxHdr[1]);
+                return;
+            }
+            this->ubxMessages++;
+            this->lastClass = this->_rxHdr[0];
+            this->lastId = this->_rxHdr[1];
+            if (this->_rxHdr[0] == 0x06)
+                this->_QueueAck(true, this->_rxHdr[0], this->_rxHdr[1]);
+            return;
+    }
+}
+
+
+/* Queue UBX-ACK-ACK (or ACK-NAK) for a CFG message */
+void SimUbloxI2C::_QueueAck(bool ack, uint8_t cls, uint8_t id)
+{
+    uint8_t msg[10] = {0xB5, 0x62, 0x05, (uint8_t)(ack ? 0x01 : 0x00), 0x02, 0x00, cls, id, 0x00, 0x00};
+
+    for (uint8_t i = 2; i < 8; i++)
+    {
+        msg[8] = (uint8_t)(msg[8] + msg[i]);
+        msg[9] = (uint8_t)(msg[9] + msg[8]);
+    }
+
+    this->QueueOutput(msg, sizeof(msg));
+}
+#endif
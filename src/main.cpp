@@ -79,7 +79,7 @@ void setup()
     digitalWrite(RED_LED, HIGH);  // Start off LOW
     digitalWrite(GRN_LED, LOW);  // digitalWrite(GRN_LED, LOW);
 
-    // if (!baro.Initialize(BMP3_NO_OVERSAMPLING, BMP3_NO_OVERSAMPLING, BMP3_IIR_FILTER_COEFF_3, BMP3_ODR_100_HZ))
+    // if (!baro.Initialize(BMP388_OS_1X, BMP388_OS_1X, BMP388_IIR_COEF_3, BMP388_ODR_100HZ))
     // {
     //     DEBUG_PORT.println("ERROR INIT. SENSOR!");
     //     return;
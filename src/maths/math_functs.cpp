@@ -8,7 +8,7 @@
  * Extra math functions such as fast square root, 'safe' trig. functions, etc.
  */
 
-#include <Arduino.h>
+#include <string.h>
 #include "maths/math_functs.h"
 
 
@@ -26,20 +26,54 @@
  */
 float InvSqrtf(float num)
 {
-    long i;
+    int32_t i;
     float x2, y;
     const float threehalfs = 1.5f;
 
     x2 = num * 0.5f;
     y = num;
-    i = *(long*) &y;                        // evil floating point bit level hacking
+    memcpy(&i, &y, sizeof(i));              // evil floating point bit level hacking (32 bits on every platform)
     i = 0x5f3759df - (i >> 1);              // what the fuck? 
-    y = *(float*) &i;                       // 1st iteration
+    memcpy(&y, &i, sizeof(y));              // 1st iteration
     y = y * (threehalfs - (x2 * y * y));    // 2nd iteration, this can be removed
     return y;
 }
 
 
+// ----------------------------------------------------------------------------
+// expf_fast(float x)
+// ----------------------------------------------------------------------------
+/**
+ * Cheap approximation of expf(). Splits x into n*ln(2) + r with |r| <= ln(2)/2, 
+ * evaluates a 5th-order polynomial for exp(r) and scales by 2^n by building 
+ * the float exponent directly. Relative error is < 5e-6, which is plenty for 
+ * computing filter coefficients every sample.
+ * 
+ * @param x  Exponent
+ * @return  Approximation of e^x
+ */
+float expf_fast(float x)
+{
+    float n, r, p, scale;
+    uint32_t bits;
+
+    if (x < -87.0f)  // Below the smallest normal float
+        return 0.0f;
+    if (x > 88.0f)  // Just below overflow
+        x = 88.0f;
+
+    n = floorf((x * 1.44269504f) + 0.5f);  // round(x / ln(2))
+    r = x - (n * 0.693147181f);
+
+    // Horner form of the Taylor series of exp(r)
+    p = 1.0f + r * (1.0f + r * (0.5f + r * (0.166666667f + r * (0.0416666667f + r * 0.00833333333f))));
+
+    bits = (uint32_t)((int32_t)n + 127) << 23;  // 2^n
+    memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+
 // ----------------------------------------------------------------------------
 // RangeConstrain(T val, T lower, T upper)
 // ----------------------------------------------------------------------------
@@ -0,0 +1,427 @@
+// ----------------------------------------------------------------------------
+// ASYNCHRONOUS I2C TRANSACTION ENGINE
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Queued, non-blocking I2C register reads/writes. See async_i2c.h.
+ *
+ * The queue is one ring of transaction pointers with three indices:
+ * _callbackIdx <= _active <= _tail. Submit() moves _tail, the backend's ISR
+ * moves _active through OnComplete(), and Poll() moves _callbackIdx.
+ *
+ * LockBus() only succeeds with nothing on the bus, and while it's held
+ * nothing new is started, so the ISR never runs a transfer under a blocking
+ * one. AsyncI2CSharedBus takes it around every blocking transfer.
+ */
+
+
+#include "sensor_drivers/async_i2c.h"
+
+#include "hal/hal_platform.h"
+
+#ifdef ARDUINO
+#define ASYNC_I2C_CRITICAL_BEGIN() noInterrupts()
+#define ASYNC_I2C_CRITICAL_END() interrupts()
+#else
+#define ASYNC_I2C_CRITICAL_BEGIN()
+#define ASYNC_I2C_CRITICAL_END()
+#endif
+
+
+// ----------------------------------------------------------------------------
+// AsyncI2C(AsyncI2CBackend *backend)
+// ----------------------------------------------------------------------------
+/**
+ * Construct the engine on a bus backend.
+ *
+ * @param backend  Bus backend that runs the transfers.
+ */
+AsyncI2C::AsyncI2C(AsyncI2CBackend *backend)
+{
+    this->_backend = backend;
+    this->_tail = 0;
+    this->_active = 0;
+    this->_callbackIdx = 0;
+    this->_busy = false;
+    this->_locked = false;
+    this->completed = 0;
+    this->failed = 0;
+    for (uint8_t i = 0; i < ASYNC_I2C_QUEUE_SIZE; i++)
+        this->_queue[i] = nullptr;
+}
+
+
+/**
+ * Start the backend. Call once before submitting anything.
+ *
+ * @return  True if successful, false if the backend failed.
+ */
+bool AsyncI2C::Begin()
+{
+    if (this->_backend == nullptr)
+        return false;
+
+    return this->_backend->Begin(this);
+}
+
+
+// ----------------------------------------------------------------------------
+// Submit(I2CTransaction_t *txn)
+// ----------------------------------------------------------------------------
+/**
+ * Queue a filled-in transaction. It starts right away if the bus is idle.
+ *
+ * @param txn  Transaction. Must stay alive until its callback runs.
+ * @return  True if queued, false if the queue is full, the transaction is
+ *          invalid, or it's still queued/on the bus from before.
+ */
+bool AsyncI2C::Submit(I2CTransaction_t *txn)
+{
+    uint8_t tail;
+    uint8_t next;
+
+    if (txn == nullptr || txn->buf == nullptr || txn->len == 0)
+        return false;
+    if (txn->status == I2C_TXN_QUEUED || txn->status == I2C_TXN_BUSY)
+        return false;
+
+    tail = this->_tail;
+    next = (uint8_t)((tail + 1) & (ASYNC_I2C_QUEUE_SIZE - 1));
+    if (next == this->_callbackIdx)
+        return false;  // Full
+
+    txn->status = I2C_TXN_QUEUED;
+    this->_queue[tail] = txn;
+
+    ASYNC_I2C_CRITICAL_BEGIN();
+    this->_tail = next;
+    if (!this->_busy && !this->_locked)
+        this->_StartNext();
+    ASYNC_I2C_CRITICAL_END();
+
+    return true;
+}
+
+
+// ----------------------------------------------------------------------------
+// SubmitRead(I2CTransaction_t *txn, uint8_t address, uint8_t reg,
+//     uint8_t *buf, uint8_t len, I2CCallback_t callback, void *context)
+// ----------------------------------------------------------------------------
+/**
+ * Fill in and queue a register read: write 'reg', repeated start, read
+ * 'len' bytes into 'buf'.
+ *
+ * @param txn       Transaction descriptor to fill in.
+ * @param address   7-bit device address.
+ * @param reg       First register.
+ * @param buf       Destination, at least 'len' bytes.
+ * @param len       Number of bytes to read.
+ * @param callback  Called from Poll() when done. Can be nullptr.
+ * @param context   Passed through for the callback.
+ * @return  True if queued.
+ */
+bool AsyncI2C::SubmitRead(I2CTransaction_t *txn, uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len,
+    I2CCallback_t callback, void *context)
+{
+    if (txn == nullptr || txn->status == I2C_TXN_QUEUED || txn->status == I2C_TXN_BUSY)
+        return false;
+
+    txn->address = address;
+    txn->reg = reg;
+    txn->buf = buf;
+    txn->len = len;
+    txn->isWrite = false;
+    txn->callback = callback;
+    txn->context = context;
+    return this->Submit(txn);
+}
+
+
+/**
+ * Fill in and queue a register write: write 'reg', then 'len' bytes from
+ * 'buf'. Same parameters as SubmitRead().
+ *
+ * @return  True if queued.
+ */
+bool AsyncI2C::SubmitWrite(I2CTransaction_t *txn, uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len,
+    I2CCallback_t callback, void *context)
+{
+    if (txn == nullptr || txn->status == I2C_TXN_QUEUED || txn->status == I2C_TXN_BUSY)
+        return false;
+
+    txn->address = address;
+    txn->reg = reg;
+    txn->buf = buf;
+    txn->len = len;
+    txn->isWrite = true;
+    txn->callback = callback;
+    txn->context = context;
+    return this->Submit(txn);
+}
+
+
+/**
+ * Run the callbacks of finished transactions, in submission order. Call
+ * every loop. Callbacks may submit new transactions.
+ */
+void AsyncI2C::Poll()
+{
+    while (this->_callbackIdx != this->_active)
+    {
+        I2CTransaction_t *txn = this->_queue[this->_callbackIdx];
+        this->_callbackIdx = (uint8_t)((this->_callbackIdx + 1) & (ASYNC_I2C_QUEUE_SIZE - 1));
+
+        if (txn->callback != nullptr)
+            txn->callback(txn);
+    }
+}
+
+
+/* Return true if nothing is queued or on the bus */
+bool AsyncI2C::IsIdle() const
+{
+    return !this->_busy && (this->_active == this->_tail);
+}
+
+
+/* Return the number of transactions queued or on the bus */
+uint8_t AsyncI2C::Pending() const
+{
+    return (uint8_t)((this->_tail - this->_active) & (ASYNC_I2C_QUEUE_SIZE - 1));
+}
+
+
+// ----------------------------------------------------------------------------
+// LockBus(uint32_t timeoutMicros)
+// ----------------------------------------------------------------------------
+/**
+ * Take the bus for a blocking transfer: wait for the transfer on the bus to 
+ * finish (the ISR starts the queued ones meanwhile), then hold off starting 
+ * any more until UnlockBus(). Submit() still queues while locked.
+ *
+ * @param timeoutMicros  [us] Max. time to wait for the engine.
+ * @return  True if locked, false if the engine stayed busy.
+ */
+bool AsyncI2C::LockBus(uint32_t timeoutMicros)
+{
+    uint64_t start = Micros64();
+
+    while (true)
+    {
+        ASYNC_I2C_CRITICAL_BEGIN();
+        if (!this->_busy)
+        {
+            this->_locked = true;
+            ASYNC_I2C_CRITICAL_END();
+            return true;
+        }
+        ASYNC_I2C_CRITICAL_END();
+
+        if (Micros64() - start >= timeoutMicros)
+            return false;
+        delayMicroseconds(1);
+    }
+}
+
+
+/* Hand the bus back, and start the transactions queued while it was locked */
+void AsyncI2C::UnlockBus()
+{
+    ASYNC_I2C_CRITICAL_BEGIN();
+    this->_locked = false;
+    if (!this->_busy)
+        this->_StartNext();
+    ASYNC_I2C_CRITICAL_END();
+}
+
+
+/* Return true while a blocking transfer has the bus */
+bool AsyncI2C::IsLocked() const
+{
+    return this->_locked;
+}
+
+
+// ----------------------------------------------------------------------------
+// OnComplete(I2CTxnStatus_t status)
+// ----------------------------------------------------------------------------
+/**
+ * Called by the backend (usually from its ISR) when the transfer on the bus
+ * finishes. Records the result and starts the next queued transaction.
+ *
+ * @param status  I2C_TXN_DONE, I2C_TXN_NACK, or I2C_TXN_ERROR
+ */
+void AsyncI2C::OnComplete(I2CTxnStatus_t status)
+{
+    I2CTransaction_t *txn;
+
+    if (!this->_busy)
+        return;
+
+    txn = this->_queue[this->_active];
+    txn->status = status;
+    if (status == I2C_TXN_DONE)
+        this->completed++;
+    else
+        this->failed++;
+
+    this->_active = (uint8_t)((this->_active + 1) & (ASYNC_I2C_QUEUE_SIZE - 1));
+    this->_StartNext();
+}
+
+
+/* Start the next queued transaction, if any. Interrupts must be off (or be in the ISR). */
+void AsyncI2C::_StartNext()
+{
+    I2CTransaction_t *txn;
+
+    if (this->_active == this->_tail)
+    {
+        this->_busy = false;
+        return;
+    }
+
+    txn = this->_queue[this->_active];
+    txn->status = I2C_TXN_BUSY;
+    txn->startMicros = Micros64();
+    this->_busy = true;
+    this->_backend->Start(txn);
+}
+
+
+// ----------------------------------------------------------------------------
+// AsyncI2CSharedBus(I2CBus *bus, AsyncI2C *engine)
+// ----------------------------------------------------------------------------
+/**
+ * Share a blocking bus with the async engine on the same controller.
+ *
+ * @param bus     Blocking bus.
+ * @param engine  Engine on the same controller. nullptr to pass through.
+ */
+AsyncI2CSharedBus::AsyncI2CSharedBus(I2CBus *bus, AsyncI2C *engine)
+{
+    this->_bus = bus;
+    this->_engine = engine;
+    this->_lastBusy = false;
+    this->busyRejects = 0;
+}
+
+
+bool AsyncI2CSharedBus::Begin()
+{
+    return this->_bus->Begin();
+}
+
+
+bool AsyncI2CSharedBus::Probe(uint8_t address)
+{
+    bool ok;
+
+    if (!this->_Lock())
+        return false;
+    ok = this->_bus->Probe(address);
+    this->_Unlock();
+    return ok;
+}
+
+
+bool AsyncI2CSharedBus::ReadRegs(uint8_t address, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    bool ok;
+
+    if (!this->_Lock())
+        return false;
+    ok = this->_bus->ReadRegs(address, reg, buf, len);
+    this->_Unlock();
+    return ok;
+}
+
+
+bool AsyncI2CSharedBus::WriteRegs(uint8_t address, uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+    bool ok;
+
+    if (!this->_Lock())
+        return false;
+    ok = this->_bus->WriteRegs(address, reg, buf, len);
+    this->_Unlock();
+    return ok;
+}
+
+
+bool AsyncI2CSharedBus::Read(uint8_t address, uint8_t *buf, uint8_t len)
+{
+    bool ok;
+
+    if (!this->_Lock())
+        return false;
+    ok = this->_bus->Read(address, buf, len);
+    this->_Unlock();
+    return ok;
+}
+
+
+bool AsyncI2CSharedBus::Write(uint8_t address, const uint8_t *buf, uint8_t len)
+{
+    bool ok;
+
+    if (!this->_Lock())
+        return false;
+    ok = this->_bus->Write(address, buf, len);
+    this->_Unlock();
+    return ok;
+}
+
+
+/* Why the last transfer failed: engine busy, or the bus's own error */
+I2CBusError_t AsyncI2CSharedBus::LastError() const
+{
+    if (this->_lastBusy)
+        return I2C_ERR_BUSY;
+    return this->_bus->LastError();
+}
+
+
+/* Recover the bus with the engine held off, so the clock-out can't cut into a transfer */
+bool AsyncI2CSharedBus::Recover()
+{
+    bool ok;
+
+    if (!this->_Lock())
+        return false;
+    ok = this->_bus->Recover();
+    this->_Unlock();
+    return ok;
+}
+
+
+/**
+ * Lock the engine for one blocking transfer.
+ *
+ * @return  True if the transfer may go ahead, false if the engine stayed busy.
+ */
+bool AsyncI2CSharedBus::_Lock()
+{
+    this->_lastBusy = false;
+    if (this->_engine == nullptr)
+        return true;
+
+    if (!this->_engine->LockBus())
+    {
+        this->_lastBusy = true;
+        this->busyRejects++;
+        return false;
+    }
+
+    return true;
+}
+
+
+/* Hand the bus back to the engine after a blocking transfer */
+void AsyncI2CSharedBus::_Unlock()
+{
+    if (this->_engine != nullptr)
+        this->_engine->UnlockBus();
+}
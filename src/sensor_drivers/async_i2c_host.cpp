@@ -0,0 +1,137 @@
+// ----------------------------------------------------------------------------
+// ASYNCHRONOUS I2C HOST (SIMULATED) BACKEND
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * AsyncI2C backend that completes transactions from simulated devices. See
+ * async_i2c_host.h.
+ */
+
+
+#include "sensor_drivers/async_i2c_host.h"
+
+
+HostI2CBackend::HostI2CBackend()
+{
+    this->_engine = nullptr;
+    this->_txn = nullptr;
+    this->_nDevices = 0;
+}
+
+
+// ----------------------------------------------------------------------------
+// AttachDevice(uint8_t address, SimI2CDevice *device)
+// ----------------------------------------------------------------------------
+/**
+ * Put a simulated device on the bus.
+ *
+ * @param address  7-bit device address.
+ * @param device   Simulated device.
+ * @return  True if attached, false if the address is taken or the bus is full.
+ */
+bool HostI2CBackend::AttachDevice(uint8_t address, SimI2CDevice *device)
+{
+    if (device == nullptr || this->FindDevice(address) != nullptr)
+        return false;
+    if (this->_nDevices >= HOST_I2C_MAX_DEVICES)
+        return false;
+
+    this->_addresses[this->_nDevices] = address;
+    this->_devices[this->_nDevices] = device;
+    this->_nDevices++;
+    return true;
+}
+
+
+/* Return the device at an address, nullptr if none (NACK) */
+SimI2CDevice *HostI2CBackend::FindDevice(uint8_t address)
+{
+    for (uint8_t i = 0; i < this->_nDevices; i++)
+    {
+        if (this->_addresses[i] == address)
+            return this->_devices[i];
+    }
+
+    return nullptr;
+}
+
+
+bool HostI2CBackend::Begin(AsyncI2C *engine)
+{
+    this->_engine = engine;
+    this->_txn = nullptr;
+    return engine != nullptr;
+}
+
+
+/* Put a transfer on the simulated bus. It finishes on the next Step(). */
+void HostI2CBackend::Start(I2CTransaction_t *txn)
+{
+    this->_txn = txn;
+}
+
+
+// ----------------------------------------------------------------------------
+// Step()
+// ----------------------------------------------------------------------------
+/**
+ * Finish the transfer on the simulated bus, like the transfer-complete ISR.
+ * The engine then starts the next queued transaction.
+ *
+ * @return  True if a transfer finished, false if the bus was idle.
+ */
+bool HostI2CBackend::Step()
+{
+    I2CTransaction_t *txn = this->_txn;
+    SimI2CDevice *dev;
+    bool ack;
+
+    if (txn == nullptr || this->_engine == nullptr)
+        return false;
+
+    this->_txn = nullptr;
+    dev = this->FindDevice(txn->address);
+    if (dev == nullptr)
+        ack = false;
+    else if (txn->isWrite)
+        ack = dev->WriteRegs(txn->reg, txn->buf, txn->len);
+    else
+        ack = dev->ReadRegs(txn->reg, txn->buf, txn->len);
+
+    this->_engine->OnComplete(ack ? I2C_TXN_DONE : I2C_TXN_NACK);
+    return true;
+}
+
+
+/**
+ * Finish every queued transfer.
+ *
+ * @return  Number of transfers finished.
+ */
+uint32_t HostI2CBackend::RunAll()
+{
+    uint32_t n = 0;
+
+    while (this->Step())
+        n++;
+
+    return n;
+}
+
+
+/* Simulated backend of SensorAsyncI2C(). Attach the sensor models to it. */
+HostI2CBackend &HostSensorI2CBackend()
+{
+    static HostI2CBackend backend;
+    return backend;
+}
+
+
+/* Host stand-in for the sensor bus engine */
+AsyncI2C *SensorAsyncI2C()
+{
+    static AsyncI2C engine(&HostSensorI2CBackend());
+    return &engine;
+}
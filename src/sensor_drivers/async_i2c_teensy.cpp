@@ -0,0 +1,235 @@
+// ----------------------------------------------------------------------------
+// ASYNCHRONOUS I2C TEENSY 4.1 (LPI2C) BACKEND
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Interrupt-driven AsyncI2C backend for the i.MX RT1062's LPI2C master. See
+ * async_i2c_teensy.h, and the i.MX RT1060 reference manual ch. 47 (LPI2C).
+ *
+ * Command sequences pushed to MTDR:
+ *   Read:  START|addr+W, reg, START|addr+R, RECEIVE len-1, STOP
+ *   Write: START|addr+W, reg, data[0], ..., data[len-1], STOP
+ */
+
+
+#include "sensor_drivers/async_i2c_teensy.h"
+
+#if defined(__IMXRT1062__)
+
+/* Master status flags that end a transfer with an error */
+constexpr uint32_t LPI2C_MSR_ERRORS = LPI2C_MSR_NDF | LPI2C_MSR_ALF | LPI2C_MSR_FEF | LPI2C_MSR_PLTF;
+
+/* All write-1-to-clear master status flags */
+constexpr uint32_t LPI2C_MSR_CLEAR_ALL = LPI2C_MSR_EPF | LPI2C_MSR_SDF | LPI2C_MSR_NDF | LPI2C_MSR_ALF |
+    LPI2C_MSR_FEF | LPI2C_MSR_PLTF | LPI2C_MSR_DMF;
+
+
+TeensyLPI2CBackend *TeensyLPI2CBackend::_instance = nullptr;
+
+
+/**
+ * Construct the backend on an LPI2C port.
+ *
+ * @param port  LPI2C peripheral. Default LPI2C4 (Wire2/SENSOR_I2C).
+ * @param irq   Its interrupt. Default IRQ_LPI2C4.
+ */
+TeensyLPI2CBackend::TeensyLPI2CBackend(IMXRT_LPI2C_t *port, IRQ_NUMBER_t irq)
+{
+    this->_port = port;
+    this->_irq = irq;
+    this->_engine = nullptr;
+    this->_txn = nullptr;
+    this->_cmdIdx = 0;
+    this->_rxIdx = 0;
+}
+
+
+// ----------------------------------------------------------------------------
+// Begin(AsyncI2C *engine)
+// ----------------------------------------------------------------------------
+/**
+ * Take over the LPI2C interrupt. Wire must already have set up the pins and
+ * clock.
+ *
+ * @param engine  Engine to notify when transfers finish.
+ * @return  True if successful, false if another backend owns the ISR.
+ */
+bool TeensyLPI2CBackend::Begin(AsyncI2C *engine)
+{
+    if (engine == nullptr || (_instance != nullptr && _instance != this))
+        return false;
+
+    this->_engine = engine;
+    _instance = this;
+
+    this->_port->MIER = 0;
+    this->_port->MSR = LPI2C_MSR_CLEAR_ALL;
+
+    attachInterruptVector(this->_irq, _Isr);
+    NVIC_SET_PRIORITY(this->_irq, 64);  // Above the default (128), so the bus stays busy
+    NVIC_ENABLE_IRQ(this->_irq);
+    return true;
+}
+
+
+/* Start a transfer. Called by the engine with interrupts off. */
+void TeensyLPI2CBackend::Start(I2CTransaction_t *txn)
+{
+    uint32_t ier;
+
+    this->_txn = txn;
+    this->_cmdIdx = 0;
+    this->_rxIdx = 0;
+
+    this->_port->MCR |= LPI2C_MCR_RTF | LPI2C_MCR_RRF;  // Flush FIFOs
+    this->_port->MFCR = LPI2C_MFCR_RXWATER(0) | LPI2C_MFCR_TXWATER(1);  // RDF on any byte, TDF with room for 3 words. Wire may have changed them.
+    this->_port->MSR = LPI2C_MSR_CLEAR_ALL;
+    this->_FillTxFIFO();
+
+    ier = LPI2C_MIER_SDIE | LPI2C_MIER_NDIE | LPI2C_MIER_ALIE | LPI2C_MIER_FEIE | LPI2C_MIER_PLTIE;
+    if (!txn->isWrite)
+        ier |= LPI2C_MIER_RDIE;
+    ier |= LPI2C_MIER_TDIE;  // Until every command is queued
+    this->_port->MIER = ier;
+}
+
+
+void TeensyLPI2CBackend::_Isr()
+{
+    if (_instance != nullptr)
+        _instance->_OnInterrupt();
+}
+
+
+// ----------------------------------------------------------------------------
+// _OnInterrupt()
+// ----------------------------------------------------------------------------
+/**
+ * LPI2C ISR: error handling, RX drain, TX feed, and completion on STOP.
+ */
+void TeensyLPI2CBackend::_OnInterrupt()
+{
+    I2CTransaction_t *txn = this->_txn;
+    uint32_t msr = this->_port->MSR;
+
+    if (txn == nullptr)
+    {
+        this->_port->MIER = 0;
+        this->_port->MSR = LPI2C_MSR_CLEAR_ALL;
+        return;
+    }
+
+    if (msr & LPI2C_MSR_ERRORS)
+    {
+        // Drop the rest of the transfer and release the bus
+        this->_port->MCR |= LPI2C_MCR_RTF | LPI2C_MCR_RRF;
+        this->_port->MSR = LPI2C_MSR_CLEAR_ALL;
+        if (!(msr & LPI2C_MSR_ALF))
+            this->_port->MTDR = LPI2C_MTDR_CMD_STOP;
+        this->_Finish((msr & LPI2C_MSR_NDF) ? I2C_TXN_NACK : I2C_TXN_ERROR);
+        return;
+    }
+
+    // Received bytes
+    while ((this->_port->MFSR >> 16) & 0x07)
+    {
+        uint8_t b = (uint8_t)(this->_port->MRDR & 0xFF);
+        if (this->_rxIdx < txn->len)
+            txn->buf[this->_rxIdx++] = b;
+    }
+
+    if (msr & LPI2C_MSR_TDF)
+        this->_FillTxFIFO();
+
+    if (msr & LPI2C_MSR_SDF)
+    {
+        this->_port->MSR = LPI2C_MSR_SDF;
+        if (!txn->isWrite && this->_rxIdx < txn->len)
+            this->_Finish(I2C_TXN_ERROR);
+        else
+            this->_Finish(I2C_TXN_DONE);
+    }
+}
+
+
+/**
+ * Get the next MTDR command word of the transfer.
+ *
+ * @param cmd  Output, command word.
+ * @return  False once every command has been queued.
+ */
+bool TeensyLPI2CBackend::_NextCommand(uint32_t *cmd)
+{
+    I2CTransaction_t *txn = this->_txn;
+    uint16_t i = this->_cmdIdx;
+
+    if (i == 0)
+        *cmd = LPI2C_MTDR_CMD_START | (uint32_t)(txn->address << 1);
+    else if (i == 1)
+        *cmd = LPI2C_MTDR_CMD_TRANSMIT | txn->reg;
+    else if (txn->isWrite)
+    {
+        if (i < 2 + txn->len)
+            *cmd = LPI2C_MTDR_CMD_TRANSMIT | txn->buf[i - 2];
+        else if (i == 2 + txn->len)
+            *cmd = LPI2C_MTDR_CMD_STOP;
+        else
+            return false;
+    }
+    else
+    {
+        if (i == 2)
+            *cmd = LPI2C_MTDR_CMD_START | (uint32_t)(txn->address << 1) | 1;
+        else if (i == 3)
+            *cmd = LPI2C_MTDR_CMD_RECEIVE | (uint32_t)(txn->len - 1);
+        else if (i == 4)
+            *cmd = LPI2C_MTDR_CMD_STOP;
+        else
+            return false;
+    }
+
+    this->_cmdIdx = i + 1;
+    return true;
+}
+
+
+/* Queue commands while the TX FIFO has room. Stops the TX interrupt when done. */
+void TeensyLPI2CBackend::_FillTxFIFO()
+{
+    uint32_t cmd;
+
+    while ((this->_port->MFSR & 0x07) < LPI2C_FIFO_DEPTH)
+    {
+        if (!this->_NextCommand(&cmd))
+        {
+            this->_port->MIER &= ~LPI2C_MIER_TDIE;
+            return;
+        }
+        this->_port->MTDR = cmd;
+    }
+}
+
+
+/* End the transfer and hand the result to the engine (which starts the next one) */
+void TeensyLPI2CBackend::_Finish(I2CTxnStatus_t status)
+{
+    this->_port->MIER = 0;
+    this->_txn = nullptr;
+    this->_engine->OnComplete(status);
+}
+
+
+/**
+ * Async engine on the sensor bus (SENSOR_I2C, LPI2C4). SensorI2CBus() shares 
+ * the bus with it. Call Begin() once the sensor bus is up.
+ */
+AsyncI2C *SensorAsyncI2C()
+{
+    static TeensyLPI2CBackend backend;
+    static AsyncI2C engine(&backend);
+    return &engine;
+}
+
+#endif
@@ -1,146 +1,364 @@
 // ----------------------------------------------------------------------------
 // BMP388 BAROMETRIC ALTIMETER AND TEMPERATURE SENSOR
-// 
+//
 // Code By: Michael Wrona
 // Created: 25 Feb 2021
 // ----------------------------------------------------------------------------
 /**
- * This is driver code for the BMP388 temp/pres sensor. It also incorporates 
- * Adafruit's BMP388 driver code.
+ * This is driver code for the BMP388 temp/pres sensor. Normal mode with the
+ * FIFO, single-precision compensation. See bmp388_barometer.h.
  */
 
+#include <math.h>
+#include <string.h>
 #include "sensor_drivers/bmp388_barometer.h"
 
 
 // ----------------------------------------------------------------------------
-// BMP388Baro::BMP388Baro(TwoWire *wireInput)
+// BMP388Baro::BMP388Baro(I2CBus *bus)
 // ----------------------------------------------------------------------------
 /**
  * Create BMP388 pressure and temperature sensor object.
- * 
- * @param wireInput Wire/I2C interface that the sensor is connected to.
+ *
+ * @param bus  I2C bus that the sensor is connected to.
  */
-BMP388Baro::BMP388Baro(TwoWire *wireInput)
+BMP388Baro::BMP388Baro(I2CBus *bus)
 {
-    this->_SensorWire = wireInput;
+    this->_bus = bus;
     this->_p = 101325.0f;
     this->_t = 15.0f;
-    this->prevMeasMicros = micros();
+    memset(&this->_calib, 0, sizeof(this->_calib));
+    this->prevMeasMicros = 0;
+    this->groupDelayMicros = 0;
+    this->fifoPeriodMicros = 0;
+    this->fifoOverflows = 0;
+    this->isConnected = false;
+    this->isFIFOEnabled = false;
 }
 
 
 // ----------------------------------------------------------------------------
-// BMP388Baro::Initialize(uint8_t presOS, uint8_t tempOS, 
-//                            uint8_t iirCoef, uint8_t odr)
+// BMP388Baro::Connect()
 // ----------------------------------------------------------------------------
 /**
- * Use Adafruit's BMP388 library to configure the BMP388. Take a few readings 
- * to 'flush out' bad data. The input config. param. definitions can be found 
- * in lib/Adafruit_BMP3XX/Adafruit_BMP3XX.h
- * 
- * @param presOS    Pressure oversampling factor.
- * @param tempOS    Temperature oversampling factor.
- * @param iirCoef   IIR filter coef. for smoothing out data.
- * @param odr       Output data rate.
- * @returns         True if good reading, false if error.
+ * Check the chip ID, soft reset the sensor, and read its NVM calibration.
+ *
+ * @returns  True if connected, false if the chip didn't answer or the ID is
+ *           wrong.
  */
-bool BMP388Baro::Initialize(uint8_t presOS, uint8_t tempOS, 
-                                uint8_t iirCoef, uint8_t odr)
+bool BMP388Baro::Connect()
 {
-    uint8_t i;
-    uint8_t numFlushReadings = 5;
-
+    this->_bus->Begin();
 
-    // Connect to the sensor with Adafruit's code
-    if (!this->begin(0x77, this->_SensorWire))
+    if (this->I2Cread8(BMP388_REG_CHIP_ID) != BMP388_CHIP_ID)
     {
         #ifdef BMP388_DEBUG
-        DEBUG_PRINTLN("BMP388BAROTEMP:BMP388BaroTemp ERROR: Cound not connect to BMP388. Check wiring and settings.");
+        DEBUG_PRINTLN("BMP388BARO:Connect ERROR: Could not connect to BMP388. Check wiring and settings.");
         #endif
-        this->connected = false;
+        return false;
     }
 
-    // Set oversampling
-    if (!this->setTemperatureOversampling(tempOS))
+    this->I2Cwrite8(BMP388_REG_CMD, BMP388_CMD_SOFT_RESET);
+    delay(2);  // Startup time after a soft reset
+
+    if (!this->_ReadCalib())
     {
         #ifdef BMP388_DEBUG
-        DEBUG_PRINTLN("BMP388BAROTEMP:Initialize ERROR: Could not set temp OS. Check settings.");
+        DEBUG_PRINTLN("BMP388BARO:Connect ERROR: Could not read calibration coefficients.");
         #endif
         return false;
     }
 
-    if (!this->setPressureOversampling(presOS))
+    this->isFIFOEnabled = false;
+    this->isConnected = true;
+    return true;
+}
+
+
+// ----------------------------------------------------------------------------
+// BMP388Baro::Initialize(BMP388OSR_t presOS, BMP388OSR_t tempOS,
+//                        BMP388IIR_t iirCoef, BMP388ODR_t odr)
+// ----------------------------------------------------------------------------
+/**
+ * Configure the BMP388 and start it in normal mode, sampling pressure and
+ * temperature at the ODR. Connects first if Connect() wasn't called.
+ *
+ * @param presOS    Pressure oversampling factor.
+ * @param tempOS    Temperature oversampling factor.
+ * @param iirCoef   IIR filter coef. for smoothing out data.
+ * @param odr       Output data rate. The oversampling has to fit in one period.
+ * @returns         True if configured, false if error.
+ */
+bool BMP388Baro::Initialize(BMP388OSR_t presOS, BMP388OSR_t tempOS,
+                            BMP388IIR_t iirCoef, BMP388ODR_t odr)
+{
+    uint8_t pwrCtrl = BMP388_PWR_MODE_NORMAL | BMP388_PWR_PRESS_TEMP;
+
+    if (!this->isConnected && !this->Connect())
+        return false;
+
+    if (presOS > BMP388_OS_32X || tempOS > BMP388_OS_32X || iirCoef > BMP388_IIR_COEF_127 || odr > BMP388_ODR_12_5HZ)
     {
         #ifdef BMP388_DEBUG
-        DEBUG_PRINTLN("BMP388BAROTEMP:Initialize ERROR: Could not set pres OS. Check settings.");
+        DEBUG_PRINTLN("BMP388BARO:Initialize ERROR: Unknown oversampling, IIR coef. or ODR specified.");
         #endif
         return false;
     }
 
-    // Set IIR coef.
-    if (!this->setIIRFilterCoeff(iirCoef))
+    // Settings are changed in sleep mode. All in one address/data pair write.
+    const RegConfig_t config[] = {
+        {BMP388_REG_PWR_CTRL, 0x00, REG_NO_VERIFY, 0},
+        {BMP388_REG_OSR, (uint8_t)((tempOS << 3) | presOS), REG_VERIFY_ALL, 0},
+        {BMP388_REG_ODR, (uint8_t)odr, REG_VERIFY_ALL, 0},
+        {BMP388_REG_CONFIG, (uint8_t)(iirCoef << 1), REG_VERIFY_ALL, 0},
+        {BMP388_REG_PWR_CTRL, pwrCtrl, REG_VERIFY_ALL, 0}
+    };
+
+    // The sensor refuses normal mode if the conversion doesn't fit in the ODR
+    if (!ApplyRegConfig(this->_bus, BMP388_ADDR, config, sizeof(config) / sizeof(config[0]), REG_BURST_ADDR_PAIRS) ||
+        (this->I2Cread8(BMP388_REG_ERR) & BMP388_ERR_CONF))
     {
         #ifdef BMP388_DEBUG
-        DEBUG_PRINTLN("BMP388BAROTEMP:Initialize ERROR: Could not set IIR filter coef. Check settings.");
+        DEBUG_PRINTLN("BMP388BARO:Initialize ERROR: Config. rejected. Lower the oversampling or the ODR.");
         #endif
         return false;
     }
 
-    // Set data rate
-    if (!this->setOutputDataRate(odr))
+    this->fifoPeriodMicros = BMP388PeriodMicros(odr);
+    this->groupDelayMicros = BMP388IIRGroupDelayMicros(iirCoef, odr);
+    this->isFIFOEnabled = false;
+
+    // Wait for the first sample
+    delay(this->fifoPeriodMicros / 1000UL + 1UL);
+    return this->ReadSensor();
+}
+
+
+// ----------------------------------------------------------------------------
+// BMP388Baro::ConfigureFIFO()
+// ----------------------------------------------------------------------------
+/**
+ * Buffer pressure+temperature frames (IIR filtered) in the sensor's FIFO, to
+ * be drained with ReadFIFO(). When full, the oldest frames are overwritten.
+ * Call after Initialize().
+ *
+ * @return  True if successful, false if failed.
+ */
+bool BMP388Baro::ConfigureFIFO()
+{
+    if (this->fifoPeriodMicros == 0)
     {
         #ifdef BMP388_DEBUG
-        DEBUG_PRINTLN("BMP388BAROTEMP:Initialize ERROR: Could not set ODR. Check settings.");
+        DEBUG_PRINTLN("BMP388BARO:ConfigureFIFO ERROR: Call Initialize() first.");
         #endif
         return false;
     }
 
+    const RegConfig_t config[] = {
+        {BMP388_REG_FIFO_CONFIG_2, BMP388_FIFO_CONFIG_2_FILT, REG_VERIFY_ALL, 0},
+        {BMP388_REG_FIFO_CONFIG_1, BMP388_FIFO_CONFIG_1_PT, REG_VERIFY_ALL, 0}
+    };
 
-    // Take a few readings to flush out bad data
-    for (i = 0; i < numFlushReadings; i++)
+    if (!ApplyRegConfig(this->_bus, BMP388_ADDR, config, sizeof(config) / sizeof(config[0]), REG_BURST_ADDR_PAIRS))
     {
-        this->ReadSensor();
-        delay(50);
+        #ifdef BMP388_DEBUG
+        DEBUG_PRINTLN("BMP388BARO:ConfigureFIFO ERROR: FIFO setup did not stick.");
+        #endif
+        return false;
     }
 
+    // Drop the config. change frame
+    if (!this->FlushFIFO())
+        return false;
+
+    this->isFIFOEnabled = true;
     return true;
 }
 
 
+/* Empty the FIFO, e.g. after a pause in reading it. True if successful. */
+bool BMP388Baro::FlushFIFO()
+{
+    return this->_bus->WriteReg8(BMP388_ADDR, BMP388_REG_CMD, BMP388_CMD_FIFO_FLUSH);
+}
+
+
+// ----------------------------------------------------------------------------
+// BMP388Baro::ReadFIFO(BaroSample_t *samples, size_t maxSamples)
+// ----------------------------------------------------------------------------
+/**
+ * Drain buffered samples from the FIFO, oldest first, and compensate them.
+ * Frames are read in bursts of up to BMP388_FIFO_BYTES_PER_READ (bus
+ * transfer limit); a frame split across bursts is put back together, and
+ * other frame types (config. change, ...) are skipped. Sample times are
+ * reconstructed from the ODR, counting back from the newest sample (ready by
+ * the time the FIFO length read started), less the IIR group delay.
+ *
+ * @param samples     Output samples, oldest first.
+ * @param maxSamples  Size of 'samples'. Newer samples stay in the FIFO.
+ * @return  Number of samples read.
+ */
+size_t BMP388Baro::ReadFIFO(BaroSample_t *samples, size_t maxSamples)
+{
+    uint8_t buf[BMP388_FIFO_BYTES_PER_READ + BMP388_FIFO_FRAME_BYTES];
+    uint8_t lenBuf[2];
+    uint16_t fifoLen;
+    uint16_t left;
+    uint8_t have = 0;  // Unparsed bytes at the start of 'buf'
+    uint8_t chunk;
+    uint8_t pos;
+    uint8_t frameLen;
+    size_t nAvail;
+    size_t n = 0;
+    uint64_t tNewest;
+
+    if (this->isFIFOEnabled == false || samples == nullptr || maxSamples == 0)
+        return 0;
+
+    tNewest = Micros64();
+    if (!this->_bus->ReadRegs(BMP388_ADDR, BMP388_REG_FIFO_LENGTH, lenBuf, 2))
+        return 0;
+
+    fifoLen = (uint16_t)(((lenBuf[1] & 0x01) << 8) | lenBuf[0]);
+    if (fifoLen > BMP388_FIFO_SIZE - BMP388_FIFO_FRAME_BYTES)
+        this->fifoOverflows++;
+
+    nAvail = fifoLen / BMP388_FIFO_FRAME_BYTES;
+    left = (nAvail < maxSamples) ? fifoLen : (uint16_t)(maxSamples * BMP388_FIFO_FRAME_BYTES);
+
+    while (left > 0 && n < maxSamples)
+    {
+        chunk = (left < BMP388_FIFO_BYTES_PER_READ) ? (uint8_t)left : BMP388_FIFO_BYTES_PER_READ;
+        if (!this->_bus->ReadRegs(BMP388_ADDR, BMP388_REG_FIFO_DATA, &buf[have], chunk))
+            break;
+        left = (uint16_t)(left - chunk);
+        have = (uint8_t)(have + chunk);
+
+        for (pos = 0; pos < have; pos = (uint8_t)(pos + frameLen))
+        {
+            frameLen = _FrameBytes(buf[pos]);
+            if (frameLen == 0)
+            {
+                left = 0;  // Empty FIFO or lost sync: drop the rest
+                pos = have;
+                break;
+            }
+            if (pos + frameLen > have)
+                break;  // Rest of the frame is in the next burst
+
+            if (buf[pos] == BMP388_FIFO_HDR_PRESS_TEMP && n < maxSamples)
+            {
+                samples[n].temperature = this->CompensateTemperature(_Raw24(&buf[pos + 1]));
+                samples[n].pressure = this->CompensatePressure(_Raw24(&buf[pos + 4]), samples[n].temperature);
+                n++;
+            }
+        }
+
+        have = (uint8_t)(have - pos);
+        memmove(buf, &buf[pos], have);
+    }
+
+    if (n == 0)
+        return 0;
+
+    if (nAvail < n)
+        nAvail = n;
+    tNewest = (tNewest > this->groupDelayMicros) ? tNewest - this->groupDelayMicros : 0;
+    for (size_t k = 0; k < n; k++)
+        samples[k].micros = tNewest - ((uint64_t)(nAvail - 1 - k) * this->fifoPeriodMicros);
+
+    this->_p = samples[n - 1].pressure;
+    this->_t = samples[n - 1].temperature;
+    this->prevMeasMicros = samples[n - 1].micros;
+
+    return n;
+}
+
+
 // ----------------------------------------------------------------------------
 // BMP388Baro::ReadSensor()
 // ----------------------------------------------------------------------------
 /**
- * Use Adafruit's BMP388 library to read temperature and pressure registers.
- * 
- * @returns True if good reading, false if error.
+ * Read the latest sample from the data registers and compensate it.
+ *
+ * @returns True if good reading, false if not initialized or error.
  */
 bool BMP388Baro::ReadSensor()
 {
-    if (!this->performReading())
+    uint8_t buf[6];
+    uint64_t tStart;
+
+    if (!this->isConnected)
+        return false;
+
+    tStart = Micros64();
+    if (!this->_bus->ReadRegs(BMP388_ADDR, BMP388_REG_DATA, buf, 6))
     {
         #ifdef BMP388_DEBUG
-        DEBUG_PRINTLN("BMP388BAROTEMP:ReadSensor ERROR: Error reading sensor data.");
+        DEBUG_PRINTLN("BMP388BARO:ReadSensor ERROR: Error reading sensor data.");
         #endif
         return false;
     }
 
-    this->prevMeasMicros = micros();
-
-    // Cvt. from double to float
-    this->_p = (float)this->pressure;
-    this->_t = (float)this->temperature;
+    this->_t = this->CompensateTemperature(_Raw24(&buf[3]));
+    this->_p = this->CompensatePressure(_Raw24(&buf[0]), this->_t);
+    this->prevMeasMicros = (tStart > this->groupDelayMicros) ? tStart - this->groupDelayMicros : 0;
 
     return true;
 }
 
 
+// ----------------------------------------------------------------------------
+// BMP388Baro::CompensateTemperature(uint32_t rawT)
+// ----------------------------------------------------------------------------
+/**
+ * Bosch floating-point temperature compensation, in single precision.
+ *
+ * @param rawT  24-bit temperature ADC value.
+ * @returns     Temperature in [C]
+ */
+float BMP388Baro::CompensateTemperature(uint32_t rawT) const
+{
+    float pd1 = (float)rawT - this->_calib.t1;
+    float pd2 = pd1 * this->_calib.t2;
+
+    return pd2 + (pd1 * pd1) * this->_calib.t3;
+}
+
+
+// ----------------------------------------------------------------------------
+// BMP388Baro::CompensatePressure(uint32_t rawP, float tempC)
+// ----------------------------------------------------------------------------
+/**
+ * Bosch floating-point pressure compensation, in single precision. Within
+ * ~0.1Pa of the double-precision result, well under the sensor's noise.
+ *
+ * @param rawP   24-bit pressure ADC value.
+ * @param tempC  [C] Compensated temperature of the same sample.
+ * @returns      Pressure in [Pa]
+ */
+float BMP388Baro::CompensatePressure(uint32_t rawP, float tempC) const
+{
+    const BMP388Calib_t &c = this->_calib;
+    float t = tempC;
+    float t2 = t * t;
+    float t3 = t2 * t;
+    float up = (float)rawP;
+    float up2 = up * up;
+    float out1 = c.p5 + (c.p6 * t) + (c.p7 * t2) + (c.p8 * t3);
+    float out2 = up * (c.p1 + (c.p2 * t) + (c.p3 * t2) + (c.p4 * t3));
+    float out3 = (up2 * (c.p9 + (c.p10 * t))) + (up2 * up * c.p11);
+
+    return out1 + out2 + out3;
+}
+
+
 // ----------------------------------------------------------------------------
 // BMP388Baro::GetPressure()
 // ----------------------------------------------------------------------------
 /**
  * Return atmospheric pressure in [Pa].
- * 
+ *
  * @returns Pressure in [Pa]
  */
 float BMP388Baro::GetPressure()
@@ -154,10 +372,100 @@ float BMP388Baro::GetPressure()
 // ----------------------------------------------------------------------------
 /**
  * Return atmospheric temperature in [C].
- * 
+ *
  * @returns Temperature in [C]
  */
 float BMP388Baro::GetTemperature()
 {
     return this->_t;
 }
+
+
+// ----------------------------------------------------------------------------
+// BMP388Baro::_ReadCalib()
+// ----------------------------------------------------------------------------
+/**
+ * Read the NVM trimming coefficients and scale them to float (datasheet
+ * section 9.1). Done once, so compensation is only multiply-adds.
+ *
+ * @returns True if read, false if the bus read failed.
+ */
+bool BMP388Baro::_ReadCalib()
+{
+    uint8_t n[BMP388_NVM_LEN];
+    BMP388Calib_t &c = this->_calib;
+
+    if (!this->_bus->ReadRegs(BMP388_ADDR, BMP388_REG_NVM_PAR_T1, n, BMP388_NVM_LEN))
+        return false;
+
+    c.t1 = ldexpf((float)(uint16_t)((n[1] << 8) | n[0]), 8);
+    c.t2 = ldexpf((float)(uint16_t)((n[3] << 8) | n[2]), -30);
+    c.t3 = ldexpf((float)(int8_t)n[4], -48);
+    c.p1 = ldexpf((float)(int16_t)((n[6] << 8) | n[5]) - 16384.0f, -20);
+    c.p2 = ldexpf((float)(int16_t)((n[8] << 8) | n[7]) - 16384.0f, -29);
+    c.p3 = ldexpf((float)(int8_t)n[9], -32);
+    c.p4 = ldexpf((float)(int8_t)n[10], -37);
+    c.p5 = ldexpf((float)(uint16_t)((n[12] << 8) | n[11]), 3);
+    c.p6 = ldexpf((float)(uint16_t)((n[14] << 8) | n[13]), -6);
+    c.p7 = ldexpf((float)(int8_t)n[15], -8);
+    c.p8 = ldexpf((float)(int8_t)n[16], -15);
+    c.p9 = ldexpf((float)(int16_t)((n[18] << 8) | n[17]), -48);
+    c.p10 = ldexpf((float)(int8_t)n[19], -48);
+    c.p11 = ldexpf((float)(int8_t)n[20], -65);
+
+    return true;
+}
+
+
+/* Length of a FIFO frame with this header [bytes], 0 for empty/unknown */
+uint8_t BMP388Baro::_FrameBytes(uint8_t header)
+{
+    switch (header)
+    {
+        case BMP388_FIFO_HDR_PRESS_TEMP:
+            return BMP388_FIFO_FRAME_BYTES;
+        case BMP388_FIFO_HDR_PRESS:
+        case BMP388_FIFO_HDR_TEMP:
+        case BMP388_FIFO_HDR_TIME:
+            return 4;
+        case BMP388_FIFO_HDR_CONFIG:
+        case BMP388_FIFO_HDR_ERROR:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+
+/* 24-bit ADC value, XLSB first */
+uint32_t BMP388Baro::_Raw24(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16);
+}
+
+
+/**
+ * Write to device register over I2C.
+ *
+ * @param regOfInterest Register address on device.
+ * @param valToWrite Value to write to register.
+ */
+void BMP388Baro::I2Cwrite8(uint8_t regOfInterest, uint8_t valToWrite)
+{
+    this->_bus->WriteReg8(BMP388_ADDR, regOfInterest, valToWrite);
+}
+
+
+/**
+ * Read register value from I2C device.
+ *
+ * @param regOfInterest Register address on device.
+ * @return Value/data in register. 0 if the read failed.
+ */
+uint8_t BMP388Baro::I2Cread8(uint8_t regOfInterest)
+{
+    uint8_t val = 0;
+
+    this->_bus->ReadReg8(BMP388_ADDR, regOfInterest, &val);
+    return val;
+}
@@ -0,0 +1,189 @@
+// ----------------------------------------------------------------------------
+// SENSOR DATA-READY INTERRUPT PIN
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Timestamps a sensor's data-ready (DRDY/INT) pin from its interrupt. See
+ * data_ready_pin.h.
+ */
+
+
+#include "sensor_drivers/data_ready_pin.h"
+#include "hal/hal_platform.h"
+
+
+DataReadyPin *DataReadyPin::_slots[DRDY_MAX_PINS] = {nullptr};
+
+
+/* ISR trampoline for one slot. attachInterrupt() takes a plain function. */
+template <uint8_t SLOT>
+void DataReadyPin::_Isr()
+{
+    DataReadyPin *drdy = _slots[SLOT];
+    if (drdy != nullptr)
+        drdy->Trigger();
+}
+
+
+// ----------------------------------------------------------------------------
+// DataReadyPin()
+// ----------------------------------------------------------------------------
+/**
+ * Construct a detached data-ready pin. Drivers without a pin keep polling.
+ */
+DataReadyPin::DataReadyPin()
+{
+    this->overruns = 0;
+    this->missed = 0;
+    this->_head = 0;
+    this->_tail = 0;
+    this->_pin = DRDY_PIN_NONE;
+    this->_slot = -1;
+}
+
+
+DataReadyPin::~DataReadyPin()
+{
+    this->Detach();
+}
+
+
+// ----------------------------------------------------------------------------
+// Attach(int8_t pin, bool activeHigh)
+// ----------------------------------------------------------------------------
+/**
+ * Attach the interrupt on a sensor's data-ready pin.
+ *
+ * @param pin         Teensy pin the sensor's DRDY/INT output is wired to.
+ *                    DRDY_PIN_NONE leaves the pin detached (polled).
+ * @param activeHigh  True to trigger on the rising edge, false for falling.
+ * @return  True if attached, false if no pin or no free ISR slot.
+ */
+bool DataReadyPin::Attach(int8_t pin, bool activeHigh)
+{
+    this->Detach();
+    if (pin < 0)
+        return false;
+
+    for (uint8_t i = 0; i < DRDY_MAX_PINS; i++)
+    {
+        if (_slots[i] != nullptr)
+            continue;
+
+        this->Clear();
+        this->_pin = pin;
+        this->_slot = (int8_t)i;
+        _slots[i] = this;
+
+        #ifdef ARDUINO
+        static void (*const isrs[DRDY_MAX_PINS])() = {_Isr<0>, _Isr<1>, _Isr<2>, _Isr<3>};
+        pinMode(pin, INPUT);
+        attachInterrupt(digitalPinToInterrupt(pin), isrs[i], activeHigh ? RISING : FALLING);
+        #else
+        (void)activeHigh;
+        #endif
+        return true;
+    }
+
+    return false;
+}
+
+
+/* Detach the interrupt. The driver goes back to polling. */
+void DataReadyPin::Detach()
+{
+    if (this->_slot < 0)
+        return;
+
+    #ifdef ARDUINO
+    detachInterrupt(digitalPinToInterrupt(this->_pin));
+    #endif
+    _slots[this->_slot] = nullptr;
+    this->_slot = -1;
+    this->_pin = DRDY_PIN_NONE;
+}
+
+
+/* Return true if the interrupt is attached */
+bool DataReadyPin::IsAttached() const
+{
+    return this->_slot >= 0;
+}
+
+
+/* Return true if a data-ready event is waiting to be read */
+bool DataReadyPin::Available() const
+{
+    return this->_head != this->_tail;
+}
+
+
+// ----------------------------------------------------------------------------
+// Pop(uint64_t *tMicros)
+// ----------------------------------------------------------------------------
+/**
+ * Take the newest pending data-ready event. Call once per sample read. The 
+ * sensor's output registers only hold the newest sample, so older pending 
+ * events are dropped and counted in 'missed'.
+ *
+ * @param tMicros  [us] Output, Micros64() when the sample became ready. Can be
+ *                 nullptr.
+ * @return  True if there was an event, false if none was pending.
+ */
+bool DataReadyPin::Pop(uint64_t *tMicros)
+{
+    uint8_t head = this->_head;
+    uint8_t tail = this->_tail;
+    uint8_t newest;
+
+    if (head == tail)
+        return false;
+
+    newest = (uint8_t)((head - 1) & (DRDY_QUEUE_SIZE - 1));
+    this->missed += (uint8_t)((newest - tail) & (DRDY_QUEUE_SIZE - 1));
+    if (tMicros != nullptr)
+        *tMicros = this->_times[newest];
+    this->_tail = head;
+    return true;
+}
+
+
+/* Drop all pending events, e.g. after reconfiguring the sensor */
+void DataReadyPin::Clear()
+{
+    this->_tail = this->_head;
+}
+
+
+/* Record a data-ready event now. Called from the ISR, or to simulate one. */
+void DataReadyPin::Trigger()
+{
+    this->Trigger(Micros64());
+}
+
+
+// ----------------------------------------------------------------------------
+// Trigger(uint64_t tMicros)
+// ----------------------------------------------------------------------------
+/**
+ * Record a data-ready event with a given timestamp. Drops the event if the
+ * queue is full.
+ *
+ * @param tMicros  [us] When the sample became ready.
+ */
+void DataReadyPin::Trigger(uint64_t tMicros)
+{
+    uint8_t head = this->_head;
+    uint8_t next = (uint8_t)((head + 1) & (DRDY_QUEUE_SIZE - 1));
+
+    if (next == this->_tail)
+    {
+        this->overruns = this->overruns + 1;
+        return;
+    }
+
+    this->_times[head] = tMicros;
+    this->_head = next;
+}
@@ -24,16 +24,26 @@
  * FXAS21002 Constructor.
  * Constructor for the FXAS21002 gyro sensor.
  * 
- * @param wireInput  I2C/Wire interface the device is connected to.
+ * @param bus  I2C bus the device is connected to.
  */
-FXAS21002Gyro::FXAS21002Gyro(TwoWire *wireInput)
+FXAS21002Gyro::FXAS21002Gyro(I2CBus *bus)
 {
     // Clear raw data
-    this->_gx = 0.0f;
-    this->_gy = 0.0f;
-    this->_gz = 0.0f;
-    this->prevMeasMicros = micros();
-    this->_SensorWire = wireInput;
+    this->_raw[0] = 0;
+    this->_raw[1] = 0;
+    this->_raw[2] = 0;
+    this->_sens = 0.0f;
+    this->gyroRange = GYRO_RNG_1000DPS;
+    this->prevMeasMicros = 0;
+    this->groupDelayMicros = GyroGroupDelayMicros(GYRO_ODR_400HZ);
+    this->_odrHz = GYRO_ODR_400HZ;
+    this->_settledMicros = 0;
+    this->fifoOverflows = 0;
+    this->isFIFOEnabled = false;
+    this->fifoPeriodMicros = 1000000UL / GYRO_ODR_400HZ;
+    this->readFailures = 0;
+    this->_txn.status = I2C_TXN_IDLE;
+    this->_bus = bus;
 }
 
 
@@ -46,11 +56,34 @@ FXAS21002Gyro::FXAS21002Gyro(TwoWire *wireInput)
  * @return  True if successful, false if failed.
  */
 bool FXAS21002Gyro::Initialize(GyroRanges_t rng)
+{
+    RegConfigStatus_t status;
+    uint32_t waitMicros;
+
+    if (!this->BeginInitialize(rng))
+        return false;
+
+    while ((status = this->StepInitialize(&waitMicros)) == REG_CONFIG_BUSY)
+        delayMicroseconds(waitMicros);
+
+    return status == REG_CONFIG_DONE;
+}
+
+
+/**
+ * Start initializing the gyro without blocking: check its ID and set up the 
+ * configuration. StepInitialize() then writes it between the datasheet 
+ * waits, for re-initializing from a running loop. Initialize() does both.
+ * 
+ * @param rng Gyro measurement range.
+ * @return  True if the gyro answered, false if not or the range is unknown.
+ */
+bool FXAS21002Gyro::BeginInitialize(GyroRanges_t rng)
 {
     uint8_t ctrlReg0;
     uint8_t connectedSensorID;
 
-    this->_SensorWire->begin();
+    this->_bus->Begin();
     this->gyroRange = rng;  // Set range
     
 
@@ -87,6 +120,7 @@ bool FXAS21002Gyro::Initialize(GyroRanges_t rng)
             return false;
             break;
     }
+    this->_sens = GyroSensitivity(this->gyroRange);  // Once, not per sample
 
     
     // Reset sensor, then switch to active mode to configure.
@@ -95,117 +129,407 @@ bool FXAS21002Gyro::Initialize(GyroRanges_t rng)
     //   FS range = +/- 1000dps
     //   HPF disabled
     //   LFP bandwidth = 128Hz
+    const RegConfig_t config[] = {
+        {GYRO_REG_CTRL1, 0x00, REG_NO_VERIFY, 0},  // Stby
+        {GYRO_REG_CTRL1, GYRO_CTRL1_RST, REG_NO_VERIFY, GYRO_BOOT_US},  // Reset
+        {GYRO_REG_CTRL0, ctrlReg0, REG_VERIFY_ALL, 0},  // Set sensitivity
+        {GYRO_REG_CTRL1, 0x06, REG_VERIFY_ALL, GyroTurnOnMicros(GYRO_ODR_400HZ)}  // Active, ODR = 400Hz
+    };
+
+    return this->_initJob.Start(this->_bus, FXAS21002C_ADDRESS, config, sizeof(config) / sizeof(config[0]), REG_BURST_AUTOINC);
+}
 
-    this->I2Cwrite8(GYRO_REG_CTRL1, 0x00);  // Stby
-    this->I2Cwrite8(GYRO_REG_CTRL1, (1 << 6));  // Reset
-    this->I2Cwrite8(GYRO_REG_CTRL0, ctrlReg0);  // Set sensitivity
-    this->I2Cwrite8(GYRO_REG_CTRL1, 0x06);  // Active, ODR = 400Hz
-    // this->I2Cwrite8(GYRO_REG_CTRL1, 0x0C);  // Active, ODR = 800Hz
-    delay(100);  // Short delay
 
-    return true;
+/**
+ * Write the next part of the configuration started by BeginInitialize(), up 
+ * to the next datasheet wait (reset boot, standby-to-active), then verify it. 
+ * 
+ * @param waitMicros  Output, [us] time before the next call. 0 if none.
+ * @return  REG_CONFIG_BUSY until the configuration is written and verified, 
+ *          then REG_CONFIG_DONE, or REG_CONFIG_FAILED.
+ */
+RegConfigStatus_t FXAS21002Gyro::StepInitialize(uint32_t *waitMicros)
+{
+    RegConfigStatus_t status = this->_initJob.Step(waitMicros);
+
+    if (status == REG_CONFIG_DONE)
+    {
+        this->_odrHz = GYRO_ODR_400HZ;
+        this->groupDelayMicros = GyroGroupDelayMicros(GYRO_ODR_400HZ);
+        this->isFIFOEnabled = false;
+    }
+    #ifdef FXAS21002_DEBUG
+    else if (status == REG_CONFIG_FAILED)
+        DEBUG_PRINTLN("FXAS21002::Initialize ERROR: Configuration did not stick.");
+    #endif
+
+    return status;
 }
 
 
 /**
- * Read gyroscope data from device registers.
- * Raw gyro readings are in [deg/s].
+ * Put the gyro in FIFO mode. Samples are buffered on the sensor (up to 32) 
+ * and drained with ReadFIFO(), so the gyro can run at a high ODR without one 
+ * I2C transaction per sample. Call after Initialize().
  * 
+ * @param odr        Output data rate.
+ * @param watermark  FIFO watermark [samples], 1 to 31. Sets the watermark flag 
+ *                   (F_STATUS[F_WMKF]) once this many samples are buffered.
+ * @see GyroODR_t
  * @return  True if successful, false if failed.
  */
-bool FXAS21002Gyro::ReadSensor()
+bool FXAS21002Gyro::ConfigureFIFO(GyroODR_t odr, uint8_t watermark)
 {
-    int16_t gxRaw;
-    int16_t gyRaw;
-    int16_t gzRaw;
-
-    // Read 7 bytes from sensor
-    this->_SensorWire->beginTransmission((uint8_t)FXAS21002C_ADDRESS);
-    this->_SensorWire->write(GYRO_REG_STATUS | 0x80);
-    this->_SensorWire->endTransmission();
-    this->_SensorWire->requestFrom((uint8_t)FXAS21002C_ADDRESS, (uint8_t)7);
-
-    uint8_t status = this->_SensorWire->read();
-    uint8_t xhi = this->_SensorWire->read();
-    uint8_t xlo = this->_SensorWire->read();
-    uint8_t yhi = this->_SensorWire->read();
-    uint8_t ylo = this->_SensorWire->read();
-    uint8_t zhi = this->_SensorWire->read();
-    uint8_t zlo = this->_SensorWire->read();
-
-    // Shift values to make proper integer, then cast int to float (with no decimals)
-    gxRaw = (int16_t)((xhi << 8) | xlo);
-    gyRaw = (int16_t)((yhi << 8) | ylo);
-    gzRaw = (int16_t)((zhi << 8) | zlo);
-    this->_gx = (float)gxRaw;  // units of LSB
-    this->_gy = (float)gyRaw;
-    this->_gz = (float)gzRaw;
-
-    this->prevMeasMicros = micros();
-
-    // Convert int readings to floats [dps] depending on sensitivity (deg/LSB)
-    switch (this->gyroRange)
+    uint8_t ctrlReg1;
+
+    // CTRL_REG1[DR]
+    switch (odr)
     {
-        case GYRO_RNG_250DPS:
-            this->_gx *= GYRO_SENS_250;
-            this->_gy *= GYRO_SENS_250;
-            this->_gz *= GYRO_SENS_250;
+        case GYRO_ODR_800HZ:
+            ctrlReg1 = (0 << 2);
             break;
-        case GYRO_RNG_500DPS:
-            this->_gx *= GYRO_SENS_500;
-            this->_gy *= GYRO_SENS_500;
-            this->_gz *= GYRO_SENS_500;
+        case GYRO_ODR_400HZ:
+            ctrlReg1 = (1 << 2);
             break;
-        case GYRO_RNG_1000DPS:
-            this->_gx *= GYRO_SENS_1000;
-            this->_gy *= GYRO_SENS_1000;
-            this->_gz *= GYRO_SENS_1000;
+        case GYRO_ODR_200HZ:
+            ctrlReg1 = (2 << 2);
             break;
-        case GYRO_RNG_2000DPS:
-            this->_gx *= GYRO_SENS_2000;
-            this->_gy *= GYRO_SENS_2000;
-            this->_gz *= GYRO_SENS_2000;
+        case GYRO_ODR_100HZ:
+            ctrlReg1 = (3 << 2);
+            break;
+        case GYRO_ODR_50HZ:
+            ctrlReg1 = (4 << 2);
+            break;
+        case GYRO_ODR_25HZ:
+            ctrlReg1 = (5 << 2);
             break;
         default:
-            return false;  // TODO: Raise error?
+            #ifdef FXAS21002_DEBUG
+            DEBUG_PRINTLN("FXAS21002::ConfigureFIFO ERROR: Unknown gyro ODR specified.");
+            #endif
+            return false;
+            break;
+    }
+
+    if (watermark == 0 || watermark >= GYRO_FIFO_SIZE)
+    {
+        #ifdef FXAS21002_DEBUG
+        DEBUG_PRINTLN("FXAS21002::ConfigureFIFO ERROR: FIFO watermark must be 1 to 31 samples.");
+        #endif
+        return false;
+    }
+
+    // FIFO and DR settings can only be changed in standby. The FIFO has to be 
+    // disabled before switching modes.
+    const RegConfig_t config[] = {
+        {GYRO_REG_CTRL1, 0x00, REG_NO_VERIFY, 0},  // Stby
+        {GYRO_REG_F_SETUP, 0x00, REG_NO_VERIFY, 0},  // FIFO off
+        {GYRO_REG_F_SETUP, (uint8_t)(GYRO_F_SETUP_CIRCULAR | watermark), REG_VERIFY_ALL, 0},
+        {GYRO_REG_CTRL3, GYRO_CTRL3_WRAPTOONE, REG_VERIFY_ALL, 0},  // Burst reads walk through the FIFO
+        {GYRO_REG_CTRL1, (uint8_t)(ctrlReg1 | GYRO_CTRL1_ACTIVE), REG_VERIFY_ALL, GyroTurnOnMicros((uint32_t)odr)}
+    };
+
+    if (!ApplyRegConfig(this->_bus, FXAS21002C_ADDRESS, config, sizeof(config) / sizeof(config[0]), REG_BURST_AUTOINC))
+    {
+        #ifdef FXAS21002_DEBUG
+        DEBUG_PRINTLN("FXAS21002::ConfigureFIFO ERROR: FIFO setup did not stick.");
+        #endif
+        return false;
+    }
+
+    this->_odrHz = (uint32_t)odr;
+    this->fifoPeriodMicros = 1000000UL / (uint32_t)odr;
+    this->groupDelayMicros = GyroGroupDelayMicros((uint32_t)odr);
+    this->isFIFOEnabled = true;
+    return true;
+}
+
+
+/**
+ * Drain buffered samples from the gyro FIFO, oldest first. Samples are read 
+ * in bursts of up to GYRO_FIFO_SAMPLES_PER_READ (bus transfer limit), with 
+ * CTRL_REG3[WRAPTOONE] set so each burst steps through consecutive FIFO 
+ * samples. Sample times are reconstructed from the ODR, counting back from 
+ * the newest sample (ready by the time the FIFO status read started), less 
+ * the group delay. The latest sample is also available from GetGx(), GetGy(), 
+ * and GetGz().
+ * 
+ * @param samples     Buffer to write samples to [deg/s].
+ * @param maxSamples  Size of the buffer. Samples that don't fit stay in the 
+ *                    FIFO for the next call.
+ * @return  Number of samples read. 0 if the FIFO was empty or the read failed.
+ */
+size_t FXAS21002Gyro::ReadFIFO(GyroSample_t *samples, size_t maxSamples)
+{
+    uint8_t buf[6 * GYRO_FIFO_SAMPLES_PER_READ];
+    uint8_t fStatus;
+    size_t nAvail;
+    size_t nRead;
+    size_t nBurst;
+    size_t i;
+    uint64_t tNewest;
+    float sens;
+
+    if (this->isFIFOEnabled == false || samples == nullptr)
+        return 0;
+
+    tNewest = this->_SampleMicros(Micros64());
+    fStatus = this->I2Cread8(GYRO_REG_F_STATUS);
+    if (fStatus & GYRO_F_STATUS_OVF)
+        this->fifoOverflows++;
+
+    nAvail = fStatus & GYRO_F_STATUS_CNT;
+    nRead = (nAvail < maxSamples) ? nAvail : maxSamples;
+    sens = this->_sens;
+
+    for (i = 0; i < nRead; i += nBurst)
+    {
+        nBurst = nRead - i;
+        if (nBurst > GYRO_FIFO_SAMPLES_PER_READ)
+            nBurst = GYRO_FIFO_SAMPLES_PER_READ;
+
+        if (!this->_bus->ReadRegs(FXAS21002C_ADDRESS, GYRO_REG_XOUT_MSB, buf, (uint8_t)(6 * nBurst)))
             break;
+
+        for (size_t k = i; k < i + nBurst; k++)
+        {
+            const uint8_t *s = &buf[6 * (k - i)];
+
+            this->_raw[0] = (int16_t)((s[0] << 8) | s[1]);
+            this->_raw[1] = (int16_t)((s[2] << 8) | s[3]);
+            this->_raw[2] = (int16_t)((s[4] << 8) | s[5]);
+            samples[k].gx = (float)this->_raw[0] * sens;
+            samples[k].gy = (float)this->_raw[1] * sens;
+            samples[k].gz = (float)this->_raw[2] * sens;
+            samples[k].micros = tNewest - ((uint64_t)(nAvail - 1 - k) * this->fifoPeriodMicros);
+            this->_Publish(samples[k].micros);
+        }
     }
 
-//    // Convert [dps] to [rad/s]
-//    this->_gx *= 0.01745329251994329576923690768489f;
-//    this->_gy *= 0.01745329251994329576923690768489f;
-//    this->_gz *= 0.01745329251994329576923690768489f;
+    nRead = i;
+    if (nRead > 0)
+        this->prevMeasMicros = samples[nRead - 1].micros;
+
+    return nRead;
+}
+
+
+/**
+ * Read gyroscope data from device registers. Keeps the raw counts; GetGx() 
+ * etc. scale them to [deg/s] with the sensitivity set in Initialize(), and 
+ * GetRaw() returns them for a fused conversion (see counts_to_si.h). The 
+ * sample is also published to 'stream', as are FIFO and async samples.
+ * 
+ * @return  True if successful, false if failed.
+ */
+bool FXAS21002Gyro::ReadSensor()
+{
+    uint8_t buf[7];
+    uint64_t tStart;
+
+    if (this->_sens == 0.0f)
+        return false;  // Not initialized
+
+    // Read 7 bytes from sensor: STATUS, then X, Y, Z (MSB first)
+    tStart = Micros64();
+    if (!this->_bus->ReadRegs(FXAS21002C_ADDRESS, GYRO_REG_STATUS, buf, 7))
+        return false;
+
+    this->_raw[0] = (int16_t)((buf[1] << 8) | buf[2]);
+    this->_raw[1] = (int16_t)((buf[3] << 8) | buf[4]);
+    this->_raw[2] = (int16_t)((buf[5] << 8) | buf[6]);
+
+    this->prevMeasMicros = this->_SampleMicros(tStart);
+    this->_Publish(this->prevMeasMicros);
 
     return true;
 }
 
 
+/**
+ * Route the data-ready interrupt to INT1 and attach it to a Teensy pin. 
+ * ReadSensor() then timestamps samples with the interrupt time. Call after 
+ * Initialize(). Routing the interrupt takes the gyro through standby, so 
+ * DataReady() ignores the interrupts for its turn-on time 
+ * (GyroTurnOnMicros()) while the output settles; this doesn't wait for it.
+ * 
+ * @param pin  Teensy pin wired to the gyro's INT1. DRDY_PIN_NONE to poll.
+ * @return  True if attached, false if polling.
+ */
+bool FXAS21002Gyro::AttachDataReady(int8_t pin)
+{
+    uint8_t ctrlReg1;
+
+    if (pin < 0)
+    {
+        this->drdy.Detach();
+        return false;
+    }
+
+    // CTRL_REG2 can only be changed in standby
+    ctrlReg1 = this->I2Cread8(GYRO_REG_CTRL1);
+    this->I2Cwrite8(GYRO_REG_CTRL1, ctrlReg1 & ~(GYRO_CTRL1_ACTIVE | 0x01));  // Stby
+    this->I2Cwrite8(GYRO_REG_CTRL2, GYRO_CTRL2_DRDY_INT1);
+    this->I2Cwrite8(GYRO_REG_CTRL1, ctrlReg1);
+    this->_settledMicros = Micros64() + GyroTurnOnMicros(this->_odrHz);
+
+    return this->drdy.Attach(pin, true);
+}
+
+
+/**
+ * Return true if a new sample is ready to read. Always true without a 
+ * data-ready pin (polled). False, with the interrupts dropped, until the 
+ * turn-on time after AttachDataReady() has passed: those samples are still 
+ * settling.
+ */
+bool FXAS21002Gyro::DataReady()
+{
+    if (!this->drdy.IsAttached())
+        return true;
+
+    if (Micros64() < this->_settledMicros)
+    {
+        this->drdy.Clear();
+        return false;
+    }
+    return this->drdy.Available();
+}
+
+
+/**
+ * Queue a non-blocking read of the gyro output registers. When it finishes, 
+ * AsyncI2C::Poll() decodes it and GetGx(), GetGy(), and GetGz() return the 
+ * new sample. prevMeasMicros is the data-ready time if the pin is wired, 
+ * otherwise the time the read started on the bus, less the group delay.
+ * 
+ * @param i2c  Async I2C engine on the gyro's bus.
+ * @return  True if queued, false if the queue is full or a read is pending.
+ */
+bool FXAS21002Gyro::SubmitRead(AsyncI2C *i2c)
+{
+    if (i2c == nullptr)
+        return false;
+
+    return i2c->SubmitRead(&this->_txn, FXAS21002C_ADDRESS, GYRO_REG_XOUT_MSB, this->_txnBuf, 
+        sizeof(this->_txnBuf), _OnReadComplete, this);
+}
+
+
+/* Return true if an async read is queued or on the bus */
+bool FXAS21002Gyro::IsReadPending()
+{
+    return this->_txn.status == I2C_TXN_QUEUED || this->_txn.status == I2C_TXN_BUSY;
+}
+
+
+/* Return the status of the latest async read, I2C_TXN_DONE if it succeeded */
+I2CTxnStatus_t FXAS21002Gyro::ReadStatus()
+{
+    return this->_txn.status;
+}
+
+
+/* Async read completion. Runs from AsyncI2C::Poll(). */
+void FXAS21002Gyro::_OnReadComplete(I2CTransaction_t *txn)
+{
+    FXAS21002Gyro *gyro = (FXAS21002Gyro *)txn->context;
+    const uint8_t *raw = txn->buf;
+
+    if (txn->status != I2C_TXN_DONE)
+    {
+        gyro->readFailures++;
+        return;
+    }
+
+    gyro->_raw[0] = (int16_t)((raw[0] << 8) | raw[1]);
+    gyro->_raw[1] = (int16_t)((raw[2] << 8) | raw[3]);
+    gyro->_raw[2] = (int16_t)((raw[4] << 8) | raw[5]);
+
+    gyro->prevMeasMicros = gyro->_SampleMicros(txn->startMicros);
+    gyro->_Publish(gyro->prevMeasMicros);
+}
+
+
+/**
+ * Publish the latest raw sample to 'stream'. If the sensor system hasn't 
+ * drained it, the sample is refused and counted in stream.Overruns().
+ * 
+ * @param micros  [us] Micros64() when the sample was taken.
+ */
+void FXAS21002Gyro::_Publish(uint64_t micros)
+{
+    SensorSample_t sample;
+
+    sample.micros = micros;
+    sample.raw[0] = this->_raw[0];
+    sample.raw[1] = this->_raw[1];
+    sample.raw[2] = this->_raw[2];
+    this->stream.Push(sample);
+}
+
+
+// ----------------------------------------------------------------------------
+// _SampleMicros(uint64_t startMicros)
+// ----------------------------------------------------------------------------
+/**
+ * Timestamp for the sample being read: the data-ready time if the pin is 
+ * wired, otherwise the start of the read, less the group delay.
+ * 
+ * @param startMicros  [us] Micros64() when the read started.
+ * @return  [us] Micros64() when the sample was taken.
+ */
+uint64_t FXAS21002Gyro::_SampleMicros(uint64_t startMicros)
+{
+    uint64_t t;
+
+    if (!this->drdy.Pop(&t))
+        t = startMicros;
+    return (t > this->groupDelayMicros) ? t - this->groupDelayMicros : 0;
+}
+
+
 /**
  * Read device's 8-bit temperature register and return in degrees C.
  * Temperature will not have any decimals, as it is an 8-bit signed int (-127C 
  * to 127C). Note that the temperature is not factory calibrated!
  * 
- * @returns Temperature in [C]
+ * @returns Temperature in [C], 0 if the read failed
  */
 float FXAS21002Gyro::GetTemperature()
 {
-    int8_t tempRead;
-    float scaling;
-    float tempC;
+    float tempC = 0.0f;
 
-    scaling = 1.0f;  // [deg.C / LSB]
-    tempRead = this->I2Cread8(GYRO_REG_TEMP);
-    tempC = (float)tempRead * scaling;
+    this->ReadTemperature(&tempC);
     return tempC;
 }
 
 
+/**
+ * Read the die temperature. 1C resolution, not factory calibrated.
+ * 
+ * @param tempC  Output, temperature in [C]. Unchanged if the read failed.
+ * @returns True if successful, false if the read failed.
+ */
+bool FXAS21002Gyro::ReadTemperature(float *tempC)
+{
+    uint8_t tempRead;
+    float scaling = 1.0f;  // [deg.C / LSB]
+
+    if (!this->_bus->ReadReg8(FXAS21002C_ADDRESS, GYRO_REG_TEMP, &tempRead))
+        return false;
+
+    *tempC = (float)(int8_t)tempRead * scaling;
+    return true;
+}
+
+
 /**
  * Return gyro x-measurement in [deg/s]
  */
 float FXAS21002Gyro::GetGx()
 {
-    return this->_gx;
+    return (float)this->_raw[0] * this->_sens;
 }
 
 
@@ -214,7 +538,7 @@ float FXAS21002Gyro::GetGx()
  */
 float FXAS21002Gyro::GetGy()
 {
-    return this->_gy;
+    return (float)this->_raw[1] * this->_sens;
 }
 
 
@@ -223,7 +547,21 @@ float FXAS21002Gyro::GetGy()
  */
 float FXAS21002Gyro::GetGz()
 {
-    return this->_gz;
+    return (float)this->_raw[2] * this->_sens;
+}
+
+
+/**
+ * Copy the latest gyro reading in raw counts [LSB], for a fused conversion 
+ * (see counts_to_si.h). Multiply by GyroSensitivity(range) for [deg/s].
+ * 
+ * @param raw  [gx, gy, gz] Output counts.
+ */
+void FXAS21002Gyro::GetRaw(int16_t raw[3])
+{
+    raw[0] = this->_raw[0];
+    raw[1] = this->_raw[1];
+    raw[2] = this->_raw[2];
 }
 
 
@@ -235,11 +573,7 @@ float FXAS21002Gyro::GetGz()
  */
 void FXAS21002Gyro::I2Cwrite8(uint8_t regOfInterest, uint8_t valToWrite)
 {
-    // Init. communication
-    this->_SensorWire->beginTransmission(FXAS21002C_ADDRESS);
-    this->_SensorWire->write((uint8_t)regOfInterest);
-    this->_SensorWire->write((uint8_t)valToWrite);
-    this->_SensorWire->endTransmission();
+    this->_bus->WriteReg8(FXAS21002C_ADDRESS, regOfInterest, valToWrite);
 }
 
 
@@ -247,23 +581,12 @@ void FXAS21002Gyro::I2Cwrite8(uint8_t regOfInterest, uint8_t valToWrite)
  * Read FXAS21002 register value over I2C.
  * 
  * @param regOfInterest Register address on device.
- * @return Value stored in the register.
+ * @return Value stored in the register. 0 if the read failed.
  */
 uint8_t FXAS21002Gyro::I2Cread8(uint8_t regOfInterest)
 {
-    uint8_t val;
-
-    // Init. communication
-    this->_SensorWire->beginTransmission((uint8_t)FXAS21002C_ADDRESS);
-    this->_SensorWire->write((uint8_t)regOfInterest);
-
-    // Check for failure
-    if (this->_SensorWire->endTransmission(false) != 0)
-        return 0;
-    
-    // Read register
-    this->_SensorWire->requestFrom((uint8_t)FXAS21002C_ADDRESS, (uint8_t)1);
-    val = this->_SensorWire->read();
+    uint8_t val = 0;
 
+    this->_bus->ReadReg8(FXAS21002C_ADDRESS, regOfInterest, &val);
     return val;
 }
@@ -10,11 +10,12 @@
 // SAME ADC! See p.22 for more.
 // - Because we are using the LIS3MDL compass in the GPS, I chose to disable 
 // hybrid mode and only use the FXOS8700's accelerometer (8/26/2021).
+// - Hybrid mode is back on by default: with M_CTRL_REG2[hyb_autoinc_mode] set, 
+// one 13-byte burst from STATUS returns accel. and mag. together, giving a 
+// second magnetometer for no extra transactions. The ODR is halved.
 
 
 
-#include <Arduino.h>
-#include <Wire.h>
 #include "sensor_drivers/fxos8700_accelmag.h"
 
 
@@ -22,29 +23,67 @@
 /**
  * Constructor for the FXOS8700 Accelerometer/Magnetometer class.
  * 
- * @param wireInput I2C bus/wire interface that the device is connected to
+ * @param bus  I2C bus that the device is connected to
  */
-FXOS8700AccelMag::FXOS8700AccelMag(TwoWire *wireInput)
+FXOS8700AccelMag::FXOS8700AccelMag(I2CBus *bus)
 {
-    this->_ax = 0.0f;  // Zero out variables
-    this->_ay = 0.0f;
-    this->_az = 0.0f;
-    this->prevMeasMicros = micros();
-    this->_SensorWire = wireInput;
+    for (uint8_t i = 0; i < 3; i++)  // Zero out variables
+    {
+        this->_accel[i] = 0;
+        this->_mag[i] = 0;
+    }
+    this->_accelSens = 0.0f;
+    this->accelRange = ACCEL_RNG_4G;
+    this->_ctrlReg1 = 0x00;
+    this->prevMeasMicros = 0;
+    this->fifoOverflows = 0;
+    this->isHybrid = false;
+    this->isFIFOEnabled = false;
+    this->readFailures = 0;
+    this->_txn.status = I2C_TXN_IDLE;
+    this->_bus = bus;
 }
 
 
 /**
  * Initialize accelerometer, set accel. measurement range, configure magnetometer.
  * 
- * @param accRange  Desired accelerometer measurement range.
+ * @param accRange   Desired accelerometer measurement range.
+ * @param useHybrid  Enable the magnetometer (hybrid mode). Default true.
  * @see AccelRanges_t
+ * @return  True if successful, false if failed.
+ */
+bool FXOS8700AccelMag::Initialize(AccelRanges_t accRange, bool useHybrid)
+{
+    RegConfigStatus_t status;
+    uint32_t waitMicros;
+
+    if (!this->BeginInitialize(accRange, useHybrid))
+        return false;
+
+    while ((status = this->StepInitialize(&waitMicros)) == REG_CONFIG_BUSY)
+        delayMicroseconds(waitMicros);
+
+    return status == REG_CONFIG_DONE;
+}
+
+
+/**
+ * Start initializing the sensor without blocking: check its ID and set up 
+ * the configuration. StepInitialize() then writes it and, after the 
+ * standby-to-active time, verifies it, for re-initializing from a running 
+ * loop. Initialize() does both.
+ * 
+ * @param accRange   Desired accelerometer measurement range.
+ * @param useHybrid  Enable the magnetometer (hybrid mode).
+ * @return  True if the sensor answered, false if not or the range is unknown.
  */
-bool FXOS8700AccelMag::Initialize(AccelRanges_t accRange)
+bool FXOS8700AccelMag::BeginInitialize(AccelRanges_t accRange, bool useHybrid)
 {
     uint8_t connectedSensorID;
+    uint8_t xyzCfg;
 
-    this->_SensorWire->begin();  // Init. communication
+    this->_bus->Begin();  // Init. communication
     this->accelRange = accRange; // Set accelerometer range
     
     // Check to make sure the ID register on the sensor matches the expected FXOS8700 ID.
@@ -58,20 +97,17 @@ bool FXOS8700AccelMag::Initialize(AccelRanges_t accRange)
         return false;
     }
     
-    // Set sensor to STANDBY MODE in order to make changes to/configure a few registers.
-    this->I2Cwrite8(ACCELMAG_REG_CTRL1, 0);
-    
     // Begin configuration
     switch (this->accelRange)  // Set accel. measurement range
     {
         case (ACCEL_RNG_2G):
-            this->I2Cwrite8(ACCELMAG_REG_XYZ_CFG, 0x00);
+            xyzCfg = 0x00;
             break;
         case (ACCEL_RNG_4G):
-            this->I2Cwrite8(ACCELMAG_REG_XYZ_CFG, 0x01);
+            xyzCfg = 0x01;
             break;
         case (ACCEL_RNG_8G):
-            this->I2Cwrite8(ACCELMAG_REG_XYZ_CFG, 0x02);
+            xyzCfg = 0x02;
             break;
         default:
             #ifdef FXOS8700_DEBUG
@@ -80,108 +116,362 @@ bool FXOS8700AccelMag::Initialize(AccelRanges_t accRange)
             return false;
             break;
     }
-
-    // Configure accel.
-    this->I2Cwrite8(ACCELMAG_REG_CTRL2, 0x12);  // Self-test disabled. Reset disabled. Sleep mode OSR mode = hi. rez. Wake mode OSR mode = hi. rez.
+    this->_accelSens = AccelSensitivity(this->accelRange);  // Once, not per sample
 
     // Low-noise mode only works for +/- 2g and 4g modes. Change bit values according to the measurement range
     if (this->accelRange == ACCEL_RNG_8G)
     {
         // normal mode instead of low-noise
         // Sleep mode ODR = 50Hz. Sensor ODR = 400Hz single sensor = 200Hz hybrid mode. Full-scale range mode = normal mode. Fast read mode = normal. Active mode.
-        this->I2Cwrite8(ACCELMAG_REG_CTRL1, 0x09);
+        this->_ctrlReg1 = 0x09;
     }
     else
     {
         // Sleep mode ODR = 50Hz. Sensor ODR = 400Hz single sensor = 200Hz hybrid mode. Full-scale range mode = low-noise mode. Fast read mode = normal. Active mode.
-        this->I2Cwrite8(ACCELMAG_REG_CTRL1, 0x0D);
+        this->_ctrlReg1 = 0x0D;
+    }
+
+    // Everything is written in standby; M_CTRL_REG1/2 are only writable there.
+    // M_CTRL_REG1: Auto-calib. disabled. m_rst = 0. m_ost = 0. Hybrid mode with max. mag. oversampling, or accel. only.
+    this->isHybrid = useHybrid;
+    const RegConfig_t config[] = {
+        {ACCELMAG_REG_CTRL1, 0x00, REG_NO_VERIFY, 0},  // Stby
+        {ACCELMAG_REG_CTRL2, 0x12, REG_VERIFY_ALL, 0},  // Self-test disabled. Reset disabled. Sleep mode OSR mode = hi. rez. Wake mode OSR mode = hi. rez.
+        {ACCELMAG_REG_XYZ_CFG, xyzCfg, REG_VERIFY_ALL, 0},
+        {ACCELMAG_REG_MCTRL1, this->isHybrid ? ACCELMAG_MCTRL1_HYBRID : ACCELMAG_MCTRL1_ACCEL, REG_VERIFY_ALL, 0},
+        {ACCELMAG_REG_MCTRL2, ACCELMAG_MCTRL2_AUTOINC, REG_VERIFY_ALL, 0},  // Auto-jump to 0x33 (see p.98). Mag. min/max detection enabled.
+        {ACCELMAG_REG_F_SETUP, 0x00, REG_VERIFY_ALL, 0},  // FIFO off
+        {ACCELMAG_REG_CTRL1, this->_ctrlReg1, REG_VERIFY_ALL,
+            this->isHybrid ? ACCELMAG_TURN_ON_US_HYBRID : ACCELMAG_TURN_ON_US_ACCEL}  // Active
+    };
+    this->isFIFOEnabled = false;
+
+    return this->_initJob.Start(this->_bus, FXOS8700_ADDRESS, config, sizeof(config) / sizeof(config[0]), REG_BURST_AUTOINC);
+}
+
+
+/**
+ * Write the configuration started by BeginInitialize(), then (on the call 
+ * after the standby-to-active time) verify it.
+ * 
+ * @param waitMicros  Output, [us] time before the next call. 0 if none.
+ * @return  REG_CONFIG_BUSY until the configuration is written and verified, 
+ *          then REG_CONFIG_DONE, or REG_CONFIG_FAILED.
+ */
+RegConfigStatus_t FXOS8700AccelMag::StepInitialize(uint32_t *waitMicros)
+{
+    RegConfigStatus_t status = this->_initJob.Step(waitMicros);
+
+    #ifdef FXOS8700_DEBUG
+    if (status == REG_CONFIG_FAILED)
+        DEBUG_PRINTLN("FXOS8700ACCELMAG::Initialize ERROR: Configuration did not stick.");
+    #endif
+
+    return status;
+}
+
+
+/**
+ * Enable the accelerometer's 32-sample FIFO (circular mode). Samples are then 
+ * drained with ReadFIFO() instead of ReadSensor(). The FIFO only holds accel. 
+ * data; in hybrid mode, ReadFIFO() also reads the latest mag. sample. Call 
+ * after Initialize().
+ * 
+ * @param watermark  FIFO watermark [samples], 1 to 31.
+ * @return  True if successful, false if failed.
+ */
+bool FXOS8700AccelMag::ConfigureFIFO(uint8_t watermark)
+{
+    if (watermark == 0 || watermark >= ACCELMAG_FIFO_SIZE)
+    {
+        #ifdef FXOS8700_DEBUG
+        DEBUG_PRINTLN("FXOS8700ACCELMAG::ConfigureFIFO ERROR: FIFO watermark must be 1 to 31 samples.");
+        #endif
+        return false;
     }
 
-    // Configure magnetometer and disable hybrid mode (accel. only)
-    this->I2Cwrite8(ACCELMAG_REG_MCTRL1, 0x10);  // Auto-calib. disabled. m_rst = 0. m_ost = 0. Mag. oversampling = 0b100. Accelerometer active, mag. disabled (no hybrid mode).
-    this->I2Cwrite8(ACCELMAG_REG_MCTRL2, 0x30);  // Auto-jump to 0x33 (see p.98). Disable mag. min/max detection. (0x20 is known to work fine if this doesn't work properly).
-    delay(100);  // Slight delay after configuring. P.45 says to wait at least 1ms after issuing a reset command.
+    // F_SETUP can only be changed in standby, and the FIFO has to be 
+    // disabled before switching modes.
+    const RegConfig_t config[] = {
+        {ACCELMAG_REG_CTRL1, 0x00, REG_NO_VERIFY, 0},  // Stby
+        {ACCELMAG_REG_F_SETUP, 0x00, REG_NO_VERIFY, 0},
+        {ACCELMAG_REG_F_SETUP, (uint8_t)(ACCELMAG_F_SETUP_CIRCULAR | watermark), REG_VERIFY_ALL, 0},
+        {ACCELMAG_REG_CTRL1, this->_ctrlReg1, REG_VERIFY_ALL,
+            this->isHybrid ? ACCELMAG_TURN_ON_US_HYBRID : ACCELMAG_TURN_ON_US_ACCEL}  // Active
+    };
+
+    if (!ApplyRegConfig(this->_bus, FXOS8700_ADDRESS, config, sizeof(config) / sizeof(config[0]), REG_BURST_AUTOINC))
+    {
+        #ifdef FXOS8700_DEBUG
+        DEBUG_PRINTLN("FXOS8700ACCELMAG::ConfigureFIFO ERROR: FIFO setup did not stick.");
+        #endif
+        return false;
+    }
 
+    this->isFIFOEnabled = true;
     return true;
 }
 
 
 /**
- * Read acceleration data from the FXOS8700 sensor.
+ * Drain buffered accel. samples from the FIFO, oldest first, in bursts of up 
+ * to ACCELMAG_FIFO_SAMPLES_PER_READ (bus transfer limit). With the FIFO 
+ * enabled, burst reads roll over from OUT_Z_LSB back to OUT_X_MSB, so each 
+ * burst steps through consecutive FIFO samples. Sample times are 
+ * reconstructed from the ODR, counting back from the newest sample, less the 
+ * group delay. The latest sample is also available from GetAx(), GetAy(), and GetAz(). In 
+ * hybrid mode the mag. registers are read once afterwards.
+ * 
+ * @param samples     Buffer to write samples to [G's].
+ * @param maxSamples  Size of the buffer. Samples that don't fit stay in the 
+ *                    FIFO for the next call.
+ * @return  Number of samples read. 0 if the FIFO was empty or the read failed.
+ */
+size_t FXOS8700AccelMag::ReadFIFO(AccelSample_t *samples, size_t maxSamples)
+{
+    uint8_t buf[6 * ACCELMAG_FIFO_SAMPLES_PER_READ];
+    uint8_t fStatus;
+    size_t nAvail;
+    size_t nRead;
+    size_t nBurst;
+    size_t i;
+    uint64_t tNewest;
+    uint32_t period;
+    float sens;
+
+    if (this->isFIFOEnabled == false || samples == nullptr)
+        return 0;
+
+    tNewest = this->_SampleMicros(Micros64());
+    fStatus = this->I2Cread8(ACCELMAG_REG_STATUS);  // Mirrors F_STATUS in FIFO mode
+    if (fStatus & ACCELMAG_F_STATUS_OVF)
+        this->fifoOverflows++;
+
+    nAvail = fStatus & ACCELMAG_F_STATUS_CNT;
+    nRead = (nAvail < maxSamples) ? nAvail : maxSamples;
+    period = this->isHybrid ? ACCELMAG_PERIOD_US_HYBRID : ACCELMAG_PERIOD_US_ACCEL;
+    sens = this->_accelSens;
+
+    for (i = 0; i < nRead; i += nBurst)
+    {
+        nBurst = nRead - i;
+        if (nBurst > ACCELMAG_FIFO_SAMPLES_PER_READ)
+            nBurst = ACCELMAG_FIFO_SAMPLES_PER_READ;
+
+        if (!this->I2CreadBurst(ACCELMAG_REG_AOUT_X_MSB, buf, (uint8_t)(6 * nBurst)))
+            break;
+
+        for (size_t k = 0; k < nBurst; k++)
+        {
+            const uint8_t *s = &buf[6 * k];
+            AccelSample_t *out = &samples[i + k];
+
+            // 14-bit, left-aligned
+            this->_accel[0] = (int16_t)((int16_t)((s[0] << 8) | s[1]) >> 2);
+            this->_accel[1] = (int16_t)((int16_t)((s[2] << 8) | s[3]) >> 2);
+            this->_accel[2] = (int16_t)((int16_t)((s[4] << 8) | s[5]) >> 2);
+            out->ax = (float)this->_accel[0] * sens;
+            out->ay = (float)this->_accel[1] * sens;
+            out->az = (float)this->_accel[2] * sens;
+            out->micros = tNewest - ((uint64_t)(nAvail - 1 - (i + k)) * period);
+            this->_Publish(out->micros);
+        }
+    }
+
+    nRead = i;
+    if (nRead > 0)
+        this->prevMeasMicros = samples[nRead - 1].micros;
+
+    if (this->isHybrid && this->I2CreadBurst(ACCELMAG_REG_MOUT_X_MSB, buf, 6))
+    {
+        this->_mag[0] = (int16_t)((buf[0] << 8) | buf[1]);
+        this->_mag[1] = (int16_t)((buf[2] << 8) | buf[3]);
+        this->_mag[2] = (int16_t)((buf[4] << 8) | buf[5]);
+    }
+
+    return nRead;
+}
+
+
+/**
+ * Read acceleration and (in hybrid mode) magnetic field data from the 
+ * FXOS8700 sensor. In hybrid mode both come back in one 13-byte burst; 
+ * otherwise only STATUS and the accel. registers (7 bytes) are read.
+ * Use ReadFIFO() instead once the FIFO is enabled. The accel. sample is also 
+ * published to 'stream', as are FIFO and async samples.
  * 
  * @return  True if successful
  */
 bool FXOS8700AccelMag::ReadSensor()
 {
-    // Raw measurements
-    int16_t axRaw = 0;
-    int16_t ayRaw = 0;
-    int16_t azRaw = 0;
-    int16_t mxRaw = 0;
-    int16_t myRaw = 0;
-    int16_t mzRaw = 0;
-
-    // Read 13 bytes from sensor
-    this->_SensorWire->beginTransmission((uint8_t)FXOS8700_ADDRESS);
-    this->_SensorWire->write(ACCELMAG_REG_STATUS | 0x80);
-    this->_SensorWire->endTransmission();
-    this->_SensorWire->requestFrom((uint8_t)FXOS8700_ADDRESS, (uint8_t)13);  // status plus 6 channels = 13 bytes
-
-    // Read the registers
-    uint8_t status = this->_SensorWire->read();
-    uint8_t axhi = this->_SensorWire->read();
-    uint8_t axlo = this->_SensorWire->read();
-    uint8_t ayhi = this->_SensorWire->read();
-    uint8_t aylo = this->_SensorWire->read();
-    uint8_t azhi = this->_SensorWire->read();
-    uint8_t azlo = this->_SensorWire->read();
-    uint8_t mxhi = this->_SensorWire->read();
-    uint8_t mxlo = this->_SensorWire->read();
-    uint8_t myhi = this->_SensorWire->read();
-    uint8_t mylo = this->_SensorWire->read();
-    uint8_t mzhi = this->_SensorWire->read();
-    uint8_t mzlo = this->_SensorWire->read();
+    uint8_t buf[13];
+    uint8_t nBytes = this->isHybrid ? 13 : 7;  // status plus 3 or 6 channels
+    uint64_t tStart;
+
+    if (this->_accelSens == 0.0f)
+        return false;  // Not initialized
 
+    // Read 13 (or 7) bytes from sensor
+    tStart = Micros64();
+    if (!this->I2CreadBurst(ACCELMAG_REG_STATUS, buf, nBytes))
+        return false;
+
+    this->_Decode(buf);
+
+    this->prevMeasMicros = this->_SampleMicros(tStart);
+    this->_Publish(this->prevMeasMicros);
+
+    return true;
+}
+
+
+/**
+ * Queue a non-blocking read of STATUS and the output registers (accel. and, 
+ * in hybrid mode, mag.). When it finishes, AsyncI2C::Poll() decodes it into 
+ * the Get...() values. prevMeasMicros is the data-ready time if the pin is 
+ * wired, otherwise the time the read started on the bus, less the group 
+ * delay.
+ * 
+ * @param i2c  Async I2C engine on the sensor's bus.
+ * @return  True if queued, false if the queue is full or a read is pending.
+ */
+bool FXOS8700AccelMag::SubmitRead(AsyncI2C *i2c)
+{
+    if (i2c == nullptr)
+        return false;
+
+    return i2c->SubmitRead(&this->_txn, FXOS8700_ADDRESS, ACCELMAG_REG_STATUS, this->_txnBuf, 
+        this->isHybrid ? 13 : 7, _OnReadComplete, this);
+}
+
+
+/* Return true if an async read is queued or on the bus */
+bool FXOS8700AccelMag::IsReadPending()
+{
+    return this->_txn.status == I2C_TXN_QUEUED || this->_txn.status == I2C_TXN_BUSY;
+}
+
+
+/* Async read completion. Runs from AsyncI2C::Poll(). */
+void FXOS8700AccelMag::_OnReadComplete(I2CTransaction_t *txn)
+{
+    FXOS8700AccelMag *sensor = (FXOS8700AccelMag *)txn->context;
+
+    if (txn->status != I2C_TXN_DONE)
+    {
+        sensor->readFailures++;
+        return;
+    }
+
+    sensor->_Decode(txn->buf);
+    sensor->prevMeasMicros = sensor->_SampleMicros(txn->startMicros);
+    sensor->_Publish(sensor->prevMeasMicros);
+}
 
+
+/**
+ * Publish the latest raw accel. sample to 'stream'. If the sensor system 
+ * hasn't drained it, the sample is refused and counted in stream.Overruns().
+ * 
+ * @param micros  [us] Micros64() when the sample was taken.
+ */
+void FXOS8700AccelMag::_Publish(uint64_t micros)
+{
+    SensorSample_t sample;
+
+    sample.micros = micros;
+    sample.raw[0] = this->_accel[0];
+    sample.raw[1] = this->_accel[1];
+    sample.raw[2] = this->_accel[2];
+    this->stream.Push(sample);
+}
+
+
+// ----------------------------------------------------------------------------
+// _SampleMicros(uint64_t startMicros)
+// ----------------------------------------------------------------------------
+/**
+ * Timestamp for the sample being read: the data-ready time if the pin is 
+ * wired, otherwise the start of the read, less the group delay.
+ * 
+ * @param startMicros  [us] Micros64() when the read started.
+ * @return  [us] Micros64() when the sample was taken.
+ */
+uint64_t FXOS8700AccelMag::_SampleMicros(uint64_t startMicros)
+{
+    uint32_t groupDelay = this->isHybrid ? ACCELMAG_GROUP_DELAY_US_HYBRID : ACCELMAG_GROUP_DELAY_US_ACCEL;
+    uint64_t t;
+
+    if (!this->drdy.Pop(&t))
+        t = startMicros;
+    return (t > groupDelay) ? t - groupDelay : 0;
+}
+
+
+/**
+ * Unpack a STATUS + output register burst into raw counts. The Get...() 
+ * functions scale them to [G's] and [uT].
+ * 
+ * @param raw  STATUS, 6 accel. bytes, then (hybrid mode) 6 mag. bytes.
+ */
+void FXOS8700AccelMag::_Decode(const uint8_t *raw)
+{
     /**
      * Read and shift values from registers into integers.
      * Accelerometer data is 14-bit and left-aligned. Shift two bits right.
      * See p.28 for datasheet's code example.
      */
-    axRaw = (int16_t)((axhi << 8) | axlo) >> 2;
-    ayRaw = (int16_t)((ayhi << 8) | aylo) >> 2;
-    azRaw = (int16_t)((azhi << 8) | azlo) >> 2;
+    this->_accel[0] = (int16_t)((int16_t)((raw[1] << 8) | raw[2]) >> 2);
+    this->_accel[1] = (int16_t)((int16_t)((raw[3] << 8) | raw[4]) >> 2);
+    this->_accel[2] = (int16_t)((int16_t)((raw[5] << 8) | raw[6]) >> 2);
 
-    // mxRaw = (int16_t)((mxhi << 8) | mxlo);
-    // myRaw = (int16_t)((myhi << 8) | mylo);
-    // mzRaw = (int16_t)((mzhi << 8) | mzlo);
+    // Mag. data is 16-bit. Hybrid auto-increment jumps from 0x06 to 0x33.
+    if (this->isHybrid)
+    {
+        this->_mag[0] = (int16_t)((raw[7] << 8) | raw[8]);
+        this->_mag[1] = (int16_t)((raw[9] << 8) | raw[10]);
+        this->_mag[2] = (int16_t)((raw[11] << 8) | raw[12]);
+    }
+}
 
-    this->prevMeasMicros = micros();
 
-    // Convert acceleration from int16_t to float in units of [g's]
-    switch (this->accelRange)
+/**
+ * Route the data-ready interrupt to INT1 and attach it to a Teensy pin. 
+ * ReadSensor() then timestamps samples with the interrupt time. In hybrid 
+ * mode it fires once per accel. + mag. sample. Call after Initialize().
+ * 
+ * @param pin  Teensy pin wired to the sensor's INT1. DRDY_PIN_NONE to poll.
+ * @return  True if attached, false if polling.
+ */
+bool FXOS8700AccelMag::AttachDataReady(int8_t pin)
+{
+    if (pin < 0)
     {
-        case (ACCEL_RNG_2G):
-            this->_ax = (float)axRaw * ACCELMAG_CVT_GS_2G;
-            this->_ay = (float)ayRaw * ACCELMAG_CVT_GS_2G;
-            this->_az = (float)azRaw * ACCELMAG_CVT_GS_2G;
-            break;
-        case (ACCEL_RNG_4G):
-            this->_ax = (float)axRaw * ACCELMAG_CVT_GS_4G;
-            this->_ay = (float)ayRaw * ACCELMAG_CVT_GS_4G;
-            this->_az = (float)azRaw * ACCELMAG_CVT_GS_4G;
-            break;
-        case (ACCEL_RNG_8G):
-            this->_ax = (float)axRaw * ACCELMAG_CVT_GS_8G;
-            this->_ay = (float)ayRaw * ACCELMAG_CVT_GS_8G;
-            this->_az = (float)azRaw * ACCELMAG_CVT_GS_8G;
-            break;
-        default:
-            return false;  // return false if not recognized
-            break;
+        this->drdy.Detach();
+        return false;
     }
 
-    return true;
+    // Interrupt registers can only be changed in standby. CTRL_REG3-5 go in one burst.
+    const RegConfig_t config[] = {
+        {ACCELMAG_REG_CTRL1, 0x00, REG_NO_VERIFY, 0},  // Stby
+        {ACCELMAG_REG_CTRL3, ACCELMAG_CTRL3_ACTIVE_HI, REG_NO_VERIFY, 0},
+        {ACCELMAG_REG_CTRL4, ACCELMAG_CTRL4_DRDY, REG_NO_VERIFY, 0},
+        {ACCELMAG_REG_CTRL5, ACCELMAG_CTRL5_DRDY_INT1, REG_NO_VERIFY, 0},
+        {ACCELMAG_REG_CTRL1, this->_ctrlReg1, REG_NO_VERIFY, 0}  // Active
+    };
+    WriteRegConfig(this->_bus, FXOS8700_ADDRESS, config, sizeof(config) / sizeof(config[0]), REG_BURST_AUTOINC);
+
+    return this->drdy.Attach(pin, true);
+}
+
+
+/**
+ * Return true if a new sample is ready to read. Always true without a 
+ * data-ready pin (polled).
+ */
+bool FXOS8700AccelMag::DataReady()
+{
+    return !this->drdy.IsAttached() || this->drdy.Available();
 }
 
 
@@ -190,7 +480,7 @@ bool FXOS8700AccelMag::ReadSensor()
  */
 float FXOS8700AccelMag::GetAx()
 {
-    return this->_ax;
+    return (float)this->_accel[0] * this->_accelSens;
 }
 
 
@@ -199,7 +489,7 @@ float FXOS8700AccelMag::GetAx()
  */
 float FXOS8700AccelMag::GetAy()
 {
-    return this->_ay;
+    return (float)this->_accel[1] * this->_accelSens;
 }
 
 
@@ -207,7 +497,63 @@ float FXOS8700AccelMag::GetAy()
  */
 float FXOS8700AccelMag::GetAz()
 {
-    return this->_az;
+    return (float)this->_accel[2] * this->_accelSens;
+}
+
+
+/**
+ * Return x-magnetometer measurement in [uT]. Zero unless in hybrid mode.
+ */
+float FXOS8700AccelMag::GetMx()
+{
+    return (float)this->_mag[0] * ACCELMAG_CVT_UT;
+}
+
+
+/**
+ * Return y-magnetometer measurement in [uT]. Zero unless in hybrid mode.
+ */
+float FXOS8700AccelMag::GetMy()
+{
+    return (float)this->_mag[1] * ACCELMAG_CVT_UT;
+}
+
+
+/**
+ * Return z-magnetometer measurement in [uT]. Zero unless in hybrid mode.
+ */
+float FXOS8700AccelMag::GetMz()
+{
+    return (float)this->_mag[2] * ACCELMAG_CVT_UT;
+}
+
+
+/**
+ * Copy the latest acceleration in raw 14-bit counts [LSB], for a fused 
+ * conversion (see counts_to_si.h). Multiply by AccelSensitivity(range) for 
+ * [G's].
+ * 
+ * @param raw  [ax, ay, az] Output counts.
+ */
+void FXOS8700AccelMag::GetRawAccel(int16_t raw[3])
+{
+    raw[0] = this->_accel[0];
+    raw[1] = this->_accel[1];
+    raw[2] = this->_accel[2];
+}
+
+
+/**
+ * Copy the latest magnetic field in raw counts [LSB]. Multiply by 
+ * ACCELMAG_CVT_UT for [uT]. Zero unless in hybrid mode.
+ * 
+ * @param raw  [mx, my, mz] Output counts.
+ */
+void FXOS8700AccelMag::GetRawMag(int16_t raw[3])
+{
+    raw[0] = this->_mag[0];
+    raw[1] = this->_mag[1];
+    raw[2] = this->_mag[2];
 }
 
 
@@ -219,11 +565,7 @@ float FXOS8700AccelMag::GetAz()
  */
 void FXOS8700AccelMag::I2Cwrite8(uint8_t regOfInterest, uint8_t valToWrite)
 {
-    // Init. communication
-    this->_SensorWire->beginTransmission(FXOS8700_ADDRESS);
-    this->_SensorWire->write((uint8_t)regOfInterest);
-    this->_SensorWire->write((uint8_t)valToWrite);
-    this->_SensorWire->endTransmission();
+    this->_bus->WriteReg8(FXOS8700_ADDRESS, regOfInterest, valToWrite);
 }
 
 
@@ -231,22 +573,26 @@ void FXOS8700AccelMag::I2Cwrite8(uint8_t regOfInterest, uint8_t valToWrite)
  * Read FXOS8700 register value over I2C.
  * 
  * @param regOfInterest Register address on device.
- * @return Value/data in register.
+ * @return Value/data in register. 0 if the read failed.
  */
 uint8_t FXOS8700AccelMag::I2Cread8(uint8_t regOfInterest)
 {
-    uint8_t val;
+    uint8_t val = 0;
 
-    // Init. communication
-    this->_SensorWire->beginTransmission((uint8_t)FXOS8700_ADDRESS);
-    this->_SensorWire->write((uint8_t)regOfInterest);
+    this->_bus->ReadReg8(FXOS8700_ADDRESS, regOfInterest, &val);
+    return val;
+}
 
-    // Check for failure
-    if (this->_SensorWire->endTransmission(false) != 0) return 0;
-    
-    // Read register
-    this->_SensorWire->requestFrom((uint8_t)FXOS8700_ADDRESS, (uint8_t)1);
-    val = this->_SensorWire->read();
 
-    return val;
+/**
+ * Burst-read consecutive FXOS8700 registers over I2C in one transaction.
+ * 
+ * @param startReg  First register address.
+ * @param buf       Buffer to read into.
+ * @param len       Number of bytes to read, up to I2C_BUS_MAX_TRANSFER.
+ * @return  True if all bytes were read.
+ */
+bool FXOS8700AccelMag::I2CreadBurst(uint8_t startReg, uint8_t *buf, uint8_t len)
+{
+    return this->_bus->ReadRegs(FXOS8700_ADDRESS, startReg, buf, len);
 }
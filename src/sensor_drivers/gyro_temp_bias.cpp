@@ -0,0 +1,257 @@
+// ----------------------------------------------------------------------------
+// GYRO TEMPERATURE BIAS TABLE
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Temperature-binned gyro bias, learned online and kept in non-volatile
+ * storage. See gyro_temp_bias.h.
+ */
+
+
+#include <string.h>
+#include <math.h>
+#include "sensor_drivers/gyro_temp_bias.h"
+#include "maths/math_functs.h"
+
+
+/**
+ * Table as stored: layout, bins, then an FNV-1a checksum of everything
+ * before it.
+ */
+typedef struct
+{
+    uint32_t magic;  // GYRO_TBIAS_NV_MAGIC
+    uint8_t nBins;  // GYRO_TBIAS_BINS
+    uint8_t reserved[3];
+    float tMin;  // [C] GYRO_TBIAS_T_MIN
+    float tStep;  // [C] GYRO_TBIAS_T_STEP
+    GyroTempBiasBin_t bins[GYRO_TBIAS_BINS];
+    uint32_t checksum;
+} GyroTempBiasRecord_t;
+
+
+/* FNV-1a hash of 'len' bytes */
+static uint32_t GyroTempBiasChecksum(const uint8_t *bytes, size_t len)
+{
+    uint32_t hash = 2166136261UL;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
+
+
+GyroTempBias::GyroTempBias()
+{
+    this->Clear();
+}
+
+
+/* Forget everything */
+void GyroTempBias::Clear()
+{
+    memset(this->bins, 0, sizeof(this->bins));
+    this->learnedSinceSave = 0;
+}
+
+
+// ----------------------------------------------------------------------------
+// Learn(float tempC, const float meas[3], float weight)
+// ----------------------------------------------------------------------------
+/**
+ * Average a stationary gyro measurement into the two bins around its
+ * temperature, split by distance. Only call when the vehicle is still.
+ *
+ * @param tempC   [C] Gyro die temperature.
+ * @param meas    [rad/s] Gyro measurement, without bias compensation.
+ * @param weight  [samples] Weight of the measurement, e.g. the sample count
+ *                if 'meas' is an average.
+ */
+void GyroTempBias::Learn(float tempC, const float meas[3], float weight)
+{
+    float pos = _Position(tempC);
+    uint8_t lo = (uint8_t)pos;
+    float frac = pos - (float)lo;
+
+    if (weight <= 0.0f)
+        return;
+
+    this->_LearnBin(lo, meas, weight * (1.0f - frac));
+    if (lo + 1 < GYRO_TBIAS_BINS)
+        this->_LearnBin(lo + 1, meas, weight * frac);
+
+    this->learnedSinceSave++;
+}
+
+
+// ----------------------------------------------------------------------------
+// GetBias(float tempC, float bias[3])
+// ----------------------------------------------------------------------------
+/**
+ * Bias at a temperature, interpolated between the nearest learned bins on
+ * either side. Past the learned range, the closest learned bin.
+ *
+ * @param tempC  [C] Gyro die temperature.
+ * @param bias   [rad/s] Output, bias [x, y, z]. Zeros if nothing is learned.
+ * @return  True if any bin is learned, false if 'bias' is just zeros.
+ */
+bool GyroTempBias::GetBias(float tempC, float bias[3]) const
+{
+    float pos = _Position(tempC);
+    int8_t lo = -1;
+    int8_t hi = -1;
+    float frac;
+
+    // Nearest learned bins at or below and at or above the temperature
+    for (int8_t i = (int8_t)floorf(pos); i >= 0; i--)
+    {
+        if (this->bins[i].weight >= GYRO_TBIAS_MIN_WEIGHT)
+        {
+            lo = i;
+            break;
+        }
+    }
+    for (int8_t i = (int8_t)ceilf(pos); i < GYRO_TBIAS_BINS; i++)
+    {
+        if (this->bins[i].weight >= GYRO_TBIAS_MIN_WEIGHT)
+        {
+            hi = i;
+            break;
+        }
+    }
+
+    if (lo < 0 && hi < 0)
+    {
+        bias[0] = bias[1] = bias[2] = 0.0f;
+        return false;
+    }
+    if (lo < 0)
+        lo = hi;
+    if (hi < 0)
+        hi = lo;
+
+    frac = (hi == lo) ? 0.0f : (pos - (float)lo) / (float)(hi - lo);
+    for (uint8_t k = 0; k < 3; k++)
+        bias[k] = this->bins[lo].bias[k] + frac * (this->bins[hi].bias[k] - this->bins[lo].bias[k]);
+
+    return true;
+}
+
+
+/**
+ * How much data the bias at a temperature rests on: the weights of the two
+ * bins around it, interpolated.
+ *
+ * @param tempC  [C] Gyro die temperature.
+ * @return  [samples] Interpolated bin weight. 0 if unlearned.
+ */
+float GyroTempBias::Confidence(float tempC) const
+{
+    float pos = _Position(tempC);
+    uint8_t lo = (uint8_t)pos;
+    float frac = pos - (float)lo;
+
+    if (lo + 1 >= GYRO_TBIAS_BINS)
+        return this->bins[lo].weight;
+    return ((1.0f - frac) * this->bins[lo].weight) + (frac * this->bins[lo + 1].weight);
+}
+
+
+// ----------------------------------------------------------------------------
+// Save(NVStorage *nv, uint16_t address)
+// ----------------------------------------------------------------------------
+/**
+ * Store the table. Unchanged bytes aren't rewritten, but every learned
+ * sample changes the bins, so don't call this more than every few minutes.
+ *
+ * @param nv       Storage, e.g. PlatformNVStorage().
+ * @param address  Byte address, e.g. NV_ADDR_GYRO_TEMP_BIAS.
+ * @return  True if written.
+ */
+bool GyroTempBias::Save(NVStorage *nv, uint16_t address)
+{
+    GyroTempBiasRecord_t rec;
+
+    if (nv == nullptr)
+        return false;
+
+    memset(&rec, 0, sizeof(rec));
+    rec.magic = GYRO_TBIAS_NV_MAGIC;
+    rec.nBins = GYRO_TBIAS_BINS;
+    rec.tMin = GYRO_TBIAS_T_MIN;
+    rec.tStep = GYRO_TBIAS_T_STEP;
+    memcpy(rec.bins, this->bins, sizeof(rec.bins));
+    rec.checksum = GyroTempBiasChecksum((const uint8_t *)&rec, offsetof(GyroTempBiasRecord_t, checksum));
+
+    if (!nv->Write(address, &rec, sizeof(rec)))
+        return false;
+
+    this->learnedSinceSave = 0;
+    return true;
+}
+
+
+/**
+ * Load a table stored by Save(). The table is left unchanged if the storage
+ * is blank, corrupt, or from a different bin layout.
+ *
+ * @param nv       Storage, e.g. PlatformNVStorage().
+ * @param address  Byte address, e.g. NV_ADDR_GYRO_TEMP_BIAS.
+ * @return  True if a valid table was loaded.
+ */
+bool GyroTempBias::Load(NVStorage *nv, uint16_t address)
+{
+    GyroTempBiasRecord_t rec;
+
+    if (nv == nullptr || !nv->Read(address, &rec, sizeof(rec)))
+        return false;
+
+    if (rec.magic != GYRO_TBIAS_NV_MAGIC || rec.nBins != GYRO_TBIAS_BINS ||
+        rec.tMin != GYRO_TBIAS_T_MIN || rec.tStep != GYRO_TBIAS_T_STEP)
+        return false;
+    if (rec.checksum != GyroTempBiasChecksum((const uint8_t *)&rec, offsetof(GyroTempBiasRecord_t, checksum)))
+        return false;
+
+    memcpy(this->bins, rec.bins, sizeof(this->bins));
+    this->learnedSinceSave = 0;
+    return true;
+}
+
+
+/* [C] Temperature of a bin */
+float GyroTempBias::BinTemperature(uint8_t bin)
+{
+    return GYRO_TBIAS_T_MIN + ((float)bin * GYRO_TBIAS_T_STEP);
+}
+
+
+/* Fractional bin index of a temperature, clamped to the table */
+float GyroTempBias::_Position(float tempC)
+{
+    return RangeConstrain((tempC - GYRO_TBIAS_T_MIN) / GYRO_TBIAS_T_STEP, 0.0f, (float)(GYRO_TBIAS_BINS - 1));
+}
+
+
+/* Running weighted mean of one bin, weight capped at GYRO_TBIAS_MAX_WEIGHT */
+void GyroTempBias::_LearnBin(uint8_t bin, const float meas[3], float weight)
+{
+    GyroTempBiasBin_t *b = &this->bins[bin];
+    float alpha;
+
+    if (weight <= 0.0f)
+        return;
+
+    b->weight += weight;
+    alpha = weight / b->weight;
+    for (uint8_t k = 0; k < 3; k++)
+        b->bias[k] += alpha * (meas[k] - b->bias[k]);
+
+    if (b->weight > GYRO_TBIAS_MAX_WEIGHT)
+        b->weight = GYRO_TBIAS_MAX_WEIGHT;
+}
@@ -9,35 +9,50 @@
 // LIS3MDL Datasheet: https://www.st.com/resource/en/datasheet/lis3mdl.pdf
 
 
+#include <math.h>
 #include "sensor_drivers/lis3mdl_magnetometer.h"
+#include "maths/math_functs.h"
 
 
 /**
  * I2C Sensor class for the LIS3MDL magnetometer.
  * 
- * @param userWire I2C bus that the sensor is attached to.
+ * @param bus  I2C bus that the sensor is attached to.
  */
-LIS3MDL_Mag::LIS3MDL_Mag(TwoWire *userWire)
+LIS3MDL_Mag::LIS3MDL_Mag(I2CBus *bus)
 {
-    this->_SensorWire = userWire;
-    this->_mx = 0.0f;
-    this->_my = 0.0f;
-    this->_mz = 0.0f;
-    this->prevMeasMicros = micros();
+    this->_bus = bus;
+    this->_raw[0] = 0;
+    this->_raw[1] = 0;
+    this->_raw[2] = 0;
+    this->_tempRaw = 0;
+    this->_sens = 0.0f;
+    this->_range = LIS3MDL_RANGE_4G;
+    this->_tcTable = nullptr;
+    this->_tcLen = 0;
+    this->_tcStale = true;
+    this->prevMeasMicros = 0;
+    this->groupDelayMicros = LIS3MDLGroupDelayMicros(LIS3MDL_ODR_155HZ);
+    this->readFailures = 0;
+    this->_txn.status = I2C_TXN_IDLE;
 }
 
 
 /**
- * Initialize the LIS3MDL magnetometer and specify the measurement range.
+ * Initialize the LIS3MDL magnetometer and specify the measurement range and 
+ * fast ODR. The temperature sensor is always on, so every read gets it.
  * 
  * @param measRange Magnetometer measurement range.
+ * @param odr       Output data rate, up to 1kHz.
  * @see LIS3MDL_MeasRange_t
+ * @see LIS3MDL_ODR_t
  */
-bool LIS3MDL_Mag::Initialize(LIS3MDL_MeasRange_t measRange)
+bool LIS3MDL_Mag::Initialize(LIS3MDL_MeasRange_t measRange, LIS3MDL_ODR_t odr)
 {
     uint8_t connSensorID;  // Check that the connected sensor ID matches the expected one
+    uint8_t opMode;  // OM/OMZ operating mode for the ODR
 
-    this->_SensorWire->begin();
+    this->_bus->Begin();
 
     if (measRange > LIS3MDL_RANGE_16G)
     {
@@ -59,11 +74,32 @@ bool LIS3MDL_Mag::Initialize(LIS3MDL_MeasRange_t measRange)
         return false;
     }
 
+    // With fast ODR on, the operating mode sets the ODR
+    switch (odr)
+    {
+        case LIS3MDL_ODR_155HZ:
+            opMode = 0x03;  // Ultra-high performance
+            break;
+        case LIS3MDL_ODR_300HZ:
+            opMode = 0x02;  // High performance
+            break;
+        case LIS3MDL_ODR_560HZ:
+            opMode = 0x01;  // Medium performance
+            break;
+        case LIS3MDL_ODR_1000HZ:
+            opMode = 0x00;  // Low power
+            break;
+        default:
+            #ifdef LIS3MDL_DEBUG
+            DEBUG_PRINTLN("LIS3MDL::Initialize ERROR: Unknown ODR specified.");
+            #endif
+            return false;
+            break;
+    }
+
     // Set Control Register 1 params
-    // uint8_t ctrlReg1Config = 0b01100010;
-    // Enable temp. sensor. XY operative mode = ultra-high performance. ODR = 0b100 (10Hz). Enable fast ODR. Disable self-test.
-    // With fast-ODR mode enabled and ultra-high performance mode selected, this yields a final ODR of 155Hz.
-    uint8_t ctrlReg1Config = 0xF2;  // 0b11110010
+    // Enable temp. sensor. XY operative mode from the ODR. ODR = 0b100 (unused with fast ODR). Enable fast ODR. Disable self-test.
+    uint8_t ctrlReg1Config = (uint8_t)(0x80 | (opMode << 5) | 0x12);  // 0b1xx10010
 
 
     // Set Control Register 2 params
@@ -91,104 +127,279 @@ bool LIS3MDL_Mag::Initialize(LIS3MDL_MeasRange_t measRange)
             return false;
             break;
     }
+    this->_sens = LIS3MDLSensitivity(this->_range);  // Once, not per sample
 
     // Set Control Register 3 params
     // Low-power disable. 4-wire SPI interface. Continuous conversion mode.
     uint8_t ctrlReg3Config = 0x00;  // 0b00000000
 
     // Set Control Register 4 params
-    // Ultra-high performance mode for Z-axis. LSb at lower address.
-    uint8_t ctrlReg4Config = 0x0C;  // 0b00001100
+    // Z-axis operative mode same as XY. LSb at lower address.
+    uint8_t ctrlReg4Config = (uint8_t)(opMode << 2);  // 0b0000xx00
 
     /* Set Control Register 5 params */
     // Disable fast-read. Continuous update.
     uint8_t ctrlReg5Config = 0x00;  // 0b00000000
 
 
-    // Send config commands
-    this->I2Cwrite8(LIS3MDL_CTRL_REG1, ctrlReg1Config);
-    this->I2Cwrite8(LIS3MDL_CTRL_REG2, ctrlReg2Config);
-    this->I2Cwrite8(LIS3MDL_CTRL_REG3, ctrlReg3Config);
-    this->I2Cwrite8(LIS3MDL_CTRL_REG4, ctrlReg4Config);
-    this->I2Cwrite8(LIS3MDL_CTRL_REG5, ctrlReg5Config);
+    // Send config commands, one burst write and one burst read-back
+    const RegConfig_t config[] = {
+        {LIS3MDL_CTRL_REG1, ctrlReg1Config, REG_VERIFY_ALL, 0},
+        {LIS3MDL_CTRL_REG2, ctrlReg2Config, REG_VERIFY_ALL, 0},
+        {LIS3MDL_CTRL_REG3, ctrlReg3Config, REG_VERIFY_ALL, 0},
+        {LIS3MDL_CTRL_REG4, ctrlReg4Config, REG_VERIFY_ALL, 0},
+        {LIS3MDL_CTRL_REG5, ctrlReg5Config, REG_VERIFY_ALL, 0}
+    };
+
+    if (!ApplyRegConfig(this->_bus, LIS3MDL_ADDR, config, sizeof(config) / sizeof(config[0]), REG_BURST_AUTOINC_MSB))
+    {
+        #ifdef LIS3MDL_DEBUG
+        DEBUG_PRINTLN("LIS3MDL::Initialize ERROR: Configuration did not stick.");
+        #endif
+        return false;
+    }
+
+    this->groupDelayMicros = LIS3MDLGroupDelayMicros((uint32_t)odr);
+    this->_tcStale = true;  // Offsets are kept in counts of the range
 
     return true;
 }
 
 
+// ----------------------------------------------------------------------------
+// SetTempCompensation(const LIS3MDLTempComp_t *table, uint8_t n)
+// ----------------------------------------------------------------------------
 /**
- * Read magnetometer registers and extract measurements.
- * Converts raw readings in Gauss [G] to microtesla [uT].
+ * Compensate readings for temperature with a table of offsets and scales, 
+ * e.g. from a thermal calibration run. The temperature comes in the same 
+ * burst as the field, so this costs no bus time, and the table is only 
+ * interpolated when the temperature reading changes.
  * 
- * @returns true if successful, false if invalid measurement range.
+ * @param table  Entries sorted by rising temperature. Must outlive the 
+ *               driver (e.g. a constexpr table). nullptr to turn it off.
+ * @param n      Number of entries.
+ * @return  True if set, false if the table is empty or unsorted.
  */
-bool LIS3MDL_Mag::ReadSensor()
+bool LIS3MDL_Mag::SetTempCompensation(const LIS3MDLTempComp_t *table, uint8_t n)
 {
-    uint8_t xlo, xhi;
-    uint8_t ylo, yhi;
-    uint8_t zlo, zhi;
-    int16_t mxRaw, myRaw, mzRaw;
-
-    // Read the 6 data bytes from sensor
-    this->_SensorWire->beginTransmission((uint8_t)LIS3MDL_ADDR);
-    this->_SensorWire->write(LIS3MDL_OUT_X_L | 0x80);
-    this->_SensorWire->endTransmission();
-
-    // Request 6 register values
-    this->_SensorWire->requestFrom((uint8_t)LIS3MDL_ADDR, (uint8_t)6);
-
-    xlo = this->_SensorWire->read();
-    xhi = this->_SensorWire->read();
-    ylo = this->_SensorWire->read();
-    yhi = this->_SensorWire->read();
-    zlo = this->_SensorWire->read();
-    zhi = this->_SensorWire->read();
-
-    // Bitwise operators to convert to actual readings
-    mxRaw = (int16_t)((xhi << 8) | xlo);
-    myRaw = (int16_t)((yhi << 8) | ylo);
-    mzRaw = (int16_t)((zhi << 8) | zlo);
-
-    // Convert to float and units of micro tesla [uT]. Raw meas. are in Gauss.
-    // LSB/gauss values are from LIS3MDL datasheet.
-    // 1G = 100uT
-    switch(this->_range)
+    if (table == nullptr)
     {
-        case LIS3MDL_RANGE_4G:
-            this->_mx = (float)mxRaw * 0.01461560947091493715287927506577f;  // 100/6842
-            this->_my = (float)myRaw * 0.01461560947091493715287927506577f;
-            this->_mz = (float)mzRaw * 0.01461560947091493715287927506577f;
-            break;
-        case LIS3MDL_RANGE_8G:
-            this->_mx = (float)mxRaw * 0.02923121894182987430575855013154f;  // 100/3421
-            this->_my = (float)myRaw * 0.02923121894182987430575855013154f;
-            this->_mz = (float)mzRaw * 0.02923121894182987430575855013154f;
-            break;
-        case LIS3MDL_RANGE_12G:
-            this->_mx = (float)mxRaw * 0.04384042086804033318719859710653f;  // 100/2281
-            this->_my = (float)myRaw * 0.04384042086804033318719859710653f;
-            this->_mz = (float)mzRaw * 0.04384042086804033318719859710653f;
-            break;
-        case LIS3MDL_RANGE_16G:
-            this->_mx = (float)mxRaw * 0.05844535359438924605493863237873f;  // 100/1711
-            this->_my = (float)myRaw * 0.05844535359438924605493863237873f;
-            this->_mz = (float)mzRaw * 0.05844535359438924605493863237873f;
-            break;
-        default:
+        this->_tcTable = nullptr;
+        this->_tcLen = 0;
+        return true;
+    }
+
+    if (n == 0)
+        return false;
+    for (uint8_t i = 1; i < n; i++)
+    {
+        if (table[i].tempC <= table[i - 1].tempC)
+        {
+            #ifdef LIS3MDL_DEBUG
+            DEBUG_PRINTLN("LIS3MDL::SetTempCompensation ERROR: Table must be sorted by temperature.");
+            #endif
             return false;
-            break;
+        }
     }
 
+    this->_tcTable = table;
+    this->_tcLen = n;
+    this->_tcStale = true;
+    return true;
+}
+
+
+/**
+ * Read the magnetometer and temperature registers in one burst and keep the 
+ * raw counts, temperature compensated if a table is set. GetMx() etc. scale 
+ * them to microtesla [uT] with the sensitivity set in Initialize().
+ * 
+ * @returns true if successful, false if not initialized or the read failed.
+ */
+bool LIS3MDL_Mag::ReadSensor()
+{
+    uint8_t buf[8];
+    uint64_t tStart;
+
+    if (this->_sens == 0.0f)
+        return false;  // Not initialized
+
+    // Read the 6 mag. and 2 temperature bytes from sensor. Bit 7 of the 
+    // register address turns on auto-increment.
+    tStart = Micros64();
+    if (!this->_bus->ReadRegs(LIS3MDL_ADDR, LIS3MDL_OUT_X_L | 0x80, buf, 8))
+        return false;
+
+    this->_Decode(buf);
+
+    this->prevMeasMicros = this->_SampleMicros(tStart);
+
     return true;
 }
 
 
+/**
+ * Queue a non-blocking read of the output registers. When it finishes, 
+ * AsyncI2C::Poll() decodes it into GetMx(), GetMy(), and GetMz(). 
+ * prevMeasMicros is the data-ready time if the pin is wired, otherwise the 
+ * time the read started on the bus, less the group delay.
+ * 
+ * @param i2c  Async I2C engine on the sensor's bus.
+ * @return  True if queued, false if the queue is full or a read is pending.
+ */
+bool LIS3MDL_Mag::SubmitRead(AsyncI2C *i2c)
+{
+    if (i2c == nullptr)
+        return false;
+
+    return i2c->SubmitRead(&this->_txn, LIS3MDL_ADDR, LIS3MDL_OUT_X_L | 0x80, this->_txnBuf, 
+        sizeof(this->_txnBuf), _OnReadComplete, this);
+}
+
+
+/* Return true if an async read is queued or on the bus */
+bool LIS3MDL_Mag::IsReadPending()
+{
+    return this->_txn.status == I2C_TXN_QUEUED || this->_txn.status == I2C_TXN_BUSY;
+}
+
+
+/* Async read completion. Runs from AsyncI2C::Poll(). */
+void LIS3MDL_Mag::_OnReadComplete(I2CTransaction_t *txn)
+{
+    LIS3MDL_Mag *mag = (LIS3MDL_Mag *)txn->context;
+
+    if (txn->status != I2C_TXN_DONE)
+    {
+        mag->readFailures++;
+        return;
+    }
+
+    mag->_Decode(txn->buf);
+
+    mag->prevMeasMicros = mag->_SampleMicros(txn->startMicros);
+}
+
+
+// ----------------------------------------------------------------------------
+// _SampleMicros(uint64_t startMicros)
+// ----------------------------------------------------------------------------
+/**
+ * Timestamp for the sample being read: the data-ready time if the pin is 
+ * wired, otherwise the start of the read, less the group delay.
+ * 
+ * @param startMicros  [us] Micros64() when the read started.
+ * @return  [us] Micros64() when the sample was taken.
+ */
+uint64_t LIS3MDL_Mag::_SampleMicros(uint64_t startMicros)
+{
+    uint64_t t;
+
+    if (!this->drdy.Pop(&t))
+        t = startMicros;
+    return (t > this->groupDelayMicros) ? t - this->groupDelayMicros : 0;
+}
+
+
+// ----------------------------------------------------------------------------
+// _Decode(const uint8_t *buf)
+// ----------------------------------------------------------------------------
+/**
+ * Decode a mag. + temperature burst (LSB first) and apply the temperature 
+ * compensation.
+ * 
+ * @param buf  OUT_X_L to TEMP_OUT_H, 8 bytes.
+ */
+void LIS3MDL_Mag::_Decode(const uint8_t *buf)
+{
+    int16_t tempRaw = (int16_t)((buf[7] << 8) | buf[6]);
+
+    if (tempRaw != this->_tempRaw || this->_tcStale)
+    {
+        this->_tempRaw = tempRaw;
+        this->_UpdateTempComp();
+    }
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        int16_t counts = (int16_t)((buf[2 * i + 1] << 8) | buf[2 * i]);
+        float comp;
+
+        if (this->_tcTable == nullptr)
+        {
+            this->_raw[i] = counts;
+            continue;
+        }
+
+        comp = roundf(((float)counts - this->_tcOffset[i]) * this->_tcScale[i]);
+        this->_raw[i] = (comp > 32767.0f) ? 32767 : (comp < -32768.0f) ? -32768 : (int16_t)comp;
+    }
+}
+
+
+/* Interpolate the compensation table at the current temperature */
+void LIS3MDL_Mag::_UpdateTempComp()
+{
+    const LIS3MDLTempComp_t *lo;
+    const LIS3MDLTempComp_t *hi;
+    float tempC = this->GetTemperature();
+    float frac = 0.0f;
+    uint8_t i;
+
+    if (this->_tcTable == nullptr || this->_sens == 0.0f)
+        return;
+
+    // Segment around the temperature; the end entries hold outside the table
+    for (i = 1; i < this->_tcLen - 1 && tempC > this->_tcTable[i].tempC; i++) {}
+    lo = &this->_tcTable[(this->_tcLen > 1) ? i - 1 : 0];
+    hi = &this->_tcTable[(this->_tcLen > 1) ? i : 0];
+    if (hi->tempC > lo->tempC)
+        frac = RangeConstrain((tempC - lo->tempC) / (hi->tempC - lo->tempC), 0.0f, 1.0f);
+
+    for (uint8_t k = 0; k < 3; k++)
+    {
+        this->_tcOffset[k] = (lo->offset[k] + frac * (hi->offset[k] - lo->offset[k])) / this->_sens;
+        this->_tcScale[k] = lo->scale[k] + frac * (hi->scale[k] - lo->scale[k]);
+    }
+    this->_tcStale = false;
+}
+
+
+/**
+ * Attach the DRDY pin's interrupt. The LIS3MDL's DRDY output is always 
+ * enabled (active high), so no registers need to change.
+ * 
+ * @param pin  Teensy pin wired to the sensor's DRDY. DRDY_PIN_NONE to poll.
+ * @return  True if attached, false if polling.
+ */
+bool LIS3MDL_Mag::AttachDataReady(int8_t pin)
+{
+    if (pin < 0)
+    {
+        this->drdy.Detach();
+        return false;
+    }
+
+    return this->drdy.Attach(pin, true);
+}
+
+
+/**
+ * Return true if a new sample is ready to read. Always true without a 
+ * data-ready pin (polled).
+ */
+bool LIS3MDL_Mag::DataReady()
+{
+    return !this->drdy.IsAttached() || this->drdy.Available();
+}
+
+
 /**
  * Return X-magnetometer reading in [uT]
  */
 float LIS3MDL_Mag::GetMx()
 {
-    return this->_mx;
+    return (float)this->_raw[0] * this->_sens;
 }
 
 
@@ -196,7 +407,7 @@ float LIS3MDL_Mag::GetMx()
  */
 float LIS3MDL_Mag::GetMy()
 {
-    return this->_my;
+    return (float)this->_raw[1] * this->_sens;
 }
 
 /**
@@ -204,38 +415,34 @@ float LIS3MDL_Mag::GetMy()
  */
 float LIS3MDL_Mag::GetMz()
 {
-    return this->_mz;
+    return (float)this->_raw[2] * this->_sens;
+}
+
+
+/**
+ * Copy the latest reading in raw counts [LSB], for a fused conversion (see 
+ * counts_to_si.h). Multiply by LIS3MDLSensitivity(range) for [uT].
+ * 
+ * @param raw  [mx, my, mz] Output counts.
+ */
+void LIS3MDL_Mag::GetRaw(int16_t raw[3])
+{
+    raw[0] = this->_raw[0];
+    raw[1] = this->_raw[1];
+    raw[2] = this->_raw[2];
 }
 
 
 /**
- * Read temperature from the magnetometer sensor.
- * Return as float in degrees C. Temperature ranges from -40C to +85C. ODR is the same as the mag's ODR.
+ * Return the die temperature of the latest reading in degrees C. Read in the 
+ * same burst as the field, so no bus transaction. Temperature ranges from 
+ * -40C to +85C; 8 LSB/C, with 0 LSB at about 25C (not trimmed).
  * 
  * @returns Floating-point temperature in [C].
  */
 float LIS3MDL_Mag::GetTemperature()
 {
-    uint8_t tlo;
-    uint8_t thi;
-    int16_t tempRaw;
-    float tempC;
-
-    // Request over i2c bus
-    this->_SensorWire->beginTransmission((uint8_t)LIS3MDL_ADDR);
-    this->_SensorWire->write(LIS3MDL_OUT_TEMP_L);
-    this->_SensorWire->endTransmission();
-
-    // Read bytes
-    this->_SensorWire->requestFrom((uint8_t)LIS3MDL_ADDR, (uint8_t)2);
-    tlo = this->_SensorWire->read();
-    thi = this->_SensorWire->read();
-
-    // Convert to float
-    // https://electronics.stackexchange.com/questions/292863/magnetometer-lis3mdl-temperature-reading-changes-with-orientation
-    tempRaw = (int16_t)((tlo << 8) | thi);  // temperature as a signed int
-    tempC =  0.125f * ((float)tempRaw / 256.0f) + 25.0f;  // Temperature scaling: 8 degC/LSB (see p.9). Offset from application note
-    return tempC;
+    return (float)this->_tempRaw / LIS3MDL_TEMP_LSB_PER_C + LIS3MDL_TEMP_OFFSET_C;
 }
 
 
@@ -247,12 +454,7 @@ float LIS3MDL_Mag::GetTemperature()
  */
 void LIS3MDL_Mag::I2Cwrite8(uint8_t regOfInterest, uint8_t valToWrite)
 {
-    // Init. communication
-    this->_SensorWire->beginTransmission(LIS3MDL_ADDR);
-    this->_SensorWire->write((uint8_t)regOfInterest);
-    this->_SensorWire->write((uint8_t)valToWrite);
-
-    this->_SensorWire->endTransmission();
+    this->_bus->WriteReg8(LIS3MDL_ADDR, regOfInterest, valToWrite);
 }
 
 
@@ -260,25 +462,12 @@ void LIS3MDL_Mag::I2Cwrite8(uint8_t regOfInterest, uint8_t valToWrite)
  * Read register value from I2C device.
  * 
  * @param regOfInterest Register address on device.
- * @return Value/data in register.
+ * @return Value/data in register. 0 if the read failed.
  */
 uint8_t LIS3MDL_Mag::I2Cread8(uint8_t regOfInterest)
 {
-    uint8_t val;
-
-    // Init. communication
-    this->_SensorWire->beginTransmission((uint8_t)LIS3MDL_ADDR);
-    this->_SensorWire->write((uint8_t)regOfInterest);
-
-    // Check for failure
-    if (this->_SensorWire->endTransmission(false) != 0)
-        return 0;
-    
-    // Read register
-    this->_SensorWire->requestFrom((uint8_t)LIS3MDL_ADDR, (uint8_t)1);
-    val = this->_SensorWire->read();
-
-    this->_SensorWire->endTransmission();
+    uint8_t val = 0;
 
+    this->_bus->ReadReg8(LIS3MDL_ADDR, regOfInterest, &val);
     return val;
 }
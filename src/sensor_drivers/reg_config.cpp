@@ -0,0 +1,291 @@
+// ----------------------------------------------------------------------------
+// REGISTER CONFIGURATION TABLES
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Burst writes and read-back of register configuration tables. See
+ * reg_config.h.
+ */
+
+
+#include "sensor_drivers/reg_config.h"
+#include "hal/hal_platform.h"
+
+
+/* Register address to send for a burst starting at 'reg' */
+static uint8_t RegConfigBurstAddress(uint8_t reg, RegBurstMode_t mode)
+{
+    return (mode == REG_BURST_AUTOINC_MSB) ? (uint8_t)(reg | 0x80) : reg;
+}
+
+
+/**
+ * Write one burst of a configuration table: entry 'i' and the entries after 
+ * it that can ride along, up to the first one with a wait.
+ * 
+ * @return  Index of the next entry to write, or 0 if the write wasn't ACKed.
+ */
+static uint8_t WriteRegConfigBurst(I2CBus *bus, uint8_t address, const RegConfig_t *config, uint8_t n, RegBurstMode_t mode, uint8_t i)
+{
+    uint8_t buf[I2C_BUS_MAX_TRANSFER];
+    uint8_t len;
+    uint8_t k;
+
+    // Grow the burst while the next entry can ride along
+    buf[0] = config[i].value;
+    len = 1;
+    for (k = i + 1; k < n && config[k - 1].waitMicros == 0; k++)
+    {
+        if (mode == REG_BURST_ADDR_PAIRS)
+        {
+            if (len + 2 > I2C_BUS_MAX_TRANSFER - 1)
+                break;
+            buf[len++] = config[k].reg;
+            buf[len++] = config[k].value;
+        }
+        else
+        {
+            if (config[k].reg != (uint8_t)(config[k - 1].reg + 1) || len + 1 > I2C_BUS_MAX_TRANSFER - 1)
+                break;
+            buf[len++] = config[k].value;
+        }
+    }
+
+    if (!bus->WriteRegs(address, RegConfigBurstAddress(config[i].reg, mode), buf, len))
+        return 0;
+
+    return k;
+}
+
+
+// ----------------------------------------------------------------------------
+// WriteRegConfig(I2CBus *bus, uint8_t address, const RegConfig_t *config,
+//     uint8_t n, RegBurstMode_t mode)
+// ----------------------------------------------------------------------------
+/**
+ * Write a configuration table, in order, batching entries into as few
+ * transfers as the part allows. Each entry's wait runs right after the
+ * transfer that wrote it.
+ *
+ * @param bus      I2C bus the part is on.
+ * @param address  7-bit device address.
+ * @param config   Table of register writes.
+ * @param n        Number of entries.
+ * @param mode     How the part handles multi-byte writes.
+ * @return  True if every transfer was ACKed, false at the first that wasn't.
+ */
+bool WriteRegConfig(I2CBus *bus, uint8_t address, const RegConfig_t *config, uint8_t n, RegBurstMode_t mode)
+{
+    uint8_t i;
+    uint8_t k;
+
+    if (bus == nullptr || (config == nullptr && n > 0))
+        return false;
+
+    for (i = 0; i < n; i = k)
+    {
+        k = WriteRegConfigBurst(bus, address, config, n, mode, i);
+        if (k == 0)
+            return false;
+
+        if (config[k - 1].waitMicros > 0)
+            delayMicroseconds(config[k - 1].waitMicros);
+    }
+
+    return true;
+}
+
+
+// ----------------------------------------------------------------------------
+// VerifyRegConfig(I2CBus *bus, uint8_t address, const RegConfig_t *config,
+//     uint8_t n, RegBurstMode_t mode)
+// ----------------------------------------------------------------------------
+/**
+ * Read a written configuration back and check it. Registers within
+ * REG_CONFIG_MAX_GAP of each other are read in one burst.
+ *
+ * @param bus      I2C bus the part is on.
+ * @param address  7-bit device address.
+ * @param config   Table of register writes, as passed to WriteRegConfig().
+ * @param n        Number of entries.
+ * @param mode     How the part handles multi-byte reads.
+ * @return  True if every verified register holds its last written value
+ *          (under its mask), false on a mismatch, a failed read, or more
+ *          than REG_CONFIG_MAX_ENTRIES verified registers.
+ */
+bool VerifyRegConfig(I2CBus *bus, uint8_t address, const RegConfig_t *config, uint8_t n, RegBurstMode_t mode)
+{
+    const RegConfig_t *check[REG_CONFIG_MAX_ENTRIES];
+    const RegConfig_t *tmp;
+    uint8_t buf[I2C_BUS_MAX_TRANSFER];
+    uint8_t nCheck = 0;
+    uint8_t first;
+    uint8_t span;
+    uint8_t i;
+    uint8_t k;
+
+    if (bus == nullptr || (config == nullptr && n > 0))
+        return false;
+
+    // Last write to each register, sorted by register
+    for (i = 0; i < n; i++)
+    {
+        if (config[i].verifyMask == REG_NO_VERIFY)
+            continue;
+        for (k = i + 1; k < n; k++)
+        {
+            if (config[k].reg == config[i].reg)
+                break;
+        }
+        if (k < n)
+            continue;  // Overwritten later
+
+        if (nCheck >= REG_CONFIG_MAX_ENTRIES)
+            return false;
+        check[nCheck] = &config[i];
+        for (k = nCheck; k > 0 && check[k - 1]->reg > check[k]->reg; k--)
+        {
+            tmp = check[k - 1];
+            check[k - 1] = check[k];
+            check[k] = tmp;
+        }
+        nCheck++;
+    }
+
+    for (i = 0; i < nCheck; i = k)
+    {
+        // One read per block of nearby registers
+        first = check[i]->reg;
+        for (k = i + 1; k < nCheck; k++)
+        {
+            if (check[k]->reg - check[k - 1]->reg > REG_CONFIG_MAX_GAP + 1 ||
+                check[k]->reg - first + 1 > I2C_BUS_MAX_TRANSFER)
+                break;
+        }
+        span = (uint8_t)(check[k - 1]->reg - first + 1);
+
+        if (!bus->ReadRegs(address, RegConfigBurstAddress(first, mode), buf, span))
+            return false;
+
+        for (uint8_t j = i; j < k; j++)
+        {
+            if ((buf[check[j]->reg - first] ^ check[j]->value) & check[j]->verifyMask)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * Write a configuration table, then verify it. See WriteRegConfig() and
+ * VerifyRegConfig().
+ *
+ * @return  True if written and verified.
+ */
+bool ApplyRegConfig(I2CBus *bus, uint8_t address, const RegConfig_t *config, uint8_t n, RegBurstMode_t mode)
+{
+    return WriteRegConfig(bus, address, config, n, mode) && VerifyRegConfig(bus, address, config, n, mode);
+}
+
+
+RegConfigJob::RegConfigJob()
+{
+    this->_bus = nullptr;
+    this->_address = 0;
+    this->_n = 0;
+    this->_next = 0;
+    this->_mode = REG_BURST_AUTOINC;
+}
+
+
+// ----------------------------------------------------------------------------
+// Start(I2CBus *bus, uint8_t address, const RegConfig_t *config, uint8_t n,
+//     RegBurstMode_t mode)
+// ----------------------------------------------------------------------------
+/**
+ * Start applying a configuration table. Nothing is written until Step(). 
+ * The table is copied, so it can be a local. A job already running is 
+ * abandoned.
+ *
+ * @param bus      I2C bus the part is on.
+ * @param address  7-bit device address.
+ * @param config   Table of register writes.
+ * @param n        Number of entries, up to REG_CONFIG_MAX_ENTRIES.
+ * @param mode     How the part handles multi-byte transfers.
+ * @return  True if started, false if the table is too long.
+ */
+bool RegConfigJob::Start(I2CBus *bus, uint8_t address, const RegConfig_t *config, uint8_t n, RegBurstMode_t mode)
+{
+    this->_bus = nullptr;
+    if (bus == nullptr || (config == nullptr && n > 0) || n > REG_CONFIG_MAX_ENTRIES)
+        return false;
+
+    for (uint8_t i = 0; i < n; i++)
+        this->_config[i] = config[i];
+    this->_bus = bus;
+    this->_address = address;
+    this->_n = n;
+    this->_next = 0;
+    this->_mode = mode;
+    return true;
+}
+
+
+// ----------------------------------------------------------------------------
+// Step(uint32_t *waitMicros)
+// ----------------------------------------------------------------------------
+/**
+ * Write the next bursts, as WriteRegConfig() would, up to and including the 
+ * next entry with a wait, but return the wait instead of spending it. Once 
+ * everything is written, the next Step() verifies it (see VerifyRegConfig()) 
+ * and the job ends.
+ *
+ * @param waitMicros  Output, [us] time the part needs before the next 
+ *                    Step(). 0 if none.
+ * @return  REG_CONFIG_BUSY after a write, REG_CONFIG_DONE once verified, 
+ *          REG_CONFIG_FAILED on a NACK, a mismatch, or no job.
+ */
+RegConfigStatus_t RegConfigJob::Step(uint32_t *waitMicros)
+{
+    uint8_t k;
+    bool ok;
+
+    if (waitMicros != nullptr)
+        *waitMicros = 0;
+    if (this->_bus == nullptr)
+        return REG_CONFIG_FAILED;
+
+    if (this->_next < this->_n)
+    {
+        // Bursts up to the next wait
+        do
+        {
+            k = WriteRegConfigBurst(this->_bus, this->_address, this->_config, this->_n, this->_mode, this->_next);
+            if (k == 0)
+            {
+                this->_bus = nullptr;
+                return REG_CONFIG_FAILED;
+            }
+            this->_next = k;
+        } while (k < this->_n && this->_config[k - 1].waitMicros == 0);
+
+        if (waitMicros != nullptr)
+            *waitMicros = this->_config[k - 1].waitMicros;
+        return REG_CONFIG_BUSY;
+    }
+
+    ok = VerifyRegConfig(this->_bus, this->_address, this->_config, this->_n, this->_mode);
+    this->_bus = nullptr;
+    return ok ? REG_CONFIG_DONE : REG_CONFIG_FAILED;
+}
+
+
+/* True between Start() and the Step() that finishes or fails */
+bool RegConfigJob::IsBusy() const
+{
+    return this->_bus != nullptr;
+}
@@ -0,0 +1,133 @@
+// ----------------------------------------------------------------------------
+// SENSOR HEALTH AND BACKGROUND RE-INITIALIZATION
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Data age, failure counts and re-initialization timing for one sensor.
+ * See sensor_health.h.
+ */
+
+
+#include "sensor_drivers/sensor_health.h"
+#include "hal/hal_platform.h"
+
+
+/**
+ * @param failsToReinit  Failed reads in a row before re-initializing, at least 1.
+ * @param retryMicros    [us] Time between re-initialization attempts.
+ */
+SensorHealth::SensorHealth(uint8_t failsToReinit, uint32_t retryMicros)
+{
+    this->lastSampleMicros = 0;
+    this->readFailures = 0;
+    this->consecutiveFailures = 0;
+    this->reinits = 0;
+    this->reinitFailures = 0;
+    this->_failsToReinit = (failsToReinit > 0) ? failsToReinit : 1;
+    this->_retryMicros = retryMicros;
+    this->_nextReinitMicros = 0;
+    this->_readyMicros = 0;
+    this->_reinitPending = false;
+}
+
+
+/**
+ * Record a good read.
+ *
+ * @param sampleMicros  [us] Micros64() timestamp of the sample read.
+ */
+void SensorHealth::ReadOk(uint64_t sampleMicros)
+{
+    this->lastSampleMicros = sampleMicros;
+    this->consecutiveFailures = 0;
+    this->_nextReinitMicros = 0;  // Next dropout gets its first attempt right away
+}
+
+
+/**
+ * Record a failed read.
+ *
+ * @return  True if the sensor should be re-initialized now. Report the
+ *          result with ReinitDone(), or ReinitWait() if it continues later.
+ *          False while a re-initialization is pending.
+ */
+bool SensorHealth::ReadFailed()
+{
+    this->readFailures++;
+    this->consecutiveFailures++;
+
+    return !this->_reinitPending && this->consecutiveFailures >= this->_failsToReinit &&
+        Micros64() >= this->_nextReinitMicros;
+}
+
+
+/**
+ * Record that a re-initialization was started (or continued) and the part 
+ * needs time before the next step, e.g. to boot after a reset.
+ *
+ * @param waitMicros  [us] Time until the part is due to be ready.
+ */
+void SensorHealth::ReinitWait(uint32_t waitMicros)
+{
+    this->_reinitPending = true;
+    this->_readyMicros = Micros64() + waitMicros;
+}
+
+
+/* True between ReinitWait() and ReinitDone(). Don't read the sensor meanwhile. */
+bool SensorHealth::IsReinitPending() const
+{
+    return this->_reinitPending;
+}
+
+
+/* True once a pending re-initialization's wait is over and it can continue */
+bool SensorHealth::ReinitDue() const
+{
+    return this->_reinitPending && Micros64() >= this->_readyMicros;
+}
+
+
+/**
+ * Record a re-initialization attempt. The next one (if reads still fail)
+ * waits 'retryMicros'.
+ *
+ * @param ok  True if the driver's Initialize() succeeded (or the last 
+ *            StepInitialize() verified the configuration).
+ */
+void SensorHealth::ReinitDone(bool ok)
+{
+    this->_reinitPending = false;
+    if (ok)
+        this->reinits++;
+    else
+        this->reinitFailures++;
+
+    this->_nextReinitMicros = Micros64() + this->_retryMicros;
+}
+
+
+/* True unless the last 'failsToReinit' or more reads failed */
+bool SensorHealth::IsOnline() const
+{
+    return this->consecutiveFailures < this->_failsToReinit;
+}
+
+
+/**
+ * Age of the newest good sample.
+ *
+ * @return  [us] Time since it was taken. UINT64_MAX if there hasn't been one.
+ */
+uint64_t SensorHealth::DataAgeMicros() const
+{
+    uint64_t now = Micros64();
+
+    if (this->lastSampleMicros == 0)
+        return UINT64_MAX;
+    if (now < this->lastSampleMicros)
+        return 0;
+    return now - this->lastSampleMicros;
+}
@@ -0,0 +1,150 @@
+// ----------------------------------------------------------------------------
+// STARTUP BIAS ESTIMATOR
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Non-blocking turn-on bias measurement, fed sample by sample. See
+ * startup_bias.h.
+ */
+
+
+#include <math.h>
+#include "sensor_drivers/startup_bias.h"
+
+
+/* True if any axis of 'x' is more than 'maxDev' from the running mean */
+static bool StrayedFromMean(const RunningStats3 &stats, const float x[3], float maxDev)
+{
+    if (stats.n == 0)
+        return false;
+
+    for (uint8_t k = 0; k < 3; k++)
+    {
+        if (fabsf(x[k] - stats.mean[k]) > maxDev)
+            return true;
+    }
+    return false;
+}
+
+
+StartupBiasEstimator::StartupBiasEstimator()
+{
+    this->state = BIAS_EST_IDLE;
+    this->restarts = 0;
+    this->measureGyro = true;
+    this->_startMicros = 0;
+    this->_windowStarted = false;
+}
+
+
+/**
+ * Start (or start over) a measurement.
+ *
+ * @param measureGyro  False if the gyro bias is already known, e.g. from the
+ *                     stored bias table. Only the accel. is measured then.
+ */
+void StartupBiasEstimator::Start(bool measureGyro)
+{
+    this->measureGyro = measureGyro;
+    this->restarts = 0;
+    this->gyro.Reset();
+    this->accel.Reset();
+    this->_windowStarted = false;
+    this->state = BIAS_EST_MEASURING;
+}
+
+
+// ----------------------------------------------------------------------------
+// AddGyro(const float gyro[3], uint64_t micros)
+// ----------------------------------------------------------------------------
+/**
+ * Add a gyro sample. Ignored unless measuring the gyro.
+ *
+ * @param gyro    [rad/s] Calibrated gyro sample, bias not removed.
+ * @param micros  [us] Micros64() when the sample was taken.
+ */
+void StartupBiasEstimator::AddGyro(const float gyro[3], uint64_t micros)
+{
+    if (this->state != BIAS_EST_MEASURING || !this->measureGyro)
+        return;
+
+    if (StrayedFromMean(this->gyro, gyro, BIAS_EST_GYRO_DEV))
+        this->_Restart(micros);
+    else if (!this->_windowStarted)
+    {
+        this->_startMicros = micros;
+        this->_windowStarted = true;
+    }
+
+    this->gyro.Add(gyro);
+    this->_CheckDone(micros);
+}
+
+
+// ----------------------------------------------------------------------------
+// AddAccel(const float accel[3], uint64_t micros)
+// ----------------------------------------------------------------------------
+/**
+ * Add an accelerometer sample. It's also watched for motion when only the 
+ * accel. is measured.
+ *
+ * @param accel   [m/s/s] Calibrated accel. sample.
+ * @param micros  [us] Micros64() when the sample was taken.
+ */
+void StartupBiasEstimator::AddAccel(const float accel[3], uint64_t micros)
+{
+    if (this->state != BIAS_EST_MEASURING)
+        return;
+
+    if (StrayedFromMean(this->accel, accel, BIAS_EST_ACCEL_DEV))
+        this->_Restart(micros);
+    else if (!this->_windowStarted)
+    {
+        this->_startMicros = micros;
+        this->_windowStarted = true;
+    }
+
+    this->accel.Add(accel);
+    this->_CheckDone(micros);
+}
+
+
+/* Return true once the means are ready */
+bool StartupBiasEstimator::IsDone() const
+{
+    return this->state == BIAS_EST_DONE;
+}
+
+
+/* The vehicle moved: drop the window and start a new one at 'micros' */
+void StartupBiasEstimator::_Restart(uint64_t micros)
+{
+    this->gyro.Reset();
+    this->accel.Reset();
+    this->_startMicros = micros;
+    this->_windowStarted = true;
+    this->restarts++;
+}
+
+
+/**
+ * Finish if the window is long enough and the means have converged (or the 
+ * window reached BIAS_EST_MAX_US).
+ *
+ * @param micros  [us] Micros64() of the newest sample.
+ */
+void StartupBiasEstimator::_CheckDone(uint64_t micros)
+{
+    uint64_t stillMicros = micros - this->_startMicros;
+    bool enough = (!this->measureGyro || this->gyro.n >= BIAS_EST_MIN_SAMPLES) && this->accel.n >= BIAS_EST_MIN_SAMPLES;
+    bool converged = (!this->measureGyro || this->gyro.MaxMeanVariance() <= BIAS_EST_GYRO_SEM * BIAS_EST_GYRO_SEM) && 
+        this->accel.MaxMeanVariance() <= BIAS_EST_ACCEL_SEM * BIAS_EST_ACCEL_SEM;
+
+    if (micros < this->_startMicros || !enough)
+        return;
+
+    if ((stillMicros >= BIAS_EST_MIN_US && converged) || stillMicros >= BIAS_EST_MAX_US)
+        this->state = BIAS_EST_DONE;
+}
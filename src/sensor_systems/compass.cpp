@@ -14,20 +14,21 @@
 
 
 // ----------------------------------------------------------------------------
-// MagCompass(TwoWire *userWire)
-// : Mag(3), MagRaw(3), MagSensor(&SENSOR_I2C)
+// MagCompass(I2CBus *bus)
+// : Mag(3), MagRaw(3), MagHealth(...), MagSensor(bus)
 // ----------------------------------------------------------------------------
 /**
  * Constructor for the compass class. Be sure to specify the I2C bus that the 
  * sensor is connected to.
  * 
- * @param userWire   I2C bus the compass is connected to. Default Wire2
+ * @param bus   I2C bus the compass is connected to. Default SensorI2CBus()
  */
-MagCompass::MagCompass(TwoWire *userWire)
-: Mag(3), MagRaw(3), MagSensor(&SENSOR_I2C)
+MagCompass::MagCompass(I2CBus *bus)
+: Mag(3), MagRaw(3), MagHealth(MAGCOMPASS_REINIT_AFTER_FAILS, MAGCOMPASS_REINIT_RETRY_US), MagSensor(bus)
 {
     heading = 0.0f;
-    prevUpdateMicros = micros();
+    prevUpdateMicros = 0;
+    magMicros = 0;
 }
 
 
@@ -46,7 +47,8 @@ bool MagCompass::Initialize()
     #endif
 
     /* Connect to and init. the magnetometer */
-    if (!MagSensor.Initialize(MAGCOMPASS_RANGE))
+    if (!MagSensor.Initialize(MAGCOMPASS_RANGE, MAGCOMPASS_ODR) || 
+        !MagSensor.SetTempCompensation(MAGCOMPASS_TEMPCOMP, MAGCOMPASS_TEMPCOMP_LEN))
     {
         #ifdef MAGCOMPASS_DEBUG
         DEBUG_PORT.println("MAGCOMPASS:Initialize ERROR: Could not initialize/connect to LIS3MDL compass. Check settings.");
@@ -54,6 +56,9 @@ bool MagCompass::Initialize()
         return false;
     }
 
+    /* Data-ready interrupt, if wired. Otherwise the sensor is polled. */
+    MagSensor.AttachDataReady(MAG_DRDY_PIN);
+
     #ifdef MAGCOMPASS_DEBUG
     DEBUG_PORT.println("Done!");
     #endif
@@ -67,49 +72,53 @@ bool MagCompass::Initialize()
 // ----------------------------------------------------------------------------
 /**
  * Update the compass. Record magnetometer data, rotate sensor data to the body 
- * frame, and apply calibration.
+ * frame, and apply calibration. Rotation and calibration are fused into one 
+ * conversion from the raw counts (MAGCOMPASS_CVT). Each new sample is 
+ * published to Outputs, for readers that may be interrupted by Update().
+ * 
+ * A failed read keeps the last good sample and returns false. After 
+ * MAGCOMPASS_REINIT_AFTER_FAILS failures in a row the magnetometer is 
+ * re-initialized, then every MAGCOMPASS_REINIT_RETRY_US until it's back.
  * 
- * @returns True if successful, false if not.
+ * @returns True if successful (or no new sample yet), false if the read failed.
  */
 bool MagCompass::Update()
 {
-    float mx, my, mz;
-    float bmx, bmy, bmz;
+    MagCompassOutput_t out;
+    int16_t raw[3];
+
+    /* Read sensor. With a data-ready pin, only when there's a new sample. */
+    if (!MagSensor.DataReady())
+        return true;
 
-    /* Read sensor */
     if (!MagSensor.ReadSensor())
     {
         #ifdef MAGCOMPASS_DEBUG
         DEBUG_PORT.println("MAGCOMPASS:Update ERROR: Could not read magnetometer sensor.");
         #endif
-        // return false;
+        if (MagHealth.ReadFailed())
+            MagHealth.ReinitDone(Initialize());
+        return false;
     }
+    MagHealth.ReadOk(MagSensor.prevMeasMicros);
 
-    // Apply sensor rotation
-    #ifdef MAGCOMPASS_DO_NOT_ROTATE
-    mx = MagSensor.GetMx();
-    my = MagSensor.GetMy();
-    mz = MagSensor.GetMz();
-    #else
-    mx = -MagSensor.GetMy();
-    my = -MagSensor.GetMx();
-    mz = -MagSensor.GetMz();
-    #endif
-
-    MagRaw.vec[0] = mx;
-    MagRaw.vec[1] = my;
-    MagRaw.vec[2] = mz;
+    // Sensor rotation only, for logging
+    MagSensor.GetRaw(raw);
+    ApplyCountsToSI(MAGCOMPASS_CVT_RAW, raw, MagRaw.vec);
 
-    prevUpdateMicros = micros();
+    magMicros = MagSensor.prevMeasMicros;
+    prevUpdateMicros = Micros64();
 
-    /* Apply calibration */
-    bmx = mx - SENSCALIB_MAG_BX;
-    bmy = my - SENSCALIB_MAG_BY;
-    bmz = mz - SENSCALIB_MAG_BZ;
+    /* Rotate and apply calibration */
+    ApplyCountsToSI(MAGCOMPASS_CVT, raw, Mag.vec);
 
-    Mag.vec[0] = (SENSCALIB_MAG_S11 * bmx) + (SENSCALIB_MAG_S12 * bmy) + (SENSCALIB_MAG_S13 * bmz);
-    Mag.vec[1] = (SENSCALIB_MAG_S12 * bmx) + (SENSCALIB_MAG_S22 * bmy) + (SENSCALIB_MAG_S23 * bmz);
-    Mag.vec[2] = (SENSCALIB_MAG_S13 * bmx) + (SENSCALIB_MAG_S23 * bmy) + (SENSCALIB_MAG_S33 * bmz);
+    for (uint8_t k = 0; k < 3; k++)
+    {
+        out.mag[k] = Mag.vec[k];
+        out.magRaw[k] = MagRaw.vec[k];
+    }
+    out.magMicros = magMicros;
+    Outputs.Write(out);
 
     return true;
 }
@@ -7,7 +7,7 @@
 
 // AltMSLParser(NMEAParser, "GNGGA", 9),
 // HDOPParser(NMEAParser, "GNGSA", 16),
-GNSSComputer::GNSSComputer(TwoWire *userWire)
+GNSSComputer::GNSSComputer(I2CBus *bus)
 // :GeoidSepParser(NMEAParser, "GNGGA", 11),
 // PDOPParser(NMEAParser, "GNGSA", 15)
 // VDOPParser(NMEAParser, "GNGSA", 17),
@@ -15,7 +15,16 @@ GNSSComputer::GNSSComputer(TwoWire *userWire)
 // GroundSpeedParser(NMEAParser, "GNVTG", 5)
 {
     isConfigured = false;
-    gpsWire = userWire;
+    lastDataCheck = 0;
+    dataPollWait = 20UL;
+    streamBytesLeft = 0;
+    ubxState = 0;
+    ubxCkA = 0;
+    ubxCkB = 0;
+    ackClass = 0;
+    ackId = 0;
+    ackStatus = GNSS_ACK_NONE;
+    gpsBus = bus;
 }
 
 
@@ -26,7 +35,9 @@ GNSSComputer::GNSSComputer(TwoWire *userWire)
 /**
  * Configure the GPS sensor. Sends config. commands over I2C. Configures port 
  * settings, satellite network/s, GPS dynamic model, enables/disables NMEA 
- * messages, and sets output data rate.
+ * messages, and sets output data rate. Each command waits for the receiver's 
+ * UBX-ACK instead of a fixed pause, so a warm receiver is configured in a few 
+ * tens of ms.
  * 
  * @param userNetwork   Network to connect to. GPS, GLONASS, or GPS+GLONASS
  * @param userDynModel  GPS's internal fusion algorithm dynamic model. Pedestrian, 
@@ -38,7 +49,8 @@ bool GNSSComputer::ConfigureDevice(
     GNSSNetworks_t userNetwork, GNSSDynamics_t userDynModel,
     GNSSNavRate_t userODR)
 {
-    uint32_t pauseBetweenTasks = 100;  // [ms] millis() between configuration tasks
+    uint32_t startMillis;
+    bool ok;
     
     isConfigured = false;
 
@@ -56,47 +68,47 @@ bool GNSSComputer::ConfigureDevice(
         userODR = GNSS_NAVRATE_5HZ;
     }
 
-    gpsWire->begin();
-    delay(250);  // Wait a sec
-    // gpsWire->flush();
+    gpsBus->Begin();
+    dataPollWait = GNSS_ACK_POLL_MS;  // Poll fast for ACKs while configuring
 
-    gpsWire->beginTransmission(GNSS_I2C_ADDR);
-    gpsWire->write(0xFF);
-
-    // Check to see if the sensor ack'd
-    if (gpsWire->endTransmission(false) != 0)
+    // Wait for the sensor to ack its address (it doesn't until it has booted)
+    startMillis = millis();
+    while (!gpsBus->Probe(GNSS_I2C_ADDR))
     {
-        #ifdef GNSS_DEBUG
-        DEBUG_PORT.println("GNSSComputer::ConfigureDevice ERROR: GPS did not respond");
-        #endif
-        return false;
+        if (millis() - startMillis >= GNSS_BOOT_TIMEOUT_MS)
+        {
+            #ifdef GNSS_DEBUG
+            DEBUG_PORT.println("GNSSComputer::ConfigureDevice ERROR: GPS did not respond");
+            #endif
+            return false;
+        }
+        delay(GNSS_ACK_POLL_MS);
     }
 
 
     // Set port settings
-    SendUBXConfigMessage(UBX_CFG_PRT_I2C, UBX_CFG_PRTLEN);
+    if (!SendUBXConfigMessage(UBX_CFG_PRT_I2C, UBX_CFG_PRTLEN))
+        return false;
     #ifdef GNSS_DEBUG
     DEBUG_PORT.println("GNSSComputer::ConfigureDevice: Changed I2C port settings.");
     #endif
 
-    delay(pauseBetweenTasks);  // Wait a sec
-
 
     /* Config. satellite network */
     switch (userNetwork)
     {
         case GNSS_NET_GPS: {
-            SendUBXConfigMessage(UBX_CFG_GNSS_GPS, UBX_CFG_GNSSLEN);
+            ok = SendUBXConfigMessage(UBX_CFG_GNSS_GPS, UBX_CFG_GNSSLEN);
             network = GNSS_NET_GPS;
             break;
         }
         case GNSS_NET_GLONASS: {
-            SendUBXConfigMessage(UBX_CFG_GNSS_GLONASS, UBX_CFG_GNSSLEN);
+            ok = SendUBXConfigMessage(UBX_CFG_GNSS_GLONASS, UBX_CFG_GNSSLEN);
             network = GNSS_NET_GLONASS;
             break;
         }
         case GNSS_NET_GPS_GLONASS: {
-            SendUBXConfigMessage(UBX_CFG_GNSS_GPS_GLONASS, UBX_CFG_GNSSLEN);
+            ok = SendUBXConfigMessage(UBX_CFG_GNSS_GPS_GLONASS, UBX_CFG_GNSSLEN);
             network = GNSS_NET_GPS_GLONASS;
             break;
         }
@@ -104,13 +116,14 @@ bool GNSSComputer::ConfigureDevice(
             #ifdef GNSS_DEBUG
             DEBUG_PORT.println("GNSSComputer::ConfigureDevice WARNING: Unknown network, defaulting to GPS+GLONASS");
             #endif
-            SendUBXConfigMessage(UBX_CFG_GNSS_GPS_GLONASS, UBX_CFG_GNSSLEN);
+            ok = SendUBXConfigMessage(UBX_CFG_GNSS_GPS_GLONASS, UBX_CFG_GNSSLEN);
             network = GNSS_NET_GPS_GLONASS;
             break;
         }
     }
 
-    delay(pauseBetweenTasks);
+    if (!ok)
+        return false;
 
     #ifdef GNSS_DEBUG
     DEBUG_PORT.println("GNSSComputer::ConfigureDevice: Changed network.");
@@ -121,17 +134,17 @@ bool GNSSComputer::ConfigureDevice(
     switch (userDynModel)
     {
         case GNSS_DYNAMICS_PORTABLE: {
-            SendUBXConfigMessage(UBX_CFG_NAV5_PORTABLE_3D, UBX_CFG_NAV5LEN);
+            ok = SendUBXConfigMessage(UBX_CFG_NAV5_PORTABLE_3D, UBX_CFG_NAV5LEN);
             dynamicModel = GNSS_DYNAMICS_PORTABLE;
             break;
         }
         case GNSS_DYNAMICS_PEDESTRIAN: {
-            SendUBXConfigMessage(UBX_CFG_NAV5_PEDESTRIAN_3D, UBX_CFG_NAV5LEN);
+            ok = SendUBXConfigMessage(UBX_CFG_NAV5_PEDESTRIAN_3D, UBX_CFG_NAV5LEN);
             dynamicModel = GNSS_DYNAMICS_PEDESTRIAN;
             break;
         }
         case GNSS_DYNAMICS_AIRBORNE_1G: {
-            SendUBXConfigMessage(UBX_CFG_NAV5_AIR1G_3D, UBX_CFG_NAV5LEN);
+            ok = SendUBXConfigMessage(UBX_CFG_NAV5_AIR1G_3D, UBX_CFG_NAV5LEN);
             dynamicModel = GNSS_DYNAMICS_AIRBORNE_1G;
             break;
         }
@@ -139,13 +152,14 @@ bool GNSSComputer::ConfigureDevice(
             #ifdef GNSS_DEBUG
             DEBUG_PORT.println("GNSSComputer::ConfigureDevice WARNING: Unknown dynamic model, defaulting to pedestrian");
             #endif
-            SendUBXConfigMessage(UBX_CFG_NAV5_PEDESTRIAN_3D, UBX_CFG_NAV5LEN);
+            ok = SendUBXConfigMessage(UBX_CFG_NAV5_PEDESTRIAN_3D, UBX_CFG_NAV5LEN);
             dynamicModel = GNSS_DYNAMICS_PEDESTRIAN;
             break;
         }
     }
 
-    delay(pauseBetweenTasks);
+    if (!ok)
+        return false;
 
     #ifdef GNSS_DEBUG
     DEBUG_PORT.println("GNSSComputer::ConfigureDevice: Changed dynamic model.");
@@ -153,24 +167,23 @@ bool GNSSComputer::ConfigureDevice(
 
 
     /* Config/disable NMEA messages */
-    SendUBXConfigMessage(UBX_CFG_MSG_DISABLE_GLL, 16);
-    delay(pauseBetweenTasks);
+    if (!SendUBXConfigMessage(UBX_CFG_MSG_DISABLE_GLL, 16))
+        return false;
 
-    SendUBXConfigMessage(UBX_CFG_MSG_DISABLE_GSV, 16);
-    delay(pauseBetweenTasks);
+    if (!SendUBXConfigMessage(UBX_CFG_MSG_DISABLE_GSV, 16))
+        return false;
 
     // SendUBXConfigMessage(UBX_CFG_MSG_DISABLE_RMC, 16);
-    // delay(pauseBetweenTasks);
     
     // Disable GxGSA
     uint8_t cfg1[16] = {0xB5,0x62,0x06,0x01,0x08,0x00,0xF0,0x02,0x00,0x00,0x01,0x01,0x01,0x00,0x04,0x3A};
-    SendUBXConfigMessage(cfg1, 16);
-    delay(pauseBetweenTasks);
+    if (!SendUBXConfigMessage(cfg1, 16))
+        return false;
 
     // Disable GxVTG
     uint8_t cfg2[16] = {0xB5,0x62,0x06,0x01,0x08,0x00,0xF0,0x05,0x00,0x00,0x01,0x01,0x01,0x00,0x07,0x4F};
-    SendUBXConfigMessage(cfg2, 16);
-    delay(pauseBetweenTasks);
+    if (!SendUBXConfigMessage(cfg2, 16))
+        return false;
 
     #ifdef GNSS_DEBUG
     DEBUG_PORT.println("GNSSComputer::ConfigureDevice: Disabled GxGLL, GxGSV, and GxRMC NMEA messages.");
@@ -181,13 +194,13 @@ bool GNSSComputer::ConfigureDevice(
     switch (userODR)
     {
         case GNSS_NAVRATE_5HZ: {
-            SendUBXConfigMessage(UBX_CFG_RATE_5HZ, UBX_CFG_RATELEN);
+            ok = SendUBXConfigMessage(UBX_CFG_RATE_5HZ, UBX_CFG_RATELEN);
             updateRate = GNSS_NAVRATE_5HZ;
             navRate = 5.0f;
             break;
         }
         case GNSS_NAVRATE_10HZ: {
-            SendUBXConfigMessage(UBX_CFG_RATE_10HZ, UBX_CFG_RATELEN);
+            ok = SendUBXConfigMessage(UBX_CFG_RATE_10HZ, UBX_CFG_RATELEN);
             updateRate = GNSS_NAVRATE_10HZ;
             navRate = 10.0f;
             break;
@@ -196,17 +209,19 @@ bool GNSSComputer::ConfigureDevice(
             #ifdef GNSS_DEBUG
             DEBUG_PORT.println("GNSSComputer::ConfigureDevice WARNING: Unknown nav rate, defaulting to 5Hz");
             #endif
-            SendUBXConfigMessage(UBX_CFG_RATE_5HZ, UBX_CFG_RATELEN);
+            ok = SendUBXConfigMessage(UBX_CFG_RATE_5HZ, UBX_CFG_RATELEN);
             updateRate = GNSS_NAVRATE_5HZ;
             navRate = 5.0f;
             break;
         }
     }
 
+    if (!ok)
+        return false;
+
     navTs = 1.0f / navRate;
     // dataPollWait = 1000UL / (((uint32_t)navRate) * 4UL);
     dataPollWait = 20UL;
-    delay(pauseBetweenTasks);
     #ifdef GNSS_DEBUG
     DEBUG_PORT.print("GNSSComputer::ConfigureDevice: Changed nav rate to ");
     DEBUG_PORT.print(navRate);
@@ -234,7 +249,6 @@ bool GNSSComputer::ConfigureDevice(
  */
 bool GNSSComputer::WaitForSatellites(uint32_t minSats)
 {
-    char b;
     uint32_t nSats;
     uint32_t startMillis;
     uint32_t currMillis;
@@ -268,11 +282,8 @@ bool GNSSComputer::WaitForSatellites(uint32_t minSats)
     {
         currMillis = millis();
 
-        while (GPS_I2C.available())
-        {
-            b = GPS_I2C.read();
-            NMEAParser.encode(b);
-        }
+        // Feed the NMEA parser whatever the GPS has
+        ListenForData();
     
         // if (NMEAParser.satellites.isUpdated() && NMEAParser.satellites.isValid())
         if (NMEAParser.satellites.isUpdated())
@@ -328,21 +339,28 @@ bool GNSSComputer::WaitForSatellites(uint32_t minSats)
 
 
 // ----------------------------------------------------------------------------
-// GNSSComputer::ListenForData()
+// GNSSComputer::ListenForData(uint16_t maxBytes)
 // ----------------------------------------------------------------------------
 /**
  * Read data from GPS I2C port and feed the TinyGPS NMEA parser data. Also 
  * includes checks to ensure data integrity.
  * 
+ * At most 'maxBytes' are read per call (including the 2-byte count read), so 
+ * a long backlog can be drained in pieces between other devices' reads (see 
+ * I2CBusScheduler). Bytes left in the receiver are read on the next call 
+ * without waiting for the poll period or re-reading the count.
+ * 
+ * @param maxBytes  Max. bytes to read from the GPS this call. Default: all.
  * @returns True if success, false if not.
  */
 // https://github.com/sparkfun/SparkFun_Ublox_Arduino_Library/blob/1e70755453a898d8267ced641500c33d377409b7/src/SparkFun_Ublox_Arduino_Library.cpp#L347
-bool GNSSComputer::ListenForData()
+bool GNSSComputer::ListenForData(uint16_t maxBytes)
 {
     // Put statement at the top of the code and allocate variables within it
-    if (millis() - lastDataCheck >= dataPollWait)
+    if (streamBytesLeft > 0 || millis() - lastDataCheck >= dataPollWait)
     {
         /* Get the bytes available for read */
+        uint8_t buf[GNSS_I2C_BUFFSIZE];
         uint8_t hibyte;
         uint8_t lobyte;
         uint8_t byteFromGps;
@@ -350,25 +368,25 @@ bool GNSSComputer::ListenForData()
         uint16_t bytesAvail;
         uint16_t bytesToRead;
 
-        bytesAvail = 0;
+        bytesAvail = streamBytesLeft;
 
-        // Check for connection
-        gpsWire->beginTransmission(GNSS_I2C_ADDR);
-        gpsWire->write(0xFD);  // See p. 38 of u-blox M8 Receiver description
-        if (gpsWire->endTransmission(false) != 0)
+        if (bytesAvail == 0)
         {
-            #ifdef GNSS_DEBUG
-            DEBUG_PORT.println("GNSSComputer::ListenForData ERROR: GPS did not respond");
-            #endif
-            return false;
-        }
+            if (maxBytes < 2)
+                return false;  // No budget for the count read
+            maxBytes -= 2;
 
-        gpsWire->requestFrom(GNSS_I2C_ADDR, (uint8_t)2);  // req. hi and lo byte
+            // Read the hi and lo byte count. See p. 38 of u-blox M8 Receiver description
+            if (!gpsBus->ReadRegs(GNSS_I2C_ADDR, 0xFD, buf, 2))
+            {
+                #ifdef GNSS_DEBUG
+                DEBUG_PORT.println("GNSSComputer::ListenForData ERROR: GPS did not respond");
+                #endif
+                return false;
+            }
 
-        if (gpsWire->available())
-        {
-            hibyte = gpsWire->read();
-            lobyte = gpsWire->read();
+            hibyte = buf[0];
+            lobyte = buf[1];
 
             // Check for possible ublox bug presented in Sparkfun code
             if (lobyte == 0xFF)
@@ -381,94 +399,86 @@ bool GNSSComputer::ListenForData()
             }
 
             bytesAvail = (uint16_t)hibyte << 8 | lobyte;  // Cvt. to 16-bit value
-        }
 
-        // Check if empty
-        if (bytesAvail == 0)
-        {
-            // #ifdef GNSS_DEBUG
-            // DEBUG_PORT.println("GNSSComputer::ListenForData No bytes available, ok");
-            // #endif
-            lastDataCheck = millis();
-            return false;
-        }
+            // Check if empty
+            if (bytesAvail == 0)
+            {
+                // #ifdef GNSS_DEBUG
+                // DEBUG_PORT.println("GNSSComputer::ListenForData No bytes available, ok");
+                // #endif
+                lastDataCheck = millis();
+                return false;
+            }
 
-        // Check for "bytes available" error documented in Sparkfun's code
-        if (bytesAvail & ((uint16_t)1 << 15))
-        {
-            // Clear hibyte
-            bytesAvail &= ~((uint16_t)1 << 15);
+            // Check for "bytes available" error documented in Sparkfun's code
+            if (bytesAvail & ((uint16_t)1 << 15))
+            {
+                // Clear hibyte
+                bytesAvail &= ~((uint16_t)1 << 15);
 
-            #ifdef GNSS_DEBUG
-            DEBUG_PORT.println("GNSSComputer::ListenForData ERROR: Encountered bytes available error");
-            #endif
+                #ifdef GNSS_DEBUG
+                DEBUG_PORT.println("GNSSComputer::ListenForData ERROR: Encountered bytes available error");
+                #endif
+            }
+            lastDataCheck = millis();
         }
 
         /* Read the data */
-        // Yeah, while loops are bad, but whatevs
         // bytesAvail decreases as bytes are read. The loop will terminate when all 
-        // bytes are read (bytesAvail = 0)
+        // bytes are read (bytesAvail = 0), or the byte budget is used up.
         bytesToRead = 0;
-        while (bytesAvail)
+        while (bytesAvail > 0 && maxBytes > 0)
         {
-            // Check connection
-            gpsWire->beginTransmission(GNSS_I2C_ADDR);
-            gpsWire->write(0xFF);
-            if (gpsWire->endTransmission(false) != 0)
+            /**
+             * Limit bytes to read to the bus's max. transfer size, 32 bytes
+             * for Arduino boards and Teensy 4.1, and to what's left of the budget
+             */
+            bytesToRead = (bytesAvail > GNSS_I2C_BUFFSIZE) ? GNSS_I2C_BUFFSIZE : bytesAvail;
+            if (bytesToRead > maxBytes)
+                bytesToRead = maxBytes;
+        
+            TRY_AGAIN:  // Checkpoint for when we encounter the 0x7F thingy
+
+            // Grab some bytes to eat from the stream register (0xFF)
+            if (!gpsBus->ReadRegs(GNSS_I2C_ADDR, 0xFF, buf, (uint8_t)bytesToRead))
             {
+                // Sensor was not available/didn't respond
                 #ifdef GNSS_DEBUG
                 DEBUG_PORT.println("GNSSComputer::ListenForData ERROR: GPS did not respond");
                 #endif
+                streamBytesLeft = 0;
                 return false;
             }
 
-            /**
-             * Limit bytes to read to device I2C buffer size, 32 bytes for 
-             * Arduino boards and Teensy 4.1
-             * 
-             * bytesToRead = bytesAvail;
-             * if (bytesToRead > 32)
-             *     bytesToRead = 32;
-             */
-            bytesToRead = (bytesAvail > GNSS_I2C_BUFFSIZE) ? GNSS_I2C_BUFFSIZE : bytesAvail;
-        
-            TRY_AGAIN:  // Checkpoint for when we encounter the 0x7F thingy
-
-            // Grab some bytes to eat
-            gpsWire->requestFrom(GNSS_I2C_ADDR, (uint8_t)bytesToRead);
-            if (gpsWire->available())
+            for (i = 0; i < bytesToRead; i++)
             {
-                for (i = 0; i < bytesToRead; i++)
+                byteFromGps = buf[i];
+
+                // Check for 0x7F error-thing outlined in Sparkfun's code
+                // I'm not sure if we need to check for this, but I put in in, just
+                // in case. Otherwise, we can comment it out
+                if (i == 0 && byteFromGps == 0x7F)
                 {
-                    byteFromGps = gpsWire->read();
-
-                    // Check for 0x7F error-thing outlined in Sparkfun's code
-                    // I'm not sure if we need to check for this, but I put in in, just
-                    // in case. Otherwise, we can comment it out
-                    if (i == 0 && byteFromGps == 0x7F)
-                    {
-                        #ifdef GNSS_DEBUG
-                        DEBUG_PORT.println("GNSSComputer::ListenForData WARNING: Encountered 0x7F error");
-                        #endif
-
-                        // This delay() probs isn't good to have in final flight code, but we might need it if this 
-                        // error is frequent
-                        delay(3);  // Sparkfun has 5ms, imma use 3ms
-                        goto TRY_AGAIN;
-                    }
-
-                    /* Pass the received byte on to TinyGPS to form and parse NMEA data */
-                    NMEAParser.encode((char)byteFromGps);
+                    #ifdef GNSS_DEBUG
+                    DEBUG_PORT.println("GNSSComputer::ListenForData WARNING: Encountered 0x7F error");
+                    #endif
+
+                    // This delay() probs isn't good to have in final flight code, but we might need it if this 
+                    // error is frequent
+                    delay(3);  // Sparkfun has 5ms, imma use 3ms
+                    goto TRY_AGAIN;
                 }
-            }
-            else
-            {
-                // Sensor was not available/didn't respond
-                return false;
+
+                /* Pass the received byte on to TinyGPS to form and parse NMEA data */
+                ParseUBXAck(byteFromGps);
+                NMEAParser.encode((char)byteFromGps);
             }
 
             bytesAvail -= bytesToRead;  // Decrease counter
+            maxBytes -= bytesToRead;
         }
+
+        streamBytesLeft = bytesAvail;  // Rest on the next call
     }
 
     // If we get to this point, we've received valid bytes!
@@ -494,39 +504,130 @@ bool GNSSComputer::ListenForData()
 // GNSSComputer::SendUBXConfigMessage(const uint8_t *msg, size_t len)
 // ----------------------------------------------------------------------------
 /**
- * Send UBX configuration message over I2C.
+ * Send UBX configuration message over I2C and wait for the receiver to 
+ * acknowledge it. Sent up to GNSS_CFG_TRIES times.
  * 
  * @param msg  uint8_t array of bytes to send.
  * @param  len  Length of message
+ * @return  True if the receiver ACKed the message, false if it NAKed it or 
+ *          didn't answer.
  */
-void GNSSComputer::SendUBXConfigMessage(const uint8_t *msg, size_t len)
+bool GNSSComputer::SendUBXConfigMessage(const uint8_t *msg, size_t len)
 {
-    gpsWire->beginTransmission(GNSS_I2C_ADDR);
-    gpsWire->write(0xFF);
+    size_t sent;
+    size_t chunk;
+
+    if (len < 8)
+        return false;  // Not a UBX frame
 
-    // Check to see if the sensor ack'd
-    if (gpsWire->endTransmission(false) != 0)
+    for (uint8_t tries = 0; tries < GNSS_CFG_TRIES; tries++)
     {
-        #ifdef GNSS_DEBUG
-        DEBUG_PORT.println("GNSSComputer::SendUBXConfigMessage ERROR: GPS did not respond to request");
-        #endif
-        // return GNSS_I2C_COMM_ERROR;
+        ackStatus = GNSS_ACK_NONE;
+
+        /**
+         * Send the message in bus-sized chunks. The DDC port takes writes of 2+
+         * bytes as message data (a 1-byte write only sets the register address),
+         * so never leave a 1-byte tail.
+         */
+        sent = 0;
+        while (sent < len)
+        {
+            chunk = len - sent;
+            if (chunk > I2C_BUS_MAX_TRANSFER)
+            {
+                chunk = I2C_BUS_MAX_TRANSFER;
+                if (len - sent - chunk == 1)
+                    chunk--;
+            }
+
+            if (!gpsBus->Write(GNSS_I2C_ADDR, msg + sent, (uint8_t)chunk))
+                break;
+            sent += chunk;
+        }
+
+        // Class and ID follow the sync chars
+        if (sent == len && WaitForAck(msg[2], msg[3], GNSS_ACK_TIMEOUT_MS))
+            return true;
     }
 
-    // Send message
-    gpsWire->beginTransmission(GNSS_I2C_ADDR);
-    gpsWire->write(msg, len);
-    
-    // Release the bus
-    if (gpsWire->endTransmission() != 0)
+    #ifdef GNSS_DEBUG
+    DEBUG_PORT.println("GNSSComputer::SendUBXConfigMessage ERROR: GPS did not accept message");
+    #endif
+    return false;
+}
+
+
+// ----------------------------------------------------------------------------
+// GNSSComputer::WaitForAck(uint8_t msgClass, uint8_t msgId, uint32_t timeoutMs)
+// ----------------------------------------------------------------------------
+/**
+ * Read the GPS output until the UBX-ACK for a message arrives. NMEA data read 
+ * meanwhile is parsed as usual.
+ * 
+ * @param msgClass   Class of the message sent.
+ * @param msgId      ID of the message sent.
+ * @param timeoutMs  [ms] Max. time to wait.
+ * @return  True on UBX-ACK-ACK, false on UBX-ACK-NAK or timeout.
+ */
+bool GNSSComputer::WaitForAck(uint8_t msgClass, uint8_t msgId, uint32_t timeoutMs)
+{
+    uint32_t startMillis = millis();
+
+    do
     {
-        #ifdef GNSS_DEBUG
-        DEBUG_PORT.println("GNSSComputer::SendUBXConfigMessage ERROR: GPS did not release after message");
-        #endif
-    }
+        ListenForData();
+        if (ackStatus != GNSS_ACK_NONE && ackClass == msgClass && ackId == msgId)
+            return ackStatus == GNSS_ACK_ACK;
+        delay(GNSS_ACK_POLL_MS);
+    } while (millis() - startMillis < timeoutMs);
 
-    // Wait a bit
-    delay(50);
+    return false;
+}
+
+
+/**
+ * Feed one byte of GPS output to the UBX-ACK parser. A valid UBX-ACK-ACK or 
+ * UBX-ACK-NAK frame sets ackClass, ackId, and ackStatus; other UBX frames and 
+ * NMEA text are skipped.
+ * 
+ * @param b  Byte read from the GPS stream.
+ */
+void GNSSComputer::ParseUBXAck(uint8_t b)
+{
+    switch (ubxState)
+    {
+        case 0:  // Sync char 1
+            if (b == 0xB5)
+                ubxState = 1;
+            return;
+        case 1:  // Sync char 2
+            ubxState = (b == 0x62) ? 2 : 0;
+            ubxCkA = 0;
+            ubxCkB = 0;
+            return;
+        case 8:  // CK_A
+            ubxState = (b == ubxCkA) ? 9 : 0;
+            return;
+        case 9:  // CK_B
+            ubxState = 0;
+            if (b == ubxCkB)
+            {
+                ackClass = ubxFrame[4];
+                ackId = ubxFrame[5];
+                ackStatus = (ubxFrame[1] == 0x01) ? GNSS_ACK_ACK : GNSS_ACK_NAK;
+            }
+            return;
+        default:  // Class, ID, length, 2-byte payload
+            ubxFrame[ubxState - 2] = b;
+            ubxCkA = (uint8_t)(ubxCkA + b);
+            ubxCkB = (uint8_t)(ubxCkB + ubxCkA);
+            ubxState++;
+
+            // Only ACK-NAK (0x05 0x00) and ACK-ACK (0x05 0x01) are wanted
+            if (ubxState == 6 && (ubxFrame[0] != 0x05 || ubxFrame[1] > 0x01 || ubxFrame[2] != 2 || ubxFrame[3] != 0))
+                ubxState = 0;
+            return;
+    }
 }
 
 // // Serial Version
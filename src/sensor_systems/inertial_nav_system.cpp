@@ -25,11 +25,34 @@
  * and applying calibration parameters.
  */
 InertialNavSystem::InertialNavSystem()
-: Gyro(3), GyroRaw(3), GyroTOBias(3),
-Accel(3), AccelRaw(3), AccelTOBias(3), 
-AccelMagSensor(&SENSOR_I2C), GyroSensor(&SENSOR_I2C)
+: Gyro(3), GyroTOBias(3), GyroBias(3),
+Accel(3), AccelTOBias(3), 
+GyroHealth(INS_REINIT_AFTER_FAILS, INS_REINIT_RETRY_US), 
+AccelHealth(INS_REINIT_AFTER_FAILS, INS_REINIT_RETRY_US), 
+AccelMagSensor(SensorI2CBus()), GyroSensor(SensorI2CBus())
 {
-    prevUpdateMicros = micros();
+    prevUpdateMicros = 0;
+    gyroMicros = 0;
+    accelMicros = 0;
+    for (uint8_t k = 0; k < 3; k++)
+    {
+        gyroCounts[k] = 0;
+        accelCounts[k] = 0;
+    }
+    accelCvt = INS_ACCEL_CVT_G;
+    accelCvtGrav = 1.0f;
+    gyroTempC = 25.0f;
+    isStill = false;
+    gyroTOBiasValid = false;
+    biasReady = false;
+    tiltInit = false;
+    accelLPFInit = false;
+    asyncI2C = nullptr;
+    gyroReadSubmitted = false;
+    gyroTempMicros = 0;
+    tbiasSaveMicros = 0;
+    stillSinceMicros = 0;
+    stillMeansInit = false;
 }
 
 
@@ -37,16 +60,18 @@ AccelMagSensor(&SENSOR_I2C), GyroSensor(&SENSOR_I2C)
 // Initialize()
 // ----------------------------------------------------------------------------
 /**
- * Initialize the INS. This function connects to the gyro and accelerometer, 
- * and measures gyro and accelerometer turn-on biases (used to initialize the 
- * EKF).
+ * Initialize the INS. This function connects to the gyro and accelerometer 
+ * and starts measuring the gyro and accelerometer turn-on biases (used to 
+ * initialize the EKF). It doesn't wait for them: BiasEstimator is fed by 
+ * Update(), and IsBiasReady() turns true once the vehicle has been still 
+ * long enough for the averages to converge. If the gyro bias table stored 
+ * on earlier boots has enough data at the current gyro temperature, the gyro 
+ * turn-on bias comes from it and only the accelerometer is measured.
  * 
  * @returns true if successfully init'd, false if not.
  */
 bool InertialNavSystem::Initialize()
 {
-    uint32_t initBiasTS = 20;  // Sample period for measuring init. IMU biases.
-
     #ifdef INS_DEBUG
     DEBUG_PRINTLN("INERTIALNAVSYSTEM::Initialize: Connecting to sensors.");
     #endif
@@ -70,50 +95,55 @@ bool InertialNavSystem::Initialize()
     }
 
 
-    /* Init accelerometer filters */
-    AxLPF.SetSmoothingFactor(INS_ACCEL_LPF_SF);
-    AyLPF.SetSmoothingFactor(INS_ACCEL_LPF_SF);
-    AzLPF.SetSmoothingFactor(INS_ACCEL_LPF_SF);
-
+    /* Data-ready interrupts, if wired. Otherwise the sensors are polled. */
+    GyroSensor.AttachDataReady(GYRO_DRDY_PIN);
+    AccelMagSensor.AttachDataReady(ACCELMAG_DRDY_PIN);
 
-    /* Compute initial gyro turn-on biases */
-    #ifdef INS_DEBUG
-    DEBUG_PRINTLN("INERTIALNAVSYSTEM::Initialize: Measuring gyro turn-on biases (rad/s)...");
-    #endif
 
-    if (!MeasureInitGyroBiases(initBiasTS))
+    /* Gyro reads go through the async engine, if it starts */
+    asyncI2C = SensorAsyncI2C();
+    if (!asyncI2C->Begin())
     {
         #ifdef INS_DEBUG
-        DEBUG_PRINTLN("INERTIALNAVSYSTEM::Initialize ERROR: Error computing gyro turn-on biases...");
+        DEBUG_PRINTLN("INERTIALNAVSYSTEM::Initialize: Async I2C unavailable, reading the gyro blocking.");
         #endif
-        return false;
+        asyncI2C = nullptr;
     }
+    gyroReadSubmitted = false;
 
-    #ifdef INS_DEBUG
-    DEBUG_PRINT("    BGX0: "); DEBUG_PRINTLNF(GyroTOBias.vec[0], 4);
-    DEBUG_PRINT("    BGY0: "); DEBUG_PRINTLNF(GyroTOBias.vec[1], 4);
-    DEBUG_PRINT("    BGZ0: "); DEBUG_PRINTLNF(GyroTOBias.vec[2], 4);
-    #endif
 
+    /* Init accelerometer filters */
+    AccelLPF.SetSmoothingFactor(INS_ACCEL_LPF_SF);
+    accelLPFInit = false;
+    Tilt.SetTimeConstant(INS_TILT_TAU);
+    tiltInit = false;
 
-    /* Compute initial accelerometer turn-on biases */
-    #ifdef INS_DEBUG
-    DEBUG_PRINTLN("INERTIALNAVSYSTEM::Initialize: Measuring accelerometer turn-on biases (g)...");
-    #endif
 
-    if (!MeasureInitAccelBiases(initBiasTS))
+    /* Gyro bias table learned on earlier boots */
+    GyroSensor.ReadTemperature(&gyroTempC);
+    gyroTempMicros = Micros64() + INS_GYRO_TEMP_PERIOD_US;
+    GyroBiasTable.Load(PlatformNVStorage(), NV_ADDR_GYRO_TEMP_BIAS);
+
+    if (GyroBiasTable.Confidence(gyroTempC) >= INS_TBIAS_SKIP_INIT_WEIGHT)
     {
+        GyroBiasTable.GetBias(gyroTempC, GyroTOBias.vec);
+        gyroTOBiasValid = true;
+
         #ifdef INS_DEBUG
-        DEBUG_PRINTLN("INERTIALNAVSYSTEM::Initialize ERROR: Error computing accelerometer turn-on biases.");
+        DEBUG_PRINTLN("INERTIALNAVSYSTEM::Initialize: Gyro turn-on biases (rad/s) from the stored bias table...");
+        DEBUG_PRINT("    BGX0: "); DEBUG_PRINTLNF(GyroTOBias.vec[0], 4);
+        DEBUG_PRINT("    BGY0: "); DEBUG_PRINTLNF(GyroTOBias.vec[1], 4);
+        DEBUG_PRINT("    BGZ0: "); DEBUG_PRINTLNF(GyroTOBias.vec[2], 4);
         #endif
-        return false;
     }
 
+
+    /* Measure the rest in the background, from Update() */
     #ifdef INS_DEBUG
-    DEBUG_PRINT("    BAX0: "); DEBUG_PRINTLNF(AccelTOBias.vec[0], 4);
-    DEBUG_PRINT("    BAY0: "); DEBUG_PRINTLNF(AccelTOBias.vec[1], 4);
-    DEBUG_PRINT("    BAZ0: "); DEBUG_PRINTLNF(AccelTOBias.vec[2], 4);
+    DEBUG_PRINTLN("INERTIALNAVSYSTEM::Initialize: Measuring turn-on biases, keep the vehicle still...");
     #endif
+    biasReady = false;
+    BiasEstimator.Start(!gyroTOBiasValid);
 
     return true;
 
@@ -125,88 +155,300 @@ bool InertialNavSystem::Initialize()
 // ----------------------------------------------------------------------------
 /**
  * Record accelerometer and gyro measurements, apply noise filters, and update 
- * accel. roll/pitch angles.
+ * accel. roll/pitch angles. Sensors with a data-ready pin are only read when 
+ * they have a new sample. The gyro is read through the async I2C engine 
+ * (SensorAsyncI2C()): the read is queued at the end of the blocking reads and 
+ * runs on the bus while the streams are processed, and its sample is 
+ * collected at the start of the next call. Every sample a driver reads 
+ * (including FIFO and async reads) is published to its stream (spsc_ring.h), 
+ * and the streams are drained here in batches of INS_STREAM_BATCH, oldest 
+ * first, so a late loop processes the samples it missed instead of only the 
+ * newest. Raw counts go 
+ * to calibrated SI units in one fused step each (INS_GYRO_CVT, accelCvt). The 
+ * gyro bias at the gyro's temperature is removed from each gyro sample 
+ * (GyroBiasTable), and learned into the table while the vehicle is still. 
+ * Until the turn-on biases are measured, each sample also goes to 
+ * BiasEstimator (see Initialize()).
  * 
- * @returns True if success, false if not.
+ * The bias table isn't saved from here; call SaveBiasTable() from a 
+ * low-priority task.
+ * 
+ * The outputs are published together to Outputs at the end, so readers that 
+ * may be interrupted by Update() (telemetry, logging, the controller) get a 
+ * consistent copy instead of reading Gyro/Accel field by field.
+ * 
+ * A failed read leaves that sensor's outputs and timestamp at its last good 
+ * sample (see GyroHealth/AccelHealth for the data age) and makes Update() 
+ * return false. After INS_REINIT_AFTER_FAILS failures in a row the sensor is 
+ * re-initialized, then again every INS_REINIT_RETRY_US until it's back. The 
+ * re-initialization doesn't block: it continues on later calls once the 
+ * sensor's datasheet waits are over, and Update() returns false meanwhile.
+ * 
+ * @returns True if success, false if a sensor read failed.
  */
 bool InertialNavSystem::Update()
 {
-    float gx, gy, gz;
-    float axRaw, ayRaw, azRaw;
-    float bax, bay, baz;
-    float g;
+    SensorSample_t batch[INS_STREAM_BATCH];
+    size_t n;
+    bool ok = true;
+
+    /* Finished async reads publish their samples to the streams */
+    if (asyncI2C != nullptr)
+        asyncI2C->Poll();
     
-    /* Read gyro sensor */
-    if (!GyroSensor.ReadSensor())
+    /* Collect the gyro read queued on the last call, or continue bringing the gyro back */
+    if (GyroHealth.IsReinitPending())
+    {
+        if (GyroHealth.ReinitDue())
+            ReinitGyro(false);
+        ok = false;
+    }
+    else if (gyroReadSubmitted && !GyroSensor.IsReadPending())
+    {
+        gyroReadSubmitted = false;
+        if (!GyroReadDone(GyroSensor.ReadStatus() == I2C_TXN_DONE))
+            ok = false;
+    }
+
+
+    /* Read accelerometer sensor, or continue bringing it back */
+    if (AccelHealth.IsReinitPending())
+    {
+        if (AccelHealth.ReinitDue())
+            ReinitAccel(false);
+        ok = false;
+    }
+    else if (AccelMagSensor.DataReady())
+    {
+        if (AccelMagSensor.ReadSensor())
+        {
+            AccelHealth.ReadOk(AccelMagSensor.prevMeasMicros);
+        }
+        else
+        {
+            #ifdef INS_DEBUG
+            DEBUG_PRINTLN("INERTIALNAVSYSTEM::Update ERROR: Could not read accelerometer sensor.");
+            #endif
+            if (AccelHealth.ReadFailed())
+                ReinitAccel(true);
+            ok = false;
+        }
+    }
+
+
+    /* Gyro die temperature for this batch's bias compensation */
+    if (!GyroHealth.IsReinitPending())
+        UpdateGyroTemp();
+
+    /* Read the gyro: queue it to run on the bus in the background, or block */
+    if (!GyroHealth.IsReinitPending() && !gyroReadSubmitted && GyroSensor.DataReady())
+    {
+        if (asyncI2C != nullptr)
+            gyroReadSubmitted = GyroSensor.SubmitRead(asyncI2C);
+        else if (!GyroReadDone(GyroSensor.ReadSensor()))
+            ok = false;
+    }
+
+    /* Drain the streams. Accel. first, so stillness detection sees it. */
+    while ((n = AccelMagSensor.stream.PopBatch(batch, INS_STREAM_BATCH)) > 0)
+    {
+        for (size_t i = 0; i < n; i++)
+            ProcessAccelSample(batch[i]);
+    }
+
+    while ((n = GyroSensor.stream.PopBatch(batch, INS_STREAM_BATCH)) > 0)
+    {
+        for (size_t i = 0; i < n; i++)
+            ProcessGyroSample(batch[i]);
+    }
+
+    /* Turn-on biases, once measured */
+    if (!biasReady && BiasEstimator.IsDone())
+        SetTurnOnBiases();
+
+    prevUpdateMicros = Micros64();
+
+    /* Update accelerometer tilt angles */
+    UpdateAccelAngles();
+
+    PublishOutputs();
+
+    return ok;
+}
+
+
+/**
+ * Samples the gyro and accelerometer streams refused because Update() 
+ * didn't drain them in time. Should stay 0.
+ * 
+ * @returns Number of refused samples, both sensors.
+ */
+uint32_t InertialNavSystem::GetStreamOverruns()
+{
+    return GyroSensor.stream.Overruns() + AccelMagSensor.stream.Overruns();
+}
+
+
+/**
+ * Return true once the turn-on biases (GyroTOBias, AccelTOBias) are 
+ * measured. Until then, the vehicle should be kept still and the EKF not 
+ * started.
+ */
+bool InertialNavSystem::IsBiasReady()
+{
+    return biasReady;
+}
+
+
+/**
+ * Save the gyro bias table to NV storage, at most every 
+ * INS_TBIAS_SAVE_PERIOD_US and once it has learned INS_TBIAS_SAVE_MIN_LEARNED 
+ * new samples. A save rewrites up to the whole table in EEPROM, which is 
+ * slow, so call this from a low-priority periodic task, not from the sensor 
+ * loop.
+ * 
+ * @returns True if the table was saved.
+ */
+bool InertialNavSystem::SaveBiasTable()
+{
+    uint64_t now = Micros64();
+
+    if (GyroBiasTable.learnedSinceSave < INS_TBIAS_SAVE_MIN_LEARNED || 
+        (tbiasSaveMicros != 0 && now - tbiasSaveMicros < INS_TBIAS_SAVE_PERIOD_US))
+        return false;
+
+    #ifdef INS_DEBUG
+    DEBUG_PRINTLN("INERTIALNAVSYSTEM::SaveBiasTable: Saving gyro bias table.");
+    #endif
+    tbiasSaveMicros = now;
+    return GyroBiasTable.Save(PlatformNVStorage(), NV_ADDR_GYRO_TEMP_BIAS);
+}
+
+
+/**
+ * Record the result of a gyro read in GyroHealth, and start re-initializing 
+ * the gyro after INS_REINIT_AFTER_FAILS failures in a row.
+ * 
+ * @param readOk  True if the read succeeded.
+ * @returns readOk
+ */
+bool InertialNavSystem::GyroReadDone(bool readOk)
+{
+    if (readOk)
+    {
+        GyroHealth.ReadOk(GyroSensor.prevMeasMicros);
+        return true;
+    }
+
+    #ifdef INS_DEBUG
+    DEBUG_PRINTLN("INERTIALNAVSYSTEM::Update ERROR: Could not read gyro sensor.");
+    #endif
+    if (GyroHealth.ReadFailed())
+        ReinitGyro(true);
+    return false;
+}
+
+
+/**
+ * Bring the gyro back after a dropout: configure it again (it may have reset 
+ * to its power-on defaults) and re-route its data-ready interrupt. Each call 
+ * runs one step of the driver's configuration and hands its datasheet wait 
+ * (reset boot, standby-to-active) to GyroHealth, so Update() continues it 
+ * once that's over instead of blocking through it.
+ * 
+ * @param start  True to start over (check the ID), false to continue.
+ */
+void InertialNavSystem::ReinitGyro(bool start)
+{
+    RegConfigStatus_t status;
+    uint32_t waitMicros;
+
+    if (start)
     {
         #ifdef INS_DEBUG
-        DEBUG_PRINTLN("INERTIALNAVSYSTEM::Update ERROR: Could not read gyro sensor.");
+        DEBUG_PRINTLN("INERTIALNAVSYSTEM::ReinitGyro: Re-initializing FXAS21002 gyro.");
         #endif
-        // return false;
+
+        if (!GyroSensor.BeginInitialize(INS_GYRO_RANGE))
+        {
+            GyroHealth.ReinitDone(false);
+            return;
+        }
     }
-    
-    gx = GyroSensor.GetGx();
-    gy = GyroSensor.GetGy();
-    gz = GyroSensor.GetGz();
-    GyroRaw.vec[0] = gx;  // In [deg/s]
-    GyroRaw.vec[1] = gy;
-    GyroRaw.vec[2] = gz;
-
-    // Convert to radians
-    // TODO: apply filter?
-    gx *= DEG2RAD;
-    gy *= DEG2RAD;
-    gz *= DEG2RAD;
-    Gyro.vec[0] = gx;
-    Gyro.vec[1] = gy;
-    Gyro.vec[2] = gz;
-
-
-    /* Read accelerometer sensor */
-    if (!AccelMagSensor.ReadSensor())
+
+    status = GyroSensor.StepInitialize(&waitMicros);
+    if (status == REG_CONFIG_BUSY)
+    {
+        GyroHealth.ReinitWait(waitMicros);
+        return;
+    }
+
+    if (status == REG_CONFIG_DONE)
+        GyroSensor.AttachDataReady(GYRO_DRDY_PIN);
+    GyroHealth.ReinitDone(status == REG_CONFIG_DONE);
+}
+
+
+/**
+ * Bring the accelerometer back after a dropout. See ReinitGyro().
+ * 
+ * @param start  True to start over (check the ID), false to continue.
+ */
+void InertialNavSystem::ReinitAccel(bool start)
+{
+    RegConfigStatus_t status;
+    uint32_t waitMicros;
+
+    if (start)
     {
         #ifdef INS_DEBUG
-        DEBUG_PRINTLN("INERTIALNAVSYSTEM::Update ERROR: Could not read accelerometer sensor.");
+        DEBUG_PRINTLN("INERTIALNAVSYSTEM::ReinitAccel: Re-initializing FXOS8700 accelerometer.");
         #endif
-        // return false;
+
+        if (!AccelMagSensor.BeginInitialize(INS_ACCEL_RANGE))
+        {
+            AccelHealth.ReinitDone(false);
+            return;
+        }
     }
 
-    /* Retrieve and log raw accel. values */
-    axRaw = AccelMagSensor.GetAx();
-    ayRaw = AccelMagSensor.GetAy();
-    azRaw = AccelMagSensor.GetAz();
-    AccelRaw.vec[0] = axRaw;  // In G's
-    AccelRaw.vec[1] = ayRaw;
-    AccelRaw.vec[2] = azRaw;
-
-    /* Apply calibration (in g's)*/
-    bax = axRaw - SENSCALIB_ACCEL_BX;
-    bay = ayRaw - SENSCALIB_ACCEL_BY;
-    baz = azRaw - SENSCALIB_ACCEL_BZ;
-    Accel.vec[0] = (SENSCALIB_ACCEL_S11 * bax) + (SENSCALIB_ACCEL_S12 * bay) + (SENSCALIB_ACCEL_S13 * baz);
-    Accel.vec[1] = (SENSCALIB_ACCEL_S12 * bax) + (SENSCALIB_ACCEL_S22 * bay) + (SENSCALIB_ACCEL_S23 * baz);
-    Accel.vec[2] = (SENSCALIB_ACCEL_S13 * bax) + (SENSCALIB_ACCEL_S23 * bay) + (SENSCALIB_ACCEL_S33 * baz);
-
-    /* Convert from g's to m/s/s */
-    g = GravComputer.GetGravity();
-    Accel.vec[0] *= g;
-    Accel.vec[1] *= g;
-    Accel.vec[2] *= g;
+    status = AccelMagSensor.StepInitialize(&waitMicros);
+    if (status == REG_CONFIG_BUSY)
+    {
+        AccelHealth.ReinitWait(waitMicros);
+        return;
+    }
 
-    /* Apply filter */
-    Accel.vec[0] = AxLPF.Filter(Accel.vec[0]);
-    Accel.vec[1] = AyLPF.Filter(Accel.vec[1]);
-    Accel.vec[2] = AzLPF.Filter(Accel.vec[2]);
+    if (status == REG_CONFIG_DONE)
+        AccelMagSensor.AttachDataReady(ACCELMAG_DRDY_PIN);
+    AccelHealth.ReinitDone(status == REG_CONFIG_DONE);
+}
 
-    prevUpdateMicros = micros();
 
-    /* Update accelerometer tilt angles */
-    UpdateAccelAngles();
 
-    return true;
+/**
+ * Latest gyro sample in [deg/s], sensitivity only (no calibration or bias). 
+ * Converted here from its raw counts, not per sample.
+ * 
+ * @param gyroRaw   [deg/s] Output, [gx, gy, gz]
+ */
+void InertialNavSystem::GetGyroRaw(float gyroRaw[3])
+{
+    ApplyCountsToSI(INS_GYRO_CVT_RAW, gyroCounts, gyroRaw);
 }
 
 
+/**
+ * Latest accelerometer sample in [g's], sensitivity only (no calibration, 
+ * unfiltered). Converted here from its raw counts, not per sample.
+ * 
+ * @param accelRaw  [g's] Output, [ax, ay, az]
+ */
+void InertialNavSystem::GetAccelRaw(float accelRaw[3])
+{
+    ApplyCountsToSI(INS_ACCEL_CVT_RAW, accelCounts, accelRaw);
+}
+
 
 /* Return the accelerometer NED pitch (phi) angle in [rad] */
 float InertialNavSystem::GetAccelPitch()
@@ -221,6 +463,31 @@ float InertialNavSystem::GetAccelRoll()
 }
 
 
+// ----------------------------------------------------------------------------
+// GetVertAccel()
+// ----------------------------------------------------------------------------
+/**
+ * Vertical acceleration with gravity removed, up is positive: the 
+ * accelerometer measurement, less its turn-on bias, projected onto the 
+ * gyro-propagated "up" direction (Tilt) minus g. At rest, the accelerometer 
+ * reads g along "up", so this is 0 at any tilt. Horizontal acceleration 
+ * shorter than INS_TILT_TAU doesn't leak in; sustained horizontal 
+ * acceleration slowly tilts the estimate. Feed this to 
+ * BaroAltimeter::SetVertAccel().
+ * 
+ * @returns [m/s/s] Vertical acceleration, up is positive
+ */
+float InertialNavSystem::GetVertAccel()
+{
+    float a[3];
+
+    a[0] = Accel.vec[0] - AccelTOBias.vec[0];
+    a[1] = Accel.vec[1] - AccelTOBias.vec[1];
+    a[2] = Accel.vec[2] - AccelTOBias.vec[2];
+    return Tilt.VerticalAccel(a, GravComputer.GetGravity());
+}
+
+
 // ------------------------------------
 // Private methods
 // ------------------------------------
@@ -245,132 +512,270 @@ void InertialNavSystem::UpdateAccelAngles()
 }
 
 
+/* Copy the outputs into one INSOutput_t and publish it to Outputs */
+void InertialNavSystem::PublishOutputs()
+{
+    INSOutput_t out;
+
+    for (uint8_t k = 0; k < 3; k++)
+    {
+        out.gyro[k] = Gyro.vec[k];
+        out.gyroBias[k] = GyroBias.vec[k];
+        out.accel[k] = Accel.vec[k];
+    }
+    out.roll = roll;
+    out.pitch = pitch;
+    out.gyroTempC = gyroTempC;
+    out.gyroMicros = gyroMicros;
+    out.accelMicros = accelMicros;
+    out.isStill = isStill;
+    out.biasReady = biasReady;
+
+    Outputs.Write(out);
+}
+
+
+// ----------------------------------------------------------------------------
+// ProcessGyroSample(const SensorSample_t &sample)
+// ----------------------------------------------------------------------------
+/**
+ * Convert one gyro sample from its stream to [rad/s] and remove its bias.
+ * 
+ * @param sample  Raw gyro sample and its timestamp.
+ */
+void InertialNavSystem::ProcessGyroSample(const SensorSample_t &sample)
+{
+    float gyroMeas[3];
+
+    float dt = (float)(sample.micros - gyroMicros) * 1.0e-6f;  // [s] Since the previous sample
+
+    gyroMicros = sample.micros;
+    gyroCounts[0] = sample.raw[0];  // For GetGyroRaw()
+    gyroCounts[1] = sample.raw[1];
+    gyroCounts[2] = sample.raw[2];
+
+    // Counts to [rad/s], then the temperature-compensated bias
+    ApplyCountsToSI(INS_GYRO_CVT, sample.raw, gyroMeas);
+    UpdateGyroBias(gyroMeas, sample.micros);
+
+    BiasEstimator.AddGyro(gyroMeas, sample.micros);
+
+    /* Tilt, propagated with the bias-compensated rate */
+    if (tiltInit && dt > 0.0f && dt <= INS_TILT_MAX_DT)
+        Tilt.Propagate(Gyro.vec, dt);
+}
+
+
 // ----------------------------------------------------------------------------
-// InertialNavSystem::MeasureInitGyroBiases(uint32_t samplePeriod)
+// ProcessAccelSample(const SensorSample_t &sample)
 // ----------------------------------------------------------------------------
 /**
- * Measure initial gyro turn-on biases.
+ * Convert one accelerometer sample from its stream to calibrated [m/s/s] and 
+ * filter it.
  * 
- * @param samplePeriod  [ms] Sample period/delay between samples. Use this to 
- * set sample rate for recording turn-on biases.
- * @returns True if successful, false if not
+ * @param sample  Raw accel. sample and its timestamp.
  */
-bool InertialNavSystem::MeasureInitGyroBiases(uint32_t samplePeriod)
+void InertialNavSystem::ProcessAccelSample(const SensorSample_t &sample)
 {
-    float x = 0.0f;
-    float y = 0.0f;
-    float z = 0.0f;
-    uint32_t n = 0;  // number of measurements
-    uint32_t prev;  // previous measurement millis()
-    uint32_t start;  // starting millis()
-
-    uint32_t now = millis();
-    prev = now;
-    start = now;
-    while (now - start <= INS_BIAS_INIT_TIME)
+    float dt = (float)(sample.micros - accelMicros) * 1.0e-6f;  // [s] Since the previous sample
+    float accelMeas[3];
+    float a[3];
+    float g;
+
+    accelMicros = sample.micros;
+    accelCounts[0] = sample.raw[0];  // For GetAccelRaw()
+    accelCounts[1] = sample.raw[1];
+    accelCounts[2] = sample.raw[2];
+
+    /* Counts to calibrated [m/s/s]. Rescale only when local gravity changes. */
+    g = GravComputer.GetGravity();
+    if (g != accelCvtGrav)
     {
-        now = millis();
-        if (now - prev >= samplePeriod)  // Take a measurement
-        {
-            if (!Update())  // Take IMU measurements
-            {
-                #ifdef INS_DEBUG
-                DEBUG_PRINTLN("INERTIALNAVSYSTEM::ComputeInitGyroBiases ERROR: Could not read sensors.");
-                #endif
-                return false;
-            }
-            x += Gyro.vec[0];  // Increase average counter
-            y += Gyro.vec[1];  // [rad]
-            z += Gyro.vec[2];
-            n++;  // number of measurements
-
-            prev = now;  // update measurement timers
-        }
+        accelCvt = ScaleCountsToSI(INS_ACCEL_CVT_G, g);
+        accelCvtGrav = g;
     }
+    ApplyCountsToSI(accelCvt, sample.raw, accelMeas);
 
-    // Compute averages
-    GyroTOBias.vec[0] = x / (float)n;
-    GyroTOBias.vec[1] = y / (float)n;
-    GyroTOBias.vec[2] = z / (float)n;
+    // Unfiltered: LPF output is autocorrelated, which would understate the 
+    // standard error of the mean
+    BiasEstimator.AddAccel(accelMeas, sample.micros);
 
-    return true;
+    /* Apply filter, starting from the first sample rather than 0 */
+    if (!accelLPFInit)
+    {
+        AccelLPF.Reset(accelMeas[0], accelMeas[1], accelMeas[2]);
+        accelLPFInit = true;
+    }
+    AccelLPF.Filter(accelMeas, Accel.vec);
+
+    /* Correct the tilt's gyro drift toward the bias-compensated accel. */
+    a[0] = Accel.vec[0] - AccelTOBias.vec[0];
+    a[1] = Accel.vec[1] - AccelTOBias.vec[1];
+    a[2] = Accel.vec[2] - AccelTOBias.vec[2];
+    if (!tiltInit)
+    {
+        Tilt.Reset(a);
+        tiltInit = true;
+    }
+    else if (dt > 0.0f && dt <= INS_TILT_MAX_DT)
+        Tilt.Correct(a, dt);
 }
 
 
 // ----------------------------------------------------------------------------
-// InertialNavSystem::MeasureInitAccelBiases(uint32_t samplePeriod)
+// UpdateGyroBias(const float gyroMeas[3], uint64_t micros)
 // ----------------------------------------------------------------------------
 /**
- * Measure initial accelerometer turn-on bias.
+ * Remove the temperature-compensated bias (at gyroTempC, see 
+ * UpdateGyroTemp()) from a new gyro sample, and learn the sample into the 
+ * bias table if the vehicle is still. Samples are only learned once the 
+ * turn-on bias is set: while it's being measured, SetTurnOnBiases() learns 
+ * those samples as one mean. No bus or NV storage access, so it can run for 
+ * every sample in a batch.
  * 
- * @param samplePeriod  [ms] Sample period/delay between samples. Use this to 
- * set sample rate for recording turn-on biases.
- * @returns True if successful, false if not
+ * @param gyroMeas  [rad/s] New gyro sample, calibrated, bias not removed.
+ * @param micros    [us] Micros64() when the sample was taken.
  */
-bool InertialNavSystem::MeasureInitAccelBiases(uint32_t samplePeriod)
+void InertialNavSystem::UpdateGyroBias(const float gyroMeas[3], uint64_t micros)
 {
-    float g;
-    float x = 0.0f;
-    float y = 0.0f;
-    float z = 0.0f;
-    float sroll, croll;
-    float spitch, cpitch;
-    float axNED, ayNED, azNED;
-    uint32_t n = 0;  // number of measurements
-    uint32_t prev;  // previous measurement millis()
-    uint32_t start;  // starting millis()
-
-    uint32_t now = millis();
-    prev = now;
-    start = now;
-    while (now - start <= INS_BIAS_INIT_TIME)
+    // Turn-on bias until the table has data
+    if (!GyroBiasTable.GetBias(gyroTempC, GyroBias.vec))
+    {
+        GyroBias.vec[0] = GyroTOBias.vec[0];
+        GyroBias.vec[1] = GyroTOBias.vec[1];
+        GyroBias.vec[2] = GyroTOBias.vec[2];
+    }
+
+    Gyro.vec[0] = gyroMeas[0] - GyroBias.vec[0];
+    Gyro.vec[1] = gyroMeas[1] - GyroBias.vec[1];
+    Gyro.vec[2] = gyroMeas[2] - GyroBias.vec[2];
+
+    if (UpdateStillness(gyroMeas, micros) && gyroTOBiasValid)
+        GyroBiasTable.Learn(gyroTempC, gyroMeas);
+}
+
+
+/**
+ * Read the gyro die temperature for the bias compensation, once per 
+ * Update() and, since it changes slowly, only every INS_GYRO_TEMP_PERIOD_US 
+ * (a blocking register read).
+ */
+void InertialNavSystem::UpdateGyroTemp()
+{
+    uint64_t now = Micros64();
+
+    if (now >= gyroTempMicros)
     {
-        now = millis();
-        if (now - prev >= samplePeriod)  // Take a measurement
+        GyroSensor.ReadTemperature(&gyroTempC);
+        gyroTempMicros = now + INS_GYRO_TEMP_PERIOD_US;
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// UpdateStillness(const float gyroMeas[3], uint64_t micros)
+// ----------------------------------------------------------------------------
+/**
+ * Stationary detection. The vehicle is moving if any gyro or accel. axis 
+ * strays from its recent mean (an EMA), or, once the turn-on bias is set, if 
+ * the compensated rate (Gyro) isn't near zero. It's still once nothing has 
+ * moved for INS_STILL_TIME_US of sample time, so a batch drained at once is 
+ * timed by when its samples were taken. Before the turn-on bias a slow, 
+ * steady turn looks still, so the bias table isn't learned until then (see 
+ * UpdateGyroBias()).
+ * 
+ * @param gyroMeas  [rad/s] New gyro sample, bias not removed.
+ * @param micros    [us] Micros64() when the sample was taken.
+ * @returns True if the vehicle is still (isStill).
+ */
+bool InertialNavSystem::UpdateStillness(const float gyroMeas[3], uint64_t micros)
+{
+    bool moving = false;
+
+    if (!stillMeansInit)
+    {
+        for (uint8_t k = 0; k < 3; k++)
         {
-            if (!Update())  // Take IMU measurements
-            {
-                #ifdef INS_DEBUG
-                DEBUG_PRINTLN("INERTIALNAVSYSTEM::ComputeInitGyroBiases ERROR: Could not read sensors.");
-                #endif
-                return false;
-            }
-            x += Accel.vec[0];  // Increase average counter
-            y += Accel.vec[1];  // [m/s/s]
-            z += Accel.vec[2];
-            n++;  // number of measurements
-
-            prev = now;  // update measurement timers
+            gyroMean[k] = gyroMeas[k];
+            accelMean[k] = Accel.vec[k];
         }
+        stillMeansInit = true;
+        stillSinceMicros = micros;
+        isStill = false;
+        return false;
     }
 
-    // Compute averages
-    x /= (float)n;
-    y /= (float)n;
-    z /= (float)n;
+    for (uint8_t k = 0; k < 3; k++)
+    {
+        gyroMean[k] += INS_STILL_MEAN_SF * (gyroMeas[k] - gyroMean[k]);
+        accelMean[k] += INS_STILL_MEAN_SF * (Accel.vec[k] - accelMean[k]);
 
-    // Compute gravity vector in body frame from accel measurements
-    // Gravity in the NED frame is [0, 0, g]
-    g = GravComputer.GetGravity();
-    pitch = asinf_safe(x / sqrtf((x * x) + (y * y) + (z * z)));
-    roll = atan2f(y, z);
+        if (fabsf(gyroMeas[k] - gyroMean[k]) > INS_STILL_GYRO_DEV || 
+            fabsf(Accel.vec[k] - accelMean[k]) > INS_STILL_ACCEL_DEV || 
+            (gyroTOBiasValid && fabsf(Gyro.vec[k]) > INS_STILL_GYRO_RATE))
+            moving = true;
+    }
 
-    sroll = sinf(roll);
-    croll = cosf(roll);
-    spitch = sinf(pitch);
-    cpitch = cosf(pitch);
+    if (moving || micros < stillSinceMicros)
+        stillSinceMicros = micros;
 
-    // Ref: https://youtu.be/p7tjtLkIlFo?t=244
-    axNED = -g * spitch;
-    ayNED = g * cpitch * sroll;
-    azNED = g * cpitch * croll;
+    isStill = (micros - stillSinceMicros) >= INS_STILL_TIME_US;
+    return isStill;
+}
 
-    // true = meas - bias  =>  bias = meas - true
-    AccelTOBias.vec[0] = x - axNED;
-    AccelTOBias.vec[1] = y - ayNED;
-    AccelTOBias.vec[2] = z - azNED;
 
-    return true;
+// ----------------------------------------------------------------------------
+// SetTurnOnBiases()
+// ----------------------------------------------------------------------------
+/**
+ * Set the turn-on biases from BiasEstimator's means once it's done. The 
+ * gyro bias (unless it came from the stored table) is learned into the 
+ * gyro bias table at the current temperature, weighted by its sample count 
+ * (UpdateGyroBias() doesn't learn them one by one until now). 
+ * The accel. bias is the mean less g along the mean's own direction, and 
+ * the tilt filter is aligned with the mean.
+ */
+void InertialNavSystem::SetTurnOnBiases()
+{
+    const float *a = BiasEstimator.accel.mean;
+    float g;
+    float n;
+
+    if (BiasEstimator.measureGyro)
+    {
+        GyroTOBias.vec[0] = BiasEstimator.gyro.mean[0];
+        GyroTOBias.vec[1] = BiasEstimator.gyro.mean[1];
+        GyroTOBias.vec[2] = BiasEstimator.gyro.mean[2];
+        gyroTOBiasValid = true;
+
+        GyroBiasTable.Learn(gyroTempC, GyroTOBias.vec, (float)BiasEstimator.gyro.n);
+    }
+
+    // At rest the accel. reads g along "up", and "up" is all the still mean 
+    // tells us, so only the bias along it (scale/gravity error) is observable
+    g = GravComputer.GetGravity();
+    n = sqrtf((a[0] * a[0]) + (a[1] * a[1]) + (a[2] * a[2]));
+    if (n > 0.0f)
+    {
+        // true = meas - bias  =>  bias = meas - g * meas / |meas|
+        AccelTOBias.vec[0] = a[0] - (g * a[0] / n);
+        AccelTOBias.vec[1] = a[1] - (g * a[1] / n);
+        AccelTOBias.vec[2] = a[2] - (g * a[2] / n);
+    }
+    Tilt.Reset(a);
+    tiltInit = true;
+
+    biasReady = true;
+
+    #ifdef INS_DEBUG
+    DEBUG_PRINTLN("INERTIALNAVSYSTEM::SetTurnOnBiases: Turn-on biases measured.");
+    DEBUG_PRINT("    BGX0: "); DEBUG_PRINTLNF(GyroTOBias.vec[0], 4);
+    DEBUG_PRINT("    BGY0: "); DEBUG_PRINTLNF(GyroTOBias.vec[1], 4);
+    DEBUG_PRINT("    BGZ0: "); DEBUG_PRINTLNF(GyroTOBias.vec[2], 4);
+    DEBUG_PRINT("    BAX0: "); DEBUG_PRINTLNF(AccelTOBias.vec[0], 4);
+    DEBUG_PRINT("    BAY0: "); DEBUG_PRINTLNF(AccelTOBias.vec[1], 4);
+    DEBUG_PRINT("    BAZ0: "); DEBUG_PRINTLNF(AccelTOBias.vec[2], 4);
+    #endif
 }
 
 
@@ -19,7 +19,7 @@
 void test_fxas21002_init_250dps(void)
 {
     bool status;
-    FXAS21002Gyro gyro(&SENSOR_I2C);
+    FXAS21002Gyro gyro(SensorI2CBus());
 
     // sensor initialization should return true
     status = gyro.Initialize(GYRO_RNG_250DPS);
@@ -31,7 +31,7 @@ void test_fxas21002_init_250dps(void)
 void test_fxas21002_init_500dps(void)
 {
     bool status;
-    FXAS21002Gyro gyro(&SENSOR_I2C);
+    FXAS21002Gyro gyro(SensorI2CBus());
 
     // sensor initialization should return true
     status = gyro.Initialize(GYRO_RNG_500DPS);
@@ -43,7 +43,7 @@ void test_fxas21002_init_500dps(void)
 void test_fxas21002_init_1000dps(void)
 {
     bool status;
-    FXAS21002Gyro gyro(&SENSOR_I2C);
+    FXAS21002Gyro gyro(SensorI2CBus());
 
     // sensor initialization should return true
     status = gyro.Initialize(GYRO_RNG_1000DPS);
@@ -55,7 +55,7 @@ void test_fxas21002_init_1000dps(void)
 void test_fxas21002_init_2000dps(void)
 {
     bool status;
-    FXAS21002Gyro gyro(&SENSOR_I2C);
+    FXAS21002Gyro gyro(SensorI2CBus());
 
     // sensor initialization should return true
     status = gyro.Initialize(GYRO_RNG_2000DPS);
@@ -69,29 +69,28 @@ void test_fxas21002_self_test(void)
     int16_t lowerBound = 7000;  // Min LSB in self-test mode
     int16_t upperBound = 25000;  // Max LSB in self-test mode
 
+    I2CBus *bus = SensorI2CBus();
+    uint8_t buf[7];
+
     // put sensor into self-test mode
-    SENSOR_I2C.begin();
+    bus->Begin();
     // reg0 -> p.39
     // reg1 -> p.45
-    FXAS21002_I2Cwrite8(&SENSOR_I2C, GYRO_REG_CTRL1, 0x00);  // Put into standby mode
-    FXAS21002_I2Cwrite8(&SENSOR_I2C, GYRO_REG_CTRL1, (1 << 6));  // Reset
-    FXAS21002_I2Cwrite8(&SENSOR_I2C, GYRO_REG_CTRL0, 0x00);  // CTRL_REG0[FS] = 00 (2000dps)
-    FXAS21002_I2Cwrite8(&SENSOR_I2C, GYRO_REG_CTRL1, 0x22);  // Enable self-test. 800Hz DR. Active.
+    FXAS21002_I2Cwrite8(bus, GYRO_REG_CTRL1, 0x00);  // Put into standby mode
+    FXAS21002_I2Cwrite8(bus, GYRO_REG_CTRL1, (1 << 6));  // Reset
+    FXAS21002_I2Cwrite8(bus, GYRO_REG_CTRL0, 0x00);  // CTRL_REG0[FS] = 00 (2000dps)
+    FXAS21002_I2Cwrite8(bus, GYRO_REG_CTRL1, 0x22);  // Enable self-test. 800Hz DR. Active.
     delay(100);
     
-    // Read 7 bytes from sensor
-    SENSOR_I2C.beginTransmission((uint8_t)FXAS21002C_ADDRESS);
-    SENSOR_I2C.write(GYRO_REG_STATUS | 0x80);
-    SENSOR_I2C.endTransmission();
-    SENSOR_I2C.requestFrom((uint8_t)FXAS21002C_ADDRESS, (uint8_t)7);
-
-    uint8_t status = SENSOR_I2C.read();
-    uint8_t xhi = SENSOR_I2C.read();
-    uint8_t xlo = SENSOR_I2C.read();
-    uint8_t yhi = SENSOR_I2C.read();
-    uint8_t ylo = SENSOR_I2C.read();
-    uint8_t zhi = SENSOR_I2C.read();
-    uint8_t zlo = SENSOR_I2C.read();
+    // Read 7 bytes from sensor: status, then X/Y/Z MSB/LSB
+    TEST_ASSERT_TRUE_MESSAGE(bus->ReadRegs(FXAS21002C_ADDRESS, GYRO_REG_STATUS, buf, 7), "[ERROR]: Self-test read failed");
+
+    uint8_t xhi = buf[1];
+    uint8_t xlo = buf[2];
+    uint8_t yhi = buf[3];
+    uint8_t ylo = buf[4];
+    uint8_t zhi = buf[5];
+    uint8_t zlo = buf[6];
 
     // Shift values to make proper integer
     int16_t gxRaw = (int16_t)((xhi << 8) | xlo);
@@ -120,31 +119,19 @@ void test_fxas21002_self_test(void)
 
 
 
-void FXAS21002_I2Cwrite8(TwoWire *sensorWire, uint8_t regOfInterest, uint8_t valToWrite)
+void FXAS21002_I2Cwrite8(I2CBus *bus, uint8_t regOfInterest, uint8_t valToWrite)
 {
-    // Init. communication
-    sensorWire->beginTransmission(FXAS21002C_ADDRESS);
-    sensorWire->write((uint8_t)regOfInterest);
-    sensorWire->write((uint8_t)valToWrite);
-    sensorWire->endTransmission();
+    bus->WriteReg8(FXAS21002C_ADDRESS, regOfInterest, valToWrite);
 }
 
 
-uint8_t FXAS21002_I2Cread8(TwoWire *sensorWire, uint8_t regOfInterest)
+uint8_t FXAS21002_I2Cread8(I2CBus *bus, uint8_t regOfInterest)
 {
     uint8_t val;
 
-    // Init. communication
-    sensorWire->beginTransmission((uint8_t)FXAS21002C_ADDRESS);
-    sensorWire->write((uint8_t)regOfInterest);
-
     // Check for failure
-    if (sensorWire->endTransmission(false) != 0)
+    if (!bus->ReadReg8(FXAS21002C_ADDRESS, regOfInterest, &val))
         return 0;
-    
-    // Read register
-    sensorWire->requestFrom((uint8_t)FXAS21002C_ADDRESS, (uint8_t)1);
-    val = sensorWire->read();
 
     return val;
 }
@@ -13,10 +13,10 @@
 #pragma once
 
 #include <unity.h>
-#include <Wire.h>
 #include <math.h>
 #include <Arduino.h>
 #include "hummingbird_config.h"
+#include "hal/i2c_bus.h"
 #include "sensor_drivers/fxas21002_gyro.h"
 
 void test_fxas21002_init_250dps(void);
@@ -26,7 +26,7 @@ void test_fxas21002_init_2000dps(void);
 void test_fxas21002_self_test(void);
 
 
-void FXAS21002_I2Cwrite8(TwoWire *sensorWire, uint8_t regOfInterest, uint8_t valToWrite);
-uint8_t FXAS21002_I2Cread8(TwoWire *sensorWire, uint8_t regOfInterest);
+void FXAS21002_I2Cwrite8(I2CBus *bus, uint8_t regOfInterest, uint8_t valToWrite);
+uint8_t FXAS21002_I2Cread8(I2CBus *bus, uint8_t regOfInterest);
 
 #endif  // UNIT_TEST
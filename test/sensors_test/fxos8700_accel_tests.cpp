@@ -22,7 +22,7 @@ void test_fxos8700_init_2g(void)
 {
     bool status;
 
-    FXOS8700AccelMag accel(&SENSOR_I2C);
+    FXOS8700AccelMag accel(SensorI2CBus());
 
     status = accel.Initialize(ACCEL_RNG_2G);
     TEST_ASSERT_TRUE(status);
@@ -34,7 +34,7 @@ void test_fxos8700_init_4g(void)
 {
     bool status;
 
-    FXOS8700AccelMag accel(&SENSOR_I2C);
+    FXOS8700AccelMag accel(SensorI2CBus());
 
     status = accel.Initialize(ACCEL_RNG_4G);
     TEST_ASSERT_TRUE(status);
@@ -46,7 +46,7 @@ void test_fxos8700_init_8g(void)
 {
     bool status;
 
-    FXOS8700AccelMag accel(&SENSOR_I2C);
+    FXOS8700AccelMag accel(SensorI2CBus());
 
     status = accel.Initialize(ACCEL_RNG_8G);
     TEST_ASSERT_TRUE(status);
@@ -60,32 +60,31 @@ void test_fxos8700_self_test(void)
     int16_t ayThres = 270;  // [LSB] ay self-test output range
     int16_t azThres = 1275;  // [LSB] az self-test output range
 
+    I2CBus *bus = SensorI2CBus();
+    uint8_t buf[7];
+
     // set to standby mode to make config. changes
-    SENSOR_I2C.begin();
-    FXOS8700_I2Cwrite8(&SENSOR_I2C, ACCELMAG_REG_CTRL1, 0x00);
+    bus->Begin();
+    FXOS8700_I2Cwrite8(bus, ACCELMAG_REG_CTRL1, 0x00);
 
     // Put into +/- 2G measurement mode
-    FXOS8700_I2Cwrite8(&SENSOR_I2C, ACCELMAG_REG_XYZ_CFG, 0x00);
+    FXOS8700_I2Cwrite8(bus, ACCELMAG_REG_XYZ_CFG, 0x00);
 
     // Put into self-test mode
-    FXOS8700_I2Cwrite8(&SENSOR_I2C, ACCELMAG_REG_CTRL2, 0x80);  // Self-test enabled. Reset disabled. Sleep mode OSR mode = normal. Wake mode OSR mode = normal.
+    FXOS8700_I2Cwrite8(bus, ACCELMAG_REG_CTRL2, 0x80);  // Self-test enabled. Reset disabled. Sleep mode OSR mode = normal. Wake mode OSR mode = normal.
 
     // Sleep mode ODR = 50Hz. Sensor ODR = 400Hz single sensor = 200Hz hybrid mode. Full-scale range mode = low-noise mode. Fast read mode = normal. Active mode.
-    FXOS8700_I2Cwrite8(&SENSOR_I2C, ACCELMAG_REG_CTRL1, 0x0D);
-
-    // Read data
-    SENSOR_I2C.beginTransmission((uint8_t)FXOS8700_ADDRESS);
-    SENSOR_I2C.write(ACCELMAG_REG_STATUS | 0x80);
-    SENSOR_I2C.endTransmission();
-    SENSOR_I2C.requestFrom((uint8_t)FXOS8700_ADDRESS, (uint8_t)7);
-
-    uint8_t status = SENSOR_I2C.read();
-    uint8_t axhi = SENSOR_I2C.read();
-    uint8_t axlo = SENSOR_I2C.read();
-    uint8_t ayhi = SENSOR_I2C.read();
-    uint8_t aylo = SENSOR_I2C.read();
-    uint8_t azhi = SENSOR_I2C.read();
-    uint8_t azlo = SENSOR_I2C.read();
+    FXOS8700_I2Cwrite8(bus, ACCELMAG_REG_CTRL1, 0x0D);
+
+    // Read data: status, then X/Y/Z MSB/LSB
+    TEST_ASSERT_TRUE_MESSAGE(bus->ReadRegs(FXOS8700_ADDRESS, ACCELMAG_REG_STATUS, buf, 7), "[ERROR]: Self-test read failed.");
+
+    uint8_t axhi = buf[1];
+    uint8_t axlo = buf[2];
+    uint8_t ayhi = buf[3];
+    uint8_t aylo = buf[4];
+    uint8_t azhi = buf[5];
+    uint8_t azlo = buf[6];
 
     int16_t axRaw = (int16_t)((axhi << 8) | axlo) >> 2;
     int16_t ayRaw = (int16_t)((ayhi << 8) | aylo) >> 2;
@@ -103,30 +102,18 @@ void test_fxos8700_self_test(void)
 
 
 
-void FXOS8700_I2Cwrite8(TwoWire *sensorWire, uint8_t regOfInterest, uint8_t valToWrite)
+void FXOS8700_I2Cwrite8(I2CBus *bus, uint8_t regOfInterest, uint8_t valToWrite)
 {
-    // Init. communication
-    sensorWire->beginTransmission(FXOS8700_ADDRESS);
-    sensorWire->write((uint8_t)regOfInterest);
-    sensorWire->write((uint8_t)valToWrite);
-    sensorWire->endTransmission();
+    bus->WriteReg8(FXOS8700_ADDRESS, regOfInterest, valToWrite);
 }
 
 
-uint8_t FXOS8700_I2Cread8(TwoWire *sensorWire, uint8_t regOfInterest)
+uint8_t FXOS8700_I2Cread8(I2CBus *bus, uint8_t regOfInterest)
 {
     uint8_t val;
 
-    // Init. communication
-    sensorWire->beginTransmission((uint8_t)FXOS8700_ADDRESS);
-    sensorWire->write((uint8_t)regOfInterest);
-
     // Check for failure
-    if (sensorWire->endTransmission(false) != 0) return 0;
-    
-    // Read register
-    sensorWire->requestFrom((uint8_t)FXOS8700_ADDRESS, (uint8_t)1);
-    val = sensorWire->read();
+    if (!bus->ReadReg8(FXOS8700_ADDRESS, regOfInterest, &val)) return 0;
 
     return val;
 }
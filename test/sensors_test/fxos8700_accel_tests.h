@@ -15,9 +15,9 @@
 #pragma once
 #include <unity.h>
 #include <Arduino.h>
-#include <Wire.h>
 #include <math.h>
 #include "hummingbird_config.h"
+#include "hal/i2c_bus.h"
 #include "sensor_drivers/fxos8700_accelmag.h"
 
 
@@ -26,8 +26,8 @@ void test_fxos8700_init_4g(void);
 void test_fxos8700_init_8g(void);
 void test_fxos8700_self_test(void);
 
-void FXOS8700_I2Cwrite8(TwoWire *sensorWire, uint8_t regOfInterest, uint8_t valToWrite);
-uint8_t FXOS8700_I2Cread8(TwoWire *sensorWire, uint8_t regOfInterest);
+void FXOS8700_I2Cwrite8(I2CBus *bus, uint8_t regOfInterest, uint8_t valToWrite);
+uint8_t FXOS8700_I2Cread8(I2CBus *bus, uint8_t regOfInterest);
 
 
 
@@ -0,0 +1,181 @@
+// ----------------------------------------------------------------------------
+// FILTER THROUGHPUT TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * These time every filter class and fail if one takes longer per sample than
+ * its budget.
+ */
+
+
+#ifdef UNIT_TEST
+#include "filter_perf_tests.h"
+#include <stdio.h>
+#include "filters/low_pass_filter.h"
+#include "filters/median_filter.h"
+#include "filters/fixed_median_filter.h"
+#include "filters/hampel_filter.h"
+#include "filters/notch_filter.h"
+#include "filters/biquad_filter.h"
+#include "filters/savgol_filter.h"
+#include "filters/fir_decimator.h"
+#include "filters/filter_chain.h"
+#include "filters/vec3_filter.h"
+
+
+/* Gives LowPassFilter::Filter(x, dt) the Filter(x) signature, with a
+   jittering dt so the smoothing factor gets recomputed */
+class LPFDtAdapter
+{
+public:
+    LowPassFilter lpf;
+    float Filter(float x)
+    {
+        _n++;
+        return lpf.Filter(x, (_n & 1) ? 0.0009f : 0.0011f);
+    }
+private:
+    uint32_t _n = 0;
+};
+
+
+/* Gives FIRDecimator3 the Filter(x) signature, one input sample per call */
+class FIRDecimatorAdapter
+{
+public:
+    FIRDecimator3<32, 4> decim;
+    float Filter(float x)
+    {
+        float ox, oy, oz;
+        if (decim.Process(&x, &x, &x, 1, &ox, &oy, &oz) > 0)
+            _last = ox + oy + oz;
+        return _last;
+    }
+private:
+    float _last = 0.0f;
+};
+
+
+/* Gives a Vec3 filter the Filter(x) signature, all three axes per call */
+template <typename V>
+class Vec3Adapter
+{
+public:
+    V filt;
+    float Filter(float x)
+    {
+        float in[3] = {x, -x, 0.5f * x};
+        float out[3];
+        filt.Filter(in, out);
+        return out[0] + out[1] + out[2];
+    }
+};
+
+
+/* Time a filter and compare against its budget */
+template <typename F>
+static void CheckPerf(F &filt, float budgetNs, const char *name)
+{
+    char msg[96];
+    float ns;
+
+    filt.Filter(0.0f);  // Warm up
+    ns = MeasureNsPerSample(filt, FILTER_PERF_N);
+    snprintf(msg, sizeof(msg), "%s: %.1f ns/sample (budget %.0f)", name, (double)ns, (double)budgetNs);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE_MESSAGE(ns <= budgetNs, msg);
+}
+
+
+void test_perf_lpf(void)
+{
+    LowPassFilter lpf;
+    lpf.SetSmoothingFactor(DesignEMAAlpha(1000.0f, 10.0f));
+    CheckPerf(lpf, FILTER_PERF_NS_LPF, "LowPassFilter");
+}
+
+
+void test_perf_lpf_dt(void)
+{
+    LPFDtAdapter lpf;
+    lpf.lpf.SetCutoffFrequency(10.0f, 0.001f);
+    CheckPerf(lpf, FILTER_PERF_NS_LPF_DT, "LowPassFilter (dt)");
+}
+
+
+void test_perf_biquad(void)
+{
+    BiquadFilter bq(DesignButterworthLPF(1000.0f, 50.0f));
+    CheckPerf(bq, FILTER_PERF_NS_BIQUAD, "BiquadFilter");
+}
+
+
+void test_perf_notch(void)
+{
+    NotchFilter notch;
+    notch.SetNotch(100.0f, 1000.0f, 2.0f);
+    CheckPerf(notch, FILTER_PERF_NS_NOTCH, "NotchFilter");
+}
+
+
+void test_perf_median(void)
+{
+    MedianFilter med(7, 0.0f);
+    CheckPerf(med, FILTER_PERF_NS_MEDIAN7, "MedianFilter(7)");
+}
+
+
+void test_perf_fixed_median(void)
+{
+    FixedMedianFilter<7> med;
+    CheckPerf(med, FILTER_PERF_NS_FIXEDMEDIAN7, "FixedMedianFilter<7>");
+}
+
+
+void test_perf_hampel(void)
+{
+    HampelFilter<7> hampel;
+    CheckPerf(hampel, FILTER_PERF_NS_HAMPEL7, "HampelFilter<7>");
+}
+
+
+void test_perf_savgol(void)
+{
+    SavGolFilter<11> sg;
+    sg.Configure(2, 1);
+    CheckPerf(sg, FILTER_PERF_NS_SAVGOL11, "SavGolFilter<11>");
+}
+
+
+void test_perf_filter_chain(void)
+{
+    FilterChain<HampelFilter<7>, LowPassFilter> chain;
+    chain.Stage<1>().SetSmoothingFactor(0.1f);
+    CheckPerf(chain, FILTER_PERF_NS_CHAIN, "FilterChain<Hampel<7>, LPF>");
+}
+
+
+void test_perf_fir_decimator(void)
+{
+    FIRDecimatorAdapter decim;
+    CheckPerf(decim, FILTER_PERF_NS_FIRDECIM, "FIRDecimator3<32, 4>");
+}
+
+
+void test_perf_vec3_lpf(void)
+{
+    Vec3Adapter<Vec3LowPassFilter> lpf;
+    lpf.filt.SetSmoothingFactor(0.1f);
+    CheckPerf(lpf, FILTER_PERF_NS_VEC3LPF, "Vec3LowPassFilter");
+}
+
+
+void test_perf_vec3_median(void)
+{
+    Vec3Adapter<Vec3MedianFilter<7>> med;
+    CheckPerf(med, FILTER_PERF_NS_VEC3MEDIAN7, "Vec3MedianFilter<7>");
+}
+
+#endif
@@ -0,0 +1,52 @@
+// ----------------------------------------------------------------------------
+// FILTER THROUGHPUT TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * These time every filter class and fail if one takes longer per sample than
+ * its budget. The budgets are set for the Teensy 4.1 (600MHz Cortex-M7) with
+ * plenty of margin, so a failure means something got a lot slower (a heap
+ * allocation, a libm call, a copy) and not just noise. A PC is faster, so the
+ * same budgets work on the native host.
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <unity.h>
+#include "filter_test_utils.h"
+
+/* [ns] Time budgets per sample */
+constexpr float FILTER_PERF_NS_LPF          = 100.0f;
+constexpr float FILTER_PERF_NS_LPF_DT       = 150.0f;
+constexpr float FILTER_PERF_NS_BIQUAD       = 150.0f;
+constexpr float FILTER_PERF_NS_NOTCH        = 150.0f;
+constexpr float FILTER_PERF_NS_MEDIAN7      = 800.0f;
+constexpr float FILTER_PERF_NS_FIXEDMEDIAN7 = 800.0f;
+constexpr float FILTER_PERF_NS_HAMPEL7      = 2000.0f;
+constexpr float FILTER_PERF_NS_SAVGOL11     = 300.0f;
+constexpr float FILTER_PERF_NS_CHAIN        = 2200.0f;  // Hampel<7> + LPF
+constexpr float FILTER_PERF_NS_FIRDECIM     = 400.0f;  // 32 taps, M = 4, 3 axes, per input sample
+constexpr float FILTER_PERF_NS_VEC3LPF      = 150.0f;  // All 3 axes
+constexpr float FILTER_PERF_NS_VEC3MEDIAN7  = 2400.0f;  // All 3 axes
+
+/* Number of samples to time each filter over */
+constexpr size_t FILTER_PERF_N = 20000;
+
+void test_perf_lpf(void);
+void test_perf_lpf_dt(void);
+void test_perf_biquad(void);
+void test_perf_notch(void);
+void test_perf_median(void);
+void test_perf_fixed_median(void);
+void test_perf_hampel(void);
+void test_perf_savgol(void);
+void test_perf_filter_chain(void);
+void test_perf_fir_decimator(void);
+void test_perf_vec3_lpf(void);
+void test_perf_vec3_median(void);
+
+#endif
@@ -0,0 +1,457 @@
+// ----------------------------------------------------------------------------
+// FILTER FREQUENCY/STEP/NOISE RESPONSE TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * These drive the filter classes with sines, steps, spikes, and white noise,
+ * and check the measured gain, phase, group delay, and noise reduction
+ * against the design targets.
+ */
+
+
+#ifdef UNIT_TEST
+#include "filter_response_tests.h"
+
+
+/* Common test setup */
+constexpr float TEST_FS = 1000.0f;  // [Hz] Sample rate
+constexpr float TEST_LPF_FC = 10.0f;  // [Hz] Low pass cutoff
+constexpr float TEST_LPF_ALPHA = DesignEMAAlpha(TEST_FS, TEST_LPF_FC);
+constexpr BiquadCoefs_t TEST_BUTTER = DesignButterworthLPF(TEST_FS, 50.0f);
+constexpr BiquadCoefs_t TEST_NOTCH = DesignNotch(TEST_FS, 100.0f, 2.0f);
+static_assert(EMAAlphaIsValid(TEST_LPF_ALPHA), "Bad test LPF");
+static_assert(BiquadIsStable(TEST_BUTTER), "Bad test Butterworth");
+static_assert(BiquadIsStable(TEST_NOTCH), "Bad test notch");
+
+constexpr float TEST_GAIN_TOL = 0.002f;  // Measured vs. exact gain
+constexpr float TEST_PHASE_TOL = 0.01f;  // [rad] Measured vs. exact phase
+
+
+/* Swept sine: LowPassFilter matches its exact transfer function */
+void test_lpf_freq_response(void)
+{
+    const float freqs[] = {2.0f, 10.0f, 50.0f, 100.0f, 250.0f};
+
+    for (size_t i = 0; i < sizeof(freqs) / sizeof(freqs[0]); i++)
+    {
+        LowPassFilter lpf;
+        lpf.SetSmoothingFactor(TEST_LPF_ALPHA);
+        FreqResponse_t meas = MeasureResponse(lpf, TEST_FS, freqs[i]);
+        FreqResponse_t exact = EMAResponse(TEST_LPF_ALPHA, TEST_FS, freqs[i]);
+
+        TEST_ASSERT_FLOAT_WITHIN(TEST_GAIN_TOL, exact.gain, meas.gain);
+        TEST_ASSERT_FLOAT_WITHIN(TEST_PHASE_TOL, 0.0f, WrapPhase(meas.phase - exact.phase));
+    }
+}
+
+
+/* LowPassFilter is -3dB at its design cutoff (fc << fs) */
+void test_lpf_cutoff(void)
+{
+    LowPassFilter lpf;
+    lpf.SetCutoffFrequency(TEST_LPF_FC, 1.0f / TEST_FS, TEST_LPF_ALPHA);
+    FreqResponse_t meas = MeasureResponse(lpf, TEST_FS, TEST_LPF_FC);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.70711f, meas.gain);
+}
+
+
+/* Group delay of the LPF at low frequency, -dphase/dw = (1 - a) / a samples */
+void test_lpf_group_delay(void)
+{
+    const float f1 = 1.0f;
+    const float f2 = 2.0f;
+    LowPassFilter lpf1, lpf2;
+    FreqResponse_t r1, r2;
+    float delay;
+
+    lpf1.SetSmoothingFactor(TEST_LPF_ALPHA);
+    lpf2.SetSmoothingFactor(TEST_LPF_ALPHA);
+    r1 = MeasureResponse(lpf1, TEST_FS, f1);
+    r2 = MeasureResponse(lpf2, TEST_FS, f2);
+    delay = -WrapPhase(r2.phase - r1.phase) / (CONSTS_2PI * (f2 - f1) / TEST_FS);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.05f * delay, (1.0f - TEST_LPF_ALPHA) / TEST_LPF_ALPHA, delay);
+}
+
+
+/* Step: LPF output after n samples is 1 - (1 - a)^n */
+void test_lpf_step(void)
+{
+    LowPassFilter lpf;
+    float y = 0.0f;
+
+    lpf.SetSmoothingFactor(TEST_LPF_ALPHA);
+    lpf.Filter(0.0f);
+    for (int n = 1; n <= 50; n++)
+    {
+        y = lpf.Filter(1.0f);
+        TEST_ASSERT_FLOAT_WITHIN(1.0e-4f, 1.0f - powf(1.0f - TEST_LPF_ALPHA, (float)n), y);
+    }
+}
+
+
+/* White noise: LPF output variance is a / (2 - a) of the input variance */
+void test_lpf_white_noise(void)
+{
+    const size_t n = 200000;
+    LowPassFilter lpf;
+    float varIn = 0.0f;
+    float varOut = 0.0f;
+
+    lpf.SetSmoothingFactor(TEST_LPF_ALPHA);
+    FilterTestSeedNoise(1234);
+    for (size_t i = 0; i < n; i++)
+    {
+        float x = FilterTestNoise();
+        float y = lpf.Filter(x);
+        varIn += x * x;
+        varOut += y * y;
+    }
+
+    TEST_ASSERT_FLOAT_WITHIN(0.05f * TEST_LPF_ALPHA / (2.0f - TEST_LPF_ALPHA),
+        TEST_LPF_ALPHA / (2.0f - TEST_LPF_ALPHA), varOut / varIn);
+}
+
+
+/* Swept sine: Butterworth biquad matches its design, -3dB at fc */
+void test_butterworth_freq_response(void)
+{
+    const float freqs[] = {10.0f, 50.0f, 100.0f, 250.0f};
+
+    for (size_t i = 0; i < sizeof(freqs) / sizeof(freqs[0]); i++)
+    {
+        BiquadFilter bq(TEST_BUTTER);
+        FreqResponse_t meas = MeasureResponse(bq, TEST_FS, freqs[i]);
+        FreqResponse_t exact = BiquadResponse(TEST_BUTTER, TEST_FS, freqs[i]);
+
+        TEST_ASSERT_FLOAT_WITHIN(TEST_GAIN_TOL, exact.gain, meas.gain);
+        TEST_ASSERT_FLOAT_WITHIN(TEST_PHASE_TOL, 0.0f, WrapPhase(meas.phase - exact.phase));
+    }
+
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 0.70711f, BiquadResponse(TEST_BUTTER, TEST_FS, 50.0f).gain);
+    TEST_ASSERT_TRUE(BiquadResponse(TEST_BUTTER, TEST_FS, 250.0f).gain < 0.05f);
+}
+
+
+/* Swept sine: notch rejects its center frequency and passes the rest */
+void test_notch_freq_response(void)
+{
+    NotchFilter runtime, designed;
+    FreqResponse_t meas;
+
+    runtime.SetNotch(100.0f, TEST_FS, 2.0f);
+    designed.SetNotch(TEST_NOTCH);
+
+    meas = MeasureResponse(runtime, TEST_FS, 100.0f);
+    TEST_ASSERT_TRUE(meas.gain < 0.01f);  // < -40dB
+    meas = MeasureResponse(designed, TEST_FS, 100.0f);
+    TEST_ASSERT_TRUE(meas.gain < 0.01f);
+
+    meas = MeasureResponse(designed, TEST_FS, 10.0f);
+    TEST_ASSERT_TRUE(meas.gain > 0.97f);
+    meas = MeasureResponse(designed, TEST_FS, 250.0f);
+    TEST_ASSERT_FLOAT_WITHIN(TEST_GAIN_TOL, BiquadResponse(TEST_NOTCH, TEST_FS, 250.0f).gain, meas.gain);
+}
+
+
+/* Median of 5: a single spike is removed, a step shows up after 3 samples */
+void test_median_filter_spike_and_step(void)
+{
+    MedianFilter med(5, 0.0f);
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, med.Filter(100.0f));  // Spike
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, med.Filter(0.0f));
+    med.Fill(0.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, med.Filter(1.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, med.Filter(1.0f));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, med.Filter(1.0f));
+}
+
+
+/* Same as above, for the fixed-size median filter */
+void test_fixed_median_filter_spike_and_step(void)
+{
+    FixedMedianFilter<5> med(0.0f);
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, med.Filter(100.0f));  // Spike
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, med.Filter(0.0f));
+    med.Fill(0.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, med.Filter(1.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, med.Filter(1.0f));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, med.Filter(1.0f));
+}
+
+
+/* Hampel: noisy data passes untouched, a spike is replaced and counted */
+void test_hampel_filter_spike(void)
+{
+    HampelFilter<7> hampel(3.0f, 0.0f);
+    float x;
+
+    // A 7-point MAD is a rough estimate, so a few percent of clean points
+    // get gated. The ones that pass must be untouched.
+    FilterTestSeedNoise(42);
+    for (int i = 0; i < 1000; i++)
+    {
+        uint32_t before = hampel.GetRejectCount();
+        x = 0.1f * FilterTestNoise();
+        if (hampel.Filter(x) != x)
+            TEST_ASSERT_EQUAL_UINT32(before + 1, hampel.GetRejectCount());
+    }
+    TEST_ASSERT_TRUE(hampel.GetRejectCount() < 100);
+
+    uint32_t before = hampel.GetRejectCount();
+    x = hampel.Filter(10.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, x);
+    TEST_ASSERT_EQUAL_UINT32(before + 1, hampel.GetRejectCount());
+}
+
+
+/* Rate limiter: a step is turned into a ramp */
+void test_rate_limit_filter_step(void)
+{
+    RateLimitFilter lim;
+
+    lim.SetMaxStep(0.25f);
+    lim.Filter(0.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, lim.Filter(1.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.50f, lim.Filter(1.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.75f, lim.Filter(1.0f));
+    TEST_ASSERT_EQUAL_FLOAT(1.00f, lim.Filter(1.0f));
+}
+
+
+/* Savitzky-Golay: no lag on polynomial inputs up to the fit order */
+void test_savgol_zero_lag(void)
+{
+    SavGolFilter<11> smooth;
+    SavGolFilter<11> deriv;
+    const float dt = 0.02f;
+    float t = 0.0f;
+
+    smooth.Configure(2, 0);
+    deriv.Configure(2, 1);
+    smooth.Fill(3.0f);
+    deriv.Fill(3.0f);
+    for (int n = 0; n < 40; n++)
+    {
+        t = (float)n * dt;
+        float x = 3.0f + (2.0f * t) + (0.5f * t * t);
+        float y = smooth.Filter(x);
+        float v = deriv.Filter(x, dt);
+        if (n >= 11)
+        {
+            TEST_ASSERT_FLOAT_WITHIN(1.0e-3f, x, y);
+            TEST_ASSERT_FLOAT_WITHIN(1.0e-2f, 2.0f + t, v);
+        }
+    }
+}
+
+
+/* FIR decimator 800Hz -> 200Hz: passband gain, linear phase, alias rejection */
+void test_fir_decimator_response(void)
+{
+    const size_t M = 4;
+    const size_t NTAPS = 32;
+    const float fsIn = 800.0f;
+    const float fPass = 10.0f;
+    const float fAlias = 350.0f;  // Would alias to 50Hz
+    const size_t nIn = 8000;
+    FIRDecimator3<NTAPS, M> decimPass;
+    FIRDecimator3<NTAPS, M> decimAlias;
+    float in[M], inAlias[M];
+    float out[2], outAlias[2];
+    float sumSin = 0.0f, sumCos = 0.0f, sumSqAlias = 0.0f;
+    size_t nOut = 0;
+    float gain, phase;
+
+    for (size_t n = 0; n < nIn; n += M)
+    {
+        for (size_t k = 0; k < M; k++)
+        {
+            in[k] = sinf(CONSTS_2PI * fPass * (float)(n + k) / fsIn);
+            inAlias[k] = sinf(CONSTS_2PI * fAlias * (float)(n + k) / fsIn);
+        }
+        decimPass.Process(in, in, in, M, out, out, out);
+        decimAlias.Process(inAlias, inAlias, inAlias, M, outAlias, outAlias, outAlias);
+
+        if (n >= 400)  // Settled
+        {
+            // Output belongs to the newest input sample of the batch
+            float ph = CONSTS_2PI * fPass * (float)(n + M - 1) / fsIn;
+            sumSin += out[0] * sinf(ph);
+            sumCos += out[0] * cosf(ph);
+            sumSqAlias += outAlias[0] * outAlias[0];
+            nOut++;
+        }
+    }
+
+    gain = 2.0f * sqrtf((sumSin * sumSin) + (sumCos * sumCos)) / (float)nOut;
+    phase = atan2f(sumCos, sumSin);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 1.0f, gain);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -CONSTS_2PI * fPass * decimPass.GetGroupDelay() / fsIn, phase);
+    TEST_ASSERT_TRUE(sqrtf(2.0f * sumSqAlias / (float)nOut) < 1.0e-3f);  // < -60dB
+}
+
+
+/* Altitude Kalman filter finds a steady climb rate from noisy baro altitude */
+void test_alt_kalman_climb(void)
+{
+    AltKalmanFilter kf;
+    const float dt = 0.02f;
+    const float climb = 2.0f;  // [m/s]
+    float alt = 100.0f;
+
+    FilterTestSeedNoise(7);
+    kf.Reset(alt);
+    for (int n = 0; n < 1500; n++)  // 30s
+    {
+        alt += climb * dt;
+        kf.Predict(dt);
+        kf.Correct(alt + (0.5f * FilterTestNoise()));
+    }
+
+    TEST_ASSERT_FLOAT_WITHIN(0.3f, climb, kf.GetVertSpeed());
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, alt, kf.GetAltitude());
+}
+
+
+/* Vector filters give the same output as one scalar filter per axis */
+void test_vec3_filters_match_scalar(void)
+{
+    Vec3LowPassFilter vlpf;
+    Vec3MedianFilter<5> vmed;
+    Vec3Filter<NotchFilter> vnotch;
+    LowPassFilter lpf[3];
+    FixedMedianFilter<5> med[3];
+    NotchFilter notch[3];
+    float in[3], outLPF[3], outMed[3], outNotch[3];
+
+    vlpf.SetSmoothingFactor(TEST_LPF_ALPHA);
+    for (size_t i = 0; i < 3; i++)
+    {
+        lpf[i].SetSmoothingFactor(TEST_LPF_ALPHA);
+        notch[i].SetNotch(TEST_NOTCH);
+        vnotch.axis[i].SetNotch(TEST_NOTCH);
+    }
+
+    FilterTestSeedNoise(99);
+    for (int n = 0; n < 500; n++)
+    {
+        for (size_t i = 0; i < 3; i++)
+            in[i] = FilterTestNoise() + (float)i;
+
+        vlpf.Filter(in, outLPF);
+        vmed.Filter(in, outMed);
+        vnotch.Filter(in, outNotch);
+        for (size_t i = 0; i < 3; i++)
+        {
+            TEST_ASSERT_FLOAT_WITHIN(1.0e-5f, lpf[i].Filter(in[i]), outLPF[i]);
+            TEST_ASSERT_EQUAL_FLOAT(med[i].Filter(in[i]), outMed[i]);
+            TEST_ASSERT_EQUAL_FLOAT(notch[i].Filter(in[i]), outNotch[i]);
+        }
+    }
+}
+
+
+/* Tilt filter: a tilted, stationary accelerometer has no vertical acceleration */
+void test_tilt_filter_stationary_tilted(void)
+{
+    const float g = 9.80665f;
+    const float tilts[] = {0.0f, 10.0f, 30.0f, 60.0f};  // [deg] Pitch
+    const float gyro[3] = {0.0f, 0.0f, 0.0f};
+    float a[3];
+
+    for (size_t i = 0; i < sizeof(tilts) / sizeof(tilts[0]); i++)
+    {
+        TiltFilter tilt;
+        float th = tilts[i] * (float)M_PI / 180.0f;
+
+        // Pitched nose up: gravity reaction tilts from +z toward -x
+        a[0] = -g * sinf(th);
+        a[1] = 0.0f;
+        a[2] = g * cosf(th);
+
+        tilt.SetTimeConstant(2.0f);
+        tilt.Reset(a);
+        for (int n = 0; n < 200; n++)  // 1s at 200Hz
+        {
+            tilt.Propagate(gyro, 0.005f);
+            tilt.Correct(a, 0.005f);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(1.0e-4f, 0.0f, tilt.VerticalAccel(a, g));
+
+        // Starting level, the accel. correction pulls it onto the tilt
+        tilt.up[0] = 0.0f;
+        tilt.up[1] = 0.0f;
+        tilt.up[2] = 1.0f;
+        for (int n = 0; n < 4000; n++)  // 20s = 10 tau
+            tilt.Correct(a, 0.005f);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, tilt.VerticalAccel(a, g));
+    }
+}
+
+
+/* Tilt filter: a rotation is followed by the gyro, not the accel. correction */
+void test_tilt_filter_follows_gyro(void)
+{
+    const float g = 9.80665f;
+    const float dt = 0.001f;
+    const float rate = 0.5f;  // [rad/s] About body +y
+    const float gyro[3] = {0.0f, rate, 0.0f};
+    const float level[3] = {0.0f, 0.0f, g};
+    float a[3];
+    float th = 0.0f;
+
+    TiltFilter tilt;
+    tilt.SetTimeConstant(1000.0f);  // Gyro only
+    tilt.Reset(level);
+    for (int n = 0; n < 1000; n++)  // 1s, 0.5rad nose up
+    {
+        tilt.Propagate(gyro, dt);
+        th += rate * dt;
+    }
+
+    // Body pitched up by th: "up" leans toward -x
+    a[0] = -g * sinf(th);
+    a[1] = 0.0f;
+    a[2] = g * cosf(th);
+    TEST_ASSERT_FLOAT_WITHIN(1.0e-3f, a[0] / g, tilt.up[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1.0e-3f, a[2] / g, tilt.up[2]);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, tilt.VerticalAccel(a, g));
+}
+
+
+/* Tilt filter: a short horizontal acceleration barely leaks into the vertical */
+void test_tilt_filter_horizontal_accel(void)
+{
+    const float g = 9.80665f;
+    const float dt = 0.005f;
+    const float gyro[3] = {0.0f, 0.0f, 0.0f};
+    const float level[3] = {0.0f, 0.0f, g};
+    const float push[3] = {3.0f, 0.0f, g};  // 3m/s/s forward for 0.2s
+    float maxVert = 0.0f;
+    float v;
+
+    TiltFilter tilt;
+    tilt.SetTimeConstant(2.0f);
+    tilt.Reset(level);
+    for (int n = 0; n < 40; n++)
+    {
+        tilt.Propagate(gyro, dt);
+        tilt.Correct(push, dt);
+        v = fabsf(tilt.VerticalAccel(push, g));
+        if (v > maxVert)
+            maxVert = v;
+    }
+
+    // Tilt from the same vector would read |a| - g (0.45m/s/s) throughout
+    v = sqrtf((push[0] * push[0]) + (push[2] * push[2])) - g;
+    TEST_ASSERT_TRUE(maxVert < 0.25f * v);
+}
+
+#endif
@@ -0,0 +1,52 @@
+// ----------------------------------------------------------------------------
+// FILTER FREQUENCY/STEP/NOISE RESPONSE TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * These drive the filter classes with sines, steps, spikes, and white noise,
+ * and check the measured gain, phase, group delay, and noise reduction
+ * against the design targets.
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <unity.h>
+#include <math.h>
+#include "filter_test_utils.h"
+#include "filters/low_pass_filter.h"
+#include "filters/median_filter.h"
+#include "filters/fixed_median_filter.h"
+#include "filters/hampel_filter.h"
+#include "filters/notch_filter.h"
+#include "filters/biquad_filter.h"
+#include "filters/rate_limit_filter.h"
+#include "filters/savgol_filter.h"
+#include "filters/fir_decimator.h"
+#include "filters/alt_kalman_filter.h"
+#include "filters/vec3_filter.h"
+#include "filters/tilt_filter.h"
+
+void test_lpf_freq_response(void);
+void test_lpf_cutoff(void);
+void test_lpf_group_delay(void);
+void test_lpf_step(void);
+void test_lpf_white_noise(void);
+void test_butterworth_freq_response(void);
+void test_notch_freq_response(void);
+void test_median_filter_spike_and_step(void);
+void test_fixed_median_filter_spike_and_step(void);
+void test_hampel_filter_spike(void);
+void test_rate_limit_filter_step(void);
+void test_savgol_zero_lag(void);
+void test_fir_decimator_response(void);
+void test_alt_kalman_climb(void);
+void test_vec3_filters_match_scalar(void);
+void test_tilt_filter_stationary_tilted(void);
+void test_tilt_filter_follows_gyro(void);
+void test_tilt_filter_horizontal_accel(void);
+
+#endif
@@ -0,0 +1,98 @@
+// ----------------------------------------------------------------------------
+// FILTER TEST HARNESS UTILITIES
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Signal generators and measurement helpers used by the filter tests.
+ */
+
+
+#ifdef UNIT_TEST
+#include "filter_test_utils.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+
+static uint32_t noiseState = 1;  // Noise generator state
+
+
+/* Microsecond timer for throughput tests */
+uint32_t FilterTestMicros()
+{
+    #ifdef ARDUINO
+    return micros();
+    #else
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    #endif
+}
+
+
+/* Restart the noise sequence so every test sees the same noise */
+void FilterTestSeedNoise(uint32_t seed)
+{
+    noiseState = (seed == 0) ? 1 : seed;
+}
+
+
+/* Zero-mean white noise, uniform in [-1, 1) (variance 1/3). xorshift32. */
+float FilterTestNoise()
+{
+    noiseState ^= noiseState << 13;
+    noiseState ^= noiseState >> 17;
+    noiseState ^= noiseState << 5;
+    return ((float)(noiseState >> 8) * (2.0f / 16777216.0f)) - 1.0f;
+}
+
+
+/* Wrap a phase to [-pi, pi] */
+float WrapPhase(float phase)
+{
+    while (phase > CONSTS_PI)
+        phase -= CONSTS_2PI;
+    while (phase < -CONSTS_PI)
+        phase += CONSTS_2PI;
+    return phase;
+}
+
+
+// ----------------------------------------------------------------------------
+// BiquadResponse(const BiquadCoefs_t &c, float fsHz, float fHz)
+// ----------------------------------------------------------------------------
+/**
+ * Exact frequency response of a biquad, H(e^jw).
+ *
+ * @param c     Biquad coefficients
+ * @param fsHz  [Hz] Sample rate
+ * @param fHz   [Hz] Frequency
+ * @return      Gain and phase
+ */
+FreqResponse_t BiquadResponse(const BiquadCoefs_t &c, float fsHz, float fHz)
+{
+    float w = CONSTS_2PI * fHz / fsHz;
+    float numRe = c.b0 + (c.b1 * cosf(w)) + (c.b2 * cosf(2.0f * w));
+    float numIm = -(c.b1 * sinf(w)) - (c.b2 * sinf(2.0f * w));
+    float denRe = 1.0f + (c.a1 * cosf(w)) + (c.a2 * cosf(2.0f * w));
+    float denIm = -(c.a1 * sinf(w)) - (c.a2 * sinf(2.0f * w));
+    FreqResponse_t resp;
+
+    resp.gain = sqrtf(((numRe * numRe) + (numIm * numIm)) / ((denRe * denRe) + (denIm * denIm)));
+    resp.phase = WrapPhase(atan2f(numIm, numRe) - atan2f(denIm, denRe));
+    return resp;
+}
+
+
+/* Exact frequency response of LowPassFilter, y = a*x + (1 - a)*y[-1] */
+FreqResponse_t EMAResponse(float alpha, float fsHz, float fHz)
+{
+    BiquadCoefs_t c = {alpha, 0.0f, 0.0f, alpha - 1.0f, 0.0f};
+    return BiquadResponse(c, fsHz, fHz);
+}
+
+#endif
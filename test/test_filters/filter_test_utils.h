@@ -0,0 +1,112 @@
+// ----------------------------------------------------------------------------
+// FILTER TEST HARNESS UTILITIES
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Signal generators and measurement helpers used by the filter tests. Any
+ * class with a 'float Filter(float)' method can be driven with them.
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+#include "constants.h"
+#include "filters/filter_design.h"
+
+
+/* Gain and phase of a filter at one frequency */
+typedef struct
+{
+    float gain;  // Output amplitude / input amplitude
+    float phase;  // [rad] Output phase - input phase
+} FreqResponse_t;
+
+
+uint32_t FilterTestMicros();
+void FilterTestSeedNoise(uint32_t seed);
+float FilterTestNoise();
+FreqResponse_t BiquadResponse(const BiquadCoefs_t &c, float fsHz, float fHz);
+FreqResponse_t EMAResponse(float alpha, float fsHz, float fHz);
+float WrapPhase(float phase);
+
+
+// ----------------------------------------------------------------------------
+// MeasureResponse(F &filt, float fsHz, float fHz)
+// ----------------------------------------------------------------------------
+/**
+ * Drive a filter with a unit sine until it settles, then correlate the output
+ * with sin/cos over whole periods to get its gain and phase. Pick fHz so that
+ * fsHz / fHz is an integer.
+ *
+ * @param filt  Filter to test
+ * @param fsHz  [Hz] Sample rate
+ * @param fHz   [Hz] Test frequency
+ * @return      Measured gain and phase
+ */
+template <typename F>
+FreqResponse_t MeasureResponse(F &filt, float fsHz, float fHz)
+{
+    const size_t nSettle = 4000;
+    const size_t period = (size_t)((fsHz / fHz) + 0.5f);
+    const size_t nMeas = period * ((2000 / period) + 1);
+    const float w = CONSTS_2PI * fHz / fsHz;
+    float sumSin = 0.0f;
+    float sumCos = 0.0f;
+    FreqResponse_t resp;
+    size_t n;
+
+    for (n = 0; n < nSettle + nMeas; n++)
+    {
+        float ph = w * (float)(n % period);
+        float y = filt.Filter(sinf(ph));
+        if (n >= nSettle)
+        {
+            sumSin += y * sinf(ph);
+            sumCos += y * cosf(ph);
+        }
+    }
+
+    resp.gain = 2.0f * sqrtf((sumSin * sumSin) + (sumCos * sumCos)) / (float)nMeas;
+    resp.phase = atan2f(sumCos, sumSin);
+    return resp;
+}
+
+
+// ----------------------------------------------------------------------------
+// MeasureNsPerSample(F &filt, size_t n)
+// ----------------------------------------------------------------------------
+/**
+ * Time how long one Filter() call takes, on average.
+ *
+ * @param filt  Filter to time
+ * @param n     Number of samples to run
+ * @return      [ns] Time per sample
+ */
+template <typename F>
+float MeasureNsPerSample(F &filt, size_t n)
+{
+    volatile float sink = 0.0f;  // Keep the compiler from dropping the calls
+    float x = 0.0f;
+    uint32_t t0, t1;
+
+    t0 = FilterTestMicros();
+    for (size_t i = 0; i < n; i++)
+    {
+        x += 0.01f;
+        if (x > 1.0f)
+            x = -1.0f;
+        sink = filt.Filter(x);
+    }
+    t1 = FilterTestMicros();
+    (void)sink;
+
+    return 1000.0f * (float)(t1 - t0) / (float)n;
+}
+
+#endif
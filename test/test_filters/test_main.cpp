@@ -0,0 +1,105 @@
+// ----------------------------------------------------------------------------
+// FILTER LIBRARY UNIT TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Response and throughput tests for the filter library. The filters don't
+ * need any hardware, so these run on the native host (pio test -e native) as
+ * well as on the Teensy.
+ */
+
+
+#ifdef UNIT_TEST
+#include <unity.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#include "hummingbird_config.h"
+#endif
+#include "filter_response_tests.h"
+#include "filter_perf_tests.h"
+
+
+/* Enable/disable certain tests (comment/uncomment) */
+#define TEST_FILTER_RESPONSE  // Gain/phase/step/noise response tests
+#define TEST_FILTER_PERF  // Throughput tests
+
+
+void run_tests()
+{
+    #ifdef ARDUINO
+    delay(5000);  // service delay
+    #endif
+    UNITY_BEGIN();
+
+    #ifdef TEST_FILTER_RESPONSE
+    RUN_TEST(test_lpf_freq_response);
+    RUN_TEST(test_lpf_cutoff);
+    RUN_TEST(test_lpf_group_delay);
+    RUN_TEST(test_lpf_step);
+    RUN_TEST(test_lpf_white_noise);
+    RUN_TEST(test_butterworth_freq_response);
+    RUN_TEST(test_notch_freq_response);
+    RUN_TEST(test_median_filter_spike_and_step);
+    RUN_TEST(test_fixed_median_filter_spike_and_step);
+    RUN_TEST(test_hampel_filter_spike);
+    RUN_TEST(test_rate_limit_filter_step);
+    RUN_TEST(test_savgol_zero_lag);
+    RUN_TEST(test_fir_decimator_response);
+    RUN_TEST(test_alt_kalman_climb);
+    RUN_TEST(test_vec3_filters_match_scalar);
+    RUN_TEST(test_tilt_filter_stationary_tilted);
+    RUN_TEST(test_tilt_filter_follows_gyro);
+    RUN_TEST(test_tilt_filter_horizontal_accel);
+    #endif
+
+    #ifdef TEST_FILTER_PERF
+    RUN_TEST(test_perf_lpf);
+    RUN_TEST(test_perf_lpf_dt);
+    RUN_TEST(test_perf_biquad);
+    RUN_TEST(test_perf_notch);
+    RUN_TEST(test_perf_median);
+    RUN_TEST(test_perf_fixed_median);
+    RUN_TEST(test_perf_hampel);
+    RUN_TEST(test_perf_savgol);
+    RUN_TEST(test_perf_filter_chain);
+    RUN_TEST(test_perf_fir_decimator);
+    RUN_TEST(test_perf_vec3_lpf);
+    RUN_TEST(test_perf_vec3_median);
+    #endif
+
+    UNITY_END();
+}
+
+
+
+#ifdef ARDUINO
+void setup()
+{
+    pinMode(RED_LED, OUTPUT);
+    pinMode(GRN_LED, OUTPUT);
+    
+    // Red during tests
+    digitalWrite(GRN_LED, LOW);
+    digitalWrite(RED_LED, HIGH);
+
+    run_tests();
+
+    // green after tests
+    digitalWrite(RED_LED, LOW);
+    digitalWrite(GRN_LED, HIGH);
+}
+
+void loop()
+{
+    // loop code
+}
+#else
+int main(int argc, char **argv)
+{
+    run_tests();
+    return 0;
+}
+#endif
+#endif
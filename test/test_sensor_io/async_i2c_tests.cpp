@@ -0,0 +1,304 @@
+// ----------------------------------------------------------------------------
+// ASYNC I2C ENGINE TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the async I2C engine on the simulated host backend.
+ */
+
+
+#ifdef UNIT_TEST
+#include "async_i2c_tests.h"
+
+constexpr uint8_t ASYNC_TEST_ADDR = 0x21;
+
+
+/* 256 auto-incrementing registers */
+class RegArrayDevice : public SimI2CDevice
+{
+public:
+    RegArrayDevice()
+    {
+        for (int i = 0; i < 256; i++)
+            regs[i] = (uint8_t)i;
+    }
+
+    bool ReadRegs(uint8_t reg, uint8_t *buf, uint8_t len) override
+    {
+        for (uint8_t i = 0; i < len; i++)
+            buf[i] = regs[(uint8_t)(reg + i)];
+        return true;
+    }
+
+    bool WriteRegs(uint8_t reg, const uint8_t *buf, uint8_t len) override
+    {
+        for (uint8_t i = 0; i < len; i++)
+            regs[(uint8_t)(reg + i)] = buf[i];
+        return true;
+    }
+
+    uint8_t regs[256];
+};
+
+
+/* Counts callbacks and records the order they ran in */
+static int callbackCount = 0;
+static uint8_t callbackOrder[ASYNC_I2C_QUEUE_SIZE];
+
+static void CountCallback(I2CTransaction_t *txn)
+{
+    if (callbackCount < ASYNC_I2C_QUEUE_SIZE)
+        callbackOrder[callbackCount] = txn->reg;
+    callbackCount++;
+}
+
+
+/* A read runs in the background and calls back from Poll() */
+void test_async_i2c_read(void)
+{
+    HostI2CBackend bus;
+    AsyncI2C i2c(&bus);
+    RegArrayDevice dev;
+    I2CTransaction_t txn = {};
+    uint8_t buf[6] = {0};
+
+    bus.AttachDevice(ASYNC_TEST_ADDR, &dev);
+    TEST_ASSERT_TRUE(i2c.Begin());
+    callbackCount = 0;
+
+    TEST_ASSERT_TRUE(i2c.SubmitRead(&txn, ASYNC_TEST_ADDR, 0x10, buf, 6, CountCallback));
+    TEST_ASSERT_TRUE(txn.status == I2C_TXN_BUSY);  // Started right away on an idle bus
+    TEST_ASSERT_FALSE(i2c.IsIdle());
+
+    // Nothing happens until the transfer finishes
+    i2c.Poll();
+    TEST_ASSERT_EQUAL_INT(0, callbackCount);
+
+    TEST_ASSERT_TRUE(bus.Step());
+    TEST_ASSERT_TRUE(txn.status == I2C_TXN_DONE);
+    TEST_ASSERT_EQUAL_INT(0, callbackCount);  // Callbacks only run from Poll()
+    i2c.Poll();
+    TEST_ASSERT_EQUAL_INT(1, callbackCount);
+    TEST_ASSERT_TRUE(i2c.IsIdle());
+
+    for (uint8_t i = 0; i < 6; i++)
+        TEST_ASSERT_EQUAL_UINT8(0x10 + i, buf[i]);
+    TEST_ASSERT_EQUAL_UINT32(1, i2c.completed);
+}
+
+
+/* A write lands in the device registers */
+void test_async_i2c_write(void)
+{
+    HostI2CBackend bus;
+    AsyncI2C i2c(&bus);
+    RegArrayDevice dev;
+    I2CTransaction_t txn = {};
+    uint8_t data[2] = {0xAB, 0xCD};
+
+    bus.AttachDevice(ASYNC_TEST_ADDR, &dev);
+    i2c.Begin();
+
+    TEST_ASSERT_TRUE(i2c.SubmitWrite(&txn, ASYNC_TEST_ADDR, 0x2A, data, 2));
+    bus.RunAll();
+    i2c.Poll();
+    TEST_ASSERT_TRUE(txn.status == I2C_TXN_DONE);
+    TEST_ASSERT_EQUAL_HEX8(0xAB, dev.regs[0x2A]);
+    TEST_ASSERT_EQUAL_HEX8(0xCD, dev.regs[0x2B]);
+}
+
+
+/* Queued transactions run and call back in submission order */
+void test_async_i2c_order(void)
+{
+    HostI2CBackend bus;
+    AsyncI2C i2c(&bus);
+    RegArrayDevice dev;
+    I2CTransaction_t txns[4] = {};
+    uint8_t bufs[4][2];
+    const uint8_t regs[4] = {0x30, 0x01, 0x50, 0x22};
+
+    bus.AttachDevice(ASYNC_TEST_ADDR, &dev);
+    i2c.Begin();
+    callbackCount = 0;
+
+    for (int i = 0; i < 4; i++)
+        TEST_ASSERT_TRUE(i2c.SubmitRead(&txns[i], ASYNC_TEST_ADDR, regs[i], bufs[i], 2, CountCallback));
+    TEST_ASSERT_EQUAL_UINT8(4, i2c.Pending());
+    TEST_ASSERT_TRUE(txns[1].status == I2C_TXN_QUEUED);
+
+    TEST_ASSERT_EQUAL_UINT32(4, bus.RunAll());
+    i2c.Poll();
+    TEST_ASSERT_EQUAL_INT(4, callbackCount);
+    for (int i = 0; i < 4; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(regs[i], callbackOrder[i]);
+        TEST_ASSERT_EQUAL_UINT8(regs[i], bufs[i][0]);
+    }
+}
+
+
+/* A missing device NACKs and the next transaction still runs */
+void test_async_i2c_nack(void)
+{
+    HostI2CBackend bus;
+    AsyncI2C i2c(&bus);
+    RegArrayDevice dev;
+    I2CTransaction_t bad = {};
+    I2CTransaction_t good = {};
+    uint8_t buf[1];
+
+    bus.AttachDevice(ASYNC_TEST_ADDR, &dev);
+    i2c.Begin();
+
+    i2c.SubmitRead(&bad, 0x55, 0x00, buf, 1);
+    i2c.SubmitRead(&good, ASYNC_TEST_ADDR, 0x07, buf, 1);
+    bus.RunAll();
+    i2c.Poll();
+
+    TEST_ASSERT_TRUE(bad.status == I2C_TXN_NACK);
+    TEST_ASSERT_TRUE(good.status == I2C_TXN_DONE);
+    TEST_ASSERT_EQUAL_UINT8(0x07, buf[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, i2c.failed);
+    TEST_ASSERT_EQUAL_UINT32(1, i2c.completed);
+}
+
+
+/* Submit fails when the queue is full or the transaction is in flight */
+void test_async_i2c_queue_full(void)
+{
+    HostI2CBackend bus;
+    AsyncI2C i2c(&bus);
+    RegArrayDevice dev;
+    I2CTransaction_t txns[ASYNC_I2C_QUEUE_SIZE] = {};
+    uint8_t buf[1];
+
+    bus.AttachDevice(ASYNC_TEST_ADDR, &dev);
+    i2c.Begin();
+
+    for (int i = 0; i < ASYNC_I2C_QUEUE_SIZE - 1; i++)
+        TEST_ASSERT_TRUE(i2c.SubmitRead(&txns[i], ASYNC_TEST_ADDR, 0x00, buf, 1));
+    TEST_ASSERT_FALSE(i2c.SubmitRead(&txns[ASYNC_I2C_QUEUE_SIZE - 1], ASYNC_TEST_ADDR, 0x00, buf, 1));
+    TEST_ASSERT_FALSE(i2c.Submit(&txns[0]));  // Already on the bus
+
+    // Slots free up once the callbacks have run
+    bus.Step();
+    TEST_ASSERT_FALSE(i2c.SubmitRead(&txns[ASYNC_I2C_QUEUE_SIZE - 1], ASYNC_TEST_ADDR, 0x00, buf, 1));
+    i2c.Poll();
+    TEST_ASSERT_TRUE(i2c.SubmitRead(&txns[ASYNC_I2C_QUEUE_SIZE - 1], ASYNC_TEST_ADDR, 0x00, buf, 1));
+    bus.RunAll();
+    i2c.Poll();
+    TEST_ASSERT_TRUE(i2c.IsIdle());
+}
+
+
+/* A callback can re-arm its own transaction, e.g. for continuous sampling */
+static AsyncI2C *rearmEngine = nullptr;
+static int rearmCount = 0;
+
+static void RearmCallback(I2CTransaction_t *txn)
+{
+    rearmCount++;
+    if (rearmCount < 3)
+        rearmEngine->Submit(txn);
+}
+
+void test_async_i2c_resubmit_from_callback(void)
+{
+    HostI2CBackend bus;
+    AsyncI2C i2c(&bus);
+    RegArrayDevice dev;
+    I2CTransaction_t txn = {};
+    uint8_t buf[2];
+
+    bus.AttachDevice(ASYNC_TEST_ADDR, &dev);
+    i2c.Begin();
+    rearmEngine = &i2c;
+    rearmCount = 0;
+
+    i2c.SubmitRead(&txn, ASYNC_TEST_ADDR, 0x00, buf, 2, RearmCallback);
+    for (int i = 0; i < 5; i++)
+    {
+        bus.Step();
+        i2c.Poll();
+    }
+
+    TEST_ASSERT_EQUAL_INT(3, rearmCount);
+    TEST_ASSERT_TRUE(i2c.IsIdle());
+}
+
+
+/* Blocking transfers wait for the engine, and hold it off while they run */
+void test_async_i2c_lock_bus(void)
+{
+    HostI2CBackend bus;
+    AsyncI2C i2c(&bus);
+    RegArrayDevice dev;
+    I2CTransaction_t txnA = {}, txnB = {};
+    uint8_t bufA[2], bufB[2];
+
+    bus.AttachDevice(ASYNC_TEST_ADDR, &dev);
+    i2c.Begin();
+
+    // Refused while a transfer is on the bus
+    i2c.SubmitRead(&txnA, ASYNC_TEST_ADDR, 0x00, bufA, 2, nullptr);
+    TEST_ASSERT_FALSE(i2c.LockBus(0));
+    TEST_ASSERT_FALSE(i2c.IsLocked());
+
+    bus.RunAll();
+    TEST_ASSERT_TRUE(i2c.LockBus(0));
+    TEST_ASSERT_TRUE(i2c.IsLocked());
+
+    // Queued but not started while locked
+    TEST_ASSERT_TRUE(i2c.SubmitRead(&txnB, ASYNC_TEST_ADDR, 0x04, bufB, 2, nullptr));
+    TEST_ASSERT_TRUE(txnB.status == I2C_TXN_QUEUED);
+    TEST_ASSERT_FALSE(bus.Step());
+
+    i2c.UnlockBus();
+    TEST_ASSERT_FALSE(i2c.IsLocked());
+    TEST_ASSERT_TRUE(txnB.status == I2C_TXN_BUSY);
+    TEST_ASSERT_TRUE(bus.Step());
+    TEST_ASSERT_TRUE(txnB.status == I2C_TXN_DONE);
+    TEST_ASSERT_EQUAL_UINT8(0x04, bufB[0]);
+}
+
+
+/* The shared bus refuses blocking transfers while the engine is busy */
+void test_async_i2c_shared_bus(void)
+{
+    HostI2CBackend engineBus;
+    AsyncI2C i2c(&engineBus);
+    HostI2CBus wire;
+    AsyncI2CSharedBus shared(&wire, &i2c);
+    RegArrayDevice dev;
+    I2CTransaction_t txn = {};
+    uint8_t buf[2] = {0};
+
+    engineBus.AttachDevice(ASYNC_TEST_ADDR, &dev);
+    wire.AttachDevice(ASYNC_TEST_ADDR, &dev);
+    i2c.Begin();
+
+    // Engine busy and never finishes: refused once the wait times out
+    i2c.SubmitRead(&txn, ASYNC_TEST_ADDR, 0x00, buf, 2, nullptr);
+    TEST_ASSERT_FALSE(shared.ReadRegs(ASYNC_TEST_ADDR, 0x08, buf, 2));
+    TEST_ASSERT_EQUAL_UINT32(I2C_ERR_BUSY, shared.LastError());
+    TEST_ASSERT_EQUAL_UINT32(1, shared.busyRejects);
+
+    // Engine idle: passes through, and hands the bus back
+    engineBus.RunAll();
+    i2c.Poll();
+    TEST_ASSERT_TRUE(shared.ReadRegs(ASYNC_TEST_ADDR, 0x08, buf, 2));
+    TEST_ASSERT_EQUAL_UINT32(I2C_ERR_NONE, shared.LastError());
+    TEST_ASSERT_EQUAL_UINT8(0x08, buf[0]);
+    TEST_ASSERT_FALSE(i2c.IsLocked());
+
+    // Device errors come from the bus underneath
+    wire.InjectNACKs(1);
+    TEST_ASSERT_FALSE(shared.ReadRegs(ASYNC_TEST_ADDR, 0x08, buf, 2));
+    TEST_ASSERT_EQUAL_UINT32(wire.LastError(), shared.LastError());
+    TEST_ASSERT_FALSE(i2c.IsLocked());
+}
+
+#endif
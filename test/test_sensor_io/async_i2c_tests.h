@@ -0,0 +1,29 @@
+// ----------------------------------------------------------------------------
+// ASYNC I2C ENGINE TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the async I2C engine on the simulated host backend.
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <unity.h>
+#include "sensor_drivers/async_i2c.h"
+#include "sensor_drivers/async_i2c_host.h"
+#include "hal/i2c_bus_host.h"
+
+void test_async_i2c_read(void);
+void test_async_i2c_write(void);
+void test_async_i2c_order(void);
+void test_async_i2c_nack(void);
+void test_async_i2c_queue_full(void);
+void test_async_i2c_resubmit_from_callback(void);
+void test_async_i2c_lock_bus(void);
+void test_async_i2c_shared_bus(void);
+
+#endif
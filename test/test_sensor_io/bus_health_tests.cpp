@@ -0,0 +1,203 @@
+// ----------------------------------------------------------------------------
+// I2C BUS HEALTH TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for I2CBusMonitor and SensorHealth on the simulated bus. Faults come
+ * from HostI2CBus::InjectNACKs() and InjectBusLock().
+ */
+
+
+#ifdef UNIT_TEST
+#include "bus_health_tests.h"
+#include "sensor_drivers/fxas21002_gyro.h"
+#include "sensor_drivers/sensor_health.h"
+
+
+/* NACKs are counted per device, with the time since each last answered */
+void test_health_device_stats(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 sim;
+    I2CBusMonitor monitor(&bus);
+    const I2CDeviceStats_t *stats;
+    uint8_t id;
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &sim);
+    HalSimAdvanceMicros(1000);
+
+    TEST_ASSERT_TRUE(monitor.ReadReg8(SIM_FXAS21002_ADDR, GYRO_REG_ID, &id));
+    TEST_ASSERT_EQUAL_UINT32(I2C_ERR_NONE, monitor.LastError());
+    TEST_ASSERT_EQUAL_UINT64(0, monitor.SinceLastOkMicros(SIM_FXAS21002_ADDR));
+
+    bus.InjectNACKs(1);
+    TEST_ASSERT_FALSE(monitor.ReadReg8(SIM_FXAS21002_ADDR, GYRO_REG_ID, &id));
+    TEST_ASSERT_EQUAL_UINT32(I2C_ERR_NACK, monitor.LastError());
+    HalSimAdvanceMicros(250);
+
+    stats = monitor.GetStats(SIM_FXAS21002_ADDR);
+    TEST_ASSERT_NOT_NULL(stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats->transfers);
+    TEST_ASSERT_EQUAL_UINT32(1, stats->errors);
+    TEST_ASSERT_EQUAL_UINT32(1, stats->nacks);
+    TEST_ASSERT_EQUAL_UINT32(0, stats->timeouts);
+    TEST_ASSERT_EQUAL_UINT32(1, stats->consecutiveErrors);
+    TEST_ASSERT_EQUAL_UINT64(250, monitor.SinceLastOkMicros(SIM_FXAS21002_ADDR));
+
+    // A missing device has its own stats and has never answered
+    TEST_ASSERT_FALSE(monitor.Probe(0x42));
+    TEST_ASSERT_EQUAL_UINT32(1, monitor.GetStats(0x42)->nacks);
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, monitor.SinceLastOkMicros(0x42));
+    TEST_ASSERT_EQUAL_UINT8(2, monitor.DeviceCount());
+
+    // A good transfer ends the run of errors
+    TEST_ASSERT_TRUE(monitor.ReadReg8(SIM_FXAS21002_ADDR, GYRO_REG_ID, &id));
+    TEST_ASSERT_EQUAL_UINT32(0, stats->consecutiveErrors);
+    TEST_ASSERT_EQUAL_UINT32(0, monitor.busRecoveries);
+}
+
+
+/* A timeout recovers the bus at once; NACKs never do */
+void test_health_bus_recovery(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 sim;
+    I2CBusMonitor monitor(&bus);
+    uint8_t id;
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &sim);
+
+    bus.InjectBusLock();
+    TEST_ASSERT_FALSE(monitor.ReadReg8(SIM_FXAS21002_ADDR, GYRO_REG_ID, &id));
+    TEST_ASSERT_EQUAL_UINT32(1, monitor.GetStats(SIM_FXAS21002_ADDR)->timeouts);
+    TEST_ASSERT_EQUAL_UINT32(1, monitor.busRecoveries);
+    TEST_ASSERT_EQUAL_UINT32(1, bus.recoveries);
+
+    // Next transfer goes through
+    TEST_ASSERT_TRUE(monitor.ReadReg8(SIM_FXAS21002_ADDR, GYRO_REG_ID, &id));
+    TEST_ASSERT_EQUAL_HEX8(FXAS21002C_ID, id);
+
+    // An absent device NACKing, alone or between good transfers, isn't a bus fault
+    for (uint8_t i = 0; i < 10; i++)
+        TEST_ASSERT_FALSE(monitor.Probe(0x42));
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        TEST_ASSERT_FALSE(monitor.Probe(0x42));
+        TEST_ASSERT_TRUE(monitor.Probe(SIM_FXAS21002_ADDR));
+    }
+    TEST_ASSERT_EQUAL_UINT32(20, monitor.GetStats(0x42)->consecutiveErrors);
+
+    // Neither is every transfer NACKing
+    bus.InjectNACKs(10);
+    for (uint8_t i = 0; i < 10; i++)
+        TEST_ASSERT_FALSE(monitor.ReadReg8(SIM_FXAS21002_ADDR, GYRO_REG_ID, &id));
+    TEST_ASSERT_EQUAL_UINT32(1, bus.recoveries);
+    TEST_ASSERT_EQUAL_UINT32(1, monitor.busRecoveries);
+}
+
+
+/* A sensor that drops out is re-initialized once it answers again */
+void test_health_sensor_reinit(void)
+{
+    const uint8_t failsToReinit = 3;
+    const uint32_t retryMicros = 50000;
+    HostI2CBus bus;
+    SimFXAS21002 sim;
+    FXAS21002Gyro gyro(&bus);
+    SensorHealth health(failsToReinit, retryMicros);
+    uint8_t reinitAttempts = 0;
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &sim);
+    bus.SetClockHz(400000);
+    TEST_ASSERT_TRUE(gyro.Initialize(GYRO_RNG_1000DPS));
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, health.DataAgeMicros());
+    TEST_ASSERT_TRUE(gyro.ReadSensor());
+    health.ReadOk(gyro.prevMeasMicros);
+    TEST_ASSERT_TRUE(health.IsOnline());
+
+    // Device gone for a while. Reads fail, the first attempts to bring it back too.
+    bus.InjectNACKs(7);  // 5 reads, 1 ID read in Initialize(), 1 more read
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        TEST_ASSERT_FALSE(gyro.ReadSensor());
+        if (health.ReadFailed())
+        {
+            reinitAttempts++;
+            health.ReinitDone(gyro.Initialize(GYRO_RNG_1000DPS));
+        }
+        HalSimAdvanceMicros(1000);
+    }
+    TEST_ASSERT_FALSE(health.IsOnline());
+    TEST_ASSERT_EQUAL_UINT8(1, reinitAttempts);  // Then held off for retryMicros
+    TEST_ASSERT_EQUAL_UINT32(1, health.reinitFailures);
+    TEST_ASSERT_TRUE(health.DataAgeMicros() >= 5000);
+
+    // After the retry period the device is back and gets configured again
+    HalSimAdvanceMicros(retryMicros);
+    sim.regs[0x0D] = 0x00;  // Lost its range setting (power-on default)
+    TEST_ASSERT_FALSE(gyro.ReadSensor());
+    TEST_ASSERT_TRUE(health.ReadFailed());
+    health.ReinitDone(gyro.Initialize(GYRO_RNG_1000DPS));
+    TEST_ASSERT_EQUAL_HEX8(0x01, sim.regs[0x0D]);
+    TEST_ASSERT_EQUAL_UINT32(1, health.reinits);
+
+    TEST_ASSERT_TRUE(gyro.ReadSensor());
+    health.ReadOk(gyro.prevMeasMicros);
+    TEST_ASSERT_TRUE(health.IsOnline());
+    TEST_ASSERT_EQUAL_UINT32(0, health.consecutiveFailures);
+    TEST_ASSERT_TRUE(health.DataAgeMicros() < gyro.groupDelayMicros + 1000);  // Sample time has the group delay removed
+}
+
+
+/* Re-initialization in steps: the datasheet waits pass between calls, not inside them */
+void test_health_sensor_reinit_nonblocking(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 sim;
+    FXAS21002Gyro gyro(&bus);
+    SensorHealth health(1, 50000);
+    RegConfigStatus_t status;
+    uint32_t waitMicros;
+    uint64_t start;
+    uint8_t steps = 0;
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &sim);
+    bus.SetClockHz(400000);
+    TEST_ASSERT_TRUE(gyro.Initialize(GYRO_RNG_1000DPS));
+
+    // Reset by a glitch: power-on defaults, and a failed read
+    sim.regs[GYRO_REG_CTRL0] = 0x00;
+    bus.InjectNACKs(1);
+    TEST_ASSERT_FALSE(gyro.ReadSensor());
+    TEST_ASSERT_TRUE(health.ReadFailed());
+
+    TEST_ASSERT_TRUE(gyro.BeginInitialize(GYRO_RNG_1000DPS));
+    while (true)
+    {
+        start = HalSimMicros64();
+        status = gyro.StepInitialize(&waitMicros);
+        TEST_ASSERT_TRUE(HalSimMicros64() - start < 1000);  // Bus time only
+        if (status != REG_CONFIG_BUSY)
+            break;
+
+        steps++;
+        health.ReinitWait(waitMicros);
+        TEST_ASSERT_TRUE(health.IsReinitPending());
+        TEST_ASSERT_FALSE(health.ReadFailed());  // No restart while pending
+        TEST_ASSERT_FALSE(health.ReinitDue());
+        HalSimAdvanceMicros(waitMicros);
+        TEST_ASSERT_TRUE(health.ReinitDue());
+    }
+    health.ReinitDone(status == REG_CONFIG_DONE);
+
+    TEST_ASSERT_EQUAL_UINT32(REG_CONFIG_DONE, status);
+    TEST_ASSERT_EQUAL_UINT8(2, steps);  // Reset (boot wait), then active (turn-on wait)
+    TEST_ASSERT_FALSE(health.IsReinitPending());
+    TEST_ASSERT_EQUAL_UINT32(1, health.reinits);
+    TEST_ASSERT_EQUAL_HEX8(0x01, sim.regs[GYRO_REG_CTRL0]);
+    TEST_ASSERT_TRUE(gyro.ReadSensor());
+}
+
+#endif
@@ -0,0 +1,27 @@
+// ----------------------------------------------------------------------------
+// I2C BUS HEALTH TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the I2C bus health layer: per-device error statistics, stuck-bus
+ * recovery, and sensor re-initialization after a dropout.
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <unity.h>
+#include "hal/hal_platform.h"
+#include "hal/i2c_bus_host.h"
+#include "hal/i2c_bus_monitor.h"
+#include "hal/sim_sensor_models.h"
+
+void test_health_device_stats(void);
+void test_health_bus_recovery(void);
+void test_health_sensor_reinit(void);
+void test_health_sensor_reinit_nonblocking(void);
+
+#endif
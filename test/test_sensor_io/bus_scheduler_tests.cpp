@@ -0,0 +1,203 @@
+// ----------------------------------------------------------------------------
+// I2C BUS SCHEDULER TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the I2C bus scheduler on the simulated bus. Bus time comes from
+ * HostI2CBus::SetClockHz(), so utilization and lateness are realistic.
+ */
+
+
+#ifdef UNIT_TEST
+#include "bus_scheduler_tests.h"
+#include "sensor_drivers/fxas21002_gyro.h"
+
+
+/* Records the order jobs ran in */
+static char schedOrder[8];
+static uint8_t schedNOrder;
+
+static void RecordJob(void *context, uint16_t maxBytes)
+{
+    (void)maxBytes;
+    if (schedNOrder < sizeof(schedOrder))
+        schedOrder[schedNOrder++] = *(const char *)context;
+}
+
+
+/* Reads WHO_AM_I-sized chunks from the gyro until refused */
+static void GreedyJob(void *context, uint16_t maxBytes)
+{
+    I2CBus *bus = (I2CBus *)context;
+    uint8_t buf[8];
+
+    (void)maxBytes;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        if (!bus->ReadRegs(SIM_FXAS21002_ADDR, GYRO_REG_ID, buf, 8))
+            break;
+    }
+}
+
+
+/* GPS stream drain within the job's byte budget, like GNSSComputer::ListenForData() */
+typedef struct
+{
+    I2CBus *bus;
+    uint16_t left;  // Bytes known to be queued in the receiver
+    uint32_t got;  // Bytes drained
+} TestDrain_t;
+
+static void DrainJob(void *context, uint16_t maxBytes)
+{
+    TestDrain_t *d = (TestDrain_t *)context;
+    uint8_t buf[I2C_BUS_MAX_TRANSFER];
+
+    if (d->left == 0)
+    {
+        if (maxBytes < 2 || !d->bus->ReadRegs(SIM_UBLOX_ADDR, 0xFD, buf, 2))
+            return;
+        d->left = (uint16_t)buf[0] << 8 | buf[1];
+        maxBytes -= 2;
+    }
+
+    while (d->left > 0 && maxBytes > 0)
+    {
+        uint16_t n = (d->left > I2C_BUS_MAX_TRANSFER) ? I2C_BUS_MAX_TRANSFER : d->left;
+        if (n > maxBytes)
+            n = maxBytes;
+        if (!d->bus->ReadRegs(SIM_UBLOX_ADDR, 0xFF, buf, (uint8_t)n))
+            return;
+        d->left -= n;
+        d->got += n;
+        maxBytes -= n;
+    }
+}
+
+
+/* Due jobs run highest priority first, each once per Service() */
+void test_sched_priority_order(void)
+{
+    HostI2CBus bus;
+    I2CBusScheduler sched(&bus);
+    static const char a = 'a', b = 'b', c = 'c';
+
+    schedNOrder = 0;
+    TEST_ASSERT_EQUAL_UINT8(0, sched.AddJob("low", RecordJob, (void *)&c, 1000, 5, 8));
+    TEST_ASSERT_EQUAL_UINT8(1, sched.AddJob("high", RecordJob, (void *)&a, 1000, 0, 8));
+    TEST_ASSERT_EQUAL_UINT8(2, sched.AddJob("mid", RecordJob, (void *)&b, 1000, 2, 8));
+
+    TEST_ASSERT_EQUAL_UINT8(3, sched.Service());
+    TEST_ASSERT_EQUAL_UINT8(3, schedNOrder);
+    TEST_ASSERT_EQUAL_MEMORY("abc", schedOrder, 3);
+
+    TEST_ASSERT_EQUAL_UINT8(0, sched.Service());  // Nothing due yet
+    delayMicroseconds(1000);
+    TEST_ASSERT_EQUAL_UINT8(3, sched.Service());
+    TEST_ASSERT_EQUAL_UINT32(2, sched.GetJob(1)->runs);
+}
+
+
+/* Transfers past a job's maxBytes are refused and counted; others pass */
+void test_sched_byte_budget(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 sim;
+    I2CBusScheduler sched(&bus);
+    uint8_t id;
+    uint8_t val = 0;
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &sim);
+    id = sched.AddJob("greedy", GreedyJob, &sched, 0, 0, 20);
+    sched.Service();
+
+    TEST_ASSERT_EQUAL_UINT32(16, sched.GetJob(id)->bytes);  // Two 8-byte reads fit in 20
+    TEST_ASSERT_EQUAL_UINT32(1, sched.GetJob(id)->rejected);
+    TEST_ASSERT_EQUAL_UINT32(2, bus.transfers);  // The refused read never reached the bus
+
+    // Outside a job, no budget
+    TEST_ASSERT_TRUE(sched.ReadReg8(SIM_FXAS21002_ADDR, GYRO_REG_ID, &val));
+    TEST_ASSERT_EQUAL_HEX8(FXAS21002C_ID, val);
+    TEST_ASSERT_EQUAL_UINT32(1, sched.otherBytes);
+}
+
+
+/* A big background job waits if it would make a high-priority job late */
+void test_sched_deferral(void)
+{
+    HostI2CBus bus;
+    I2CBusScheduler sched(&bus);
+    static const char a = 'a', g = 'g';
+    uint8_t imu, gps;
+
+    schedNOrder = 0;
+    imu = sched.AddJob("imu", RecordJob, (void *)&a, 2500, 0, 7);
+    gps = sched.AddJob("gps", RecordJob, (void *)&g, 0, 1, 64);  // ~1.5ms of bus time at 400kHz
+    TEST_ASSERT_EQUAL_UINT32(1507, sched.WireMicros(64));
+
+    sched.Service();  // Both run: the IMU's next sample is 2.5ms away
+    TEST_ASSERT_EQUAL_UINT8(2, schedNOrder);
+
+    delayMicroseconds(1500);  // 1ms left before the IMU is due
+    sched.Service();
+    TEST_ASSERT_EQUAL_UINT8(2, schedNOrder);
+    TEST_ASSERT_EQUAL_UINT32(1, sched.GetJob(gps)->deferrals);
+
+    delayMicroseconds(1000);  // IMU due: it runs, then there is room for the GPS
+    sched.Service();
+    TEST_ASSERT_EQUAL_MEMORY("agag", schedOrder, 4);
+    TEST_ASSERT_EQUAL_UINT32(0, sched.GetJob(imu)->deferrals);
+}
+
+
+/* A large GPS backlog is drained between gyro reads without making them late */
+void test_sched_gps_backlog_jitter(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 simGyro;
+    SimUbloxI2C simGps;
+    I2CBusScheduler sched(&bus);
+    FXAS21002Gyro gyro(&sched);
+    TestDrain_t drain = {&sched, 0, 0};
+    uint8_t imu, gps;
+    uint64_t start;
+    char line[80];
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &simGyro);
+    bus.AttachDevice(SIM_UBLOX_ADDR, &simGps);
+    bus.SetClockHz(400000);
+    TEST_ASSERT_TRUE(gyro.Initialize(GYRO_RNG_1000DPS));
+
+    for (uint8_t i = 0; i < 24; i++)  // ~1.6kB backlog, ~37ms of bus time in one go
+    {
+        snprintf(line, sizeof(line), "$GNGSV,3,1,12,01,02,003,04,05,06,007,08,09,10,011,12,13,14,015,16*%02X\r\n", i);
+        simGps.QueueOutput(line);
+    }
+    TEST_ASSERT_TRUE(simGps.Available() > 1500);
+
+    imu = sched.AddJob("gyro", [](void *ctx, uint16_t) { ((FXAS21002Gyro *)ctx)->ReadSensor(); }, &gyro, 2500, 0, 7);
+    gps = sched.AddJob("gps", DrainJob, &drain, 0, 1, 64);
+    sched.ResetStats();
+
+    start = Micros64();
+    while (Micros64() - start < 100000)
+    {
+        sched.Service();
+        delayMicroseconds(50);  // Rest of the loop
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(0, simGps.Available());  // All drained...
+    TEST_ASSERT_TRUE(sched.GetJob(imu)->maxLateMicros < 100);  // ...without delaying a gyro read by more than a loop
+    TEST_ASSERT_TRUE(sched.GetJob(imu)->runs >= 39);
+    TEST_ASSERT_TRUE(sched.GetJob(gps)->deferrals > 0);
+    TEST_ASSERT_EQUAL_UINT32(0, sched.GetJob(gps)->rejected);
+
+    // Gyro: 10 bytes on the wire every 2.5ms = 9%. GPS: the rest of the traffic.
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.09f, sched.Utilization(imu));
+    TEST_ASSERT_TRUE(sched.Utilization(gps) > 0.3f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, sched.Utilization(imu) + sched.Utilization(gps), sched.TotalUtilization());
+}
+
+#endif
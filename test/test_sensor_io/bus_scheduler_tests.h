@@ -0,0 +1,27 @@
+// ----------------------------------------------------------------------------
+// I2C BUS SCHEDULER TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the I2C bus scheduler: priorities, byte budgets, deferral, and
+ * IMU jitter with a GPS backlog on the same simulated bus.
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <unity.h>
+#include "hal/hal_platform.h"
+#include "hal/i2c_bus_host.h"
+#include "hal/i2c_bus_scheduler.h"
+#include "hal/sim_sensor_models.h"
+
+void test_sched_priority_order(void);
+void test_sched_byte_budget(void);
+void test_sched_deferral(void);
+void test_sched_gps_backlog_jitter(void);
+
+#endif
@@ -0,0 +1,129 @@
+// ----------------------------------------------------------------------------
+// COUNTS TO SI CONVERSION TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the fused raw-count to SI conversion. Each fused result is
+ * checked against the step-by-step chain it replaces (sensitivity, unit
+ * conversion, rotation, bias, calibration matrix).
+ */
+
+
+#ifdef UNIT_TEST
+#include "counts_to_si_tests.h"
+#include "conversions.h"
+#include "sensor_drivers/counts_to_si.h"
+#include "sensor_drivers/sensor_calib_params.h"
+#include "sensor_drivers/fxas21002_gyro.h"
+#include "sensor_drivers/fxos8700_accelmag.h"
+#include "sensor_drivers/lis3mdl_magnetometer.h"
+
+/* Built by the compiler */
+constexpr CountsToSI_t TEST_GYRO_CVT = MakeCountsToSI(GyroSensitivity(GYRO_RNG_1000DPS), DEG2RAD);
+static_assert(TEST_GYRO_CVT.m[0][0] == GYRO_SENS_1000 * DEG2RAD, "Gyro conversion should be compile-time");
+static_assert(TEST_GYRO_CVT.m[0][1] == 0.0f && TEST_GYRO_CVT.b[2] == 0.0f, "Gyro conversion should be diagonal");
+
+static const int16_t TEST_COUNTS[4][3] = {{0, 0, 0}, {1000, -2000, 3000}, {32767, -32768, 1}, {-1234, 567, -8191}};
+
+
+/* Sensitivity and unit conversion only: a diagonal matrix, no offset */
+void test_counts_to_si_scale_only(void)
+{
+    float out[3];
+
+    for (uint8_t n = 0; n < 4; n++)
+    {
+        ApplyCountsToSI(TEST_GYRO_CVT, TEST_COUNTS[n], out);
+        for (uint8_t i = 0; i < 3; i++)
+            TEST_ASSERT_EQUAL_FLOAT(((float)TEST_COUNTS[n][i] * GYRO_SENS_1000) * DEG2RAD, out[i]);
+    }
+}
+
+
+/* Accel.: counts -> g's -> minus bias -> S matrix -> m/s/s, in one step */
+void test_counts_to_si_calibration(void)
+{
+    const float g = 9.79f;
+    const CountsToSI_t cvt = ScaleCountsToSI(MakeCountsToSI(AccelSensitivity(ACCEL_RNG_4G), 1.0f, SENSCALIB_ACCEL), g);
+    float out[3];
+    float bx, by, bz;
+
+    for (uint8_t n = 0; n < 4; n++)
+    {
+        int16_t c[3] = {(int16_t)(TEST_COUNTS[n][0] / 4), (int16_t)(TEST_COUNTS[n][1] / 4), (int16_t)(TEST_COUNTS[n][2] / 4)};  // 14-bit
+
+        ApplyCountsToSI(cvt, c, out);
+
+        bx = ((float)c[0] * ACCELMAG_CVT_GS_4G) - SENSCALIB_ACCEL_BX;
+        by = ((float)c[1] * ACCELMAG_CVT_GS_4G) - SENSCALIB_ACCEL_BY;
+        bz = ((float)c[2] * ACCELMAG_CVT_GS_4G) - SENSCALIB_ACCEL_BZ;
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, g * ((SENSCALIB_ACCEL_S11 * bx) + (SENSCALIB_ACCEL_S12 * by) + (SENSCALIB_ACCEL_S13 * bz)), out[0]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, g * ((SENSCALIB_ACCEL_S12 * bx) + (SENSCALIB_ACCEL_S22 * by) + (SENSCALIB_ACCEL_S23 * bz)), out[1]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, g * ((SENSCALIB_ACCEL_S13 * bx) + (SENSCALIB_ACCEL_S23 * by) + (SENSCALIB_ACCEL_S33 * bz)), out[2]);
+    }
+}
+
+
+/* Compass: rotate to body axes ([-y, -x, -z]), then calibrate, in one step */
+void test_counts_to_si_axes(void)
+{
+    constexpr SensorAxes_t axes = {{{0.0f, -1.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}}};
+    constexpr CountsToSI_t cvt = MakeCountsToSI(LIS3MDLSensitivity(LIS3MDL_RANGE_4G), 1.0f, SENSCALIB_MAG, axes);
+    const float sens = 100.0f / 6842.0f;
+    float out[3];
+    float bx, by, bz;
+
+    for (uint8_t n = 0; n < 4; n++)
+    {
+        ApplyCountsToSI(cvt, TEST_COUNTS[n], out);
+
+        bx = -((float)TEST_COUNTS[n][1] * sens) - SENSCALIB_MAG_BX;
+        by = -((float)TEST_COUNTS[n][0] * sens) - SENSCALIB_MAG_BY;
+        bz = -((float)TEST_COUNTS[n][2] * sens) - SENSCALIB_MAG_BZ;
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, (SENSCALIB_MAG_S11 * bx) + (SENSCALIB_MAG_S12 * by) + (SENSCALIB_MAG_S13 * bz), out[0]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, (SENSCALIB_MAG_S12 * bx) + (SENSCALIB_MAG_S22 * by) + (SENSCALIB_MAG_S23 * bz), out[1]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, (SENSCALIB_MAG_S13 * bx) + (SENSCALIB_MAG_S23 * by) + (SENSCALIB_MAG_S33 * bz), out[2]);
+    }
+}
+
+
+/* Drivers keep raw counts; the float getters scale them by the range sensitivity */
+void test_counts_to_si_drivers(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 simGyro;
+    SimFXOS8700 simAccel;
+    FXAS21002Gyro gyro(&bus);
+    FXOS8700AccelMag accel(&bus);
+    int16_t raw[3];
+    float out[3];
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &simGyro);
+    bus.AttachDevice(SIM_FXOS8700_ADDR, &simAccel);
+    TEST_ASSERT_FALSE(gyro.ReadSensor());  // No sensitivity before Initialize()
+    TEST_ASSERT_TRUE(gyro.Initialize(GYRO_RNG_500DPS));
+    TEST_ASSERT_TRUE(accel.Initialize(ACCEL_RNG_2G));
+
+    simGyro.SetRate(100.0f, -50.0f, 12.5f);
+    simAccel.SetAccel(0.25f, -0.5f, 1.0f);
+    delay(20);
+    TEST_ASSERT_TRUE(gyro.ReadSensor());
+    TEST_ASSERT_TRUE(accel.ReadSensor());
+
+    gyro.GetRaw(raw);
+    TEST_ASSERT_EQUAL_INT16(6400, raw[0]);  // 100dps / 0.015625 dps/LSB
+    TEST_ASSERT_EQUAL_FLOAT((float)raw[1] * GYRO_SENS_500, gyro.GetGy());
+    ApplyCountsToSI(MakeCountsToSI(GyroSensitivity(GYRO_RNG_500DPS), DEG2RAD), raw, out);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 100.0f * DEG2RAD, out[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, -50.0f * DEG2RAD, out[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 12.5f * DEG2RAD, out[2]);
+
+    accel.GetRawAccel(raw);
+    TEST_ASSERT_EQUAL_INT16(1024, raw[0]);  // 0.25g / 0.000244 g/LSB, 14-bit
+    TEST_ASSERT_EQUAL_FLOAT((float)raw[2] * ACCELMAG_CVT_GS_2G, accel.GetAz());
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, -0.5f, accel.GetAy());
+}
+
+#endif
@@ -0,0 +1,26 @@
+// ----------------------------------------------------------------------------
+// COUNTS TO SI CONVERSION TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the fused raw-count to SI conversion (counts_to_si.h) and the
+ * drivers' raw count outputs.
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <unity.h>
+#include "hal/hal_platform.h"
+#include "hal/i2c_bus_host.h"
+#include "hal/sim_sensor_models.h"
+
+void test_counts_to_si_scale_only(void);
+void test_counts_to_si_calibration(void);
+void test_counts_to_si_axes(void);
+void test_counts_to_si_drivers(void);
+
+#endif
@@ -0,0 +1,101 @@
+// ----------------------------------------------------------------------------
+// DATA-READY PIN TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the data-ready pin event queue. Trigger() stands in for the ISR.
+ */
+
+
+#ifdef UNIT_TEST
+#include "data_ready_tests.h"
+
+constexpr int8_t DRDY_TEST_PIN = 2;  // Any pin, nothing is wired on the host
+
+
+/* Without a pin nothing is attached and nothing is pending */
+void test_drdy_detached_is_polled(void)
+{
+    DataReadyPin drdy;
+    uint64_t t;
+
+    TEST_ASSERT_FALSE(drdy.Attach(DRDY_PIN_NONE));
+    TEST_ASSERT_FALSE(drdy.IsAttached());
+    TEST_ASSERT_FALSE(drdy.Available());
+    TEST_ASSERT_FALSE(drdy.Pop(&t));
+}
+
+
+/* One event in, one event out, with its timestamp */
+void test_drdy_trigger_and_pop(void)
+{
+    DataReadyPin drdy;
+    uint64_t t = 0;
+
+    TEST_ASSERT_TRUE(drdy.Attach(DRDY_TEST_PIN));
+    drdy.Trigger(1234);
+    TEST_ASSERT_TRUE(drdy.Available());
+    TEST_ASSERT_TRUE(drdy.Pop(&t));
+    TEST_ASSERT_EQUAL_UINT32(1234, t);
+    TEST_ASSERT_FALSE(drdy.Available());
+    TEST_ASSERT_FALSE(drdy.Pop(&t));
+    TEST_ASSERT_EQUAL_UINT32(0, drdy.missed);
+}
+
+
+/* A late read gets the newest sample's time and counts the skipped ones */
+void test_drdy_pop_newest(void)
+{
+    DataReadyPin drdy;
+    uint64_t t = 0;
+
+    drdy.Attach(DRDY_TEST_PIN);
+    drdy.Trigger(1000);
+    drdy.Trigger(2250);
+    drdy.Trigger(3500);
+    TEST_ASSERT_TRUE(drdy.Pop(&t));
+    TEST_ASSERT_EQUAL_UINT32(3500, t);
+    TEST_ASSERT_EQUAL_UINT32(2, drdy.missed);
+    TEST_ASSERT_FALSE(drdy.Available());
+}
+
+
+/* A full queue drops new events and counts them */
+void test_drdy_overrun(void)
+{
+    DataReadyPin drdy;
+    uint64_t t = 0;
+
+    drdy.Attach(DRDY_TEST_PIN);
+    for (uint32_t i = 0; i < DRDY_QUEUE_SIZE + 3; i++)
+        drdy.Trigger(100 * i);
+
+    TEST_ASSERT_EQUAL_UINT32(4, drdy.overruns);  // Queue holds DRDY_QUEUE_SIZE - 1
+    TEST_ASSERT_TRUE(drdy.Pop(&t));
+    TEST_ASSERT_EQUAL_UINT32(100 * (DRDY_QUEUE_SIZE - 2), t);
+
+    // Queue works again after draining
+    drdy.Trigger(99999);
+    TEST_ASSERT_TRUE(drdy.Pop(&t));
+    TEST_ASSERT_EQUAL_UINT32(99999, t);
+}
+
+
+/* ISR slots run out at DRDY_MAX_PINS and are freed on detach */
+void test_drdy_slots(void)
+{
+    DataReadyPin pins[DRDY_MAX_PINS];
+    DataReadyPin extra;
+
+    for (uint8_t i = 0; i < DRDY_MAX_PINS; i++)
+        TEST_ASSERT_TRUE(pins[i].Attach((int8_t)(DRDY_TEST_PIN + i)));
+    TEST_ASSERT_FALSE(extra.Attach(DRDY_TEST_PIN + DRDY_MAX_PINS));
+
+    pins[0].Detach();
+    TEST_ASSERT_FALSE(pins[0].IsAttached());
+    TEST_ASSERT_TRUE(extra.Attach(DRDY_TEST_PIN + DRDY_MAX_PINS));
+}
+
+#endif
@@ -0,0 +1,24 @@
+// ----------------------------------------------------------------------------
+// DATA-READY PIN TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the data-ready pin event queue. Trigger() stands in for the ISR.
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <unity.h>
+#include "sensor_drivers/data_ready_pin.h"
+
+void test_drdy_detached_is_polled(void);
+void test_drdy_trigger_and_pop(void);
+void test_drdy_pop_newest(void);
+void test_drdy_overrun(void);
+void test_drdy_slots(void);
+
+#endif
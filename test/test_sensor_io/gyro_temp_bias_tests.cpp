@@ -0,0 +1,139 @@
+// ----------------------------------------------------------------------------
+// GYRO TEMPERATURE BIAS TABLE TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for GyroTempBias, the NV storage it's saved to, and the gyro die
+ * temperature read it's indexed by.
+ */
+
+
+#ifdef UNIT_TEST
+#include <string.h>
+#include "gyro_temp_bias_tests.h"
+#include "sensor_drivers/fxas21002_gyro.h"
+
+
+/* Bias between learned bins is interpolated, flat past them */
+void test_tbias_interpolation(void)
+{
+    GyroTempBias table;
+    const float cold[3] = {0.010f, -0.020f, 0.000f};  // At 20C, a bin center
+    const float warm[3] = {0.030f, -0.010f, 0.004f};  // At 30C, two bins up
+    float bias[3];
+
+    TEST_ASSERT_FALSE(table.GetBias(25.0f, bias));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, bias[0]);
+
+    table.Learn(20.0f, cold, 100.0f);
+    TEST_ASSERT_TRUE(table.GetBias(45.0f, bias));  // Only one bin learned: flat
+    TEST_ASSERT_EQUAL_FLOAT(cold[0], bias[0]);
+
+    table.Learn(30.0f, warm, 100.0f);
+    TEST_ASSERT_TRUE(table.GetBias(25.0f, bias));  // Skips the unlearned 25C bin
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.020f, bias[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, -0.015f, bias[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.002f, bias[2]);
+
+    TEST_ASSERT_TRUE(table.GetBias(27.5f, bias));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.025f, bias[0]);
+
+    TEST_ASSERT_TRUE(table.GetBias(-40.0f, bias));  // Below the table
+    TEST_ASSERT_EQUAL_FLOAT(cold[1], bias[1]);
+    TEST_ASSERT_TRUE(table.GetBias(80.0f, bias));  // Above the table
+    TEST_ASSERT_EQUAL_FLOAT(warm[1], bias[1]);
+
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, table.Confidence(20.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, table.Confidence(25.0f));
+    TEST_ASSERT_EQUAL_FLOAT(50.0f, table.Confidence(22.5f));
+}
+
+
+/* Samples split between the two nearest bins; capped weight keeps tracking */
+void test_tbias_learn_split_and_cap(void)
+{
+    GyroTempBias table;
+    const float a[3] = {0.01f, 0.02f, 0.03f};
+    const float b[3] = {0.05f, 0.05f, 0.05f};
+    float bias[3];
+
+    table.Learn(GyroTempBias::BinTemperature(4) + 0.25f * GYRO_TBIAS_T_STEP, a, 40.0f);
+    TEST_ASSERT_EQUAL_FLOAT(30.0f, table.bins[4].weight);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, table.bins[5].weight);
+    TEST_ASSERT_EQUAL_FLOAT(a[2], table.bins[4].bias[2]);
+    TEST_ASSERT_EQUAL_UINT32(1, table.learnedSinceSave);
+
+    // Single samples: a running mean until the cap
+    for (uint32_t i = 0; i < 2 * (uint32_t)GYRO_TBIAS_MAX_WEIGHT; i++)
+        table.Learn(GyroTempBias::BinTemperature(10), a);
+    TEST_ASSERT_EQUAL_FLOAT(GYRO_TBIAS_MAX_WEIGHT, table.bins[10].weight);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, a[0], table.bins[10].bias[0]);
+
+    // Past the cap, a new bias is still followed (1 - 1/e after MAX_WEIGHT samples)
+    for (uint32_t i = 0; i < (uint32_t)GYRO_TBIAS_MAX_WEIGHT; i++)
+        table.Learn(GyroTempBias::BinTemperature(10), b);
+    TEST_ASSERT_TRUE(table.GetBias(GyroTempBias::BinTemperature(10), bias));
+    TEST_ASSERT_FLOAT_WITHIN(0.002f, a[0] + 0.632f * (b[0] - a[0]), bias[0]);
+}
+
+
+/* Saved tables load back; blank or corrupt storage is refused */
+void test_tbias_nv_roundtrip(void)
+{
+    HostNVStorage nv;
+    GyroTempBias table;
+    GyroTempBias loaded;
+    const float meas[3] = {0.011f, -0.007f, 0.002f};
+    const uint16_t addr = 64;
+    float bias[3];
+    uint32_t bytesWritten;
+
+    TEST_ASSERT_FALSE(loaded.Load(&nv, addr));  // Blank
+
+    table.Learn(31.0f, meas, 250.0f);
+    TEST_ASSERT_TRUE(table.Save(&nv, addr));
+    TEST_ASSERT_EQUAL_UINT32(0, table.learnedSinceSave);
+    TEST_ASSERT_TRUE(loaded.Load(&nv, addr));
+    TEST_ASSERT_EQUAL_MEMORY(table.bins, loaded.bins, sizeof(table.bins));
+    TEST_ASSERT_TRUE(loaded.GetBias(31.0f, bias));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, meas[1], bias[1]);
+
+    // Saving an unchanged table doesn't rewrite anything
+    bytesWritten = nv.bytesWritten;
+    TEST_ASSERT_TRUE(table.Save(&nv, addr));
+    TEST_ASSERT_EQUAL_UINT32(bytesWritten, nv.bytesWritten);
+
+    // A flipped bit is caught, and the table is left alone
+    nv.mem[addr + 20] ^= 0x01;
+    loaded.Clear();
+    TEST_ASSERT_FALSE(loaded.Load(&nv, addr));
+    TEST_ASSERT_FALSE(loaded.GetBias(31.0f, bias));
+
+    // Past the end of storage
+    TEST_ASSERT_FALSE(table.Save(&nv, HOST_NV_SIZE - 8));
+}
+
+
+/* Die temperature read used to index the table */
+void test_tbias_gyro_temperature(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 sim;
+    FXAS21002Gyro gyro(&bus);
+    float tempC = 99.0f;
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &sim);
+    TEST_ASSERT_TRUE(gyro.Initialize(GYRO_RNG_1000DPS));
+
+    sim.SetTemperature(-12);
+    TEST_ASSERT_TRUE(gyro.ReadTemperature(&tempC));
+    TEST_ASSERT_EQUAL_FLOAT(-12.0f, tempC);
+
+    bus.InjectNACKs(1);
+    TEST_ASSERT_FALSE(gyro.ReadTemperature(&tempC));
+    TEST_ASSERT_EQUAL_FLOAT(-12.0f, tempC);  // Unchanged
+}
+
+#endif
@@ -0,0 +1,28 @@
+// ----------------------------------------------------------------------------
+// GYRO TEMPERATURE BIAS TABLE TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the temperature-binned gyro bias table: learning, interpolation,
+ * and keeping it in (host) non-volatile storage.
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <unity.h>
+#include "hal/hal_platform.h"
+#include "hal/i2c_bus_host.h"
+#include "hal/nv_storage_host.h"
+#include "hal/sim_sensor_models.h"
+#include "sensor_drivers/gyro_temp_bias.h"
+
+void test_tbias_interpolation(void);
+void test_tbias_learn_split_and_cap(void);
+void test_tbias_nv_roundtrip(void);
+void test_tbias_gyro_temperature(void);
+
+#endif
@@ -0,0 +1,464 @@
+// ----------------------------------------------------------------------------
+// I2C BUS HAL TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the host I2C bus and the simulated sensor models. The driver
+ * tests run the real FXAS21002/FXOS8700/LIS3MDL/BMP388 drivers on a
+ * HostI2CBus.
+ */
+
+
+#ifdef UNIT_TEST
+#include <string.h>
+#include "hal_bus_tests.h"
+#include "sensor_drivers/fxas21002_gyro.h"
+#include "sensor_drivers/fxos8700_accelmag.h"
+#include "sensor_drivers/lis3mdl_magnetometer.h"
+#include "sensor_drivers/bmp388_barometer.h"
+
+
+/* Append the UBX checksum to a message of 'len' bytes (sync chars included) */
+static void AddUBXChecksum(uint8_t *msg, uint16_t len)
+{
+    uint8_t ckA = 0;
+    uint8_t ckB = 0;
+
+    for (uint16_t i = 2; i < len; i++)
+    {
+        ckA += msg[i];
+        ckB += ckA;
+    }
+    msg[len] = ckA;
+    msg[len + 1] = ckB;
+}
+
+
+/* Probe finds attached devices, empty addresses and injected faults NACK */
+void test_hal_bus_probe_and_nack(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 gyro;
+    uint8_t id = 0;
+
+    TEST_ASSERT_TRUE(bus.AttachDevice(SIM_FXAS21002_ADDR, &gyro));
+    TEST_ASSERT_FALSE(bus.AttachDevice(SIM_FXAS21002_ADDR, &gyro));  // Address taken
+
+    TEST_ASSERT_TRUE(bus.Probe(SIM_FXAS21002_ADDR));
+    TEST_ASSERT_FALSE(bus.Probe(0x50));
+    TEST_ASSERT_TRUE(bus.ReadReg8(SIM_FXAS21002_ADDR, GYRO_REG_ID, &id));
+    TEST_ASSERT_EQUAL_HEX8(FXAS21002C_ID, id);
+
+    bus.InjectNACKs(2);
+    TEST_ASSERT_FALSE(bus.ReadReg8(SIM_FXAS21002_ADDR, GYRO_REG_ID, &id));
+    TEST_ASSERT_FALSE(bus.Probe(SIM_FXAS21002_ADDR));
+    TEST_ASSERT_TRUE(bus.Probe(SIM_FXAS21002_ADDR));
+    TEST_ASSERT_EQUAL_UINT32(3, bus.nacks);
+}
+
+
+/* Transfers advance the simulated clock by their time on the wire */
+void test_hal_bus_timing(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 gyro;
+    uint8_t buf[6];
+    uint64_t t0;
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &gyro);
+
+    // No clock: zero-time transfers
+    t0 = HalSimMicros64();
+    TEST_ASSERT_TRUE(bus.ReadRegs(SIM_FXAS21002_ADDR, GYRO_REG_STATUS, buf, 6));
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)(HalSimMicros64() - t0));
+
+    // 400kHz: 9 bytes (2 address, 1 register, 6 data) of 9 bits = 202us
+    bus.SetClockHz(400000);
+    t0 = HalSimMicros64();
+    TEST_ASSERT_TRUE(bus.ReadRegs(SIM_FXAS21002_ADDR, GYRO_REG_STATUS, buf, 6));
+    TEST_ASSERT_EQUAL_UINT32(202, (uint32_t)(HalSimMicros64() - t0));
+    TEST_ASSERT_EQUAL_UINT32(9 + 9, bus.bytes);
+}
+
+
+/* The gyro driver configures the model and reads the set rates back */
+void test_hal_fxas21002_driver(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 sim;
+    FXAS21002Gyro gyro(&bus);
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &sim);
+    sim.SetRate(10.0f, -20.0f, 300.0f);
+
+    TEST_ASSERT_TRUE(gyro.Initialize(GYRO_RNG_1000DPS));
+    TEST_ASSERT_EQUAL_HEX8(0x01, sim.regs[0x0D]);  // CTRL0 FS = 1000dps
+
+    TEST_ASSERT_TRUE(gyro.ReadSensor());
+    TEST_ASSERT_TRUE(sim.samples > 0);  // Active since before the 100ms settle delay
+    TEST_ASSERT_FLOAT_WITHIN(GYRO_SENS_1000, 10.0f, gyro.GetGx());
+    TEST_ASSERT_FLOAT_WITHIN(GYRO_SENS_1000, -20.0f, gyro.GetGy());
+    TEST_ASSERT_FLOAT_WITHIN(GYRO_SENS_1000, 300.0f, gyro.GetGz());
+
+    // Bus faults are reported
+    bus.InjectNACKs(1);
+    TEST_ASSERT_FALSE(gyro.ReadSensor());
+}
+
+
+/* FIFO fills at the ODR and drains through the driver */
+void test_hal_fxas21002_fifo(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 sim;
+    FXAS21002Gyro gyro(&bus);
+    GyroSample_t samples[GYRO_FIFO_SIZE];
+    uint32_t transfers;
+    size_t n;
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &sim);
+    sim.SetRate(1.0f, 2.0f, 3.0f);
+    TEST_ASSERT_TRUE(gyro.Initialize(GYRO_RNG_250DPS));
+    TEST_ASSERT_TRUE(gyro.ConfigureFIFO(GYRO_ODR_800HZ, 8));
+
+    // The FIFO filled and overflowed during the 100ms settle delay
+    TEST_ASSERT_EQUAL_UINT8(SIM_FIFO_SIZE, sim.FIFOCount());
+    transfers = bus.transfers;
+    n = gyro.ReadFIFO(samples, GYRO_FIFO_SIZE);
+    TEST_ASSERT_TRUE(n >= GYRO_FIFO_SIZE - 1);  // Samples arrive during the burst
+    TEST_ASSERT_EQUAL_UINT32(3, bus.transfers - transfers);  // Status, two bursts
+    TEST_ASSERT_EQUAL_UINT32(1, gyro.fifoOverflows);
+
+    delay(10);  // 8 samples at 800Hz
+    TEST_ASSERT_EQUAL_UINT8(8, sim.FIFOCount());
+
+    n = gyro.ReadFIFO(samples, GYRO_FIFO_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(8, (uint32_t)n);
+    TEST_ASSERT_EQUAL_UINT8(0, sim.FIFOCount());
+    TEST_ASSERT_FLOAT_WITHIN(GYRO_SENS_250, 1.0f, samples[0].gx);
+    TEST_ASSERT_FLOAT_WITHIN(GYRO_SENS_250, 3.0f, samples[7].gz);
+    TEST_ASSERT_EQUAL_UINT32(1, gyro.fifoOverflows);
+}
+
+
+/* Hybrid accel/mag burst decodes both sensors */
+void test_hal_fxos8700_driver(void)
+{
+    HostI2CBus bus;
+    SimFXOS8700 sim;
+    FXOS8700AccelMag accelMag(&bus);
+
+    bus.AttachDevice(SIM_FXOS8700_ADDR, &sim);
+    sim.SetAccel(0.1f, -0.2f, 1.0f);
+    sim.SetMag(20.0f, -5.0f, -40.0f);
+
+    TEST_ASSERT_TRUE(accelMag.Initialize(ACCEL_RNG_4G, true));
+    delay(10);
+    TEST_ASSERT_TRUE(accelMag.ReadSensor());
+
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.1f, accelMag.GetAx());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -0.2f, accelMag.GetAy());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, accelMag.GetAz());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 20.0f, accelMag.GetMx());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, -5.0f, accelMag.GetMy());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, -40.0f, accelMag.GetMz());
+}
+
+
+/* Accel. FIFO drains in bus-limit bursts, then the hybrid mag. sample */
+void test_hal_fxos8700_fifo(void)
+{
+    HostI2CBus bus;
+    SimFXOS8700 sim;
+    FXOS8700AccelMag accelMag(&bus);
+    AccelSample_t samples[ACCELMAG_FIFO_SIZE];
+    uint32_t transfers;
+    size_t n;
+
+    bus.AttachDevice(SIM_FXOS8700_ADDR, &sim);
+    sim.SetAccel(0.1f, -0.2f, 1.0f);
+    sim.SetMag(20.0f, -5.0f, -40.0f);
+    TEST_ASSERT_TRUE(accelMag.Initialize(ACCEL_RNG_4G, true));
+    TEST_ASSERT_TRUE(accelMag.ConfigureFIFO(8));
+
+    delay(200);  // 40 samples at 200Hz: full and overflowed
+    TEST_ASSERT_EQUAL_UINT8(SIM_FIFO_SIZE, sim.FIFOCount());
+    transfers = bus.transfers;
+    n = accelMag.ReadFIFO(samples, ACCELMAG_FIFO_SIZE);
+    TEST_ASSERT_TRUE(n >= ACCELMAG_FIFO_SIZE - 1);  // Samples arrive during the burst
+    TEST_ASSERT_EQUAL_UINT32(4, bus.transfers - transfers);  // Status, two bursts, mag.
+    TEST_ASSERT_EQUAL_UINT32(1, accelMag.fifoOverflows);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.1f, samples[0].ax);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, samples[n - 1].az);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, -40.0f, accelMag.GetMz());
+}
+
+
+/* Magnetometer burst (auto-increment bit) and little-endian decode */
+void test_hal_lis3mdl_driver(void)
+{
+    HostI2CBus bus;
+    SimLIS3MDL sim;
+    LIS3MDL_Mag mag(&bus);
+
+    bus.AttachDevice(SIM_LIS3MDL_ADDR, &sim);
+    sim.SetField(25.0f, -12.5f, 40.0f);
+
+    TEST_ASSERT_TRUE(mag.Initialize(LIS3MDL_RANGE_4G));
+    delay(20);
+    TEST_ASSERT_TRUE(mag.ReadSensor());
+
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 25.0f, mag.GetMx());
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, -12.5f, mag.GetMy());
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 40.0f, mag.GetMz());
+}
+
+
+/* 1kHz fast ODR, and the temperature comes in the same burst as the field */
+void test_hal_lis3mdl_fast_odr(void)
+{
+    HostI2CBus bus;
+    SimLIS3MDL sim;
+    LIS3MDL_Mag mag(&bus);
+    uint32_t samples;
+    uint32_t transfers;
+
+    bus.AttachDevice(SIM_LIS3MDL_ADDR, &sim);
+    sim.SetField(10.0f, 20.0f, -30.0f);
+    sim.SetTemperature(41.0f);
+
+    TEST_ASSERT_TRUE(mag.Initialize(LIS3MDL_RANGE_4G, LIS3MDL_ODR_1000HZ));
+    TEST_ASSERT_EQUAL_UINT32(500, mag.groupDelayMicros);
+    samples = sim.samples;
+    delay(10);
+
+    transfers = bus.transfers;
+    TEST_ASSERT_TRUE(mag.ReadSensor());
+    TEST_ASSERT_EQUAL_UINT32(10, sim.samples - samples);  // Counted when the model is next accessed
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 10.0f, mag.GetMx());
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, -30.0f, mag.GetMz());
+    TEST_ASSERT_FLOAT_WITHIN(0.125f, 41.0f, mag.GetTemperature());
+    TEST_ASSERT_EQUAL_UINT32(1, bus.transfers - transfers);  // No extra transaction
+}
+
+
+/* Offsets and scales are interpolated from the table at the die temperature */
+void test_hal_lis3mdl_temp_comp(void)
+{
+    static const LIS3MDLTempComp_t table[3] = {
+        {0.0f, {0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+        {25.0f, {2.0f, -4.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+        {65.0f, {6.0f, -4.0f, 0.0f}, {1.0f, 1.0f, 0.9f}}
+    };
+    static const LIS3MDLTempComp_t unsorted[2] = {
+        {25.0f, {0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+        {0.0f, {0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}}
+    };
+    HostI2CBus bus;
+    SimLIS3MDL sim;
+    LIS3MDL_Mag mag(&bus);
+
+    bus.AttachDevice(SIM_LIS3MDL_ADDR, &sim);
+    TEST_ASSERT_TRUE(mag.Initialize(LIS3MDL_RANGE_4G));
+    TEST_ASSERT_FALSE(mag.SetTempCompensation(unsorted, 2));
+    TEST_ASSERT_FALSE(mag.SetTempCompensation(table, 0));
+    TEST_ASSERT_TRUE(mag.SetTempCompensation(table, 3));
+
+    // Halfway between 25C and 65C: offset (4, -4, 0), z scale 0.95
+    sim.SetField(30.0f, 30.0f, 30.0f);
+    sim.SetTemperature(45.0f);
+    delay(10);
+    TEST_ASSERT_TRUE(mag.ReadSensor());
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 26.0f, mag.GetMx());
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 34.0f, mag.GetMy());
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 28.5f, mag.GetMz());
+
+    // Below the table the first entry holds
+    sim.SetTemperature(-10.0f);
+    delay(10);
+    TEST_ASSERT_TRUE(mag.ReadSensor());
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 30.0f, mag.GetMx());
+
+    // Off
+    TEST_ASSERT_TRUE(mag.SetTempCompensation(nullptr, 0));
+    sim.SetTemperature(65.0f);
+    delay(10);
+    TEST_ASSERT_TRUE(mag.ReadSensor());
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 30.0f, mag.GetMz());
+}
+
+
+/* Raw ADC values compensate back to the set pressure and temperature */
+void test_hal_bmp388_compensation(void)
+{
+    SimBMP388 sim;
+    double tempC;
+    double pressPa;
+
+    sim.SetTemperature(25.0f);
+    sim.SetPressure(101325.0f);
+    tempC = sim.CompensateTemperature(sim.RawTemperature());
+    pressPa = sim.CompensatePressure(sim.RawPressure(), tempC);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 25.0f, (float)tempC);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 101325.0f, (float)pressPa);
+
+    sim.SetTemperature(-10.0f);
+    sim.SetPressure(85000.0f);
+    tempC = sim.CompensateTemperature(sim.RawTemperature());
+    pressPa = sim.CompensatePressure(sim.RawPressure(), tempC);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -10.0f, (float)tempC);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 85000.0f, (float)pressPa);
+}
+
+
+/* Single-precision driver compensation matches the model's double precision */
+void test_hal_bmp388_driver(void)
+{
+    HostI2CBus bus;
+    SimBMP388 sim;
+    BMP388Baro baro(&bus);
+    static const float points[4][2] = {{25.0f, 101325.0f}, {-10.0f, 95000.0f}, {40.0f, 108000.0f}, {5.0f, 85000.0f}};
+    double tempC;
+
+    bus.AttachDevice(SIM_BMP388_ADDR, &sim);
+    TEST_ASSERT_FALSE(baro.ReadSensor());  // Not connected
+    TEST_ASSERT_TRUE(baro.Initialize(BMP388_OS_1X, BMP388_OS_1X, BMP388_IIR_COEF_3, BMP388_ODR_50HZ));
+    TEST_ASSERT_EQUAL_UINT32(20000, baro.fifoPeriodMicros);
+    TEST_ASSERT_EQUAL_UINT32(60000, baro.groupDelayMicros);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 101325.0f, baro.GetPressure());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 25.0f, baro.GetTemperature());
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        sim.SetTemperature(points[i][0]);
+        sim.SetPressure(points[i][1]);
+        tempC = sim.CompensateTemperature(sim.RawTemperature());
+
+        TEST_ASSERT_FLOAT_WITHIN(0.001f, (float)tempC, baro.CompensateTemperature(sim.RawTemperature()));
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, (float)sim.CompensatePressure(sim.RawPressure(), tempC),
+            baro.CompensatePressure(sim.RawPressure(), (float)tempC));
+
+        delay(20);
+        TEST_ASSERT_TRUE(baro.ReadSensor());
+        TEST_ASSERT_FLOAT_WITHIN(0.5f, points[i][1], baro.GetPressure());
+    }
+}
+
+
+/* FIFO drains in bursts, with ODR-spaced timestamps, a batch limit, and overflow */
+void test_hal_bmp388_fifo(void)
+{
+    HostI2CBus bus;
+    SimBMP388 sim;
+    BMP388Baro baro(&bus);
+    BaroSample_t samples[32];
+    uint64_t t0;
+    size_t n;
+
+    bus.AttachDevice(SIM_BMP388_ADDR, &sim);
+    sim.SetTemperature(20.0f);
+    sim.SetPressure(98000.0f);
+    TEST_ASSERT_TRUE(baro.Initialize(BMP388_OS_1X, BMP388_OS_1X, BMP388_IIR_COEF_3, BMP388_ODR_200HZ));
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)baro.ReadFIFO(samples, 32));  // FIFO not configured
+    TEST_ASSERT_TRUE(baro.ConfigureFIFO());
+    TEST_ASSERT_EQUAL_UINT16(0, sim.FIFOLength());
+
+    // 10 frames at 200Hz, read in 28, 28 and 14-byte bursts
+    delay(50);
+    TEST_ASSERT_EQUAL_UINT16(10 * BMP388_FIFO_FRAME_BYTES, sim.FIFOLength());
+    t0 = Micros64();
+    n = baro.ReadFIFO(samples, 32);
+    TEST_ASSERT_EQUAL_UINT32(10, (uint32_t)n);
+    TEST_ASSERT_EQUAL_UINT16(0, sim.FIFOLength());
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 98000.0f, samples[0].pressure);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 20.0f, samples[9].temperature);
+    TEST_ASSERT_TRUE(t0 - 15000 == samples[9].micros);  // IIR coef. 3 at 200Hz
+    TEST_ASSERT_TRUE(samples[9].micros - samples[0].micros == 9 * 5000);
+    TEST_ASSERT_TRUE(baro.prevMeasMicros == samples[9].micros);
+
+    // Batch limit leaves the newer frames in the FIFO
+    delay(50);
+    n = baro.ReadFIFO(samples, 4);
+    TEST_ASSERT_EQUAL_UINT32(4, (uint32_t)n);
+    TEST_ASSERT_EQUAL_UINT16(6 * BMP388_FIFO_FRAME_BYTES, sim.FIFOLength());
+    n = baro.ReadFIFO(samples, 32);
+    TEST_ASSERT_EQUAL_UINT32(6, (uint32_t)n);
+    TEST_ASSERT_EQUAL_UINT32(0, baro.fifoOverflows);
+
+    // 100 frames overwrite the oldest
+    delay(500);
+    TEST_ASSERT_EQUAL_UINT16((BMP388_FIFO_SIZE / BMP388_FIFO_FRAME_BYTES) * BMP388_FIFO_FRAME_BYTES, sim.FIFOLength());
+    n = baro.ReadFIFO(samples, 32);
+    TEST_ASSERT_EQUAL_UINT32(32, (uint32_t)n);
+    TEST_ASSERT_EQUAL_UINT32(1, baro.fifoOverflows);
+    TEST_ASSERT_TRUE(baro.FlushFIFO());
+    TEST_ASSERT_EQUAL_UINT16(0, sim.FIFOLength());
+}
+
+
+/* Byte count at 0xFD/0xFE, stream at 0xFF, 0xFF when empty */
+void test_hal_ublox_stream(void)
+{
+    HostI2CBus bus;
+    SimUbloxI2C gps;
+    const char *nmea = "$GNGGA,,,,,,0,00,99.99,,,,,,*56\r\n";
+    uint8_t buf[I2C_BUS_MAX_TRANSFER];
+    uint16_t count;
+    uint16_t got;
+
+    bus.AttachDevice(SIM_UBLOX_ADDR, &gps);
+    gps.QueueOutput(nmea);
+
+    TEST_ASSERT_TRUE(bus.ReadRegs(SIM_UBLOX_ADDR, 0xFD, buf, 2));
+    count = (uint16_t)buf[0] << 8 | buf[1];
+    TEST_ASSERT_EQUAL_UINT16(strlen(nmea), count);
+
+    got = 0;
+    while (got < count)
+    {
+        uint8_t n = (count - got > I2C_BUS_MAX_TRANSFER) ? I2C_BUS_MAX_TRANSFER : (uint8_t)(count - got);
+        TEST_ASSERT_TRUE(bus.ReadRegs(SIM_UBLOX_ADDR, 0xFF, buf, n));
+        TEST_ASSERT_EQUAL_MEMORY(nmea + got, buf, n);
+        got += n;
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(0, gps.Available());
+    TEST_ASSERT_TRUE(bus.ReadRegs(SIM_UBLOX_ADDR, 0xFF, buf, 1));
+    TEST_ASSERT_EQUAL_HEX8(0xFF, buf[0]);
+}
+
+
+/* CFG messages are ACK'd, bad checksums NAK'd, even when split over writes */
+void test_hal_ublox_ack(void)
+{
+    HostI2CBus bus;
+    SimUbloxI2C gps;
+    uint8_t msg[14] = {0xB5, 0x62, 0x06, 0x08, 0x06, 0x00, 0xC8, 0x00, 0x01, 0x00, 0x01, 0x00};  // CFG-RATE 5Hz
+    uint8_t ack[10];
+
+    bus.AttachDevice(SIM_UBLOX_ADDR, &gps);
+    AddUBXChecksum(msg, 12);
+
+    TEST_ASSERT_TRUE(bus.Write(SIM_UBLOX_ADDR, msg, 8));
+    TEST_ASSERT_TRUE(bus.Write(SIM_UBLOX_ADDR, msg + 8, 6));
+    TEST_ASSERT_EQUAL_UINT32(1, gps.ubxMessages);
+    TEST_ASSERT_EQUAL_HEX8(0x06, gps.lastClass);
+    TEST_ASSERT_EQUAL_HEX8(0x08, gps.lastId);
+
+    TEST_ASSERT_EQUAL_UINT16(10, gps.Available());
+    TEST_ASSERT_TRUE(bus.ReadRegs(SIM_UBLOX_ADDR, 0xFF, ack, 10));
+    TEST_ASSERT_EQUAL_HEX8(0x05, ack[2]);  // ACK class
+    TEST_ASSERT_EQUAL_HEX8(0x01, ack[3]);  // ACK-ACK
+    TEST_ASSERT_EQUAL_HEX8(0x06, ack[6]);
+    TEST_ASSERT_EQUAL_HEX8(0x08, ack[7]);
+
+    msg[13] ^= 0x5A;  // Corrupt checksum
+    TEST_ASSERT_TRUE(bus.Write(SIM_UBLOX_ADDR, msg, 14));
+    TEST_ASSERT_EQUAL_UINT32(1, gps.ubxBadChecksums);
+    TEST_ASSERT_TRUE(bus.ReadRegs(SIM_UBLOX_ADDR, 0xFF, ack, 10));
+    TEST_ASSERT_EQUAL_HEX8(0x00, ack[3]);  // ACK-NAK
+}
+
+#endif
@@ -0,0 +1,36 @@
+// ----------------------------------------------------------------------------
+// I2C BUS HAL TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the host I2C bus and the simulated sensor models, including the
+ * unmodified sensor drivers running against the models.
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <unity.h>
+#include "hal/hal_platform.h"
+#include "hal/i2c_bus_host.h"
+#include "hal/sim_sensor_models.h"
+
+void test_hal_bus_probe_and_nack(void);
+void test_hal_bus_timing(void);
+void test_hal_fxas21002_driver(void);
+void test_hal_fxas21002_fifo(void);
+void test_hal_fxos8700_driver(void);
+void test_hal_fxos8700_fifo(void);
+void test_hal_lis3mdl_driver(void);
+void test_hal_lis3mdl_fast_odr(void);
+void test_hal_lis3mdl_temp_comp(void);
+void test_hal_bmp388_compensation(void);
+void test_hal_bmp388_driver(void);
+void test_hal_bmp388_fifo(void);
+void test_hal_ublox_stream(void);
+void test_hal_ublox_ack(void);
+
+#endif
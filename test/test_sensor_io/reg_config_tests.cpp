@@ -0,0 +1,199 @@
+// ----------------------------------------------------------------------------
+// REGISTER CONFIGURATION TABLE TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for register configuration tables on the simulated bus. Transfer
+ * counts come from HostI2CBus::transfers.
+ */
+
+
+#ifdef UNIT_TEST
+#include "reg_config_tests.h"
+#include "sensor_drivers/fxas21002_gyro.h"
+#include "sensor_drivers/fxos8700_accelmag.h"
+#include "sensor_drivers/lis3mdl_magnetometer.h"
+#include "sensor_drivers/bmp388_barometer.h"
+
+
+/* Consecutive registers go out in one write and come back in one read */
+void test_regcfg_burst_autoinc(void)
+{
+    HostI2CBus bus;
+    SimLIS3MDL sim;
+    LIS3MDL_Mag mag(&bus);
+    uint32_t transfers;
+
+    bus.AttachDevice(SIM_LIS3MDL_ADDR, &sim);
+
+    transfers = bus.transfers;
+    TEST_ASSERT_TRUE(mag.Initialize(LIS3MDL_RANGE_8G, LIS3MDL_ODR_300HZ));
+    TEST_ASSERT_EQUAL_UINT32(3, bus.transfers - transfers);  // ID, config. burst, read-back burst
+    TEST_ASSERT_EQUAL_HEX8(0xD2, sim.regs[LIS3MDL_CTRL_REG1]);  // Temp. on, high perf., fast ODR
+    TEST_ASSERT_EQUAL_HEX8(0x20, sim.regs[LIS3MDL_CTRL_REG2]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, sim.regs[LIS3MDL_CTRL_REG3]);
+    TEST_ASSERT_EQUAL_HEX8(0x08, sim.regs[LIS3MDL_CTRL_REG4]);
+
+    // A wait splits the burst
+    const RegConfig_t config[] = {
+        {LIS3MDL_CTRL_REG4, 0x0C, REG_VERIFY_ALL, 500},
+        {LIS3MDL_CTRL_REG5, 0x40, REG_VERIFY_ALL, 0}
+    };
+    uint64_t start = HalSimMicros64();
+    transfers = bus.transfers;
+    TEST_ASSERT_TRUE(ApplyRegConfig(&bus, SIM_LIS3MDL_ADDR, config, 2, REG_BURST_AUTOINC_MSB));
+    TEST_ASSERT_EQUAL_UINT32(3, bus.transfers - transfers);
+    TEST_ASSERT_EQUAL_UINT64(500, HalSimMicros64() - start);
+    TEST_ASSERT_EQUAL_HEX8(0x0C, sim.regs[LIS3MDL_CTRL_REG4]);
+    TEST_ASSERT_EQUAL_HEX8(0x40, sim.regs[LIS3MDL_CTRL_REG5]);
+}
+
+
+/* BMP388: any registers in one address/data pair write, read back across the reserved 0x1E */
+void test_regcfg_addr_pairs(void)
+{
+    HostI2CBus bus;
+    SimBMP388 sim;
+    uint32_t transfers;
+
+    bus.AttachDevice(SIM_BMP388_ADDR, &sim);
+
+    const RegConfig_t config[] = {
+        {BMP388_REG_PWR_CTRL, 0x00, REG_NO_VERIFY, 0},
+        {BMP388_REG_CONFIG, 0x04, REG_VERIFY_ALL, 0},
+        {BMP388_REG_OSR, 0x0B, REG_VERIFY_ALL, 0},
+        {BMP388_REG_FIFO_CONFIG_2, 0x08, REG_VERIFY_ALL, 0},
+        {BMP388_REG_ODR, 0x02, REG_VERIFY_ALL, 0}
+    };
+
+    transfers = bus.transfers;
+    TEST_ASSERT_TRUE(ApplyRegConfig(&bus, SIM_BMP388_ADDR, config, 5, REG_BURST_ADDR_PAIRS));
+    TEST_ASSERT_EQUAL_UINT32(3, bus.transfers - transfers);  // Write, FIFO_CONFIG_2 read, OSR-CONFIG read
+    TEST_ASSERT_EQUAL_HEX8(0x04, sim.regs[BMP388_REG_CONFIG]);
+    TEST_ASSERT_EQUAL_HEX8(0x0B, sim.regs[BMP388_REG_OSR]);
+    TEST_ASSERT_EQUAL_HEX8(0x08, sim.regs[BMP388_REG_FIFO_CONFIG_2]);
+    TEST_ASSERT_EQUAL_HEX8(0x02, sim.regs[BMP388_REG_ODR]);
+}
+
+
+/* Only the last write to a register is checked, under its mask */
+void test_regcfg_verify(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 sim;
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &sim);
+
+    // WHO_AM_I is read-only
+    const RegConfig_t wrongId[] = {{GYRO_REG_ID, 0x00, REG_VERIFY_ALL, 0}};
+    const RegConfig_t maskedId[] = {{GYRO_REG_ID, 0x57, 0x7F, 0}};
+    const RegConfig_t unverifiedId[] = {{GYRO_REG_ID, 0x00, REG_NO_VERIFY, 0}};
+    TEST_ASSERT_FALSE(ApplyRegConfig(&bus, SIM_FXAS21002_ADDR, wrongId, 1, REG_BURST_AUTOINC));
+    TEST_ASSERT_TRUE(ApplyRegConfig(&bus, SIM_FXAS21002_ADDR, maskedId, 1, REG_BURST_AUTOINC));
+    TEST_ASSERT_TRUE(ApplyRegConfig(&bus, SIM_FXAS21002_ADDR, unverifiedId, 1, REG_BURST_AUTOINC));
+
+    const RegConfig_t rewritten[] = {
+        {GYRO_REG_CTRL0, 0x03, REG_VERIFY_ALL, 0},
+        {GYRO_REG_CTRL0, 0x01, REG_VERIFY_ALL, 0}
+    };
+    TEST_ASSERT_TRUE(ApplyRegConfig(&bus, SIM_FXAS21002_ADDR, rewritten, 2, REG_BURST_AUTOINC));
+    TEST_ASSERT_EQUAL_HEX8(0x01, sim.regs[GYRO_REG_CTRL0]);
+
+    // Gone device
+    bus.InjectNACKs(1);
+    TEST_ASSERT_FALSE(ApplyRegConfig(&bus, SIM_FXAS21002_ADDR, rewritten, 2, REG_BURST_AUTOINC));
+}
+
+
+/* Each driver waits only its datasheet times */
+void test_regcfg_init_time(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 simGyro;
+    SimFXOS8700 simAccel;
+    SimLIS3MDL simMag;
+    SimBMP388 simBaro;
+    FXAS21002Gyro gyro(&bus);
+    FXOS8700AccelMag accel(&bus);
+    LIS3MDL_Mag mag(&bus);
+    BMP388Baro baro(&bus);
+    uint64_t bootMicros;
+    uint64_t start;
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &simGyro);
+    bus.AttachDevice(SIM_FXOS8700_ADDR, &simAccel);
+    bus.AttachDevice(SIM_LIS3MDL_ADDR, &simMag);
+    bus.AttachDevice(SIM_BMP388_ADDR, &simBaro);
+    bus.SetClockHz(400000);
+    bootMicros = HalSimMicros64();
+
+    start = HalSimMicros64();
+    TEST_ASSERT_TRUE(gyro.Initialize(GYRO_RNG_1000DPS));
+    TEST_ASSERT_TRUE(HalSimMicros64() - start < GYRO_BOOT_US + GyroTurnOnMicros(GYRO_ODR_400HZ) + 2000);
+    TEST_ASSERT_EQUAL_HEX8(0x06, simGyro.regs[GYRO_REG_CTRL1]);
+
+    start = HalSimMicros64();
+    TEST_ASSERT_TRUE(accel.Initialize(ACCEL_RNG_4G, true));
+    TEST_ASSERT_TRUE(HalSimMicros64() - start < ACCELMAG_TURN_ON_US_HYBRID + 2000);
+    TEST_ASSERT_EQUAL_HEX8(ACCELMAG_MCTRL1_HYBRID, simAccel.regs[ACCELMAG_REG_MCTRL1]);
+    TEST_ASSERT_EQUAL_HEX8(ACCELMAG_MCTRL2_AUTOINC, simAccel.regs[ACCELMAG_REG_MCTRL2]);
+
+    start = HalSimMicros64();
+    TEST_ASSERT_TRUE(mag.Initialize());
+    TEST_ASSERT_TRUE(baro.Initialize(BMP388_OS_1X, BMP388_OS_1X, BMP388_IIR_COEF_3, BMP388_ODR_50HZ));
+    TEST_ASSERT_TRUE(HalSimMicros64() - start < 30000);  // Baro.: 2ms reset, first 20ms sample
+
+    // Datasheet waits plus bus time. Was 200ms of fixed delays for the gyro and accel. alone.
+    TEST_ASSERT_TRUE(HalSimMicros64() - bootMicros <
+        GYRO_BOOT_US + GyroTurnOnMicros(GYRO_ODR_400HZ) + ACCELMAG_TURN_ON_US_HYBRID + 30000 + 5000);
+}
+
+
+/* A job does the same writes one wait at a time, without waiting */
+void test_regcfg_job(void)
+{
+    HostI2CBus bus;
+    SimLIS3MDL sim;
+    RegConfigJob job;
+    RegConfig_t tooLong[REG_CONFIG_MAX_ENTRIES + 1] = {};
+    uint32_t waitMicros;
+    uint32_t transfers;
+    uint64_t start;
+
+    bus.AttachDevice(SIM_LIS3MDL_ADDR, &sim);
+
+    const RegConfig_t config[] = {
+        {LIS3MDL_CTRL_REG3, 0x00, REG_VERIFY_ALL, 0},
+        {LIS3MDL_CTRL_REG4, 0x0C, REG_VERIFY_ALL, 500},
+        {LIS3MDL_CTRL_REG5, 0x40, REG_VERIFY_ALL, 0}
+    };
+    TEST_ASSERT_EQUAL_UINT32(REG_CONFIG_FAILED, job.Step(&waitMicros));  // Not started
+    TEST_ASSERT_TRUE(job.Start(&bus, SIM_LIS3MDL_ADDR, config, 3, REG_BURST_AUTOINC_MSB));
+    TEST_ASSERT_TRUE(job.IsBusy());
+
+    start = HalSimMicros64();
+    transfers = bus.transfers;
+    TEST_ASSERT_EQUAL_UINT32(REG_CONFIG_BUSY, job.Step(&waitMicros));
+    TEST_ASSERT_EQUAL_UINT32(500, waitMicros);
+    TEST_ASSERT_EQUAL_UINT32(1, bus.transfers - transfers);  // CTRL_REG3-4 in one burst
+    TEST_ASSERT_EQUAL_UINT32(REG_CONFIG_BUSY, job.Step(&waitMicros));
+    TEST_ASSERT_EQUAL_UINT32(0, waitMicros);
+    TEST_ASSERT_EQUAL_UINT32(REG_CONFIG_DONE, job.Step(&waitMicros));  // Read-back
+    TEST_ASSERT_EQUAL_UINT32(3, bus.transfers - transfers);
+    TEST_ASSERT_EQUAL_UINT64(0, HalSimMicros64() - start);  // The wait was left to the caller
+    TEST_ASSERT_FALSE(job.IsBusy());
+    TEST_ASSERT_EQUAL_HEX8(0x0C, sim.regs[LIS3MDL_CTRL_REG4]);
+    TEST_ASSERT_EQUAL_HEX8(0x40, sim.regs[LIS3MDL_CTRL_REG5]);
+
+    // A NACK ends the job
+    TEST_ASSERT_TRUE(job.Start(&bus, SIM_LIS3MDL_ADDR, config, 3, REG_BURST_AUTOINC_MSB));
+    bus.InjectNACKs(1);
+    TEST_ASSERT_EQUAL_UINT32(REG_CONFIG_FAILED, job.Step(&waitMicros));
+    TEST_ASSERT_FALSE(job.IsBusy());
+
+    TEST_ASSERT_FALSE(job.Start(&bus, SIM_LIS3MDL_ADDR, tooLong, REG_CONFIG_MAX_ENTRIES + 1, REG_BURST_AUTOINC_MSB));
+}
+
+#endif
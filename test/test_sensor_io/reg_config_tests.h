@@ -0,0 +1,28 @@
+// ----------------------------------------------------------------------------
+// REGISTER CONFIGURATION TABLE TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for register configuration tables: burst batching, read-back
+ * verification, and driver init time on the simulated bus.
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <unity.h>
+#include "hal/hal_platform.h"
+#include "hal/i2c_bus_host.h"
+#include "hal/sim_sensor_models.h"
+#include "sensor_drivers/reg_config.h"
+
+void test_regcfg_burst_autoinc(void);
+void test_regcfg_addr_pairs(void);
+void test_regcfg_verify(void);
+void test_regcfg_init_time(void);
+void test_regcfg_job(void);
+
+#endif
@@ -0,0 +1,134 @@
+// ----------------------------------------------------------------------------
+// SEQLOCK SNAPSHOT TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for seqlock snapshots: copies in and out, values that aren't a
+ * whole number of words, and a writer thread updating while the reader
+ * copies (host only).
+ */
+
+
+#ifdef UNIT_TEST
+#include "seqlock_tests.h"
+#ifndef ARDUINO
+#include <thread>
+#endif
+
+constexpr uint32_t SEQLOCK_TEST_WRITES = 1000000;  // Writes in the threaded test
+
+
+/**
+ * Test snapshot, like a sensor system's outputs. Every field is derived from 
+ * the update count, so a copy mixing two updates doesn't check out.
+ */
+typedef struct
+{
+    uint32_t count;
+    float vec[3];
+    uint64_t micros;
+    float extra[8];
+} SeqLockTestOutput_t;
+
+static SeqLockTestOutput_t MakeOutput(uint32_t count)
+{
+    SeqLockTestOutput_t out;
+
+    out.count = count;
+    for (uint8_t k = 0; k < 3; k++)
+        out.vec[k] = (float)(count % 1000) + (float)k;
+    out.micros = (uint64_t)count * 1250;
+    for (uint8_t k = 0; k < 8; k++)
+        out.extra[k] = -(float)(count % 4096) - (float)k;
+    return out;
+}
+
+static bool OutputIsWhole(const SeqLockTestOutput_t &out)
+{
+    SeqLockTestOutput_t expected = MakeOutput(out.count);
+
+    return memcmp(&out, &expected, sizeof(out)) == 0;
+}
+
+
+/* Read returns the last write, and Version counts writes */
+void test_seqlock_write_read(void)
+{
+    SeqLock<SeqLockTestOutput_t> snap;
+    SeqLockTestOutput_t out;
+
+    TEST_ASSERT_EQUAL_UINT32(0, snap.Version());
+    TEST_ASSERT_TRUE(snap.Read(&out));
+    TEST_ASSERT_EQUAL_UINT32(0, out.count);  // Zeros before the first write
+    TEST_ASSERT_FALSE(snap.Read(nullptr));
+
+    snap.Write(MakeOutput(7));
+    snap.Write(MakeOutput(8));
+    TEST_ASSERT_EQUAL_UINT32(2, snap.Version());
+    TEST_ASSERT_TRUE(snap.Read(&out));
+    TEST_ASSERT_EQUAL_UINT32(8, out.count);
+    TEST_ASSERT_TRUE(OutputIsWhole(out));
+}
+
+
+/* Values that aren't a multiple of 4 bytes copy exactly */
+void test_seqlock_odd_size(void)
+{
+    typedef struct
+    {
+        uint8_t b[7];
+    } Odd_t;
+    SeqLock<Odd_t> snap;
+    Odd_t in = {{1, 2, 3, 4, 5, 6, 7}};
+    Odd_t out;
+
+    snap.Write(in);
+    TEST_ASSERT_TRUE(snap.Read(&out));
+    TEST_ASSERT_EQUAL_MEMORY(in.b, out.b, sizeof(in.b));
+}
+
+
+#ifndef ARDUINO
+/* Updates from another thread: every copy is one whole update, never older than the last */
+void test_seqlock_threads(void)
+{
+    static SeqLock<SeqLockTestOutput_t> snap;
+    static std::atomic<bool> done(false);
+    SeqLockTestOutput_t out;
+    uint32_t reads = 0;
+    uint32_t torn = 0;
+    uint32_t backwards = 0;
+    uint32_t last = 0;
+
+    snap.Write(MakeOutput(0));
+    std::thread writer([]() {
+        for (uint32_t count = 1; count <= SEQLOCK_TEST_WRITES; count++)
+            snap.Write(MakeOutput(count));
+        done.store(true, std::memory_order_release);
+    });
+
+    while (!done.load(std::memory_order_acquire))
+    {
+        if (!snap.Read(&out))
+            continue;  // Writer kept landing mid-copy, try again
+        if (!OutputIsWhole(out))
+            torn++;
+        if (out.count < last)
+            backwards++;
+        last = out.count;
+        reads++;
+    }
+    writer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(0, backwards);
+    TEST_ASSERT_TRUE(reads > 0);
+    TEST_ASSERT_TRUE(snap.Read(&out));
+    TEST_ASSERT_EQUAL_UINT32(SEQLOCK_TEST_WRITES, out.count);
+    TEST_ASSERT_EQUAL_UINT32(SEQLOCK_TEST_WRITES + 1, snap.Version());
+}
+#endif
+
+#endif
@@ -0,0 +1,24 @@
+// ----------------------------------------------------------------------------
+// SEQLOCK SNAPSHOT TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for seqlock snapshots. The threaded test only runs on the host.
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <unity.h>
+#include "sensor_drivers/seqlock.h"
+
+void test_seqlock_write_read(void);
+void test_seqlock_odd_size(void);
+#ifndef ARDUINO
+void test_seqlock_threads(void);
+#endif
+
+#endif
@@ -0,0 +1,252 @@
+// ----------------------------------------------------------------------------
+// SPSC RING BUFFER TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the single-producer/single-consumer ring buffer: order, full
+ * ring, batches across the wrap, the drivers' sample streams, and a
+ * producer and consumer on real threads (host only).
+ */
+
+
+#ifdef UNIT_TEST
+#include "spsc_ring_tests.h"
+#include "sensor_drivers/fxas21002_gyro.h"
+#ifndef ARDUINO
+#include <thread>
+#endif
+
+constexpr uint32_t SPSC_TEST_ITEMS = 1000000;  // Items through the ring in the threaded tests
+
+
+/**
+ * Test item. Every word is derived from the sequence number, so a torn copy 
+ * (half from one item, half from another) doesn't check out.
+ */
+typedef struct
+{
+    uint32_t seq;
+    uint32_t words[7];
+} SPSCTestItem_t;
+
+static uint32_t ItemWord(uint32_t seq, uint8_t k)
+{
+    return (uint32_t)(seq * 2654435761UL) + k;
+}
+
+static SPSCTestItem_t MakeItem(uint32_t seq)
+{
+    SPSCTestItem_t item;
+
+    item.seq = seq;
+    for (uint8_t k = 0; k < 7; k++)
+        item.words[k] = ItemWord(seq, k);
+    return item;
+}
+
+static bool ItemIsWhole(const SPSCTestItem_t &item)
+{
+    for (uint8_t k = 0; k < 7; k++)
+    {
+        if (item.words[k] != ItemWord(item.seq, k))
+            return false;
+    }
+    return true;
+}
+
+
+/* Items come out in the order they went in */
+void test_spsc_push_pop(void)
+{
+    SPSCRing<uint32_t, 8> ring;
+    uint32_t v = 0;
+
+    TEST_ASSERT_FALSE(ring.Pop(&v));
+    TEST_ASSERT_TRUE(ring.Push(1));
+    TEST_ASSERT_TRUE(ring.Push(2));
+    TEST_ASSERT_EQUAL_UINT32(2, ring.Available());
+
+    TEST_ASSERT_TRUE(ring.Pop(&v));
+    TEST_ASSERT_EQUAL_UINT32(1, v);
+    TEST_ASSERT_TRUE(ring.Pop(&v));
+    TEST_ASSERT_EQUAL_UINT32(2, v);
+    TEST_ASSERT_FALSE(ring.Pop(&v));
+    TEST_ASSERT_EQUAL_UINT32(2, v);  // Unchanged when empty
+
+    ring.Push(3);
+    ring.Clear();
+    TEST_ASSERT_EQUAL_UINT32(0, ring.Available());
+}
+
+
+/* A full ring refuses new items and keeps the unread ones */
+void test_spsc_full(void)
+{
+    SPSCRing<uint32_t, 4> ring;
+    uint32_t v;
+
+    for (uint32_t i = 0; i < 4; i++)
+        TEST_ASSERT_TRUE(ring.Push(i));
+    TEST_ASSERT_FALSE(ring.Push(99));
+    TEST_ASSERT_FALSE(ring.Push(100));
+    TEST_ASSERT_EQUAL_UINT32(2, ring.Overruns());
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        TEST_ASSERT_TRUE(ring.Pop(&v));
+        TEST_ASSERT_EQUAL_UINT32(i, v);
+    }
+    TEST_ASSERT_TRUE(ring.Push(5));  // Room again
+}
+
+
+/* Batches are oldest first, across the end of the slot array */
+void test_spsc_batch_wrap(void)
+{
+    SPSCRing<uint32_t, 8> ring;
+    uint32_t out[8];
+    uint32_t next = 0;
+    size_t n;
+
+    for (uint32_t i = 0; i < 6; i++)
+        ring.Push(i);
+    TEST_ASSERT_EQUAL_UINT32(5, (uint32_t)ring.PopBatch(out, 5));
+    for (uint32_t i = 6; i < 13; i++)
+        TEST_ASSERT_TRUE(ring.Push(i));  // Wraps
+
+    next = 5;
+    while ((n = ring.PopBatch(out, 3)) > 0)
+    {
+        for (size_t i = 0; i < n; i++)
+            TEST_ASSERT_EQUAL_UINT32(next++, out[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(13, next);
+    TEST_ASSERT_EQUAL_UINT32(0, ring.Overruns());
+}
+
+
+/* The gyro publishes every sample it reads, FIFO samples included */
+void test_spsc_driver_stream(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 sim;
+    FXAS21002Gyro gyro(&bus);
+    GyroSample_t fifo[GYRO_FIFO_SIZE];
+    SensorSample_t samples[SENSOR_STREAM_DEPTH];
+    int16_t raw[3];
+    size_t nFIFO;
+    size_t n;
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &sim);
+    TEST_ASSERT_TRUE(gyro.Initialize());
+
+    sim.SetRate(10.0f, -20.0f, 30.0f);
+    TEST_ASSERT_TRUE(gyro.ReadSensor());
+    gyro.GetRaw(raw);
+    n = gyro.stream.PopBatch(samples, SENSOR_STREAM_DEPTH);
+    TEST_ASSERT_EQUAL_UINT32(1, (uint32_t)n);
+    TEST_ASSERT_EQUAL_MEMORY(raw, samples[0].raw, sizeof(raw));
+    TEST_ASSERT_EQUAL_UINT64(gyro.prevMeasMicros, samples[0].micros);
+
+    // A loop overrun's worth of FIFO samples all reach the stream
+    TEST_ASSERT_TRUE(gyro.ConfigureFIFO(GYRO_ODR_800HZ, 8));
+    gyro.ReadFIFO(fifo, GYRO_FIFO_SIZE);
+    gyro.stream.Clear();
+    delay(20);
+    nFIFO = gyro.ReadFIFO(fifo, GYRO_FIFO_SIZE);
+    TEST_ASSERT_TRUE(nFIFO >= 15);
+
+    n = gyro.stream.PopBatch(samples, SENSOR_STREAM_DEPTH);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)nFIFO, (uint32_t)n);
+    for (size_t i = 0; i < n; i++)
+        TEST_ASSERT_EQUAL_UINT64(fifo[i].micros, samples[i].micros);
+    TEST_ASSERT_EQUAL_UINT32(0, gyro.stream.Overruns());
+}
+
+
+#ifndef ARDUINO
+/* Producer retries while full: every item arrives, in order, whole */
+void test_spsc_threads_lossless(void)
+{
+    static SPSCRing<SPSCTestItem_t, 64> ring;
+    SPSCTestItem_t batch[16];
+    uint32_t next = 0;
+    uint32_t torn = 0;
+    uint32_t outOfOrder = 0;
+    size_t n;
+
+    std::thread producer([]() {
+        for (uint32_t seq = 0; seq < SPSC_TEST_ITEMS; seq++)
+        {
+            SPSCTestItem_t item = MakeItem(seq);
+            while (!ring.Push(item))
+                std::this_thread::yield();
+        }
+    });
+
+    while (next < SPSC_TEST_ITEMS)
+    {
+        n = ring.PopBatch(batch, 16);
+        if (n == 0)
+            std::this_thread::yield();
+        for (size_t i = 0; i < n; i++)
+        {
+            if (!ItemIsWhole(batch[i]))
+                torn++;
+            if (batch[i].seq != next)
+                outOfOrder++;
+            next++;
+        }
+    }
+    producer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(0, outOfOrder);
+    TEST_ASSERT_EQUAL_UINT32(0, ring.Available());
+}
+
+
+/* A slow consumer: refused items are counted, the rest arrive whole and in order */
+void test_spsc_threads_overrun(void)
+{
+    static SPSCRing<SPSCTestItem_t, 16> ring;
+    static std::atomic<bool> done(false);
+    SPSCTestItem_t batch[4];
+    uint32_t received = 0;
+    uint32_t torn = 0;
+    uint32_t outOfOrder = 0;
+    int64_t last = -1;
+    size_t n;
+
+    std::thread producer([]() {
+        for (uint32_t seq = 0; seq < SPSC_TEST_ITEMS; seq++)
+            ring.Push(MakeItem(seq));
+        done.store(true, std::memory_order_release);
+    });
+
+    do
+    {
+        n = ring.PopBatch(batch, 4);
+        for (size_t i = 0; i < n; i++)
+        {
+            if (!ItemIsWhole(batch[i]))
+                torn++;
+            if ((int64_t)batch[i].seq <= last)
+                outOfOrder++;
+            last = batch[i].seq;
+            received++;
+        }
+        if (received % 64 == 0)
+            std::this_thread::yield();  // Fall behind now and then
+    } while (!done.load(std::memory_order_acquire) || ring.Available() > 0);
+    producer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(0, outOfOrder);
+    TEST_ASSERT_EQUAL_UINT32(SPSC_TEST_ITEMS, received + ring.Overruns());
+}
+#endif
+
+#endif
@@ -0,0 +1,31 @@
+// ----------------------------------------------------------------------------
+// SPSC RING BUFFER TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the single-producer/single-consumer ring buffer and the drivers'
+ * sample streams. The threaded tests only run on the host.
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <unity.h>
+#include "hal/hal_platform.h"
+#include "hal/i2c_bus_host.h"
+#include "hal/sim_sensor_models.h"
+#include "sensor_drivers/spsc_ring.h"
+
+void test_spsc_push_pop(void);
+void test_spsc_full(void);
+void test_spsc_batch_wrap(void);
+void test_spsc_driver_stream(void);
+#ifndef ARDUINO
+void test_spsc_threads_lossless(void);
+void test_spsc_threads_overrun(void);
+#endif
+
+#endif
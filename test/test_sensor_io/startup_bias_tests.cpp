@@ -0,0 +1,186 @@
+// ----------------------------------------------------------------------------
+// STARTUP BIAS ESTIMATOR TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the running mean/variance and the non-blocking turn-on bias
+ * estimator. Samples come at the INS rates (400Hz gyro, 200Hz accel.) with
+ * repeatable pseudo-random noise.
+ */
+
+
+#ifdef UNIT_TEST
+#include "startup_bias_tests.h"
+
+constexpr uint32_t BIAS_TEST_GYRO_US = 2500;  // [us] Gyro sample period (400Hz)
+constexpr float BIAS_TEST_GYRO_BIAS[3] = {0.012f, -0.007f, 0.003f};  // [rad/s]
+constexpr float BIAS_TEST_ACCEL[3] = {0.15f, -0.2f, 9.79f};  // [m/s/s]
+
+
+/* Repeatable uniform noise in [-1, 1] */
+static float TestNoise(uint32_t *state)
+{
+    *state = (*state * 1664525UL) + 1013904223UL;
+    return ((float)(*state >> 8) / 8388608.0f) - 1.0f;
+}
+
+
+/**
+ * Feed still samples (bias plus noise) from 'startMicros' until the 
+ * estimator is done or 'maxMicros' passes. Every other gyro sample comes 
+ * with an accel. sample.
+ * 
+ * @return  [us] Time of the sample that finished it, 0 if it didn't.
+ */
+static uint64_t FeedStill(StartupBiasEstimator *est, uint64_t startMicros, uint64_t maxMicros, 
+    float gyroNoise, float accelNoise, uint32_t *rng)
+{
+    float g[3];
+    float a[3];
+
+    for (uint64_t t = startMicros; t < startMicros + maxMicros; t += BIAS_TEST_GYRO_US)
+    {
+        for (uint8_t k = 0; k < 3; k++)
+            g[k] = BIAS_TEST_GYRO_BIAS[k] + gyroNoise * TestNoise(rng);
+        est->AddGyro(g, t);
+
+        if ((t / BIAS_TEST_GYRO_US) % 2 == 0)
+        {
+            for (uint8_t k = 0; k < 3; k++)
+                a[k] = BIAS_TEST_ACCEL[k] + accelNoise * TestNoise(rng);
+            est->AddAccel(a, t);
+        }
+
+        if (est->IsDone())
+            return t;
+    }
+    return 0;
+}
+
+
+/* Welford matches the two-pass mean and variance, on a large offset in single precision */
+void test_running_stats_welford(void)
+{
+    RunningStats3 stats;
+    float x[200][3];
+    float mean[3] = {0.0f, 0.0f, 0.0f};
+    float var[3] = {0.0f, 0.0f, 0.0f};
+    uint32_t rng = 1;
+
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        for (uint8_t k = 0; k < 3; k++)
+        {
+            x[i][k] = 1000.0f * (float)(k + 1) + 0.01f * TestNoise(&rng);
+            mean[k] += x[i][k] / 200.0f;
+        }
+        stats.Add(x[i]);
+    }
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        for (uint8_t k = 0; k < 3; k++)
+            var[k] += (x[i][k] - mean[k]) * (x[i][k] - mean[k]) / 199.0f;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(200, stats.n);
+    for (uint8_t k = 0; k < 3; k++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, mean[k], stats.mean[k]);
+        TEST_ASSERT_FLOAT_WITHIN(0.05f * var[k], var[k], stats.Variance(k));
+    }
+
+    stats.Reset();
+    TEST_ASSERT_EQUAL_UINT32(0, stats.n);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, stats.Variance(0));
+}
+
+
+/* Quiet sensors converge well before the old 1s averaging time */
+void test_bias_est_converges_early(void)
+{
+    StartupBiasEstimator est;
+    uint32_t rng = 7;
+    uint64_t tDone;
+
+    TEST_ASSERT_TRUE(est.state == BIAS_EST_IDLE);
+    est.Start();
+    TEST_ASSERT_TRUE(est.state == BIAS_EST_MEASURING);
+
+    tDone = FeedStill(&est, 1000000, 2 * BIAS_EST_MAX_US, 0.006f, 0.02f, &rng);
+    TEST_ASSERT_TRUE(tDone > 0);
+    TEST_ASSERT_TRUE(tDone - 1000000 >= BIAS_EST_MIN_US);
+    TEST_ASSERT_TRUE(tDone - 1000000 < BIAS_EST_MAX_US / 2);
+    TEST_ASSERT_EQUAL_UINT32(0, est.restarts);
+
+    for (uint8_t k = 0; k < 3; k++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(4.0f * BIAS_EST_GYRO_SEM, BIAS_TEST_GYRO_BIAS[k], est.gyro.mean[k]);
+        TEST_ASSERT_FLOAT_WITHIN(4.0f * BIAS_EST_ACCEL_SEM, BIAS_TEST_ACCEL[k], est.accel.mean[k]);
+    }
+
+    // Done stays done
+    FeedStill(&est, tDone + BIAS_TEST_GYRO_US, 10000, 1.0f, 1.0f, &rng);
+    TEST_ASSERT_TRUE(est.IsDone());
+    TEST_ASSERT_EQUAL_UINT32(0, est.restarts);
+}
+
+
+/* A bump starts the measurement over, and none of it ends up in the means */
+void test_bias_est_restarts_on_motion(void)
+{
+    StartupBiasEstimator est;
+    uint32_t rng = 11;
+    float bump[3] = {0.5f, 0.0f, 0.0f};  // [rad/s]
+    float tilt[3] = {2.0f, -0.2f, 9.6f};  // [m/s/s]
+    uint64_t tDone;
+
+    est.Start();
+    TEST_ASSERT_EQUAL_UINT32(0, FeedStill(&est, 0, 150000, 0.006f, 0.02f, &rng));
+    est.AddGyro(bump, 150000);
+    est.AddAccel(tilt, 152500);
+    TEST_ASSERT_FALSE(est.IsDone());
+    TEST_ASSERT_TRUE(est.restarts >= 1);
+
+    tDone = FeedStill(&est, 155000, 2 * BIAS_EST_MAX_US, 0.006f, 0.02f, &rng);
+    TEST_ASSERT_TRUE(tDone > 0);
+    TEST_ASSERT_TRUE(tDone - 155000 >= BIAS_EST_MIN_US);  // A full still window after the bump
+    for (uint8_t k = 0; k < 3; k++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(4.0f * BIAS_EST_GYRO_SEM, BIAS_TEST_GYRO_BIAS[k], est.gyro.mean[k]);
+        TEST_ASSERT_FLOAT_WITHIN(4.0f * BIAS_EST_ACCEL_SEM, BIAS_TEST_ACCEL[k], est.accel.mean[k]);
+    }
+}
+
+
+/* With the gyro bias already known (stored table), only the accel. is measured */
+void test_bias_est_gyro_known(void)
+{
+    StartupBiasEstimator est;
+    uint32_t rng = 13;
+    uint64_t tDone;
+
+    est.Start(false);
+    tDone = FeedStill(&est, 0, 2 * BIAS_EST_MAX_US, 0.006f, 0.02f, &rng);
+    TEST_ASSERT_TRUE(tDone > 0);
+    TEST_ASSERT_EQUAL_UINT32(0, est.gyro.n);
+    TEST_ASSERT_TRUE(est.accel.n >= BIAS_EST_MIN_SAMPLES);
+}
+
+
+/* Noisier than expected but still: done after BIAS_EST_MAX_US anyway */
+void test_bias_est_noisy_timeout(void)
+{
+    StartupBiasEstimator est;
+    uint32_t rng = 17;
+    uint64_t tDone;
+
+    est.Start();
+    tDone = FeedStill(&est, 0, 2 * BIAS_EST_MAX_US, 0.025f, 0.02f, &rng);
+    TEST_ASSERT_TRUE(tDone >= BIAS_EST_MAX_US);
+    TEST_ASSERT_TRUE(tDone < BIAS_EST_MAX_US + 2 * BIAS_TEST_GYRO_US);
+    TEST_ASSERT_EQUAL_UINT32(0, est.restarts);
+}
+
+#endif
@@ -0,0 +1,26 @@
+// ----------------------------------------------------------------------------
+// STARTUP BIAS ESTIMATOR TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the running mean/variance and the non-blocking turn-on bias
+ * estimator, fed with simulated still and moving samples.
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <unity.h>
+#include "maths/running_stats.h"
+#include "sensor_drivers/startup_bias.h"
+
+void test_running_stats_welford(void);
+void test_bias_est_converges_early(void);
+void test_bias_est_restarts_on_motion(void);
+void test_bias_est_gyro_known(void);
+void test_bias_est_noisy_timeout(void);
+
+#endif
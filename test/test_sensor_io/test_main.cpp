@@ -0,0 +1,182 @@
+// ----------------------------------------------------------------------------
+// SENSOR I/O UNIT TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the sensor I/O layer (data-ready interrupts, etc.). Hardware
+ * events are simulated, so these run on the native host (pio test -e native).
+ */
+
+
+#ifdef UNIT_TEST
+#include <unity.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include "data_ready_tests.h"
+#include "async_i2c_tests.h"
+#include "hal_bus_tests.h"
+#include "timestamp_tests.h"
+#include "counts_to_si_tests.h"
+#include "bus_scheduler_tests.h"
+#include "bus_health_tests.h"
+#include "gyro_temp_bias_tests.h"
+#include "reg_config_tests.h"
+#include "spsc_ring_tests.h"
+#include "seqlock_tests.h"
+#include "startup_bias_tests.h"
+
+
+/* Enable/disable certain tests (comment/uncomment) */
+#define TEST_DATA_READY  // Data-ready pin event queue
+#define TEST_ASYNC_I2C  // Async I2C engine
+#define TEST_HAL_BUS  // I2C bus HAL, sensor models, and drivers on the simulated bus
+#define TEST_TIMESTAMPS  // 64-bit clock and sample timestamps
+#define TEST_COUNTS_TO_SI  // Fused raw-count to SI conversion
+#define TEST_BUS_SCHEDULER  // I2C bus scheduler
+#define TEST_BUS_HEALTH  // I2C bus error stats, recovery, and sensor re-init
+#define TEST_GYRO_TEMP_BIAS  // Gyro temperature bias table and NV storage
+#define TEST_REG_CONFIG  // Register configuration tables and driver init time
+#define TEST_SPSC_RING  // SPSC ring buffer and driver sample streams
+#define TEST_SEQLOCK  // Seqlock output snapshots
+#define TEST_STARTUP_BIAS  // Running mean/variance and turn-on bias estimation
+
+
+void run_tests()
+{
+    #ifdef ARDUINO
+    delay(5000);  // service delay
+    #endif
+    UNITY_BEGIN();
+
+    #ifdef TEST_DATA_READY
+    RUN_TEST(test_drdy_detached_is_polled);
+    RUN_TEST(test_drdy_trigger_and_pop);
+    RUN_TEST(test_drdy_pop_newest);
+    RUN_TEST(test_drdy_overrun);
+    RUN_TEST(test_drdy_slots);
+    #endif
+
+    #ifdef TEST_ASYNC_I2C
+    RUN_TEST(test_async_i2c_read);
+    RUN_TEST(test_async_i2c_write);
+    RUN_TEST(test_async_i2c_order);
+    RUN_TEST(test_async_i2c_nack);
+    RUN_TEST(test_async_i2c_queue_full);
+    RUN_TEST(test_async_i2c_resubmit_from_callback);
+    RUN_TEST(test_async_i2c_lock_bus);
+    RUN_TEST(test_async_i2c_shared_bus);
+    #endif
+
+    #ifdef TEST_HAL_BUS
+    RUN_TEST(test_hal_bus_probe_and_nack);
+    RUN_TEST(test_hal_bus_timing);
+    RUN_TEST(test_hal_fxas21002_driver);
+    RUN_TEST(test_hal_fxas21002_fifo);
+    RUN_TEST(test_hal_fxos8700_driver);
+    RUN_TEST(test_hal_fxos8700_fifo);
+    RUN_TEST(test_hal_lis3mdl_driver);
+    RUN_TEST(test_hal_lis3mdl_fast_odr);
+    RUN_TEST(test_hal_lis3mdl_temp_comp);
+    RUN_TEST(test_hal_bmp388_compensation);
+    RUN_TEST(test_hal_bmp388_driver);
+    RUN_TEST(test_hal_bmp388_fifo);
+    RUN_TEST(test_hal_ublox_stream);
+    RUN_TEST(test_hal_ublox_ack);
+    #endif
+
+    #ifdef TEST_TIMESTAMPS
+    RUN_TEST(test_micros64_across_wrap);
+    RUN_TEST(test_timestamp_polled_read);
+    RUN_TEST(test_timestamp_data_ready);
+    RUN_TEST(test_timestamp_fifo);
+    #endif
+
+    #ifdef TEST_COUNTS_TO_SI
+    RUN_TEST(test_counts_to_si_scale_only);
+    RUN_TEST(test_counts_to_si_calibration);
+    RUN_TEST(test_counts_to_si_axes);
+    RUN_TEST(test_counts_to_si_drivers);
+    #endif
+
+    #ifdef TEST_BUS_SCHEDULER
+    RUN_TEST(test_sched_priority_order);
+    RUN_TEST(test_sched_byte_budget);
+    RUN_TEST(test_sched_deferral);
+    RUN_TEST(test_sched_gps_backlog_jitter);
+    #endif
+
+    #ifdef TEST_BUS_HEALTH
+    RUN_TEST(test_health_device_stats);
+    RUN_TEST(test_health_bus_recovery);
+    RUN_TEST(test_health_sensor_reinit);
+    RUN_TEST(test_health_sensor_reinit_nonblocking);
+    #endif
+
+    #ifdef TEST_GYRO_TEMP_BIAS
+    RUN_TEST(test_tbias_interpolation);
+    RUN_TEST(test_tbias_learn_split_and_cap);
+    RUN_TEST(test_tbias_nv_roundtrip);
+    RUN_TEST(test_tbias_gyro_temperature);
+    #endif
+
+    #ifdef TEST_REG_CONFIG
+    RUN_TEST(test_regcfg_burst_autoinc);
+    RUN_TEST(test_regcfg_addr_pairs);
+    RUN_TEST(test_regcfg_verify);
+    RUN_TEST(test_regcfg_init_time);
+    RUN_TEST(test_regcfg_job);
+    #endif
+
+    #ifdef TEST_SPSC_RING
+    RUN_TEST(test_spsc_push_pop);
+    RUN_TEST(test_spsc_full);
+    RUN_TEST(test_spsc_batch_wrap);
+    RUN_TEST(test_spsc_driver_stream);
+    #ifndef ARDUINO
+    RUN_TEST(test_spsc_threads_lossless);
+    RUN_TEST(test_spsc_threads_overrun);
+    #endif
+    #endif
+
+    #ifdef TEST_SEQLOCK
+    RUN_TEST(test_seqlock_write_read);
+    RUN_TEST(test_seqlock_odd_size);
+    #ifndef ARDUINO
+    RUN_TEST(test_seqlock_threads);
+    #endif
+    #endif
+
+    #ifdef TEST_STARTUP_BIAS
+    RUN_TEST(test_running_stats_welford);
+    RUN_TEST(test_bias_est_converges_early);
+    RUN_TEST(test_bias_est_restarts_on_motion);
+    RUN_TEST(test_bias_est_gyro_known);
+    RUN_TEST(test_bias_est_noisy_timeout);
+    #endif
+
+    UNITY_END();
+}
+
+
+
+#ifdef ARDUINO
+void setup()
+{
+    run_tests();
+}
+
+void loop()
+{
+    // loop code
+}
+#else
+int main(int argc, char **argv)
+{
+    run_tests();
+    return 0;
+}
+#endif
+#endif
@@ -0,0 +1,113 @@
+// ----------------------------------------------------------------------------
+// SENSOR TIMESTAMP TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the 64-bit timestamp clock and the drivers' sample timestamps,
+ * on the simulated bus and sensor models.
+ */
+
+
+#ifdef UNIT_TEST
+#include "timestamp_tests.h"
+#include "sensor_drivers/fxas21002_gyro.h"
+#include "sensor_drivers/lis3mdl_magnetometer.h"
+
+constexpr int8_t TIMESTAMP_TEST_PIN = 3;  // Any pin, nothing is wired on the host
+
+
+/* Micros64() keeps counting where micros() wraps */
+void test_micros64_across_wrap(void)
+{
+    uint64_t t0;
+
+    HalSimSetMicros(0xFFFFFF00ULL);
+    t0 = Micros64();
+    delayMicroseconds(0x200);
+
+    TEST_ASSERT_EQUAL_UINT32(0x100, micros());  // Wrapped
+    TEST_ASSERT_TRUE(Micros64() > t0);
+    TEST_ASSERT_EQUAL_UINT32(0x200, (uint32_t)(Micros64() - t0));
+}
+
+
+/* Without a data-ready pin, samples are stamped at the transfer start */
+void test_timestamp_polled_read(void)
+{
+    HostI2CBus bus;
+    SimLIS3MDL sim;
+    LIS3MDL_Mag mag(&bus);
+    uint64_t tStart;
+
+    bus.AttachDevice(SIM_LIS3MDL_ADDR, &sim);
+    bus.SetClockHz(400000);
+    TEST_ASSERT_TRUE(mag.Initialize());
+    delay(10);
+
+    tStart = Micros64();
+    TEST_ASSERT_TRUE(mag.ReadSensor());
+    TEST_ASSERT_TRUE(Micros64() > tStart);  // The read took bus time...
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(tStart - LIS3MDLGroupDelayMicros(LIS3MDL_ODR_155HZ)), (uint32_t)mag.prevMeasMicros);  // ...which isn't in the stamp
+}
+
+
+/* With a data-ready pin, samples are stamped at data-ready, not at the read */
+void test_timestamp_data_ready(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 sim;
+    FXAS21002Gyro gyro(&bus);
+    uint64_t tReady;
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &sim);
+    TEST_ASSERT_TRUE(gyro.Initialize(GYRO_RNG_1000DPS));
+    TEST_ASSERT_TRUE(gyro.AttachDataReady(TIMESTAMP_TEST_PIN));
+
+    // Attaching went through standby: samples during the turn-on time are dropped
+    gyro.drdy.Trigger(Micros64());
+    TEST_ASSERT_FALSE(gyro.DataReady());
+    delayMicroseconds(GyroTurnOnMicros(GYRO_ODR_400HZ));
+    TEST_ASSERT_FALSE(gyro.DataReady());
+
+    // Interrupt fires, the loop gets to the read 3ms later
+    tReady = Micros64();
+    gyro.drdy.Trigger(tReady);
+    delay(3);
+    TEST_ASSERT_TRUE(gyro.DataReady());
+    TEST_ASSERT_TRUE(gyro.ReadSensor());
+
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(tReady - GyroGroupDelayMicros(GYRO_ODR_400HZ)), (uint32_t)gyro.prevMeasMicros);
+    TEST_ASSERT_FALSE(gyro.DataReady());
+    gyro.drdy.Detach();
+}
+
+
+/* FIFO samples are spaced one ODR period apart, newest last */
+void test_timestamp_fifo(void)
+{
+    HostI2CBus bus;
+    SimFXAS21002 sim;
+    FXAS21002Gyro gyro(&bus);
+    GyroSample_t samples[GYRO_FIFO_SIZE];
+    uint64_t tStart;
+    size_t n;
+
+    bus.AttachDevice(SIM_FXAS21002_ADDR, &sim);
+    TEST_ASSERT_TRUE(gyro.Initialize());
+    TEST_ASSERT_TRUE(gyro.ConfigureFIFO(GYRO_ODR_800HZ, 8));
+    gyro.ReadFIFO(samples, GYRO_FIFO_SIZE);  // Empty it
+
+    delay(5);
+    tStart = Micros64();
+    n = gyro.ReadFIFO(samples, GYRO_FIFO_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(4, (uint32_t)n);
+
+    TEST_ASSERT_EQUAL_UINT32(1250, (uint32_t)(samples[1].micros - samples[0].micros));
+    TEST_ASSERT_EQUAL_UINT32(1250, (uint32_t)(samples[3].micros - samples[2].micros));
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(tStart - GyroGroupDelayMicros(GYRO_ODR_800HZ)), (uint32_t)samples[3].micros);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)samples[3].micros, (uint32_t)gyro.prevMeasMicros);
+}
+
+#endif
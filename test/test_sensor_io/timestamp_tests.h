@@ -0,0 +1,26 @@
+// ----------------------------------------------------------------------------
+// SENSOR TIMESTAMP TESTS
+//
+// Code By: Michael Wrona
+// Created: 18 Oct 2026
+// ----------------------------------------------------------------------------
+/**
+ * Tests for the 64-bit timestamp clock and the drivers' sample timestamps
+ * (data-ready or transfer start, less the group delay).
+ */
+
+
+#ifdef UNIT_TEST
+#pragma once
+
+#include <unity.h>
+#include "hal/hal_platform.h"
+#include "hal/i2c_bus_host.h"
+#include "hal/sim_sensor_models.h"
+
+void test_micros64_across_wrap(void);
+void test_timestamp_polled_read(void);
+void test_timestamp_data_ready(void);
+void test_timestamp_fifo(void);
+
+#endif